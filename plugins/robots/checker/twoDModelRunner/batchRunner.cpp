@@ -0,0 +1,272 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "batchRunner.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTimer>
+
+#include <qrkernel/logging.h>
+#include <qrutils/outFile.h>
+
+#include "batchWorker.h"
+#include "runner.h"
+
+using namespace twoDModel;
+
+/// Time given to a worker above the time limit of a run before it is considered hanged and killed.
+/// Includes plugins loading in a freshly started worker.
+const int hangGraceTime = 30000;
+
+/// Time given to workers to exit when all the tasks are done.
+const int workerExitTimeout = 5000;
+
+BatchRunner::BatchRunner(const QString &manifest, const QList<BatchTask> &tasks
+		, int jobs, int timeLimit, int memoryLimit, const QString &report, TrajectoryFormat trajectoryFormat)
+	: mManifest(manifest)
+	, mTasks(tasks)
+	, mJobs(qMax(1, jobs))
+	, mTimeLimit(timeLimit)
+	, mMemoryLimit(memoryLimit)
+	, mReport(report)
+	, mTrajectoryFormat(trajectoryFormat)
+	, mWorkerProgram(QCoreApplication::applicationFilePath())
+	, mHangGraceTime(hangGraceTime)
+	, mStatuses(tasks.size(), Status::notStarted)
+	, mExitCodes(tasks.size(), -1)
+{
+}
+
+BatchRunner::~BatchRunner()
+{
+	for (Worker * const worker : mWorkers) {
+		worker->process->disconnect(this);
+		worker->process->closeWriteChannel();
+		if (!worker->process->waitForFinished(workerExitTimeout)) {
+			worker->process->kill();
+			worker->process->waitForFinished();
+		}
+
+		delete worker;
+	}
+}
+
+void BatchRunner::setWorkerProgram(const QString &program, int hangGraceTime)
+{
+	mWorkerProgram = program;
+	mHangGraceTime = hangGraceTime;
+}
+
+void BatchRunner::start()
+{
+	for (int i = 0; i < mTasks.size(); ++i) {
+		QDir().mkpath(QFileInfo(mTasks[i].report).absolutePath());
+		QDir().mkpath(QFileInfo(mTasks[i].trajectory).absolutePath());
+		mPendingTasks.enqueue(i);
+	}
+
+	if (mTasks.isEmpty()) {
+		writeReport();
+		emit finished(0);
+		return;
+	}
+
+	for (int i = 0; i < qMin(mJobs, mTasks.size()); ++i) {
+		startWorker();
+	}
+}
+
+void BatchRunner::startWorker()
+{
+	Worker * const worker = new Worker;
+	worker->process = new QProcess(this);
+	worker->process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+	worker->watchdog = new QTimer(worker->process);
+	worker->watchdog->setSingleShot(true);
+	mWorkers << worker;
+
+	connect(worker->process, &QProcess::readyReadStandardOutput, this, [=]() { onWorkerOutput(worker); });
+	connect(worker->process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished)
+			, this, [=]() { onWorkerFinished(worker); });
+	connect(worker->process, static_cast<void (QProcess::*)(QProcess::ProcessError)>(&QProcess::error)
+			, this, [=](QProcess::ProcessError error) {
+		if (error == QProcess::FailedToStart) {
+			QLOG_ERROR() << "Failed to start batch worker:" << worker->process->errorString();
+			onWorkerFinished(worker);
+		}
+	});
+
+	connect(worker->watchdog, &QTimer::timeout, this, [=]() { onWorkerHanged(worker); });
+
+	worker->process->start(mWorkerProgram, {
+			"--platform", "minimal"
+			, "--batch-worker", mManifest
+			, "--time-limit", QString::number(mTimeLimit)
+			, "--memory-limit", QString::number(mMemoryLimit)
+			, "--trajectory-format", mTrajectoryFormat == TrajectoryFormat::binary ? "binary" : "json"
+	});
+
+	giveTask(worker);
+}
+
+void BatchRunner::giveTask(Worker *worker)
+{
+	if (mPendingTasks.isEmpty()) {
+		// Worker exits when its input is closed.
+		worker->process->closeWriteChannel();
+		return;
+	}
+
+	worker->task = mPendingTasks.dequeue();
+	worker->process->write(QByteArray::number(worker->task) + "\n");
+	if (mTimeLimit > 0) {
+		worker->watchdog->start(2 * mTimeLimit + mHangGraceTime);
+	}
+}
+
+void BatchRunner::onWorkerOutput(Worker *worker)
+{
+	worker->output += worker->process->readAllStandardOutput();
+	int lineEnd = worker->output.indexOf('\n');
+	while (lineEnd >= 0) {
+		const QString line = QString::fromUtf8(worker->output.left(lineEnd)).trimmed();
+		worker->output.remove(0, lineEnd + 1);
+		lineEnd = worker->output.indexOf('\n');
+
+		if (!line.startsWith(BatchWorker::finishedMarker)) {
+			continue;
+		}
+
+		const QStringList result = line.mid(qstrlen(BatchWorker::finishedMarker)).split(' ', QString::SkipEmptyParts);
+		if (result.size() != 2 || result[0].toInt() != worker->task) {
+			QLOG_ERROR() << "Unexpected batch worker output:" << line;
+			continue;
+		}
+
+		const int exitCode = result[1].toInt();
+		const Status status = exitCode == 0 ? Status::passed
+				: exitCode == 1 ? Status::failed
+				: exitCode == 2 ? Status::incorrectSaveFile
+				: exitCode == Runner::timeLimitExceededExitCode ? Status::timeout
+				: Status::internalError;
+
+		worker->watchdog->stop();
+		const int task = worker->task;
+		worker->task = -1;
+		completeTask(task, status, exitCode);
+		giveTask(worker);
+	}
+}
+
+void BatchRunner::onWorkerFinished(Worker *worker)
+{
+	if (!mWorkers.contains(worker)) {
+		return;
+	}
+
+	worker->watchdog->stop();
+	mWorkers.removeOne(worker);
+	worker->process->deleteLater();
+	const int task = worker->task;
+	const bool hanged = worker->hanged;
+	delete worker;
+
+	if (task >= 0) {
+		// A solution crashed the worker (possibly having exceeded memory limit) or hanged it, other tasks
+		// must not suffer from it, so a new worker is started instead.
+		completeTask(task, hanged ? Status::timeout : Status::crashed, -1);
+		if (!mPendingTasks.isEmpty()) {
+			startWorker();
+		}
+	}
+}
+
+void BatchRunner::onWorkerHanged(Worker *worker)
+{
+	QLOG_WARN() << "Batch worker hanged on" << mTasks[worker->task].solution << mTasks[worker->task].field
+			<< ", killing it";
+	worker->hanged = true;
+	worker->process->kill();
+}
+
+void BatchRunner::completeTask(int task, Status status, int exitCode)
+{
+	mStatuses[task] = status;
+	mExitCodes[task] = exitCode;
+	++mCompletedTasks;
+	QLOG_INFO() << "Batch task" << mTasks[task].solution << mTasks[task].field << ":" << statusName(status);
+
+	if (mCompletedTasks < mTasks.size()) {
+		return;
+	}
+
+	writeReport();
+	emit finished(mStatuses.count(Status::passed) == mStatuses.size() ? 0 : 1);
+}
+
+void BatchRunner::writeReport() const
+{
+	if (mReport.isEmpty()) {
+		return;
+	}
+
+	QJsonArray runs;
+	for (int i = 0; i < mTasks.size(); ++i) {
+		QFile runReport(mTasks[i].report);
+		const QJsonArray messages = runReport.open(QIODevice::ReadOnly)
+				? QJsonDocument::fromJson(runReport.readAll()).array()
+				: QJsonArray();
+
+		runs.append(QJsonObject({
+			{ "solution", mTasks[i].solution }
+			, { "field", mTasks[i].field }
+			, { "mode", mTasks[i].mode }
+			, { "status", statusName(mStatuses[i]) }
+			, { "exitCode", mExitCodes[i] }
+			, { "report", mTasks[i].report }
+			, { "trajectory", mTasks[i].trajectory }
+			, { "messages", messages }
+		}));
+	}
+
+	utils::OutFile out(mReport);
+	out() << QJsonDocument(runs).toJson();
+}
+
+QString BatchRunner::statusName(Status status)
+{
+	switch (status) {
+	case Status::notStarted:
+		return "not-started";
+	case Status::passed:
+		return "passed";
+	case Status::failed:
+		return "failed";
+	case Status::incorrectSaveFile:
+		return "incorrect-save";
+	case Status::timeout:
+		return "timeout";
+	case Status::crashed:
+		return "crashed";
+	case Status::internalError:
+		return "internal-error";
+	}
+
+	return QString();
+}
@@ -0,0 +1,113 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QProcess>
+#include <QtCore/QQueue>
+#include <QtCore/QVector>
+
+#include "batchTask.h"
+#include "reporter.h"
+
+class QTimer;
+
+namespace twoDModel {
+
+/// Checks many solutions on many fields. Tasks are distributed among a pool of worker processes (each of them
+/// loads plugins only once and then interprets tasks one by one), so a crash or a hang of one solution does not
+/// affect the others. Results of all the runs are collected into one JSON report.
+class BatchRunner : public QObject
+{
+	Q_OBJECT
+
+public:
+	/// @param manifest Batch manifest, see BatchTask::loadManifest() for its format.
+	/// @param tasks Tasks loaded from manifest.
+	/// @param jobs Count of worker processes.
+	/// @param timeLimit Maximal real-time duration of one run in milliseconds, 0 means no limit.
+	/// @param memoryLimit Maximal address space of one worker in megabytes, 0 means no limit.
+	/// @param report A path to a file where summary of all runs will be written (JSON).
+	/// @param trajectoryFormat Format in which robot`s trajectories will be written by workers.
+	BatchRunner(const QString &manifest, const QList<BatchTask> &tasks
+			, int jobs, int timeLimit, int memoryLimit, const QString &report, TrajectoryFormat trajectoryFormat);
+
+	~BatchRunner() override;
+
+	/// Replaces the program started as a worker, by default it is this application in batch worker mode.
+	/// Used to check the runner itself with a stub worker.
+	/// @param hangGraceTime Time given to the worker above the time limit of a run before it is killed.
+	void setWorkerProgram(const QString &program, int hangGraceTime);
+
+	/// Starts workers and distributes tasks among them, emits finished() when all tasks are done.
+	void start();
+
+signals:
+	/// Emitted when all tasks are done.
+	/// @param exitCode 0 if all the solutions passed on all the fields, 1 otherwise.
+	void finished(int exitCode);
+
+private:
+	/// Result of one task, used in summary.
+	enum class Status
+	{
+		notStarted
+		, passed
+		, failed
+		, incorrectSaveFile
+		, timeout
+		, crashed
+		, internalError
+	};
+
+	struct Worker
+	{
+		QProcess *process = nullptr;
+		QTimer *watchdog = nullptr;
+		QByteArray output;
+		int task = -1;
+		bool hanged = false;
+	};
+
+	void startWorker();
+	void giveTask(Worker *worker);
+	void onWorkerOutput(Worker *worker);
+	void onWorkerFinished(Worker *worker);
+	void onWorkerHanged(Worker *worker);
+	void completeTask(int task, Status status, int exitCode);
+	void writeReport() const;
+
+	static QString statusName(Status status);
+
+	const QString mManifest;
+	const QList<BatchTask> mTasks;
+	const int mJobs;
+	const int mTimeLimit;
+	const int mMemoryLimit;
+	const QString mReport;
+	const TrajectoryFormat mTrajectoryFormat;
+	QString mWorkerProgram;
+	int mHangGraceTime;
+
+	QQueue<int> mPendingTasks;
+	QVector<Status> mStatuses;
+	QVector<int> mExitCodes;
+	int mCompletedTasks = 0;
+	QList<Worker *> mWorkers;
+};
+
+}
@@ -0,0 +1,108 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "batchTask.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+using namespace twoDModel;
+
+bool BatchTask::loadManifest(const QString &fileName, QList<BatchTask> &tasks, QString &errorMessage)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		errorMessage = QObject::tr("Can not open %1").arg(fileName);
+		return false;
+	}
+
+	QJsonParseError parseError;
+	const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &parseError);
+	if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+		errorMessage = QObject::tr("%1 is not a valid manifest: %2").arg(fileName, parseError.errorString());
+		return false;
+	}
+
+	const QJsonObject manifest = document.object();
+	const QDir root = QFileInfo(fileName).absoluteDir();
+	const auto path = [&root](const QJsonValue &value) {
+		return value.toString().isEmpty() ? QString() : root.absoluteFilePath(value.toString());
+	};
+
+	const QDir reports(path(manifest["reports"].toString("reports")));
+	const QDir trajectories(path(manifest["trajectories"].toString("trajectories")));
+	const bool checkOwnField = manifest["checkOwnField"].toBool(true);
+	const QJsonArray fields = manifest["fields"].toArray();
+	const QJsonObject generation = manifest["generate"].toObject();
+	QStringList targets;
+	for (const QJsonValue &target : generation["targets"].toArray()) {
+		targets << target.toString();
+	}
+
+	const QDir generated(path(generation["output"].toString("generated")));
+
+	tasks.clear();
+	for (const QJsonValue &solutionValue : manifest["solutions"].toArray()) {
+		const QJsonObject solution = solutionValue.toObject();
+		const QString saveFile = path(solution["file"]);
+		const QString solutionId = solution["id"].toString(QFileInfo(saveFile).completeBaseName());
+		if (saveFile.isEmpty()) {
+			errorMessage = QObject::tr("Solution %1 has no save file").arg(solutionId);
+			return false;
+		}
+
+		BatchTask task;
+		task.solution = solutionId;
+		task.saveFile = saveFile;
+		task.mode = solution["mode"].toString("diagram");
+
+		if (checkOwnField) {
+			task.input = path(solution["input"]);
+			task.report = reports.absoluteFilePath(solutionId + "/_" + solutionId);
+			task.trajectory = trajectories.absoluteFilePath(solutionId + "/_" + solutionId);
+			tasks << task;
+		}
+
+		for (const QJsonValue &fieldValue : fields) {
+			const QJsonObject field = fieldValue.toObject();
+			task.fieldFile = path(field["file"]);
+			task.field = field["id"].toString(QFileInfo(task.fieldFile).completeBaseName());
+			if (task.fieldFile.isEmpty()) {
+				errorMessage = QObject::tr("Field %1 has no world model file").arg(task.field);
+				return false;
+			}
+
+			task.input = path(field["input"]);
+			task.report = reports.absoluteFilePath(solutionId + "/" + task.field);
+			task.trajectory = trajectories.absoluteFilePath(solutionId + "/" + task.field);
+			tasks << task;
+		}
+
+		if (!targets.isEmpty()) {
+			BatchTask generationTask;
+			generationTask.solution = solutionId;
+			generationTask.saveFile = saveFile;
+			generationTask.mode = "generate";
+			generationTask.targets = targets;
+			generationTask.outputFolder = generated.absoluteFilePath(solutionId);
+			generationTask.report = reports.absoluteFilePath(solutionId + "/generation");
+			tasks << generationTask;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,79 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+namespace twoDModel {
+
+/// One run of the checker in batch mode: a solution interpreted on one of the fields or code generated from it.
+struct BatchTask
+{
+	/// Identifier of the solution, used as a name of reports folder.
+	QString solution;
+
+	/// Identifier of the field, empty if the solution is checked on its own field.
+	QString field;
+
+	/// Save file with the solution.
+	QString saveFile;
+
+	/// XML file with the world model that must replace the one from save file, empty for its own field.
+	QString fieldFile;
+
+	/// A path to a file with inputs for JavaScript solution.
+	QString input;
+
+	/// Interpret mode, "diagram" or "js", or "generate" for code generation.
+	QString mode;
+
+	/// Names of generators for "generate" mode.
+	QStringList targets;
+
+	/// A folder where generated code will be put for "generate" mode.
+	QString outputFolder;
+
+	/// A path to a file where JSON report about this run will be written.
+	QString report;
+
+	/// A path to a file where robot`s trajectory will be written.
+	QString trajectory;
+
+	/// Reads batch manifest and returns tasks for all pairs of solutions and fields listed there.
+	/// Manifest is a JSON object like
+	/// @code
+	/// {
+	///     "solutions": [ { "id": "alongTheBox", "file": "alongTheBox.qrs", "mode": "diagram"
+	///             , "input": "check-self.txt" } ],
+	///     "fields": [ { "id": "field1", "file": "field1.xml", "input": "field1.txt" } ],
+	///     "checkOwnField": true,
+	///     "reports": "reports",
+	///     "trajectories": "trajectories",
+	///     "generate": { "targets": [ "trikQts", "trikPython" ], "output": "generated" }
+	/// }
+	/// @endcode
+	/// Relative paths are resolved against the folder of manifest. Reports and trajectories are placed like
+	/// check-solution.sh does it: "<reports>/<solution>/<field>", "<reports>/<solution>/_<solution>" for
+	/// the run on solution`s own field. If "generate" section is present, code for each solution is also generated
+	/// with all the listed generators into "<output>/<solution>/<target>", generation messages are reported
+	/// into "<reports>/<solution>/generation".
+	/// @param errorMessage Filled with the description of a problem if manifest can not be read.
+	/// @returns True if manifest was successfully read.
+	static bool loadManifest(const QString &fileName, QList<BatchTask> &tasks, QString &errorMessage);
+};
+
+}
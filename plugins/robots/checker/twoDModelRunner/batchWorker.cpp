@@ -0,0 +1,121 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "batchWorker.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+
+#include <qrkernel/logging.h>
+#include <qrrepo/repoApi.h>
+
+#include "runner.h"
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+using namespace twoDModel;
+
+const char *BatchWorker::finishedMarker = "@@2D-model-batch finished";
+
+BatchWorker::BatchWorker(const QList<BatchTask> &tasks, int timeLimit, int memoryLimit
+		, TrajectoryFormat trajectoryFormat)
+	: mTasks(tasks)
+	, mTimeLimit(timeLimit)
+	, mMemoryLimit(memoryLimit)
+	, mTrajectoryFormat(trajectoryFormat)
+{
+}
+
+int BatchWorker::exec()
+{
+#ifdef Q_OS_UNIX
+	if (mMemoryLimit > 0) {
+		const rlim_t limit = static_cast<rlim_t>(mMemoryLimit) * 1024 * 1024;
+		const rlimit addressSpace = { limit, limit };
+		if (setrlimit(RLIMIT_AS, &addressSpace) != 0) {
+			QLOG_WARN() << "Failed to set memory limit of batch worker";
+		}
+	}
+#endif
+
+	Runner runner(QString(), QString(), mTrajectoryFormat);
+	QFile input;
+	QFile output;
+	if (!input.open(stdin, QIODevice::ReadOnly) || !output.open(stdout, QIODevice::WriteOnly)) {
+		return 1;
+	}
+
+	while (true) {
+		const QByteArray line = input.readLine().trimmed();
+		if (line.isEmpty()) {
+			break;
+		}
+
+		bool ok = false;
+		const int index = line.toInt(&ok);
+		if (!ok || index < 0 || index >= mTasks.size()) {
+			QLOG_ERROR() << "Batch worker got incorrect task" << line;
+			continue;
+		}
+
+		const BatchTask &task = mTasks[index];
+		int exitCode = internalErrorExitCode;
+		if (task.mode == "generate") {
+			QLOG_INFO() << "Batch worker generates code for" << task.solution << "with" << task.targets;
+			exitCode = runner.generate(task.saveFile, task.report, task.targets, task.outputFolder);
+		} else {
+			QLOG_INFO() << "Batch worker runs" << task.solution << "on"
+					<< (task.field.isEmpty() ? "own" : task.field) << "field";
+
+			QTemporaryDir workingFolder;
+			const QString saveFile = prepareSaveFile(task, workingFolder.path());
+			if (!saveFile.isEmpty()) {
+				exitCode = runner.interpretAndWait(saveFile, task.report, task.trajectory, task.input, task.mode
+						, mTimeLimit);
+			}
+		}
+
+		output.write(QString("%1 %2 %3\n").arg(finishedMarker).arg(index).arg(exitCode).toUtf8());
+		output.flush();
+	}
+
+	return 0;
+}
+
+QString BatchWorker::prepareSaveFile(const BatchTask &task, const QString &workingFolder) const
+{
+	if (task.fieldFile.isEmpty()) {
+		return task.saveFile;
+	}
+
+	// Like patcher does it, but without spawning a process for each field.
+	const QString patchedFile = QDir(workingFolder).absoluteFilePath(QFileInfo(task.saveFile).fileName());
+	QFile field(task.fieldFile);
+	if (!QFile::copy(task.saveFile, patchedFile) || !field.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		QLOG_ERROR() << "Failed to prepare" << task.saveFile << "for field" << task.fieldFile;
+		return QString();
+	}
+
+	qrRepo::RepoApi repo(patchedFile);
+	repo.setMetaInformation("worldModel", QString(field.readAll()));
+	if (!repo.saveAll()) {
+		QLOG_ERROR() << "Failed to patch" << patchedFile;
+		return QString();
+	}
+
+	return patchedFile;
+}
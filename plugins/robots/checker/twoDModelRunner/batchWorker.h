@@ -0,0 +1,54 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QList>
+
+#include "batchTask.h"
+#include "reporter.h"
+
+namespace twoDModel {
+
+/// Worker process of batch mode. Loads plugins and creates interpreter once, then reads indices of tasks
+/// from standard input one per line and runs them one by one, reporting results to the standard output.
+class BatchWorker
+{
+public:
+	/// Prefix of lines with results of tasks in worker`s output, followed by task index and its exit code.
+	static const char *finishedMarker;
+
+	/// Exit code of the task that could not be prepared (for example, field patching failed).
+	static const int internalErrorExitCode = 101;
+
+	/// @param tasks All tasks of the manifest, workers receive only indices of them.
+	/// @param timeLimit Maximal real-time duration of one run in milliseconds, 0 means no limit.
+	/// @param memoryLimit Maximal address space of the worker in megabytes, 0 means no limit.
+	/// @param trajectoryFormat Format in which robot`s trajectories will be written.
+	BatchWorker(const QList<BatchTask> &tasks, int timeLimit, int memoryLimit, TrajectoryFormat trajectoryFormat);
+
+	/// Processes tasks until standard input is closed.
+	int exec();
+
+private:
+	/// Returns a save file to be interpreted for the given task, with world model patched if needed.
+	QString prepareSaveFile(const BatchTask &task, const QString &workingFolder) const;
+
+	const QList<BatchTask> mTasks;
+	const int mTimeLimit;
+	const int mMemoryLimit;
+	const TrajectoryFormat mTrajectoryFormat;
+};
+
+}
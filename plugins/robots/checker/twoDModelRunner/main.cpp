@@ -14,15 +14,21 @@
 
 #include <time.h>
 
+#include <QtCore/QDebug>
 #include <QtCore/QDir>
 #include <QtCore/QCommandLineParser>
 #include <QtCore/QTranslator>
 #include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QThread>
 #include <QtWidgets/QApplication>
 
 #include <qrkernel/logging.h>
 #include <qrkernel/platformInfo.h>
+#include <utils/trajectory/trajectoryReader.h>
 
+#include "batchRunner.h"
+#include "batchWorker.h"
 #include "runner.h"
 
 const int maxLogSize = 10 * 1024 * 1024;  // 10 MB
@@ -32,8 +38,16 @@ const QString description = QObject::tr(
 		"Passed .qrs will be interpreted just like when 'Run' button was pressed in TRIK Studio. \n"\
 		"In background mode the session will be terminated just after the execution ended and return code "
 		"will then contain binary information about program correctness."
+		"In batch mode all solutions listed in the manifest will be checked on all its fields by a pool of worker "
+		"processes, summary will be written into the report.\n"
+		"In generation mode code for the main diagram of passed .qrs is generated with all the given generators, "
+		"the save file is loaded only once.\n"
+		"Trajectory may be written in compact binary format, such trajectory can be converted to JSON later.\n"
 		"Example: \n") +
-		"    2D-model -b --platform minimal --report report.json --trajectory trajectory.fifo example.qrs";
+		"    2D-model -b --platform minimal --report report.json --trajectory trajectory.fifo example.qrs\n"
+		"    2D-model --platform minimal --batch manifest.json --jobs 4 --time-limit 60000 --report summary.json\n"
+		"    2D-model --platform minimal --generate trikQts,trikPython,nxtOsekC --output generated example.qrs\n"
+		"    2D-model --platform minimal --convert-trajectory trajectory.bin --trajectory trajectory.json";
 
 void loadTranslators(const QString &locale)
 {
@@ -67,6 +81,50 @@ void initLogging()
 	}
 }
 
+/// Converts binary trajectory to JSON, writes it to the given file or to standard output if the path is empty.
+int convertTrajectory(const QString &binaryTrajectory, const QString &jsonTrajectory)
+{
+	QFile binary(binaryTrajectory);
+	if (!binary.open(QIODevice::ReadOnly)) {
+		qWarning() << binary.errorString();
+		return 2;
+	}
+
+	QFile json(jsonTrajectory);
+	const bool opened = jsonTrajectory.isEmpty()
+			? json.open(stdout, QIODevice::WriteOnly)
+			: json.open(QIODevice::WriteOnly | QIODevice::Truncate);
+	if (!opened) {
+		qWarning() << json.errorString();
+		return 2;
+	}
+
+	QString errorMessage;
+	if (!utils::trajectory::TrajectoryReader::convertToJson(binary, json, errorMessage)) {
+		QLOG_ERROR() << errorMessage;
+		qWarning() << errorMessage;
+		return 2;
+	}
+
+	return 0;
+}
+
+/// Parses the value of trajectory format option into @a format, returns false if the format is unknown.
+bool parseTrajectoryFormat(const QString &value, twoDModel::TrajectoryFormat &format)
+{
+	if (value == "json") {
+		format = twoDModel::TrajectoryFormat::json;
+		return true;
+	}
+
+	if (value == "binary") {
+		format = twoDModel::TrajectoryFormat::binary;
+		return true;
+	}
+
+	return false;
+}
+
 int main(int argc, char *argv[])
 {
 	QApplication app(argc, argv);
@@ -88,15 +146,43 @@ int main(int argc, char *argv[])
 				" written. The writing will not be performed not immediately, each trajectory point will be written"\
 				" just when obtained by checker, so FIFOs are recommended to be targets for this option.")
 			, "path-to-trajectory", "trajectory.fifo");
+	QCommandLineOption trajectoryFormatOption("trajectory-format", QObject::tr("Format of robot`s trajectory, "\
+				"\"json\" or compact \"binary\"."), "format", "json");
+	QCommandLineOption convertTrajectoryOption("convert-trajectory", QObject::tr("Convert the given binary "\
+				"trajectory to JSON, it is written to the file given by --trajectory or to standard output.")
+			, "path-to-binary-trajectory");
 	QCommandLineOption inputOption("input", QObject::tr("Inputs for JavaScript solution")// probably others too
 			, "path-to-input", "inputs.txt");
 	QCommandLineOption modeOption("mode", QObject::tr("Interpret mode"), "mode", "diagram");
+	QCommandLineOption batchOption("batch", QObject::tr("Check all solutions from the given manifest on all its "\
+				"fields (JSON), qrs-file is not needed in this mode."), "path-to-manifest");
+	QCommandLineOption batchWorkerOption("batch-worker", QObject::tr("Internal, runs a worker of batch mode.")
+			, "path-to-manifest");
+	QCommandLineOption jobsOption("jobs", QObject::tr("Count of worker processes in batch mode.")
+			, "count", QString::number(QThread::idealThreadCount()));
+	QCommandLineOption timeLimitOption("time-limit", QObject::tr("Maximal real-time duration of one run in batch "\
+				"mode in milliseconds, 0 means no limit."), "ms", "0");
+	QCommandLineOption memoryLimitOption("memory-limit", QObject::tr("Maximal memory of one worker process in batch "\
+				"mode in megabytes, 0 means no limit."), "MB", "0");
+	QCommandLineOption generateOption("generate", QObject::tr("Generate code with the given comma-separated "\
+				"generators instead of interpretation."), "generators");
+	QCommandLineOption outputOption("output", QObject::tr("A folder where generated code will be put, each "\
+				"generator gets its own subfolder."), "path-to-folder", "generated");
 	parser.addOption(backgroundOption);
 	parser.addOption(platformOption);
 	parser.addOption(reportOption);
 	parser.addOption(trajectoryOption);
+	parser.addOption(trajectoryFormatOption);
+	parser.addOption(convertTrajectoryOption);
 	parser.addOption(inputOption);
 	parser.addOption(modeOption);
+	parser.addOption(batchOption);
+	parser.addOption(batchWorkerOption);
+	parser.addOption(jobsOption);
+	parser.addOption(timeLimitOption);
+	parser.addOption(memoryLimitOption);
+	parser.addOption(generateOption);
+	parser.addOption(outputOption);
 
 	qsrand(time(0));
 	initLogging();
@@ -107,6 +193,49 @@ int main(int argc, char *argv[])
 
 	parser.process(app);
 
+	twoDModel::TrajectoryFormat trajectoryFormat = twoDModel::TrajectoryFormat::json;
+	if (!parseTrajectoryFormat(parser.value(trajectoryFormatOption), trajectoryFormat)) {
+		const QString errorMessage = QObject::tr("Unknown trajectory format: %1")
+				.arg(parser.value(trajectoryFormatOption));
+		QLOG_ERROR() << errorMessage;
+		qWarning() << errorMessage;
+		return 2;
+	}
+
+	if (parser.isSet(convertTrajectoryOption)) {
+		return convertTrajectory(parser.value(convertTrajectoryOption)
+				, parser.isSet(trajectoryOption) ? parser.value(trajectoryOption) : QString());
+	}
+
+	if (parser.isSet(batchOption) || parser.isSet(batchWorkerOption)) {
+		const QString manifest = parser.isSet(batchOption)
+				? parser.value(batchOption)
+				: parser.value(batchWorkerOption);
+		QList<twoDModel::BatchTask> tasks;
+		QString errorMessage;
+		if (!twoDModel::BatchTask::loadManifest(manifest, tasks, errorMessage)) {
+			QLOG_ERROR() << errorMessage;
+			qWarning() << errorMessage;
+			return 2;
+		}
+
+		const int timeLimit = parser.value(timeLimitOption).toInt();
+		const int memoryLimit = parser.value(memoryLimitOption).toInt();
+		if (parser.isSet(batchWorkerOption)) {
+			return twoDModel::BatchWorker(tasks, timeLimit, memoryLimit, trajectoryFormat).exec();
+		}
+
+		const QString report = parser.isSet(reportOption) ? parser.value(reportOption) : QString();
+		twoDModel::BatchRunner batch(QFileInfo(manifest).absoluteFilePath(), tasks
+				, parser.value(jobsOption).toInt(), timeLimit, memoryLimit, report, trajectoryFormat);
+		QObject::connect(&batch, &twoDModel::BatchRunner::finished
+				, &app, &QCoreApplication::exit, Qt::QueuedConnection);
+		batch.start();
+		const int exitCode = app.exec();
+		QLOG_INFO() << "------------------- APPLICATION FINISHED -------------------";
+		return exitCode;
+	}
+
 	const QStringList positionalArgs = parser.positionalArguments();
 	if (positionalArgs.size() != 1) {
 		parser.showHelp();
@@ -115,10 +244,18 @@ int main(int argc, char *argv[])
 	const QString qrsFile = positionalArgs.first();
 	const bool backgroundMode = parser.isSet(backgroundOption);
 	const QString report = parser.isSet(reportOption) ? parser.value(reportOption) : QString();
+	if (parser.isSet(generateOption)) {
+		const QStringList targets = parser.value(generateOption).split(',', QString::SkipEmptyParts);
+		twoDModel::Runner runner(report, QString());
+		const int exitCode = runner.generate(qrsFile, report, targets, parser.value(outputOption));
+		QLOG_INFO() << "------------------- APPLICATION FINISHED -------------------";
+		return exitCode;
+	}
+
 	const QString trajectory = parser.isSet(trajectoryOption) ? parser.value(trajectoryOption) : QString();
 	const QString input = parser.isSet(inputOption) ? parser.value(inputOption) : QString();
 	const QString mode = parser.isSet(modeOption) ? parser.value(modeOption) : QString("diagram");
-	twoDModel::Runner runner(report, trajectory, input, mode);
+	twoDModel::Runner runner(report, trajectory, input, mode, trajectoryFormat);
 	if (!runner.interpret(qrsFile, backgroundMode)) {
 		return 2;
 	}
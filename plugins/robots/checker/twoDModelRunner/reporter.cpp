@@ -14,19 +14,31 @@
 
 #include "reporter.h"
 
+#include <QtCore/QFile>
 #include <QtCore/QPointF>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonArray>
 
+#include <qrkernel/logging.h>
 #include <qrutils/outFile.h>
+#include <utils/trajectory/trajectoryWriter.h>
 
 using namespace twoDModel;
 
-Reporter::Reporter(const QString &messagesFile, const QString &trajectoryFile)
+Reporter::Reporter(const QString &messagesFile, const QString &trajectoryFile, TrajectoryFormat trajectoryFormat)
 	: mMessagesFile(new utils::OutFile(messagesFile))
-	, mTrajectoryFile(new utils::OutFile(trajectoryFile))
+	, mTrajectoryFile(trajectoryFormat == TrajectoryFormat::json ? new utils::OutFile(trajectoryFile) : nullptr)
 {
+	if (trajectoryFormat == TrajectoryFormat::binary && !trajectoryFile.isEmpty()) {
+		mBinaryTrajectoryFile.reset(new QFile(trajectoryFile));
+		if (mBinaryTrajectoryFile->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+			mTrajectoryWriter.reset(new utils::trajectory::TrajectoryWriter(*mBinaryTrajectoryFile));
+		} else {
+			QLOG_ERROR() << QString("Opening %1 for write failed: %2")
+					.arg(trajectoryFile, mBinaryTrajectoryFile->errorString());
+		}
+	}
 }
 
 Reporter::~Reporter()
@@ -57,20 +69,19 @@ void Reporter::onInterpretationStart()
 void Reporter::onInterpretationEnd()
 {
 	report("]\n", mTrajectoryFile);
+	if (mTrajectoryWriter) {
+		mTrajectoryWriter->flush();
+	}
 }
 
 void Reporter::newTrajectoryPoint(const QString &robotId, int timestamp, const QPointF &position, qreal rotation)
 {
-	if (!mTrajectoryFile.isNull()) {
-		QJsonObject transition;
-		transition["robotId"] = robotId;
-		transition["timestamp"] = timestamp;
-		transition["x"] = position.x();
-		transition["y"] = position.y();
-		transition["rotation"] = rotation;
-
+	const utils::trajectory::TrajectoryPoint point{robotId, timestamp, position, rotation};
+	if (mTrajectoryWriter) {
+		mTrajectoryWriter->writePoint(point);
+	} else if (!mTrajectoryFile.isNull()) {
 		QJsonDocument document;
-		document.setObject(transition);
+		document.setObject(point.toJson());
 		report((mFirstMessage ? "" : ", ") + document.toJson(), mTrajectoryFile);
 		mFirstMessage = false;
 	}
@@ -79,17 +90,13 @@ void Reporter::newTrajectoryPoint(const QString &robotId, int timestamp, const Q
 void Reporter::newDeviceState(const QString &robotId, int timestamp, const QString &deviceType
 		, const QString &devicePort, const QString &property, const QVariant &value)
 {
-	if (!mTrajectoryFile.isNull()) {
-		QJsonObject modification;
-		modification["robotId"] = robotId;
-		modification["timestamp"] = timestamp;
-		modification["device"] = deviceType;
-		modification["port"] = devicePort;
-		modification["property"] = property;
-		modification["value"] = variantToJson(value);
-
+	const utils::trajectory::DeviceState state{robotId, timestamp, deviceType, devicePort, property
+			, variantToJson(value)};
+	if (mTrajectoryWriter) {
+		mTrajectoryWriter->writeDeviceState(state);
+	} else if (!mTrajectoryFile.isNull()) {
 		QJsonDocument document;
-		document.setObject(modification);
+		document.setObject(state.toJson());
 		report((mFirstMessage ? "" : ", ") + document.toJson(), mTrajectoryFile);
 		mFirstMessage = false;
 	}
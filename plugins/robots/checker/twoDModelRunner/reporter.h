@@ -17,8 +17,14 @@
 #include <QtCore/QObject>
 #include <QtCore/QScopedPointer>
 
+class QFile;
+
 namespace utils {
 class OutFile;
+
+namespace trajectory {
+class TrajectoryWriter;
+}
 }
 
 namespace twoDModel {
@@ -32,6 +38,16 @@ enum class Level
 	, error
 };
 
+/// Format of the file with robot`s trajectory.
+enum class TrajectoryFormat
+{
+	/// JSON array of trajectory points and device states.
+	json = 0
+	/// Compact binary log, see utils::trajectory::TrajectoryWriter. Can be converted to JSON with
+	/// utils::trajectory::TrajectoryReader.
+	, binary
+};
+
 /// Collects information about the interpretation process and writes it into the given file as JSON report.
 class Reporter : public QObject
 {
@@ -43,7 +59,10 @@ public:
 	/// @param trajectoryFile If non-empty the information about robot`s movement will be stored there
 	/// during the interpetation (so the factical data write will not be performed in one moment, it will be written
 	/// in chunks, each chunk with the new robot transition).
-	Reporter(const QString &messagesFile, const QString &trajectoryFile);
+	/// @param trajectoryFormat Format of the trajectory file. Binary trajectory is written in chunks of several
+	/// records and when the interpretation ends.
+	Reporter(const QString &messagesFile, const QString &trajectoryFile
+			, TrajectoryFormat trajectoryFormat = TrajectoryFormat::json);
 
 	~Reporter() override;
 
@@ -91,6 +110,8 @@ private:
 	QList<QPair<Level, QString>> mMessages;
 	const QScopedPointer<utils::OutFile> mMessagesFile;
 	const QScopedPointer<utils::OutFile> mTrajectoryFile;
+	QScopedPointer<QFile> mBinaryTrajectoryFile;
+	QScopedPointer<utils::trajectory::TrajectoryWriter> mTrajectoryWriter;
 	bool mFirstMessage;
 };
 
@@ -14,6 +14,8 @@
 
 #include "runner.h"
 
+#include <QtCore/QDir>
+#include <QtCore/QEventLoop>
 #include <QtCore/QFile>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
@@ -22,10 +24,11 @@
 
 #include <twoDModel/engine/view/twoDModelWidget.h>
 #include <twoDModel/engine/model/model.h>
+#include <generatorBase/robotsGeneratorPluginBase.h>
 
 using namespace twoDModel;
 
-Runner::Runner(const QString &report, const QString &trajectory)
+Runner::Runner(const QString &report, const QString &trajectory, TrajectoryFormat trajectoryFormat)
 	: mProjectManager(mQRealFacade.models())
 	, mMainWindow(mErrorReporter, mQRealFacade.events()
 			, mProjectManager, mQRealFacade.models().graphicalModelAssistApi())
@@ -39,20 +42,20 @@ Runner::Runner(const QString &report, const QString &trajectory)
 			, mSceneCustomizer
 			, mQRealFacade.events()
 			, mTextManager)
-	, mReporter(report, trajectory)
+	, mReporter(new Reporter(report, trajectory, trajectoryFormat))
+	, mTrajectoryFormat(trajectoryFormat)
 {
 	mPluginFacade.init(mConfigurator);
 	for (const QString &defaultSettingsFile : mPluginFacade.defaultSettingsFiles()) {
 		qReal::SettingsManager::loadDefaultSettings(defaultSettingsFile);
 	}
 
-	connect(&mErrorReporter, &qReal::ConsoleErrorReporter::informationAdded, &mReporter, &Reporter::addInformation);
-	connect(&mErrorReporter, &qReal::ConsoleErrorReporter::errorAdded, &mReporter, &Reporter::addError);
-	connect(&mErrorReporter, &qReal::ConsoleErrorReporter::criticalAdded, &mReporter, &Reporter::addError);
+	connectReporter();
 }
 
-Runner::Runner(const QString &report, const QString &trajectory, const QString &input, const QString &mode)
-	: Runner(report, trajectory)
+Runner::Runner(const QString &report, const QString &trajectory, const QString &input, const QString &mode
+		, TrajectoryFormat trajectoryFormat)
+	: Runner(report, trajectory, trajectoryFormat)
 
 {
 	mInputsFile = input;
@@ -61,11 +64,127 @@ Runner::Runner(const QString &report, const QString &trajectory, const QString &
 
 Runner::~Runner()
 {
-	mReporter.onInterpretationEnd();
-	mReporter.reportMessages();
+	finishReport();
 }
 
 bool Runner::interpret(const QString &saveFile, bool background)
+{
+	if (background) {
+		connect(&mPluginFacade.eventsForKitPlugins(), &kitBase::EventsForKitPluginInterface::interpretationStopped
+				, this, [this]() {
+				QTimer::singleShot(0, this, SLOT(close()));
+		});
+	}
+
+	return start(saveFile, background);
+}
+
+int Runner::interpretAndWait(const QString &saveFile, const QString &report, const QString &trajectory
+		, const QString &input, const QString &mode, int timeLimit)
+{
+	mReporter.reset(new Reporter(report, trajectory, mTrajectoryFormat));
+	mInterpretationStarted = false;
+	mReportWritten = false;
+	connectReporter();
+	mInputsFile = input;
+	mMode = mode;
+
+	QEventLoop loop;
+	bool stopped = false;
+	const QMetaObject::Connection stopConnection = connect(&mPluginFacade.eventsForKitPlugins()
+			, &kitBase::EventsForKitPluginInterface::interpretationStopped, &loop, [&stopped, &loop]() {
+		stopped = true;
+		loop.quit();
+	});
+
+	bool timeLimitExceeded = false;
+	QTimer timeLimitTimer;
+	timeLimitTimer.setSingleShot(true);
+	connect(&timeLimitTimer, &QTimer::timeout, &loop, [this, &timeLimitExceeded]() {
+		timeLimitExceeded = true;
+		mPluginFacade.actionsManager().stopRobotAction().trigger();
+	});
+
+	if (!start(saveFile, true)) {
+		disconnect(stopConnection);
+		finishReport();
+		return 2;
+	}
+
+	if (timeLimit > 0) {
+		timeLimitTimer.start(timeLimit);
+	}
+
+	if (!stopped) {
+		loop.exec();
+	}
+
+	disconnect(stopConnection);
+	finishReport();
+	if (timeLimitExceeded) {
+		return timeLimitExceededExitCode;
+	}
+
+	return mReporter->lastMessageIsError() ? 1 : 0;
+}
+
+int Runner::generate(const QString &saveFile, const QString &report, const QStringList &targets
+		, const QString &outputFolder)
+{
+	mReporter.reset(new Reporter(report, QString()));
+	mInterpretationStarted = false;
+	mReportWritten = false;
+	connectReporter();
+
+	if (!mProjectManager.open(saveFile)) {
+		finishReport();
+		return 2;
+	}
+
+	QMap<QString, generatorBase::RobotsGeneratorPluginBase *> generators;
+	for (kitBase::KitPluginInterface * const kit : mPluginFacade.kitPlugins()) {
+		if (auto generator = dynamic_cast<generatorBase::RobotsGeneratorPluginBase *>(kit)) {
+			generators[generator->generatorName()] = generator;
+		}
+	}
+
+	interpreterCore::RobotModelManager &robotModelManager = mPluginFacade.robotModelManager();
+	kitBase::robotModel::RobotModelInterface * const initialModel = &robotModelManager.model();
+	bool failed = false;
+	for (const QString &target : targets) {
+		generatorBase::RobotsGeneratorPluginBase * const generator = generators.value(target);
+		if (!generator) {
+			mErrorReporter.addError(tr("There is no %1 generator").arg(target));
+			failed = true;
+			continue;
+		}
+
+		// Generators take ports and devices from the current robot model, so the model of generator's kit
+		// is selected as it would be when generating from GUI.
+		kitBase::robotModel::RobotModelInterface *model = generator->defaultRobotModel();
+		if (!model && !generator->robotModels().isEmpty()) {
+			model = generator->robotModels().first();
+		}
+
+		if (model) {
+			robotModelManager.setModel(model);
+		}
+
+		mErrorReporter.clearErrors();
+		const QString generatedFile = generator->generateCodeToFolder(QDir(outputFolder).absoluteFilePath(target));
+		if (generatedFile.isEmpty() || mErrorReporter.wereErrors()) {
+			failed = true;
+		} else {
+			mErrorReporter.addInformation(tr("Generated %1").arg(generatedFile));
+		}
+	}
+
+	robotModelManager.setModel(initialModel);
+	finishReport();
+	return failed ? 1 : 0;
+}
+
+bool Runner::start(const QString &saveFile, bool background)
 {
 	if (!mProjectManager.open(saveFile)) {
 		return false;
@@ -80,23 +199,21 @@ bool Runner::interpret(const QString &saveFile, bool background)
 		}
 	}
 
-	if (background) {
-		connect(&mPluginFacade.eventsForKitPlugins(), &kitBase::EventsForKitPluginInterface::interpretationStopped
-				, this, [this]() {
-				QTimer::singleShot(0, this, SLOT(close()));
-		});
-	}
-
 	for (view::TwoDModelWidget * const twoDModelWindow : twoDModelWindows) {
-		connect(twoDModelWindow, &view::TwoDModelWidget::widgetClosed, &mMainWindow
-				, [this]() { this->mMainWindow.emulateClose(); });
+		if (!mConnectedWindows.contains(twoDModelWindow)) {
+			mConnectedWindows << twoDModelWindow;
+			connect(twoDModelWindow, &view::TwoDModelWidget::widgetClosed, &mMainWindow
+					, [this]() { this->mMainWindow.emulateClose(); });
+		}
+
 		twoDModelWindow->model().timeline().setImmediateMode(background);
 		for (const model::RobotModel *robotModel : twoDModelWindow->model().robotModels()) {
 			connectRobotModel(robotModel);
 		}
 	}
 
-	mReporter.onInterpretationStart();
+	mReporter->onInterpretationStart();
+	mInterpretationStarted = true;
 	if (mMode == "js") {
 		return mPluginFacade.interpretCode(mInputsFile);
 	} else if (mMode == "diagram") {
@@ -106,8 +223,35 @@ bool Runner::interpret(const QString &saveFile, bool background)
 	return true;
 }
 
+void Runner::finishReport()
+{
+	if (mReportWritten) {
+		return;
+	}
+
+	if (mInterpretationStarted) {
+		mReporter->onInterpretationEnd();
+	}
+
+	mReporter->reportMessages();
+	mReportWritten = true;
+}
+
+void Runner::connectReporter()
+{
+	Reporter * const reporter = mReporter.data();
+	connect(&mErrorReporter, &qReal::ConsoleErrorReporter::informationAdded, reporter, &Reporter::addInformation);
+	connect(&mErrorReporter, &qReal::ConsoleErrorReporter::errorAdded, reporter, &Reporter::addError);
+	connect(&mErrorReporter, &qReal::ConsoleErrorReporter::criticalAdded, reporter, &Reporter::addError);
+}
+
 void Runner::connectRobotModel(const model::RobotModel *robotModel)
 {
+	if (mConnectedRobotModels.contains(robotModel)) {
+		return;
+	}
+
+	mConnectedRobotModels << robotModel;
 	connect(robotModel, &model::RobotModel::positionRecalculated
 			, this, &Runner::onRobotRided, Qt::UniqueConnection);
 
@@ -123,7 +267,7 @@ void Runner::connectRobotModel(const model::RobotModel *robotModel)
 
 void Runner::onRobotRided(const QPointF &newPosition, const qreal newRotation)
 {
-	mReporter.newTrajectoryPoint(
+	mReporter->newTrajectoryPoint(
 			static_cast<model::RobotModel *>(sender())->info().robotId()
 			, mPluginFacade.interpreter().timeElapsed()
 			, newPosition
@@ -136,7 +280,7 @@ void Runner::onDeviceStateChanged(const QString &robotId
 		, const QString &property
 		, const QVariant &value)
 {
-	mReporter.newDeviceState(robotId
+	mReporter->newDeviceState(robotId
 			, mPluginFacade.interpreter().timeElapsed()
 			, device->deviceInfo().name()
 			, device->port().name()
@@ -147,5 +291,5 @@ void Runner::onDeviceStateChanged(const QString &robotId
 
 void Runner::close()
 {
-	mMainWindow.emulateClose(mReporter.lastMessageIsError() ? 1 : 0);
+	mMainWindow.emulateClose(mReporter->lastMessageIsError() ? 1 : 0);
 }
@@ -15,6 +15,8 @@
 #pragma once
 
 #include <QtCore/QScopedPointer>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
 
 #include <qrgui/systemFacade/systemFacade.h>
 #include <qrgui/systemFacade/components/consoleErrorReporter.h>
@@ -33,6 +35,10 @@ namespace model {
 class RobotModel;
 }
 
+namespace view {
+class TwoDModelWidget;
+}
+
 /// Creates instances null QReal environment, of robots plugin and runs interpretation on 2D model window.
 class Runner : public QObject
 {
@@ -42,14 +48,18 @@ public:
 	/// Constructor.
 	/// @param report A path to a file where JSON report about the session will be written after it ends.
 	/// @param trajectory A path to a file where robot`s trajectory will be written during the session.
-	Runner(const QString &report, const QString &trajectory);
+	/// @param trajectoryFormat Format in which robot`s trajectory will be written.
+	Runner(const QString &report, const QString &trajectory
+			, TrajectoryFormat trajectoryFormat = TrajectoryFormat::json);
 
 	/// Constructor.
 	/// @param report A path to a file where JSON report about the session will be written after it ends.
 	/// @param trajectory A path to a file where robot`s trajectory will be written during the session.
 	/// @param input A path to a file where JSON with inputs for JavaScript.
 	/// @param mode Interpret mode.
-	Runner(const QString &report, const QString &trajectory, const QString &input, const QString &mode);
+	/// @param trajectoryFormat Format in which robot`s trajectory will be written.
+	Runner(const QString &report, const QString &trajectory, const QString &input, const QString &mode
+			, TrajectoryFormat trajectoryFormat = TrajectoryFormat::json);
 
 	~Runner();
 
@@ -59,10 +69,42 @@ public:
 	/// will be closed immediately after the interpretation stopped.
 	bool interpret(const QString &saveFile, bool background);
 
+	/// Interprets the given save file in background, waits until the interpretation ends and returns its result
+	/// as process exit code in single run mode would be (0 if the solution is correct, 1 if not,
+	/// 2 if the save file is incorrect, 3 if time limit exceeded). Can be called many times, plugins are loaded once.
+	/// @param report A path to a file where JSON report about this run will be written.
+	/// @param trajectory A path to a file where robot`s trajectory will be written during this run, in the format
+	/// given to constructor.
+	/// @param input A path to a file where JSON with inputs for JavaScript.
+	/// @param mode Interpret mode.
+	/// @param timeLimit Maximal interpretation duration in real-time milliseconds, 0 means no limit.
+	int interpretAndWait(const QString &saveFile, const QString &report, const QString &trajectory
+			, const QString &input, const QString &mode, int timeLimit);
+
+	/// Opens the given save file once and generates code for its main diagram with each of the given generators.
+	/// Code of each target is put into "<outputFolder>/<target>/", named after the save file as GUI names it.
+	/// Can be called many times, plugins are loaded once.
+	/// @param report A path to a file where JSON report with generation messages will be written.
+	/// @param targets Names of generators, like "trikQts", "ev3/rbf", "nxtOsekC" or "pioneer/lua".
+	/// @returns 0 if code for all the targets was generated, 1 if some of them failed,
+	/// 2 if the save file is incorrect.
+	int generate(const QString &saveFile, const QString &report, const QStringList &targets
+			, const QString &outputFolder);
+
+	/// Exit code of the run which was stopped because of time limit.
+	static const int timeLimitExceededExitCode = 3;
+
 private slots:
 	void close();
 
 private:
+	/// Opens the given save file, prepares 2D model windows and starts interpretation.
+	bool start(const QString &saveFile, bool background);
+
+	/// Finishes the trajectory and writes messages of the current run, if it was not done yet.
+	void finishReport();
+
+	void connectReporter();
 	void connectRobotModel(const model::RobotModel *robotModel);
 	void onRobotRided(const QPointF &newPosition, const qreal newRotation);
 	void onDeviceStateChanged(const QString &robotId, const kitBase::robotModel::robotParts::Device *device
@@ -77,9 +119,16 @@ private:
 	qReal::gui::editor::SceneCustomizer mSceneCustomizer;
 	qReal::PluginConfigurator mConfigurator;
 	interpreterCore::RobotsPluginFacade mPluginFacade;
-	Reporter mReporter;
+	QScopedPointer<Reporter> mReporter;
+	const TrajectoryFormat mTrajectoryFormat;
+	bool mInterpretationStarted = false;
+	bool mReportWritten = false;
 	QString mInputsFile;
 	QString mMode;
+
+	/// Windows and robot models are kept between runs, so they are connected only once.
+	QSet<view::TwoDModelWidget *> mConnectedWindows;
+	QSet<const model::RobotModel *> mConnectedRobotModels;
 };
 
 }
@@ -0,0 +1,41 @@
+# Copyright 2016 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+includes(plugins/robots/interpreters/interpreterCore \
+		plugins/robots/common/kitBase \
+		plugins/robots/common/twoDModel \
+		plugins/robots/utils \
+		plugins/robots/generators/generatorBase \
+		qrtext \
+		qrrepo \
+)
+
+links(qslog qrkernel qrutils qrrepo qrgui-tool-plugin-interface qrgui-preferences-dialog qrgui-facade \
+		qrgui-models qrgui-editor qrgui-plugin-manager qrgui-text-editor qrgui-controller \
+		robots-utils robots-kit-base robots-interpreter-core robots-2d-model robots-generator-base \
+)
+
+HEADERS += \
+	$$PWD/runner.h \
+	$$PWD/reporter.h \
+	$$PWD/batchTask.h \
+	$$PWD/batchRunner.h \
+	$$PWD/batchWorker.h \
+
+SOURCES += \
+	$$PWD/runner.cpp \
+	$$PWD/reporter.cpp \
+	$$PWD/batchTask.cpp \
+	$$PWD/batchRunner.cpp \
+	$$PWD/batchWorker.cpp \
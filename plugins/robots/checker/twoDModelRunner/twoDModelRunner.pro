@@ -20,27 +20,11 @@ TEMPLATE = app
 CONFIG-=app_bundle
 QT += widgets
 
-includes(plugins/robots/interpreters/interpreterCore \
-		plugins/robots/common/kitBase \
-		plugins/robots/common/twoDModel \
-		plugins/robots/utils \
-		qrtext \
-)
-
-links(qslog qrkernel qrutils qrgui-tool-plugin-interface qrgui-preferences-dialog qrgui-facade \
-		qrgui-models qrgui-editor qrgui-plugin-manager qrgui-text-editor qrgui-controller \
-		robots-utils robots-kit-base robots-interpreter-core robots-2d-model \
-)
+include(twoDModelRunner.pri)
 
 TRANSLATIONS = \
 	$$PWD/../../../../qrtranslations/ru/plugins/robots/twoDModelRunner_ru.ts \
 	$$PWD/../../../../qrtranslations/fr/plugins/robots/twoDModelRunner_fr.ts \
 
-HEADERS += \
-	$$PWD/runner.h \
-	$$PWD/reporter.h \
-
 SOURCES += \
 	$$PWD/main.cpp \
-	$$PWD/runner.cpp \
-	$$PWD/reporter.cpp \
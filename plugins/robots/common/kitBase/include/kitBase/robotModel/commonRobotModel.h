@@ -55,6 +55,8 @@ public:
 
 	void updateSensorsValues() const override;
 
+	void updateSelectedSensorsValues(const QList<PortInfo> &ports) const override;
+
 	int updateIntervalForInterpretation() const override;
 
 	bool interpretedModel() const override;
@@ -116,6 +118,9 @@ private slots:
 	void onDisconnected();
 
 private:
+	/// Asks a device to provide new readings if it is a sensor with a variable and it is ready to be read.
+	void readSensor(robotParts::Device *device) const;
+
 	/// Shows which types of devices can be connected to which ports.
 	/// @todo Add a notion of direction.
 	QHash<PortInfo, QList<DeviceInfo>> mAllowedConnections;
@@ -108,6 +108,9 @@ public:
 	/// Requests updates for all configured sensors.
 	virtual void updateSensorsValues() const = 0;
 
+	/// Requests updates only for sensors configured on given ports, other sensors keep their last readings.
+	virtual void updateSelectedSensorsValues(const QList<PortInfo> &ports) const = 0;
+
 	/// Returns time interval for polling sensors data.
 	virtual int updateIntervalForInterpretation() const = 0;
 
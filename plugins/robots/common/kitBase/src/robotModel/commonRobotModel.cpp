@@ -85,16 +85,28 @@ void CommonRobotModel::disconnectFromRobot()
 void CommonRobotModel::updateSensorsValues() const
 {
 	for (robotParts::Device * const device : mConfiguration.devices()) {
-		robotParts::AbstractSensor * const sensor = dynamic_cast<robotParts::AbstractSensor *>(device);
-		if (sensor && !sensor->port().reservedVariable().isEmpty()) {
+		readSensor(device);
+	}
+}
+
+void CommonRobotModel::updateSelectedSensorsValues(const QList<PortInfo> &ports) const
+{
+	for (const PortInfo &port : ports) {
+		readSensor(mConfiguration.device(port));
+	}
+}
 
-			if (!sensor->ready() || sensor->isLocked()) {
-				/// @todo Error reporting
-				continue;
-			}
+void CommonRobotModel::readSensor(robotParts::Device *device) const
+{
+	robotParts::AbstractSensor * const sensor = dynamic_cast<robotParts::AbstractSensor *>(device);
+	if (sensor && !sensor->port().reservedVariable().isEmpty()) {
 
-			sensor->read();
+		if (!sensor->ready() || sensor->isLocked()) {
+			/// @todo Error reporting
+			return;
 		}
+
+		sensor->read();
 	}
 }
 
@@ -15,8 +15,11 @@
 #pragma once
 
 #include <QtCore/QPoint>
+#include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtCore/QPair>
+#include <QtCore/QSet>
+#include <QtCore/QVector>
 #include <QtGui/QPainterPath>
 #include <QtGui/QPolygon>
 #include <QtWidgets/QGraphicsLineItem>
@@ -44,6 +47,16 @@ class RegionItem;
 
 namespace model {
 
+class SolidGeometry;
+
+/// One segment of the line that robot`s marker leaves on the floor.
+struct TraceSegment
+{
+	QLineF line;
+	QColor color;
+	int width;
+};
+
 class TWO_D_MODEL_EXPORT WorldModel : public QObject
 {
 	Q_OBJECT
@@ -87,8 +100,8 @@ public:
 	/// Returns a list of image items in the world model.
 	const QMap<QString, items::ImageItem *> &imageItems() const;
 
-	/// Returns a list of trace items on the floor.
-	const QList<QGraphicsLineItem *> &trace() const;
+	/// Returns a list of robot trace segments on the floor in order of their drawing.
+	const QVector<TraceSegment> &trace() const;
 
 	/// Appends \a wall into world model.
 	void addWall(items::WallItem *wall);
@@ -214,8 +227,8 @@ signals:
 	/// Emitted each time when model is appended with some new item.
 	void regionItemAdded(items::RegionItem *item);
 
-	/// Emitted each time when model is appended with some new item.
-	void traceItemAdded(QGraphicsLineItem *item);
+	/// Emitted each time when robot trace is appended with one more segment.
+	void traceSegmentAdded(const TraceSegment &segment);
 
 	/// Emitted each time when some item was removed from the 2D model world.
 	void itemRemoved(QGraphicsItem *item);
@@ -233,10 +246,12 @@ signals:
 	void backgroundImageItemAdded(items::ImageItem *item);
 
 private:
-	/// Returns true if ray intersects some wall.
-	bool checkSonarDistance(const int distance, const QPointF &position
-			, const qreal direction, const QPainterPath &wallPath) const;
-	QPainterPath buildSolidItemsPath() const;
+	/// Brings solid geometry in accordance with current state of walls, skittles and balls.
+	void updateSolidGeometry() const;
+
+	/// Returns true if the given skittle or ball was moved or rotated since its body was put into solid geometry.
+	/// Those items are moved by physics engine without any notifications, so their state is compared on each query.
+	bool movableSolidChanged(const QGraphicsItem *item) const;
 
 	void createBackgroundImageItem(const QDomElement &element);
 
@@ -252,14 +267,24 @@ private:
 	QMap<QString, items::RegionItem *> mRegions;
 	QMap<QString, Image*> mImages; // takes ownership
 	QMap<QString, int> mOrder;
-	QList<QGraphicsLineItem *> mRobotTrace;
+	QVector<TraceSegment> mRobotTrace;
 	Image *mBackgroundImage = nullptr;
 	QRect mBackgroundRect;
 	QScopedPointer<QDomDocument> mXmlFactory;
 	qReal::ErrorReporterInterface *mErrorReporter;  // Doesn`t take ownership.
+
+	/// Cached and spatially indexed outlines of walls, skittles and balls used for collisions and sonars.
+	QScopedPointer<SolidGeometry> mSolidGeometry;
+
+	/// Walls that were modified since their bodies were put into solid geometry.
+	mutable QSet<items::WallItem *> mChangedWalls;
+
+	/// Scene positions and rotations of skittles and balls as they are in solid geometry.
+	mutable QHash<const QGraphicsItem *, QPair<QPointF, qreal>> mMovableSolidsState;
 };
 
 }
 }
 
-Q_DECLARE_METATYPE(QGraphicsLineItem *)
+Q_DECLARE_TYPEINFO(twoDModel::model::TraceSegment, Q_MOVABLE_TYPE);
+Q_DECLARE_METATYPE(twoDModel::model::TraceSegment)
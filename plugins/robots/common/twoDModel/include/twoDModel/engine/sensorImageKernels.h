@@ -0,0 +1,57 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtGui/QImage>
+
+#include "twoDModel/twoDModelDeclSpec.h"
+
+namespace twoDModel {
+namespace engine {
+
+/// Pixel processing routines for sensors of all kits, working on 32-bit RGB pixels. Images shall be passed here
+/// scanline by scanline or, if they have no padding, as a whole.
+class TWO_D_MODEL_EXPORT SensorImageKernels
+{
+public:
+	/// Returns @a image itself if its pixels are already 32-bit RGB or ARGB, otherwise its copy converted to ARGB.
+	static QImage toKernelFormat(const QImage &image);
+
+	/// Returns the sum of brightnesses (in [0..255] each) of the given pixels.
+	/// Gives exactly the same result as summing brightness() for each pixel.
+	static quint64 brightnessSum(const uint *pixels, int count);
+
+	/// Returns the brightness of the given pixel in [0..255], as seen by light sensor.
+	static uint brightness(uint color);
+
+	/// Adds channel values of pixels that are not fully transparent to @a red, @a green and @a blue, so the mean
+	/// color of an image can be accumulated over its scanlines. Returns the number of such pixels.
+	static int sumOpaqueChannels(const uint *pixels, int count, quint64 &red, quint64 &green, quint64 &blue);
+
+	/// Returns the number of pixels that are not fully transparent and differ from @a color by less than
+	/// @a tolerance in each channel. Adds indices of such pixels to @a indexSum.
+	static int countCloseColors(const uint *pixels, int count, uint color, int tolerance, qint64 &indexSum);
+
+	/// Counts pixels exactly equal to each of @a paletteSize distinct colors from @a palette and writes
+	/// the numbers into @a counts. Returns the number of pixels of other colors.
+	static int countPaletteColors(const uint *pixels, int count, const uint *palette, int paletteSize, int *counts);
+
+	/// Adds the number of occurences of each color among given pixels into @a histogram.
+	static void countColors(const uint *pixels, int count, QHash<uint, int> &histogram);
+};
+
+}
+}
@@ -55,7 +55,8 @@ ConstraintsChecker::ConstraintsChecker(qReal::ErrorReporterInterface &errorRepor
 
 	bindToWorldModelObjects();
 	bindToRobotObjects();
-	mObjects["trace"] = new utils::ObjectsSet<QGraphicsLineItem *>(mModel.worldModel().trace(), this);
+	mObjects["trace"] = new utils::ObjectsSet<model::TraceSegment, QVector<model::TraceSegment>>(
+			mModel.worldModel().trace(), this);
 }
 
 ConstraintsChecker::~ConstraintsChecker()
@@ -38,6 +38,14 @@ WallItem::WallItem(const QPointF &begin, const QPointF &end)
 	setFlags(ItemIsSelectable | ItemIsMovable | ItemSendsScenePositionChanges);
 	setPrivateData();
 	setAcceptDrops(true);
+
+	// Borders are used by collisions and sonars that may be queried before the wall is painted again.
+	connect(this, &AbstractItem::positionChanged, this, &WallItem::recalculateBorders);
+	connect(this, &AbstractItem::x1Changed, this, &WallItem::recalculateBorders);
+	connect(this, &AbstractItem::y1Changed, this, &WallItem::recalculateBorders);
+	connect(this, &AbstractItem::x2Changed, this, &WallItem::recalculateBorders);
+	connect(this, &AbstractItem::y2Changed, this, &WallItem::recalculateBorders);
+	recalculateBorders();
 }
 
 WallItem *WallItem::clone() const
@@ -0,0 +1,279 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "solidGeometry.h"
+
+#include <QtCore/QSet>
+#include <QtCore/QtMath>
+
+#include <cmath>
+
+using namespace twoDModel::model;
+
+/// Tolerance of geometric predicates, in scene pixels.
+const qreal epsilon = 1e-9;
+
+static qreal dot(const QPointF &a, const QPointF &b)
+{
+	return a.x() * b.x() + a.y() * b.y();
+}
+
+static qreal cross(const QPointF &a, const QPointF &b)
+{
+	return a.x() * b.y() - a.y() * b.x();
+}
+
+static qreal length(const QPointF &vector)
+{
+	return std::sqrt(dot(vector, vector));
+}
+
+/// Returns a unit vector directed at the given angle in degrees, clockwise in scene coordinates.
+static QPointF directionVector(qreal angle)
+{
+	const qreal radians = qDegreesToRadians(angle);
+	return QPointF(std::cos(radians), std::sin(radians));
+}
+
+SolidGeometry::SolidGeometry(qreal cellSize)
+	: mCellSize(cellSize)
+{
+}
+
+void SolidGeometry::setBody(const QGraphicsItem *item, const QPainterPath &path)
+{
+	removeBody(item);
+
+	Body body;
+	body.path = path;
+	body.bounds = path.boundingRect();
+	for (const QPolygonF &polygon : path.toSubpathPolygons()) {
+		for (int i = 1; i < polygon.size(); ++i) {
+			body.edges << QLineF(polygon[i - 1], polygon[i]);
+		}
+
+		if (polygon.size() > 2 && polygon.first() != polygon.last()) {
+			body.edges << QLineF(polygon.last(), polygon.first());
+		}
+	}
+
+	const int left = cellCoordinate(body.bounds.left());
+	const int right = cellCoordinate(body.bounds.right());
+	const int top = cellCoordinate(body.bounds.top());
+	const int bottom = cellCoordinate(body.bounds.bottom());
+	for (int x = left; x <= right; ++x) {
+		for (int y = top; y <= bottom; ++y) {
+			const quint64 key = cellKey(x, y);
+			mGrid[key] << item;
+			body.cells << key;
+		}
+	}
+
+	mBodies.insert(item, body);
+}
+
+void SolidGeometry::removeBody(const QGraphicsItem *item)
+{
+	const auto body = mBodies.find(item);
+	if (body == mBodies.end()) {
+		return;
+	}
+
+	for (const quint64 key : body->cells) {
+		const auto cell = mGrid.find(key);
+		cell->removeOne(item);
+		if (cell->isEmpty()) {
+			mGrid.erase(cell);
+		}
+	}
+
+	mBodies.erase(body);
+}
+
+bool SolidGeometry::contains(const QGraphicsItem *item) const
+{
+	return mBodies.contains(item);
+}
+
+void SolidGeometry::clear()
+{
+	mBodies.clear();
+	mGrid.clear();
+}
+
+bool SolidGeometry::intersects(const QPainterPath &path) const
+{
+	const QRectF bounds = path.boundingRect();
+	for (const Body *body : bodiesNear(bounds)) {
+		if (body->bounds.intersects(bounds) && body->path.intersects(path)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+qreal SolidGeometry::coneCast(const QPointF &position, qreal direction, qreal halfAngle, qreal maxDistance) const
+{
+	const QPointF axis = directionVector(direction);
+	const QPointF leftRay = directionVector(direction - halfAngle);
+	const QPointF rightRay = directionVector(direction + halfAngle);
+	const qreal cosHalfAngle = std::cos(qDegreesToRadians(halfAngle));
+
+	// Bounding rect of the sector: its apex, ends of its boundary rays and extreme points of its arc.
+	QPolygonF sectorPoints;
+	sectorPoints << position << position + leftRay * maxDistance << position + rightRay * maxDistance;
+	for (const QPointF &extreme : { QPointF(1, 0), QPointF(0, 1), QPointF(-1, 0), QPointF(0, -1) }) {
+		if (dot(extreme, axis) >= cosHalfAngle) {
+			sectorPoints << position + extreme * maxDistance;
+		}
+	}
+
+	const QRectF sector = sectorPoints.boundingRect();
+
+	qreal result = -1;
+	for (const Body *body : bodiesNear(sector)) {
+		if (!body->bounds.intersects(sector)) {
+			continue;
+		}
+
+		if (body->path.contains(position)) {
+			return 0;
+		}
+
+		for (const QLineF &edge : body->edges) {
+			const qreal distance = edgeDistanceInCone(position, edge, axis, cosHalfAngle, leftRay, rightRay);
+			if (distance >= 0 && distance <= maxDistance && (result < 0 || distance < result)) {
+				result = distance;
+			}
+		}
+	}
+
+	return result;
+}
+
+QPainterPath SolidGeometry::united() const
+{
+	QPainterPath result;
+	for (const Body &body : mBodies) {
+		result.addPath(body.path);
+	}
+
+	return result;
+}
+
+quint64 SolidGeometry::cellKey(int x, int y)
+{
+	return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y);
+}
+
+int SolidGeometry::cellCoordinate(qreal coordinate) const
+{
+	return static_cast<int>(std::floor(coordinate / mCellSize));
+}
+
+QVector<const SolidGeometry::Body *> SolidGeometry::bodiesNear(const QRectF &rect) const
+{
+	QVector<const Body *> result;
+	if (mBodies.isEmpty()) {
+		return result;
+	}
+
+	const int left = cellCoordinate(rect.left());
+	const int right = cellCoordinate(rect.right());
+	const int top = cellCoordinate(rect.top());
+	const int bottom = cellCoordinate(rect.bottom());
+
+	// Large query may cover much more cells than there are bodies, then it is cheaper to check all of them.
+	if (static_cast<qint64>(right - left + 1) * (bottom - top + 1) > mBodies.size()) {
+		for (const Body &body : mBodies) {
+			result << &body;
+		}
+
+		return result;
+	}
+
+	QSet<const QGraphicsItem *> visited;
+	for (int x = left; x <= right; ++x) {
+		for (int y = top; y <= bottom; ++y) {
+			const auto cell = mGrid.constFind(cellKey(x, y));
+			if (cell == mGrid.constEnd()) {
+				continue;
+			}
+
+			for (const QGraphicsItem *item : *cell) {
+				if (!visited.contains(item)) {
+					visited.insert(item);
+					result << &mBodies.constFind(item).value();
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+qreal SolidGeometry::edgeDistanceInCone(const QPointF &position, const QLineF &edge
+		, const QPointF &axis, qreal cosHalfAngle, const QPointF &leftRay, const QPointF &rightRay)
+{
+	const auto inCone = [&position, &axis, cosHalfAngle](const QPointF &point) {
+		const QPointF vector = point - position;
+		return dot(vector, axis) >= length(vector) * cosHalfAngle - epsilon;
+	};
+
+	qreal result = -1;
+	const auto consider = [&result](qreal distance) {
+		if (result < 0 || distance < result) {
+			result = distance;
+		}
+	};
+
+	// Distance to a segment restricted by a cone is reached either in the point of the segment closest to the apex
+	// or on the boundary of the restriction: in segment ends or in intersections with boundary rays.
+	const QPointF start = edge.p1();
+	const QPointF segment = edge.p2() - edge.p1();
+	const qreal squaredLength = dot(segment, segment);
+
+	if (inCone(edge.p1())) {
+		consider(length(edge.p1() - position));
+	}
+
+	if (inCone(edge.p2())) {
+		consider(length(edge.p2() - position));
+	}
+
+	if (squaredLength > epsilon) {
+		const qreal t = qBound(0.0, dot(position - start, segment) / squaredLength, 1.0);
+		const QPointF closest = start + segment * t;
+		if (inCone(closest)) {
+			consider(length(closest - position));
+		}
+	}
+
+	for (const QPointF &ray : { leftRay, rightRay }) {
+		const qreal denominator = cross(ray, segment);
+		if (qAbs(denominator) < epsilon) {
+			continue;
+		}
+
+		const QPointF toStart = start - position;
+		const qreal distance = cross(toStart, segment) / denominator;
+		const qreal u = cross(toStart, ray) / denominator;
+		if (distance >= 0 && u >= 0 && u <= 1) {
+			consider(distance);
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,87 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QLineF>
+#include <QtCore/QVector>
+#include <QtGui/QPainterPath>
+
+class QGraphicsItem;
+
+namespace twoDModel {
+namespace model {
+
+/// Outlines of solid items of the world (walls, skittles, balls) with a uniform grid over them, so collision
+/// checks and sonar readings only look at bodies near the query instead of the union of all the solid items.
+/// Bodies are identified by items they belong to, the geometry itself knows nothing about items.
+class SolidGeometry
+{
+public:
+	/// @param cellSize Size of a grid cell side in scene pixels.
+	explicit SolidGeometry(qreal cellSize = 64.0);
+
+	/// Sets or replaces the outline of the body of the given item.
+	void setBody(const QGraphicsItem *item, const QPainterPath &path);
+
+	/// Removes the body of the given item, if any.
+	void removeBody(const QGraphicsItem *item);
+
+	/// Returns true if the body of the given item is in the geometry.
+	bool contains(const QGraphicsItem *item) const;
+
+	/// Removes all the bodies.
+	void clear();
+
+	/// Returns true if the given path intersects some body.
+	bool intersects(const QPainterPath &path) const;
+
+	/// Returns the distance from @a position to the nearest point of bodies seen inside the cone with apex in
+	/// @a position, axis directed at @a direction degrees (clockwise, as scene rotation) and angular half-width
+	/// @a halfAngle degrees. Returns -1 if nothing is seen at distance @a maxDistance or closer.
+	qreal coneCast(const QPointF &position, qreal direction, qreal halfAngle, qreal maxDistance) const;
+
+	/// Returns the union of all the bodies, for debugging purposes.
+	QPainterPath united() const;
+
+private:
+	struct Body
+	{
+		QPainterPath path;
+		QRectF bounds;
+		QVector<QLineF> edges;
+		QVector<quint64> cells;
+	};
+
+	/// Returns the key of the grid cell with the given coordinates.
+	static quint64 cellKey(int x, int y);
+
+	/// Returns the coordinates of the cell containing the given scene coordinate.
+	int cellCoordinate(qreal coordinate) const;
+
+	/// Returns all bodies whose bounding rectangles are in cells covered by the given rect.
+	QVector<const Body *> bodiesNear(const QRectF &rect) const;
+
+	/// Returns the distance from @a position to the nearest point of @a edge inside the cone, or -1.
+	static qreal edgeDistanceInCone(const QPointF &position, const QLineF &edge
+			, const QPointF &axis, qreal cosHalfAngle, const QPointF &leftRay, const QPointF &rightRay);
+
+	const qreal mCellSize;
+	QHash<const QGraphicsItem *, Body> mBodies;
+	QHash<quint64, QVector<const QGraphicsItem *>> mGrid;
+};
+
+}
+}
@@ -16,6 +16,8 @@
 #include <QtCore/QStringList>
 #include <QtCore/QUuid>
 
+#include <cmath>
+
 #include <qrgui/plugins/toolPluginInterface/usedInterfaces/errorReporterInterface.h>
 
 #include "twoDModel/engine/model/constants.h"
@@ -35,9 +37,17 @@
 #include "src/engine/items/regions/rectangularRegion.h"
 #include "src/engine/items/regions/boundRegion.h"
 
+#include "solidGeometry.h"
+
 using namespace twoDModel;
 using namespace model;
 
+/// Sonar sees objects inside the sector of this half-width (in degrees) around its direction.
+const qreal sonarRayWidthDegrees = 10.0;
+
+/// Maximal distance measured by sonar, in cm. Sonar returns this value when nothing is seen.
+const int maxSonarRangeCms = 255;
+
 //#define D2_MODEL_FRAMES_DEBUG
 
 #ifdef D2_MODEL_FRAMES_DEBUG
@@ -48,6 +58,7 @@ QGraphicsPathItem *debugPath = nullptr;
 WorldModel::WorldModel()
 	: mXmlFactory(new QDomDocument)
 	, mErrorReporter(nullptr)
+	, mSolidGeometry(new SolidGeometry)
 {
 }
 
@@ -72,33 +83,15 @@ qreal WorldModel::pixelsInCm() const
 
 int WorldModel::sonarReading(const QPointF &position, qreal direction) const
 {
-	int maxSonarRangeCms = 255;
-	int minSonarRangeCms = 0;
-	int currentRangeInCm = (minSonarRangeCms + maxSonarRangeCms) / 2;
-
-	const QPainterPath path = buildSolidItemsPath();
-	if (!checkSonarDistance(maxSonarRangeCms, position, direction, path)) {
+	updateSolidGeometry();
+	const qreal distance = mSolidGeometry->coneCast(position, direction, sonarRayWidthDegrees
+			, maxSonarRangeCms * pixelsInCm());
+	if (distance < 0) {
 		return maxSonarRangeCms;
 	}
 
-	for ( ; minSonarRangeCms < maxSonarRangeCms;
-			currentRangeInCm = (minSonarRangeCms + maxSonarRangeCms) / 2)
-	{
-		if (checkSonarDistance(currentRangeInCm, position, direction, path)) {
-			maxSonarRangeCms = currentRangeInCm;
-		} else {
-			minSonarRangeCms = currentRangeInCm + 1;
-		}
-	}
-
-	return currentRangeInCm;
-}
-
-bool WorldModel::checkSonarDistance(const int distance, const QPointF &position
-		, const qreal direction, const QPainterPath &wallPath) const
-{
-	const QPainterPath rayPath = sonarScanningRegion(position, direction, distance);
-	return rayPath.intersects(wallPath);
+	// Sonar reports the smallest range in cm whose scanning region touches some solid item.
+	return qMin(maxSonarRangeCms, static_cast<int>(std::ceil(distance / pixelsInCm())));
 }
 
 QPainterPath WorldModel::sonarScanningRegion(const QPointF &position, int range) const
@@ -108,12 +101,11 @@ QPainterPath WorldModel::sonarScanningRegion(const QPointF &position, int range)
 
 QPainterPath WorldModel::sonarScanningRegion(const QPointF &position, qreal direction, int range) const
 {
-	const qreal rayWidthDegrees = 10.0;
 	const qreal rangeInPixels = range * pixelsInCm();
 
 	QPainterPath rayPath;
 	rayPath.arcTo(QRectF(-rangeInPixels, -rangeInPixels, 2 * rangeInPixels, 2 * rangeInPixels)
-			, -direction - rayWidthDegrees, 2 * rayWidthDegrees);
+			, -direction - sonarRayWidthDegrees, 2 * sonarRayWidthDegrees);
 	rayPath.closeSubpath();
 	const QTransform sensorPositionTransform = QTransform().translate(position.x(), position.y());
 	return sensorPositionTransform.map(rayPath);
@@ -121,9 +113,11 @@ QPainterPath WorldModel::sonarScanningRegion(const QPointF &position, qreal dire
 
 bool WorldModel::checkCollision(const QPainterPath &path) const
 {
+	updateSolidGeometry();
+
 #ifdef D2_MODEL_FRAMES_DEBUG
 	delete debugPath;
-	QPainterPath commonPath = buildSolidItemsPath();
+	QPainterPath commonPath = mSolidGeometry->united();
 	commonPath.addPath(path);
 	debugPath = new QGraphicsPathItem(commonPath);
 	debugPath->setBrush(Qt::red);
@@ -140,7 +134,7 @@ bool WorldModel::checkCollision(const QPainterPath &path) const
 	}
 #endif
 
-	return buildSolidItemsPath().intersects(path);
+	return mSolidGeometry->intersects(path);
 }
 
 const QMap<QString, items::WallItem *> &WorldModel::walls() const
@@ -168,12 +162,24 @@ void WorldModel::addWall(items::WallItem *wall)
 
 	mWalls[id] = wall;
 	mOrder[id] = mOrder.size();
+
+	const auto invalidate = [this, wall]() { mChangedWalls.insert(wall); };
+	connect(wall, &items::WallItem::positionChanged, this, invalidate);
+	connect(wall, &items::WallItem::x1Changed, this, invalidate);
+	connect(wall, &items::WallItem::y1Changed, this, invalidate);
+	connect(wall, &items::WallItem::x2Changed, this, invalidate);
+	connect(wall, &items::WallItem::y2Changed, this, invalidate);
+	mChangedWalls.insert(wall);
+
 	emit wallAdded(wall);
 }
 
 void WorldModel::removeWall(items::WallItem *wall)
 {
 	mWalls.remove(wall->id());
+	disconnect(wall, nullptr, this, nullptr);
+	mChangedWalls.remove(wall);
+	mSolidGeometry->removeBody(wall);
 	emit itemRemoved(wall);
 }
 
@@ -192,6 +198,8 @@ void WorldModel::addSkittle(items::SkittleItem *skittle)
 void WorldModel::removeSkittle(items::SkittleItem *skittle)
 {
 	mSkittles.remove(skittle->id());
+	mMovableSolidsState.remove(skittle);
+	mSolidGeometry->removeBody(skittle);
 	emit itemRemoved(skittle);
 }
 
@@ -210,6 +218,8 @@ void WorldModel::addBall(items::BallItem *ball)
 void WorldModel::removeBall(items::BallItem *ball)
 {
 	mBalls.remove(ball->id());
+	mMovableSolidsState.remove(ball);
+	mSolidGeometry->removeBody(ball);
 	emit itemRemoved(ball);
 }
 
@@ -228,7 +238,7 @@ const QMap<QString, items::RegionItem *> &WorldModel::regions() const
 	return mRegions;
 }
 
-const QList<QGraphicsLineItem *> &WorldModel::trace() const
+const QVector<TraceSegment> &WorldModel::trace() const
 {
 	return mRobotTrace;
 }
@@ -321,46 +331,51 @@ void WorldModel::appendRobotTrace(const QPen &pen, const QPointF &begin, const Q
 		return;
 	}
 
-	QGraphicsLineItem * const traceItem = new QGraphicsLineItem(QLineF(begin, end));
-	traceItem->setPen(pen);
-
 	if (mRobotTrace.isEmpty()) {
 		emit robotTraceAppearedOrDisappeared(true);
 	}
 
-	mRobotTrace << traceItem;
-	emit traceItemAdded(traceItem);
+	mRobotTrace << TraceSegment{QLineF(begin, end), pen.color(), pen.width()};
+	emit traceSegmentAdded(mRobotTrace.last());
 }
 
 void WorldModel::clearRobotTrace()
 {
-	while (!mRobotTrace.isEmpty()) {
-		QGraphicsLineItem * const toRemove = mRobotTrace.first();
-		mRobotTrace.removeOne(toRemove);
-		emit itemRemoved(toRemove);
-	}
-
+	mRobotTrace.clear();
 	emit robotTraceAppearedOrDisappeared(false);
 }
 
-QPainterPath WorldModel::buildSolidItemsPath() const
+void WorldModel::updateSolidGeometry() const
 {
-	/// @todo Maintain a cache for this.
-	QPainterPath path;
+	for (items::WallItem * const wall : mChangedWalls) {
+		mSolidGeometry->setBody(wall, wall->path());
+	}
 
-	for (items::WallItem *wall : mWalls) {
-		path.addPath(wall->path());
+	mChangedWalls.clear();
+
+	for (items::SkittleItem * const skittle : mSkittles) {
+		if (movableSolidChanged(skittle)) {
+			mSolidGeometry->setBody(skittle, skittle->path());
+		}
 	}
 
-	for (items::SkittleItem *skittle: mSkittles) {
-		path.addPath(skittle->path());
+	for (items::BallItem * const ball : mBalls) {
+		if (movableSolidChanged(ball)) {
+			mSolidGeometry->setBody(ball, ball->path());
+		}
 	}
+}
 
-	for (items::BallItem *ball: mBalls) {
-		path.addPath(ball->path());
+bool WorldModel::movableSolidChanged(const QGraphicsItem *item) const
+{
+	const QPair<QPointF, qreal> state(item->scenePos(), item->rotation());
+	const auto oldState = mMovableSolidsState.constFind(item);
+	if (oldState != mMovableSolidsState.constEnd() && oldState.value() == state) {
+		return false;
 	}
 
-	return path;
+	mMovableSolidsState[item] = state;
+	return true;
 }
 
 void WorldModel::serializeBackground(QDomElement &background, const QRect &rect, const Image * const img) const
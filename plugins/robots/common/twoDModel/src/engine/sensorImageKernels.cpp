@@ -0,0 +1,253 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "twoDModel/engine/sensorImageKernels.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace twoDModel::engine;
+
+// http://stackoverflow.com/questions/596216/formula-to-determine-brightness-of-rgb-color
+const double redWeight = 0.2126;
+const double greenWeight = 0.7152;
+const double blueWeight = 0.0722;
+
+QImage SensorImageKernels::toKernelFormat(const QImage &image)
+{
+	return image.format() == QImage::Format_RGB32 || image.format() == QImage::Format_ARGB32
+			? image
+			: image.convertToFormat(QImage::Format_ARGB32);
+}
+
+uint SensorImageKernels::brightness(uint color)
+{
+	const uint b = (color >> 0) & 0xFF;
+	const uint g = (color >> 8) & 0xFF;
+	const uint r = (color >> 16) & 0xFF;
+	return static_cast<uint>(redWeight * r + greenWeight * g + blueWeight * b);
+}
+
+quint64 SensorImageKernels::brightnessSum(const uint *pixels, int count)
+{
+	quint64 sum = 0;
+	int i = 0;
+
+#ifdef __SSE2__
+	// Four pixels at a time. Channels are weighted in double precision with the same operations in the same order
+	// as in brightness(), so results are bit-exact.
+	const __m128i channelMask = _mm_set1_epi32(0xFF);
+	const __m128d red = _mm_set1_pd(redWeight);
+	const __m128d green = _mm_set1_pd(greenWeight);
+	const __m128d blue = _mm_set1_pd(blueWeight);
+
+	const auto weigh = [&](__m128i r, __m128i g, __m128i b) {
+		const __m128d value = _mm_add_pd(
+				_mm_add_pd(_mm_mul_pd(red, _mm_cvtepi32_pd(r)), _mm_mul_pd(green, _mm_cvtepi32_pd(g)))
+				, _mm_mul_pd(blue, _mm_cvtepi32_pd(b)));
+		return _mm_cvttpd_epi32(value);
+	};
+
+	// Per-lane sums never exceed 255 * blockSize, so they fit into 32 bits.
+	const int blockSize = 1 << 20;
+	while (i + 4 <= count) {
+		const int blockEnd = qMin(count - (count - i) % 4, i + blockSize);
+		__m128i lanes = _mm_setzero_si128();
+		for (; i < blockEnd; i += 4) {
+			const __m128i colors = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+			const __m128i b = _mm_and_si128(colors, channelMask);
+			const __m128i g = _mm_and_si128(_mm_srli_epi32(colors, 8), channelMask);
+			const __m128i r = _mm_and_si128(_mm_srli_epi32(colors, 16), channelMask);
+			const __m128i low = weigh(r, g, b);
+			const __m128i high = weigh(_mm_unpackhi_epi64(r, r), _mm_unpackhi_epi64(g, g), _mm_unpackhi_epi64(b, b));
+			lanes = _mm_add_epi32(lanes, _mm_add_epi32(low, high));
+		}
+
+		quint32 parts[4];
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(parts), lanes);
+		sum += static_cast<quint64>(parts[0]) + parts[1] + parts[2] + parts[3];
+	}
+#endif
+
+	for (; i < count; ++i) {
+		sum += brightness(pixels[i]);
+	}
+
+	return sum;
+}
+
+int SensorImageKernels::sumOpaqueChannels(const uint *pixels, int count
+		, quint64 &red, quint64 &green, quint64 &blue)
+{
+	int opaque = 0;
+	int i = 0;
+
+#ifdef __SSE2__
+	const __m128i channelMask = _mm_set1_epi32(0xFF);
+	const __m128i alphaMask = _mm_set1_epi32(0xFF000000);
+	const __m128i zero = _mm_setzero_si128();
+
+	// Per-lane sums never exceed 255 * blockSize, so they fit into 32 bits.
+	const int blockSize = 1 << 20;
+	while (i + 4 <= count) {
+		const int blockEnd = qMin(count - (count - i) % 4, i + blockSize);
+		__m128i r = zero;
+		__m128i g = zero;
+		__m128i b = zero;
+		__m128i opaqueLanes = zero;
+		for (; i < blockEnd; i += 4) {
+			__m128i colors = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+			const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(colors, alphaMask), zero);
+			colors = _mm_andnot_si128(transparent, colors);
+			b = _mm_add_epi32(b, _mm_and_si128(colors, channelMask));
+			g = _mm_add_epi32(g, _mm_and_si128(_mm_srli_epi32(colors, 8), channelMask));
+			r = _mm_add_epi32(r, _mm_and_si128(_mm_srli_epi32(colors, 16), channelMask));
+			// Comparison gives -1 in lanes of transparent pixels, so opaque ones are counted as 1 + transparent.
+			opaqueLanes = _mm_add_epi32(opaqueLanes, _mm_add_epi32(_mm_set1_epi32(1), transparent));
+		}
+
+		quint32 parts[4];
+		const auto add = [&parts](__m128i lanes, quint64 &sum) {
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(parts), lanes);
+			sum += static_cast<quint64>(parts[0]) + parts[1] + parts[2] + parts[3];
+		};
+
+		add(r, red);
+		add(g, green);
+		add(b, blue);
+		quint64 opaqueInBlock = 0;
+		add(opaqueLanes, opaqueInBlock);
+		opaque += static_cast<int>(opaqueInBlock);
+	}
+#endif
+
+	for (; i < count; ++i) {
+		const uint color = pixels[i];
+		if (color >> 24) {
+			++opaque;
+			red += (color >> 16) & 0xFF;
+			green += (color >> 8) & 0xFF;
+			blue += color & 0xFF;
+		}
+	}
+
+	return opaque;
+}
+
+int SensorImageKernels::countCloseColors(const uint *pixels, int count, uint color, int tolerance
+		, qint64 &indexSum)
+{
+	if (tolerance <= 0) {
+		return 0;
+	}
+
+	const int limit = qMin(tolerance - 1, 255);
+	const auto isClose = [color, limit](uint pixel) {
+		return (pixel >> 24) != 0
+				&& qAbs(static_cast<int>((pixel >> 16) & 0xFF) - static_cast<int>((color >> 16) & 0xFF)) <= limit
+				&& qAbs(static_cast<int>((pixel >> 8) & 0xFF) - static_cast<int>((color >> 8) & 0xFF)) <= limit
+				&& qAbs(static_cast<int>(pixel & 0xFF) - static_cast<int>(color & 0xFF)) <= limit;
+	};
+
+	int result = 0;
+	int i = 0;
+
+#ifdef __SSE2__
+	// Per-byte absolute differences via saturated subtractions in both directions, alpha difference is ignored.
+	const __m128i reference = _mm_set1_epi32(color);
+	const __m128i rgbMask = _mm_set1_epi32(0x00FFFFFF);
+	const __m128i alphaMask = _mm_set1_epi32(0xFF000000);
+	const __m128i limits = _mm_set1_epi8(static_cast<char>(limit));
+	const __m128i allOnes = _mm_set1_epi32(-1);
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 4 <= count; i += 4) {
+		const __m128i colors = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+		const __m128i difference = _mm_and_si128(rgbMask
+				, _mm_or_si128(_mm_subs_epu8(colors, reference), _mm_subs_epu8(reference, colors)));
+		const __m128i closeBytes = _mm_cmpeq_epi8(_mm_max_epu8(difference, limits), limits);
+		const __m128i close = _mm_cmpeq_epi32(closeBytes, allOnes);
+		const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(colors, alphaMask), zero);
+		const int matches = _mm_movemask_ps(_mm_castsi128_ps(_mm_andnot_si128(transparent, close)));
+		for (int lane = 0; lane < 4; ++lane) {
+			if (matches & (1 << lane)) {
+				++result;
+				indexSum += i + lane;
+			}
+		}
+	}
+#endif
+
+	for (; i < count; ++i) {
+		if (isClose(pixels[i])) {
+			++result;
+			indexSum += i;
+		}
+	}
+
+	return result;
+}
+
+int SensorImageKernels::countPaletteColors(const uint *pixels, int count, const uint *palette, int paletteSize
+		, int *counts)
+{
+	// Sensor images are small enough to stay in cache, so they are just scanned once per palette color.
+	int others = count;
+	for (int color = 0; color < paletteSize; ++color) {
+		int matches = 0;
+		int i = 0;
+
+#ifdef __SSE2__
+		const __m128i reference = _mm_set1_epi32(palette[color]);
+		__m128i lanes = _mm_setzero_si128();
+		for (; i + 4 <= count; i += 4) {
+			const __m128i colors = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+			// Comparison gives -1 in matching lanes.
+			lanes = _mm_sub_epi32(lanes, _mm_cmpeq_epi32(colors, reference));
+		}
+
+		qint32 parts[4];
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(parts), lanes);
+		matches = parts[0] + parts[1] + parts[2] + parts[3];
+#endif
+
+		for (; i < count; ++i) {
+			if (pixels[i] == palette[color]) {
+				++matches;
+			}
+		}
+
+		counts[color] = matches;
+		others -= matches;
+	}
+
+	return others;
+}
+
+void SensorImageKernels::countColors(const uint *pixels, int count, QHash<uint, int> &histogram)
+{
+	// Sensors mostly look at large areas of the same color, so runs of equal pixels are counted before
+	// going to the hash table.
+	int i = 0;
+	while (i < count) {
+		const uint color = pixels[i];
+		int runEnd = i + 1;
+		while (runEnd < count && pixels[runEnd] == color) {
+			++runEnd;
+		}
+
+		histogram[color] += runEnd - i;
+		i = runEnd;
+	}
+}
@@ -32,6 +32,7 @@
 #include "twoDModel/engine/twoDModelGuiFacade.h"
 #include "twoDModel/engine/model/model.h"
 #include "twoDModel/engine/model/constants.h"
+#include "twoDModel/engine/sensorImageKernels.h"
 #include "twoDModel/engine/view/twoDModelWidget.h"
 
 #include "view/scene/twoDModelScene.h"
@@ -153,26 +154,25 @@ int TwoDModelEngineApi::spoilSonarReading(const int distance) const
 
 int TwoDModelEngineApi::readColorSensor(const PortInfo &port) const
 {
-	const QImage image = areaUnderSensor(port, 1.0);
-	QHash<uint, int> countsColor;
-
-	const uint *data = reinterpret_cast<const uint *>(image.bits());
+	QImage image = areaUnderSensor(port, 1.0);
+	uint *data = reinterpret_cast<uint *>(image.bits());
 	const int n = image.byteCount() / 4;
-	for (int i = 0; i < n; ++i) {
-		const uint color = mModel.settings().realisticSensors() ? spoilColor(data[i]) : data[i];
-		++countsColor[color];
+	if (mModel.settings().realisticSensors()) {
+		for (int i = 0; i < n; ++i) {
+			data[i] = spoilColor(data[i]);
+		}
 	}
 
 	if (mModel.robotModels()[0]->configuration().type(port).isA<robotParts::ColorSensorFull>()) {
-		return readColorFullSensor(countsColor);
+		return readColorFullSensor(data, n);
 	} else if (mModel.robotModels()[0]->configuration().type(port).isA<robotParts::ColorSensorPassive>()) {
-		return readColorNoneSensor(countsColor, n);
+		return readColorNoneSensor(data, n);
 	} else if (mModel.robotModels()[0]->configuration().type(port).isA<robotParts::ColorSensorRed>()) {
-		return readSingleColorSensor(red, countsColor, n);
+		return readSingleColorSensor(red, data, n);
 	} else if (mModel.robotModels()[0]->configuration().type(port).isA<robotParts::ColorSensorGreen>()) {
-		return readSingleColorSensor(green, countsColor, n);
+		return readSingleColorSensor(green, data, n);
 	} else if (mModel.robotModels()[0]->configuration().type(port).isA<robotParts::ColorSensorBlue>()) {
-		return readSingleColorSensor(blue, countsColor, n);
+		return readSingleColorSensor(blue, data, n);
 	}
 
 	QLOG_ERROR() << "Incorrect 2d model sensor configuration";
@@ -211,21 +211,13 @@ QImage TwoDModelEngineApi::areaUnderSensor(const PortInfo &port, qreal widthFact
 	const QRect imageRect = mModel.robotModels()[0]->info().sensorImageRect(device);
 	const qreal width = imageRect.width() * widthFactor / 2.0;
 
-	const QRectF sensorRectangle = QTransform().rotate(direction).map(QPolygonF(QRectF(imageRect))).boundingRect();
-	const qreal rotationFactor = sensorRectangle.width() / imageRect.width();
-
-	const qreal realWidth = width * rotationFactor;
-	const QRectF scanningRect = QRectF(position.x() - realWidth, position.y() - realWidth
-			, 2 * realWidth, 2 * realWidth);
-	const QImage image(mFakeScene->render(scanningRect));
-	const QPoint offset = QPointF(width, width).toPoint() - QPoint(1, 1);
-	const QImage rotated(image.transformed(QTransform().rotate(-(90 + direction))));
-	const QRect realImage(rotated.rect().center() - offset, rotated.rect().center() + offset);
-	QImage result(realImage.size(), QImage::Format_RGB32);
-	result.fill(Qt::white);
-	QPainter painter(&result);
-	painter.drawImage(QRect(QPoint(), result.size()), rotated, realImage);
-	painter.end();
+	// The area is a square with odd side centered at sensor position and rotated to look towards sensor direction.
+	const int halfSide = qRound(width) - 1;
+	if (halfSide < 0) {
+		return QImage();
+	}
+
+	const QImage result = mFakeScene->sample(position, 90 + direction, QSize(2 * halfSide + 1, 2 * halfSide + 1));
 
 #ifdef BACKGROUND_SCENE_DEBUGGING
 	mView.scene()->addItem(new QGraphicsPixmapItem(QPixmap::fromImage(result)));
@@ -234,8 +226,26 @@ QImage TwoDModelEngineApi::areaUnderSensor(const PortInfo &port, qreal widthFact
 	return result;
 }
 
-int TwoDModelEngineApi::readColorFullSensor(QHash<uint, int> const &countsColor) const
+int TwoDModelEngineApi::readColorFullSensor(const uint *pixels, int n) const
 {
+	static const uint palette[] = { black, red, green, blue, yellow, white, cyan, magenta };
+	const int paletteSize = sizeof(palette) / sizeof(palette[0]);
+	int counts[paletteSize];
+	const int others = engine::SensorImageKernels::countPaletteColors(pixels, n, palette, paletteSize, counts);
+	int mostFrequent = 0;
+	for (int i = 1; i < paletteSize; ++i) {
+		if (counts[i] > counts[mostFrequent]) {
+			mostFrequent = i;
+		}
+	}
+
+	if (counts[mostFrequent] > others) {
+		return colorCode(palette[mostFrequent]);
+	}
+
+	// Some color out of palette may be the most frequent one, so all the colors have to be counted.
+	QHash<uint, int> countsColor;
+	engine::SensorImageKernels::countColors(pixels, n, countsColor);
 	if (countsColor.isEmpty()) {
 		return 0;
 	}
@@ -248,8 +258,12 @@ int TwoDModelEngineApi::readColorFullSensor(QHash<uint, int> const &countsColor)
 		}
 	}
 
-	const uint maxColor = countsColor.key(maxValue);
-	switch (maxColor) {
+	return colorCode(countsColor.key(maxValue));
+}
+
+int TwoDModelEngineApi::colorCode(uint color) const
+{
+	switch (color) {
 	case (black):
 		return 1;
 	case (red):
@@ -271,13 +285,17 @@ int TwoDModelEngineApi::readColorFullSensor(QHash<uint, int> const &countsColor)
 	}
 }
 
-int TwoDModelEngineApi::readSingleColorSensor(uint color, QHash<uint, int> const &countsColor, int n) const
+int TwoDModelEngineApi::readSingleColorSensor(uint color, const uint *pixels, int n) const
 {
-	return (static_cast<double>(countsColor[color]) / static_cast<double>(n)) * 100.0;
+	int count = 0;
+	engine::SensorImageKernels::countPaletteColors(pixels, n, &color, 1, &count);
+	return (static_cast<double>(count) / static_cast<double>(n)) * 100.0;
 }
 
-int TwoDModelEngineApi::readColorNoneSensor(QHash<uint, int> const &countsColor, int n) const
+int TwoDModelEngineApi::readColorNoneSensor(const uint *pixels, int n) const
 {
+	QHash<uint, int> countsColor;
+	engine::SensorImageKernels::countColors(pixels, n, countsColor);
 	qreal allWhite = static_cast<qreal>(countsColor[white]);
 
 	QHashIterator<uint, int> i(countsColor);
@@ -301,26 +319,22 @@ int TwoDModelEngineApi::readLightSensor(const PortInfo &port) const
 	// Must return 1023 on white and 0 on black normalized to percents
 	// http://stackoverflow.com/questions/596216/formula-to-determine-brightness-of-rgb-color
 
-	const QImage image = areaUnderSensor(port, 1.0);
+	QImage image = areaUnderSensor(port, 1.0);
 	if (image.isNull()) {
 		return 0;
 	}
 
-	uint sum = 0;
-	const uint *data = reinterpret_cast<const uint *>(image.bits());
+	uint *data = reinterpret_cast<uint *>(image.bits());
 	const int n = image.byteCount() / 4;
-
-	for (int i = 0; i < n; ++i) {
-		const uint color = mModel.settings().realisticSensors() ? spoilLight(data[i]) : data[i];
-		const uint b = (color >> 0) & 0xFF;
-		const uint g = (color >> 8) & 0xFF;
-		const uint r = (color >> 16) & 0xFF;
-		// brightness in [0..256]
-		const uint brightness = static_cast<uint>(0.2126 * r + 0.7152 * g + 0.0722 * b);
-
-		sum += 4 * brightness; // 4 = max sensor value / max brightness value
+	if (mModel.settings().realisticSensors()) {
+		for (int i = 0; i < n; ++i) {
+			data[i] = spoilLight(data[i]);
+		}
 	}
 
+	// brightness in [0..256], 4 = max sensor value / max brightness value
+	const quint64 sum = 4 * engine::SensorImageKernels::brightnessSum(data, n);
+
 	const qreal rawValue = sum * 1.0 / n; // Average by whole region
 	return static_cast<int>(rawValue * 100.0 / maxLightSensorValue); // Normalizing to percents
 }
@@ -64,9 +64,12 @@ public:
 private:
 	QPair<QPointF, qreal> countPositionAndDirection(const kitBase::robotModel::PortInfo &port) const;
 
-	int readColorFullSensor(QHash<uint, int> const &countsColor) const;
-	int readColorNoneSensor(QHash<uint, int> const &countsColor, int n) const;
-	int readSingleColorSensor(uint color, QHash<uint, int> const &countsColor, int n) const;
+	int readColorFullSensor(const uint *pixels, int n) const;
+	int readColorNoneSensor(const uint *pixels, int n) const;
+	int readSingleColorSensor(uint color, const uint *pixels, int n) const;
+
+	/// Returns the value color sensor gives for a color that is the most frequent one under it.
+	int colorCode(uint color) const;
 
 	uint spoilColor(const uint color) const;
 	uint spoilLight(const uint color) const;
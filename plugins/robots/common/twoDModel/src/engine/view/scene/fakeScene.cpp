@@ -14,23 +14,52 @@
 
 #include "fakeScene.h"
 
+#include <QtCore/QtMath>
+
 #include "twoDModel/engine/model/worldModel.h"
 #include "src/engine/items/wallItem.h"
 #include "src/engine/items/colorFieldItem.h"
 #include "src/engine/items/imageItem.h"
+#include "src/engine/view/scene/traceLayer.h"
 
 using namespace twoDModel;
 using namespace view;
 using namespace model;
 
+/// Side of a cached raster tile in pixels.
+const int tileSize = 128;
+
+/// Maximal number of cached tiles (64 KB each), when exceeded the cache is dropped.
+const int maxTilesCount = 512;
+
+static int tileCoordinate(int pixel)
+{
+	return pixel >= 0 ? pixel / tileSize : -((-pixel - 1) / tileSize) - 1;
+}
+
+static quint64 tileKey(int x, int y)
+{
+	return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y);
+}
+
 FakeScene::FakeScene(const WorldModel &world)
+	: mTraceLayer(new TraceLayer)
 {
+	addItem(mTraceLayer);
 	connect(&world, &WorldModel::wallAdded, this, [=](items::WallItem *wall) { addClone(wall, wall->clone()); });
 	connect(&world, &WorldModel::colorItemAdded
 			, this, [=](items::ColorFieldItem *item) { addClone(item, item->clone()); });
 	connect(&world, &WorldModel::imageItemAdded, this, [=](items::ImageItem *item) { addClone(item, item->clone()); });
-	connect(&world, &WorldModel::traceItemAdded, this, [=](QGraphicsLineItem *item) {
-		addClone(item, new QGraphicsLineItem(item->line()));
+	connect(&world, &WorldModel::traceSegmentAdded, this, [=](const TraceSegment &segment) {
+		// Sensors see the trace as thin black line, as they always did.
+		mTraceLayer->append(TraceSegment{segment.line, Qt::black, 1});
+		invalidateRaster(QRectF(segment.line.p1(), segment.line.p2()).normalized());
+	});
+	connect(&world, &WorldModel::robotTraceAppearedOrDisappeared, this, [=](bool appeared) {
+		if (!appeared && !mTraceLayer->boundingRect().isNull()) {
+			invalidateRaster(mTraceLayer->boundingRect());
+			mTraceLayer->clear();
+		}
 	});
 	connect(&world, &WorldModel::itemRemoved, this, &FakeScene::deleteItem);
 	connect(&world, &WorldModel::backgroundChanged, this, &FakeScene::setBackground);
@@ -40,6 +69,7 @@ void FakeScene::addClone(QGraphicsItem * const original, QGraphicsItem * const c
 {
 	mClonedItems[original] = cloned;
 	addItem(cloned);
+	invalidateRaster(cloned->sceneBoundingRect());
 
 	// Interesting things happen here. Fake scene behaviours really strangely without this hack.
 	// Lines, ellipses and stylus is drawn correctly, but PARTIALLY until it moves the first time
@@ -55,12 +85,29 @@ void FakeScene::addClone(QGraphicsItem * const original, QGraphicsItem * const c
 		connect(orit, &graphicsUtils::AbstractItem::y1Changed, this, hack);
 		connect(orit, &graphicsUtils::AbstractItem::x2Changed, this, hack);
 		connect(orit, &graphicsUtils::AbstractItem::y2Changed, this, hack);
+
+		const auto invalidate = [=]() { invalidateRaster(); };
+		connect(orit, &graphicsUtils::AbstractItem::positionChanged, this, invalidate);
+		connect(orit, &graphicsUtils::AbstractItem::x1Changed, this, invalidate);
+		connect(orit, &graphicsUtils::AbstractItem::y1Changed, this, invalidate);
+		connect(orit, &graphicsUtils::AbstractItem::x2Changed, this, invalidate);
+		connect(orit, &graphicsUtils::AbstractItem::y2Changed, this, invalidate);
+		connect(orit, &graphicsUtils::AbstractItem::penChanged, this, invalidate);
+		connect(orit, &graphicsUtils::AbstractItem::brushChanged, this, invalidate);
+	}
+
+	// Clone shares the picture with original, but its tiles have to be drawn again.
+	if (items::ImageItem *image = dynamic_cast<items::ImageItem *>(original)) {
+		connect(image, &items::ImageItem::internalImageChanged, this, [=]() {
+			invalidateRaster(cloned->sceneBoundingRect());
+		});
 	}
 }
 
 void FakeScene::deleteItem(QGraphicsItem * const original)
 {
 	if (mClonedItems.contains(original)) {
+		invalidateRaster(mClonedItems[original]->sceneBoundingRect());
 		delete mClonedItems[original];
 		mClonedItems.remove(original);
 	}
@@ -84,6 +131,100 @@ QImage view::FakeScene::render(const QRectF &piece)
 	return result;
 }
 
+QImage FakeScene::sample(const QPointF &center, qreal angle, const QSize &size)
+{
+	QImage result(size, QImage::Format_RGB32);
+	if (result.isNull()) {
+		return result;
+	}
+
+	const QTransform rotation = QTransform().rotate(angle);
+	const QPointF columnStep = rotation.map(QPointF(1, 0));
+	const QPointF rowStep = rotation.map(QPointF(0, 1));
+	const QPointF origin = center
+			- columnStep * ((size.width() - 1) / 2.0)
+			- rowStep * ((size.height() - 1) / 2.0);
+
+	QMutexLocker locker(&mRasterMutex);
+
+	// Neighbouring pixels almost always belong to the same tile, so the last one is remembered.
+	const QImage *currentTile = nullptr;
+	int currentTileX = 0;
+	int currentTileY = 0;
+	for (int row = 0; row < size.height(); ++row) {
+		QRgb * const line = reinterpret_cast<QRgb *>(result.scanLine(row));
+		QPointF point = origin + rowStep * row;
+		for (int column = 0; column < size.width(); ++column, point += columnStep) {
+			const int x = qFloor(point.x());
+			const int y = qFloor(point.y());
+			const int tileX = tileCoordinate(x);
+			const int tileY = tileCoordinate(y);
+			if (!currentTile || tileX != currentTileX || tileY != currentTileY) {
+				currentTile = &tile(tileX, tileY);
+				currentTileX = tileX;
+				currentTileY = tileY;
+			}
+
+			line[column] = reinterpret_cast<const QRgb *>(currentTile->constScanLine(y - tileY * tileSize))
+					[x - tileX * tileSize];
+		}
+	}
+
+	return result;
+}
+
+const QImage &FakeScene::tile(int x, int y)
+{
+	const quint64 key = tileKey(x, y);
+	const auto cached = mTiles.constFind(key);
+	if (cached != mTiles.constEnd()) {
+		return cached.value();
+	}
+
+	if (mTiles.size() >= maxTilesCount) {
+		mTiles.clear();
+	}
+
+	return mTiles.insert(key, render(QRectF(x * tileSize, y * tileSize, tileSize, tileSize))).value();
+}
+
+void FakeScene::invalidateRaster()
+{
+	QMutexLocker locker(&mRasterMutex);
+	mTiles.clear();
+}
+
+void FakeScene::invalidateRaster(const QRectF &rect)
+{
+	// Antialiased edges may go a bit out of item bounding rect.
+	const QRect area = rect.toAlignedRect().adjusted(-1, -1, 1, 1);
+	const int left = tileCoordinate(area.left());
+	const int right = tileCoordinate(area.right());
+	const int top = tileCoordinate(area.top());
+	const int bottom = tileCoordinate(area.bottom());
+
+	QMutexLocker locker(&mRasterMutex);
+	if (static_cast<qint64>(right - left + 1) * (bottom - top + 1) > mTiles.size()) {
+		for (auto it = mTiles.begin(); it != mTiles.end();) {
+			const int x = static_cast<int>(static_cast<quint32>(it.key() >> 32));
+			const int y = static_cast<int>(static_cast<quint32>(it.key()));
+			if (x >= left && x <= right && y >= top && y <= bottom) {
+				it = mTiles.erase(it);
+			} else {
+				++it;
+			}
+		}
+
+		return;
+	}
+
+	for (int x = left; x <= right; ++x) {
+		for (int y = top; y <= bottom; ++y) {
+			mTiles.remove(tileKey(x, y));
+		}
+	}
+}
+
 void FakeScene::setBackground(Image * const background, const QRect &backgroundRect)
 {
 	if ((background && mBackground && *background != *mBackground)
@@ -92,6 +233,7 @@ void FakeScene::setBackground(Image * const background, const QRect &backgroundR
 			|| backgroundRect != mBackgroundRect) {
 		mBackground = background;
 		mBackgroundRect = backgroundRect;
+		invalidateRaster();
 		update();
 	}
 }
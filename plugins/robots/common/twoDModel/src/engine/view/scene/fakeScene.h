@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <QtCore/QHash>
 #include <QtCore/QMap>
+#include <QtCore/QMutex>
 #include <QtWidgets/QGraphicsScene>
 
 #include "twoDModel/engine/model/image.h"
@@ -27,7 +29,11 @@ class WorldModel;
 
 namespace view {
 
+class TraceLayer;
+
 /// A scene that maintains a copy of the visible world for rendering some pieces of that (for sensors, for example).
+/// Rendered world is cached in square tiles that are rendered on first access and dropped when items under them
+/// change, so sensors read pixels from memory instead of rendering the scene on each reading.
 class FakeScene : public QGraphicsScene
 {
 	Q_OBJECT
@@ -38,6 +44,11 @@ public:
 	/// Renders a given piece of the scene and returns resulting image.
 	QImage render(const QRectF &piece);
 
+	/// Returns the image of an oriented rectangle of the scene taken from cached raster of the world.
+	/// Pixels of the result are rotated by @a angle degrees clockwise around @a center that is mapped
+	/// to the center of the result.
+	QImage sample(const QPointF &center, qreal angle, const QSize &size);
+
 public slots:
 	/// Sets a background image on the scene and its geometry.
 	void setBackground(model::Image * const background, const QRect &backgroundRect);
@@ -47,9 +58,24 @@ private:
 	void deleteItem(QGraphicsItem * const original);
 	void drawBackground(QPainter *painter, const QRectF &rect) override;
 
+	/// Returns cached raster of the tile with the given coordinates, rendering it if needed.
+	/// Shall be called with mRasterMutex locked.
+	const QImage &tile(int x, int y);
+
+	/// Drops all cached tiles.
+	void invalidateRaster();
+
+	/// Drops cached tiles under the given scene rect.
+	void invalidateRaster(const QRectF &rect);
+
 	QMap<QGraphicsItem *, QGraphicsItem *> mClonedItems;
 	model::Image * mBackground = nullptr; // doesn't have the ownership
+	TraceLayer *mTraceLayer;  // Takes ownership via scene.
 	QRect mBackgroundRect;
+
+	/// Cached tiles of the world raster, by tile coordinates packed in one number.
+	QHash<quint64, QImage> mTiles;
+	QMutex mRasterMutex;
 };
 
 }
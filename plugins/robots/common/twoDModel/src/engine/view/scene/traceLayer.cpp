@@ -0,0 +1,148 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include "traceLayer.h"
+
+#include <QtCore/QtMath>
+#include <QtGui/QPainter>
+#include <QtWidgets/QStyleOptionGraphicsItem>
+
+using namespace twoDModel::view;
+
+/// Side of a trace raster tile in pixels.
+const int tileSize = 256;
+
+/// Trace is shown above color fields and images but below walls, robots and other solid items.
+const qreal traceZValue = 0.5;
+
+static int tileCoordinate(int pixel)
+{
+	return pixel >= 0 ? pixel / tileSize : -((-pixel - 1) / tileSize) - 1;
+}
+
+static quint64 tileKey(int x, int y)
+{
+	return (static_cast<quint64>(static_cast<quint32>(x)) << 32) | static_cast<quint32>(y);
+}
+
+/// Returns true if some part of the given line lies inside of the given rectangle.
+static bool crosses(const QLineF &line, const QRectF &rect)
+{
+	if (rect.contains(line.p1()) || rect.contains(line.p2())) {
+		return true;
+	}
+
+	const QLineF edges[] = {
+		QLineF(rect.topLeft(), rect.topRight())
+		, QLineF(rect.topRight(), rect.bottomRight())
+		, QLineF(rect.bottomRight(), rect.bottomLeft())
+		, QLineF(rect.bottomLeft(), rect.topLeft())
+	};
+
+	for (const QLineF &edge : edges) {
+		if (line.intersect(edge, nullptr) == QLineF::BoundedIntersection) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+TraceLayer::TraceLayer()
+{
+	setZValue(traceZValue);
+	setAcceptedMouseButtons(Qt::NoButton);
+	setFlag(ItemUsesExtendedStyleOption);
+}
+
+QRectF TraceLayer::boundingRect() const
+{
+	return mBoundingRect;
+}
+
+void TraceLayer::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+	Q_UNUSED(widget)
+
+	const QRect exposed = option->exposedRect.toAlignedRect();
+	const int left = tileCoordinate(exposed.left());
+	const int right = tileCoordinate(exposed.right());
+	const int top = tileCoordinate(exposed.top());
+	const int bottom = tileCoordinate(exposed.bottom());
+
+	painter->save();
+	painter->setRenderHint(QPainter::SmoothPixmapTransform);
+	for (auto it = mTiles.constBegin(); it != mTiles.constEnd(); ++it) {
+		const int x = static_cast<int>(static_cast<quint32>(it.key() >> 32));
+		const int y = static_cast<int>(static_cast<quint32>(it.key()));
+		if (x >= left && x <= right && y >= top && y <= bottom) {
+			painter->drawImage(QPoint(x * tileSize, y * tileSize), it.value());
+		}
+	}
+
+	painter->restore();
+}
+
+void TraceLayer::append(const model::TraceSegment &segment)
+{
+	// Antialiased and square-capped ends may go out of the line bounding rect up to the half of pen width.
+	const qreal margin = segment.width / 2.0 + 1;
+	const QRectF segmentRect = QRectF(segment.line.p1(), segment.line.p2()).normalized()
+			.adjusted(-margin, -margin, margin, margin);
+	const QRect area = segmentRect.toAlignedRect();
+
+	const QPen pen(segment.color, segment.width);
+	for (int x = tileCoordinate(area.left()); x <= tileCoordinate(area.right()); ++x) {
+		for (int y = tileCoordinate(area.top()); y <= tileCoordinate(area.bottom()); ++y) {
+			const QRectF tileRect(x * tileSize, y * tileSize, tileSize, tileSize);
+			if (!crosses(segment.line, tileRect.adjusted(-margin, -margin, margin, margin))) {
+				continue;
+			}
+
+			QPainter painter(&tile(x, y));
+			painter.setRenderHint(QPainter::Antialiasing);
+			painter.translate(-tileRect.topLeft());
+			painter.setPen(pen);
+			painter.drawLine(segment.line);
+		}
+	}
+
+	if (!mBoundingRect.contains(segmentRect)) {
+		prepareGeometryChange();
+		mBoundingRect |= segmentRect;
+	}
+
+	update(segmentRect);
+}
+
+void TraceLayer::clear()
+{
+	prepareGeometryChange();
+	mTiles.clear();
+	mBoundingRect = QRectF();
+}
+
+QImage &TraceLayer::tile(int x, int y)
+{
+	const quint64 key = tileKey(x, y);
+	auto existing = mTiles.find(key);
+	if (existing != mTiles.end()) {
+		return existing.value();
+	}
+
+	QImage result(tileSize, tileSize, QImage::Format_ARGB32_Premultiplied);
+	result.fill(Qt::transparent);
+	return mTiles.insert(key, result).value();
+}
@@ -0,0 +1,54 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtGui/QImage>
+#include <QtWidgets/QGraphicsItem>
+
+#include "twoDModel/engine/model/worldModel.h"
+
+namespace twoDModel {
+namespace view {
+
+/// A single scene item that shows the whole robot trace. Segments are drawn into raster tiles once when appended,
+/// so the scene does not grow with the length of the trace and repainting costs the same for any number of segments.
+/// Tiles are created only under the segments, so memory is bounded by the area covered by the trace.
+class TraceLayer : public QGraphicsItem
+{
+public:
+	TraceLayer();
+
+	QRectF boundingRect() const override;
+	void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+	/// Draws one more segment over the trace.
+	void append(const model::TraceSegment &segment);
+
+	/// Removes the whole trace.
+	void clear();
+
+private:
+	/// Returns the tile with the given coordinates, creating transparent one if needed.
+	QImage &tile(int x, int y);
+
+	/// Tiles with the drawn trace, by tile coordinates packed in one number.
+	QHash<quint64, QImage> mTiles;
+	QRectF mBoundingRect;
+};
+
+}
+}
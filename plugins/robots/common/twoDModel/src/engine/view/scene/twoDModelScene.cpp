@@ -38,6 +38,7 @@
 #include "twoDModel/engine/model/image.h"
 #include "src/engine/view/scene/sensorItem.h"
 #include "src/engine/view/scene/sonarSensorItem.h"
+#include "src/engine/view/scene/traceLayer.h"
 #include "src/engine/items/wallItem.h"
 #include "src/engine/items/skittleItem.h"
 #include "src/engine/items/ballItem.h"
@@ -65,6 +66,7 @@ TwoDModelScene::TwoDModelScene(model::Model &model
 	: AbstractScene(view, parent)
 	, mModel(model)
 	, mDrawingAction(none)
+	, mTraceLayer(new TraceLayer)
 {
 	mFirstPenWidth = 6;
 	mSizeEmptyRectX = 1000;
@@ -72,6 +74,7 @@ TwoDModelScene::TwoDModelScene(model::Model &model
 	setEmptyRect(-500, -500, mSizeEmptyRectX, mSizeEmptyRectY);
 	setItemIndexMethod(NoIndex);
 	setEmptyPenBrushItems();
+	addItem(mTraceLayer);
 
 	connect(&mModel.worldModel(), &model::WorldModel::wallAdded, this, &TwoDModelScene::onWallAdded);
 	connect(&mModel.worldModel(), &model::WorldModel::skittleAdded, this, &TwoDModelScene::onSkittleAdded);
@@ -80,8 +83,14 @@ TwoDModelScene::TwoDModelScene(model::Model &model
 	connect(&mModel.worldModel(), &model::WorldModel::imageItemAdded, this, &TwoDModelScene::onImageItemAdded);
 	connect(&mModel.worldModel(), &model::WorldModel::regionItemAdded
 			, this, [=](items::RegionItem *item) { addItem(item); });
-	connect(&mModel.worldModel(), &model::WorldModel::traceItemAdded
-			, this, [=](QGraphicsLineItem *item) { addItem(item); });
+	connect(&mModel.worldModel(), &model::WorldModel::traceSegmentAdded, this, [=](const model::TraceSegment &segment) {
+		mTraceLayer->append(segment);
+	});
+	connect(&mModel.worldModel(), &model::WorldModel::robotTraceAppearedOrDisappeared, this, [=](bool appeared) {
+		if (!appeared) {
+			mTraceLayer->clear();
+		}
+	});
 	connect(&mModel.worldModel(), &model::WorldModel::itemRemoved, this, &TwoDModelScene::onItemRemoved);
 
 	connect(&mModel.worldModel(), &model::WorldModel::backgroundImageItemAdded
@@ -61,6 +61,7 @@ class ReshapeCommand;
 
 namespace view {
 class RobotItem;
+class TraceLayer;
 
 /// Implementation of QGraphicsScene for 2D robot model
 class TwoDModelScene: public graphicsUtils::AbstractScene, public kitBase::DevicesConfigurationProvider
@@ -242,6 +243,9 @@ private:
 
 	QMap<model::RobotModel *, RobotItem *> mRobots;
 
+	/// Raster of the robot trace, owned by the scene.
+	TraceLayer *mTraceLayer;
+
 	/// Temporary wall that's being created. When it's complete, it's added to world model
 	items::WallItem *mCurrentWall = nullptr;
 	items::SkittleItem *mCurrentSkittle = nullptr;
@@ -34,6 +34,7 @@ HEADERS += \
 	$$PWD/include/twoDModel/engine/twoDModelEngineFacade.h \
 	$$PWD/include/twoDModel/engine/twoDModelEngineInterface.h \
 	$$PWD/include/twoDModel/engine/twoDModelGuiFacade.h \
+	$$PWD/include/twoDModel/engine/sensorImageKernels.h \
 	$$PWD/include/twoDModel/engine/view/twoDModelWidget.h \
 	$$PWD/include/twoDModel/engine/model/constants.h \
 	$$PWD/include/twoDModel/engine/model/model.h \
@@ -70,6 +71,7 @@ HEADERS += \
 	$$PWD/src/engine/view/scene/robotItem.h \
 	$$PWD/src/engine/view/scene/sensorItem.h \
 	$$PWD/src/engine/view/scene/sonarSensorItem.h \
+	$$PWD/src/engine/view/scene/traceLayer.h \
 	$$PWD/src/engine/view/parts/palette.h \
 	$$PWD/src/engine/view/parts/actionsBox.h \
 	$$PWD/src/engine/view/parts/gridParameters.h \
@@ -87,6 +89,7 @@ HEADERS += \
 	$$PWD/src/engine/constraints/details/triggersFactory.h \
 	$$PWD/src/engine/constraints/details/valuesFactory.h \
 	$$PWD/src/engine/model/modelTimer.h \
+	$$PWD/src/engine/model/solidGeometry.h \
 	$$PWD/src/engine/model/physics/physicsEngineBase.h \
 	$$PWD/src/engine/model/physics/simplePhysicsEngine.h \
 	$$PWD/src/engine/model/physics/parts/box2DRobot.h \
@@ -123,6 +126,7 @@ HEADERS += \
 SOURCES += \
 	$$PWD/src/engine/twoDModelEngineFacade.cpp \
 	$$PWD/src/engine/twoDModelEngineApi.cpp \
+	$$PWD/src/engine/sensorImageKernels.cpp \
 	$$PWD/src/engine/twoDModelGuiFacade.cpp \
 	$$PWD/src/engine/view/twoDModelWidget.cpp \
 	$$PWD/src/engine/view/twoDModelDisplayWidget.cpp \
@@ -132,6 +136,7 @@ SOURCES += \
 	$$PWD/src/engine/view/scene/robotItem.cpp \
 	$$PWD/src/engine/view/scene/sensorItem.cpp \
 	$$PWD/src/engine/view/scene/sonarSensorItem.cpp \
+	$$PWD/src/engine/view/scene/traceLayer.cpp \
 	$$PWD/src/engine/view/parts/palette.cpp \
 	$$PWD/src/engine/view/parts/actionsBox.cpp \
 	$$PWD/src/engine/view/parts/gridParameters.cpp \
@@ -145,6 +150,7 @@ SOURCES += \
 	$$PWD/src/engine/model/settings.cpp \
 	$$PWD/src/engine/model/robotModel.cpp \
 	$$PWD/src/engine/model/modelTimer.cpp \
+	$$PWD/src/engine/model/solidGeometry.cpp \
 	$$PWD/src/engine/model/sensorsConfiguration.cpp \
 	$$PWD/src/engine/model/worldModel.cpp \
 	$$PWD/src/engine/model/timeline.cpp \
@@ -36,6 +36,7 @@ HEADERS += \
 	$$PWD/include/generatorBase/controlFlowGeneratorBase.h \
 	$$PWD/include/generatorBase/generatorFactoryBase.h \
 	$$PWD/include/generatorBase/templateParametrizedEntity.h \
+	$$PWD/include/generatorBase/precompiledTemplate.h \
 	$$PWD/include/generatorBase/robotsDiagramVisitor.h \
 	$$PWD/include/generatorBase/primaryControlFlowValidator.h \
 	$$PWD/include/generatorBase/semanticTree/semanticTree.h \
@@ -67,6 +68,7 @@ HEADERS += \
 	$$PWD/src/converters/dynamicPropertiesConverter.h \
 	$$PWD/src/structuralControlFlowGenerator.h \
 	$$PWD/src/structurizator.h \
+	$$PWD/src/templateCache.h \
 
 HEADERS += \
 	$$PWD/src/structurizatorNodes/intermediateStructurizatorNode.h \
@@ -89,6 +91,8 @@ SOURCES += \
 	$$PWD/src/primaryControlFlowValidator.cpp \
 	$$PWD/src/generatorFactoryBase.cpp \
 	$$PWD/src/templateParametrizedEntity.cpp \
+	$$PWD/src/precompiledTemplate.cpp \
+	$$PWD/src/templateCache.cpp \
 	$$PWD/src/parts/variables.cpp \
 	$$PWD/src/parts/subprograms.cpp \
 	$$PWD/src/parts/threads.cpp \
@@ -0,0 +1,67 @@
+/* Copyright 2007-2015 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "robotsGeneratorDeclSpec.h"
+
+namespace generatorBase {
+
+/// Generator template split into literal text and @@LABEL@@ placeholders once, so all the placeholders
+/// are substituted in a single pass instead of a QString::replace() call for each of them.
+/// Unlike a chain of replace() calls, substituted values are never scanned for placeholders again.
+/// Copies are cheap, text and segments are implicitly shared.
+class ROBOTS_GENERATOR_EXPORT PrecompiledTemplate
+{
+public:
+	/// Creates empty template.
+	PrecompiledTemplate();
+
+	/// Splits the given template text. Placeholders are labels of the form @@NAME@@ where NAME consists of
+	/// latin letters, digits and underscores.
+	explicit PrecompiledTemplate(const QString &text);
+
+	/// Returns the text of a template as it was given.
+	QString text() const;
+
+	/// Returns labels of all placeholders in order of their first occurrence, with @@ around them.
+	QStringList labels() const;
+
+	/// Returns true if the template contains the given label (with @@ around it).
+	bool contains(const QString &label) const;
+
+	/// Returns the text of a template with placeholders replaced by values of @a values for their labels
+	/// (with @@ around them). Placeholders without values are left as they are.
+	QString substitute(const QHash<QString, QString> &values) const;
+
+private:
+	struct Segment
+	{
+		int start;
+		int length;
+
+		/// Label with @@ around it for placeholders, null for literal text.
+		QString label;
+	};
+
+	QString mText;
+	QVector<Segment> mSegments;
+};
+
+}
@@ -43,6 +43,19 @@ public:
 
 	QString friendlyKitName() const override;
 
+	/// Returns an identifier of the generator, like "trikQts" or "ev3/rbf".
+	virtual QString generatorName() const;
+
+	/// Generates code for the active diagram into the given file without opening it in the text editor.
+	/// Used by console tools which generate code for several targets from one loaded model.
+	/// @returns Path to the generated file or empty string if generation failed.
+	QString generateCodeTo(const QFileInfo &target);
+
+	/// Generates code for the active diagram into the given folder without opening it in the text editor.
+	/// Generated file is named after the opened save file in the same way as when generating from GUI.
+	/// @returns Path to the generated file or empty string if generation failed.
+	QString generateCodeToFolder(const QString &folder);
+
 protected slots:
 	/// Calls code generator. Returns true if operation was successful.
 	/// @param openTab If true after code generation a tab with generated code will be opened.
@@ -74,8 +87,6 @@ protected:
 
 	QFileInfo generateCodeForProcessing();
 
-	virtual QString generatorName() const;
-
 	/// Returns an information about the language code on which will be generated;
 	/// this information will be used by text editors when user will be edit the generated code.
 	virtual qReal::text::LanguageInfo language() const = 0;
@@ -83,6 +94,9 @@ protected:
 	/// Returns default name for generated file.
 	virtual QString defaultProjectName() const;
 
+	/// Returns default project name turned into an identifier, generated files are named by it.
+	QString normalizedProjectName() const;
+
 	virtual bool canGenerateTo(const QString &project);
 
 	/// Can be overrided to show or hide concrete actions on toolbars.
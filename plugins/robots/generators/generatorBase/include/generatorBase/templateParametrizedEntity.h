@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <QtCore/QHash>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 
@@ -21,6 +22,8 @@
 
 namespace generatorBase {
 
+class PrecompiledTemplate;
+
 /// This class can be inherited by those entities who need to use generator templates
 class ROBOTS_GENERATOR_EXPORT TemplateParametrizedEntity
 {
@@ -40,6 +43,13 @@ protected:
 	/// @param pathFromRoot A path to a concrete template relatively to specified in constructor folder.
 	QString readTemplate(const QString &pathFromRoot) const;
 
+	/// Reads the given template and replaces its @@LABEL@@ placeholders by values of @a values for their labels
+	/// in a single pass, faster than a chain of QString::replace() calls. Values are not scanned for placeholders.
+	/// Templates are read from disk only once, see TemplateCache.
+	/// @param pathFromRoot A path to a concrete template relatively to specified in constructor folder.
+	/// @param values Maps labels with @@ around them (like "@@VALUE@@") to substituted strings.
+	QString readTemplate(const QString &pathFromRoot, const QHash<QString, QString> &values) const;
+
 	/// Reads the given file contents if such exists or returns @arg fallback string otherwise.
 	/// Same as readTemplate() but does not display 'file not found' messages in debug output.
 	/// A path to file must be relative to templates folder root.
@@ -54,6 +64,9 @@ protected:
 	QString addRandomIds(QString templateString) const;
 
 private:
+	/// Substitutes @a values and fresh random ids into the given template.
+	QString instantiate(const PrecompiledTemplate &precompiledTemplate, QHash<QString, QString> values) const;
+
 	QStringList mPathsToRoot;
 };
 
@@ -149,29 +149,30 @@ void LuaPrinter::processTemplate(const QSharedPointer<qrtext::lua::ast::Node> &n
 		, const QString &templateFileName
 		, QMap<QString, QSharedPointer<qrtext::lua::ast::Node>> const &bindings)
 {
-	QString result = readTemplate(templateFileName);
+	QHash<QString, QString> values;
 	for (const QString &toReplace : bindings.keys()) {
-		result.replace(toReplace, popResult(bindings[toReplace]));
+		values[toReplace] = popResult(bindings[toReplace]);
 	}
 
-	pushResult(node, result);
+	pushResult(node, readTemplate(templateFileName, values));
 }
 
 void LuaPrinter::processUnary(const QSharedPointer<qrtext::core::ast::UnaryOperator> &node
 		, const QString &templateFileName)
 {
-	pushResult(node, readTemplate(templateFileName)
-			.replace("@@OPERAND@@", popResult(node->operand(), needBrackets(node, node->operand()))));
+	pushResult(node, readTemplate(templateFileName
+			, {{"@@OPERAND@@", popResult(node->operand(), needBrackets(node, node->operand()))}}));
 }
 
 void LuaPrinter::processBinary(const QSharedPointer<qrtext::core::ast::BinaryOperator> &node
 		, const QString &templateFileName)
 {
-	pushResult(node, readTemplate(templateFileName)
-			.replace("@@LEFT@@", popResult(node->leftOperand(), needBrackets(node
-					, node->leftOperand(), qrtext::core::Associativity::left)))
-			.replace("@@RIGHT@@", popResult(node->rightOperand(), needBrackets(node
-					, node->rightOperand(), qrtext::core::Associativity::right))));
+	pushResult(node, readTemplate(templateFileName, {
+			{"@@LEFT@@", popResult(node->leftOperand(), needBrackets(node
+					, node->leftOperand(), qrtext::core::Associativity::left))}
+			, {"@@RIGHT@@", popResult(node->rightOperand(), needBrackets(node
+					, node->rightOperand(), qrtext::core::Associativity::right))}
+			}));
 }
 
 bool LuaPrinter::needBrackets(const QSharedPointer<qrtext::lua::ast::Node> &parent
@@ -301,9 +302,10 @@ void LuaPrinter::visit(const QSharedPointer<qrtext::lua::ast::BitwiseRightShift>
 void LuaPrinter::visit(const QSharedPointer<qrtext::lua::ast::Concatenation> &node
 		, const QSharedPointer<qrtext::core::ast::Node> &)
 {
-	pushResult(node, readTemplate("concatenation.t")
-			.replace("@@LEFT@@", toString(node->leftOperand()))
-			.replace("@@RIGHT@@", toString(node->rightOperand())));
+	pushResult(node, readTemplate("concatenation.t", {
+			{"@@LEFT@@", toString(node->leftOperand())}
+			, {"@@RIGHT@@", toString(node->rightOperand())}
+			}));
 }
 
 void LuaPrinter::visit(const QSharedPointer<qrtext::lua::ast::Equality> &node
@@ -367,16 +369,17 @@ void LuaPrinter::visit(const QSharedPointer<qrtext::lua::ast::TableConstructor>
 		, const QSharedPointer<qrtext::core::ast::Node> &)
 {
 	const QStringList initializers = popResults(qrtext::as<qrtext::lua::ast::Node>(node->initializers()));
-	pushResult(node, readTemplate("tableConstructor.t")
-			.replace("@@COUNT@@", QString::number(initializers.count()))
-			.replace("@@INITIALIZERS@@", initializers.join(readTemplate("fieldInitializersSeparator.t"))));
+	pushResult(node, readTemplate("tableConstructor.t", {
+			{"@@COUNT@@", QString::number(initializers.count())}
+			, {"@@INITIALIZERS@@", initializers.join(readTemplate("fieldInitializersSeparator.t"))}
+			}));
 }
 
 void LuaPrinter::visit(const QSharedPointer<qrtext::lua::ast::String> &node
 		, const QSharedPointer<qrtext::core::ast::Node> &)
 {
 	auto escapedString = qrtext::lua::LuaStringEscapeUtils::escape(node->string());
-	pushResult(node, readTemplate("string.t").replace("@@VALUE@@", escapedString));
+	pushResult(node, readTemplate("string.t", {{"@@VALUE@@", escapedString}}));
 }
 
 void LuaPrinter::visit(const QSharedPointer<qrtext::lua::ast::True> &node
@@ -416,9 +419,10 @@ void LuaPrinter::visit(const QSharedPointer<qrtext::lua::ast::FunctionCall> &nod
 			: QString();
 
 	if (reservedFunctionCall.isEmpty()) {
-		pushResult(node, readTemplate("functionCall.t")
-				.replace("@@FUNCTION@@", expression)
-				.replace("@@ARGUMENTS@@", arguments.join(readTemplate("argumentsSeparator.t"))));
+		pushResult(node, readTemplate("functionCall.t", {
+				{"@@FUNCTION@@", expression}
+				, {"@@ARGUMENTS@@", arguments.join(readTemplate("argumentsSeparator.t"))}
+				}));
 	} else {
 		pushResult(node, reservedFunctionCall);
 	}
@@ -430,10 +434,11 @@ void LuaPrinter::visit(const QSharedPointer<qrtext::lua::ast::MethodCall> &node
 	const QString object = popResult(node->object());
 	const QString method = popResult(node->methodName());
 	const QStringList arguments = popResults(qrtext::as<qrtext::lua::ast::Node>(node->arguments()));
-	pushResult(node, readTemplate("methodCall.t")
-			.replace("@@OBJECT@@", object)
-			.replace("@@METHOD@@", method)
-			.replace("@@ARGUMENTS@@", arguments.join(readTemplate("argumentsSeparator.t"))));
+	pushResult(node, readTemplate("methodCall.t", {
+			{"@@OBJECT@@", object}
+			, {"@@METHOD@@", method}
+			, {"@@ARGUMENTS@@", arguments.join(readTemplate("argumentsSeparator.t"))}
+			}));
 }
 
 void LuaPrinter::visit(const QSharedPointer<qrtext::lua::ast::Assignment> &node
@@ -480,9 +485,8 @@ QString LuaPrinter::to(const QSharedPointer<qrtext::core::types::TypeExpression>
 		return value;
 	}
 
-	QString castTemplate = readTemplate("../types/cast.t");
 	const QString typeName = readTemplate(QString("../types/%1.t").arg(templateName));
-	return castTemplate.replace("@@TYPE@@", typeName).replace("@@EXPRESSION@@", value);
+	return readTemplate("../types/cast.t", {{"@@TYPE@@", typeName}, {"@@EXPRESSION@@", value}});
 }
 
 QString LuaPrinter::toString(const QSharedPointer<qrtext::lua::ast::Node> &node)
@@ -494,16 +498,16 @@ QString LuaPrinter::toString(const QSharedPointer<qrtext::lua::ast::Node> &node)
 	}
 
 	if (type->is<qrtext::lua::types::Integer>()) {
-		return readTemplate("intToString.t").replace("@@VALUE@@", value);
+		return readTemplate("intToString.t", {{"@@VALUE@@", value}});
 	}
 
 	if (type->is<qrtext::lua::types::Float>()) {
-		return readTemplate("floatToString.t").replace("@@VALUE@@", value);
+		return readTemplate("floatToString.t", {{"@@VALUE@@", value}});
 	}
 
 	if (type->is<qrtext::lua::types::Integer>()) {
-		return readTemplate("boolToString.t").replace("@@VALUE@@", value);
+		return readTemplate("boolToString.t", {{"@@VALUE@@", value}});
 	}
 
-	return readTemplate("otherToString.t").replace("@@VALUE@@", value);
+	return readTemplate("otherToString.t", {{"@@VALUE@@", value}});
 }
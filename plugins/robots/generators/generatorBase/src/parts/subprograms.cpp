@@ -74,6 +74,9 @@ Subprograms::GenerationResult Subprograms::generate(ControlFlowGeneratorBase *ma
 	QMap<Id, QString> declarations;
 	QMap<Id, QString> implementations;
 
+	/// @todo: Subprograms are generated one by one. Generating them concurrently needs a generator factory and
+	/// a Lua toolbox per task: now all tasks share variables, threads and subprograms parts of the factory and
+	/// types of variables are inferred by one toolbox for the whole program.
 	Id toGen = firstToGenerate();
 	while (toGen != Id()) {
 		mDiscoveredSubprograms[toGen] = true;
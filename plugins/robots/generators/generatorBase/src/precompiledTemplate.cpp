@@ -0,0 +1,115 @@
+/* Copyright 2007-2015 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "generatorBase/precompiledTemplate.h"
+
+using namespace generatorBase;
+
+const QString placeholderDelimiter = "@@";
+
+static bool isLabelCharacter(const QChar &character)
+{
+	const ushort code = character.unicode();
+	return (code >= 'A' && code <= 'Z') || (code >= 'a' && code <= 'z') || (code >= '0' && code <= '9')
+			|| code == '_';
+}
+
+PrecompiledTemplate::PrecompiledTemplate()
+{
+}
+
+PrecompiledTemplate::PrecompiledTemplate(const QString &text)
+	: mText(text)
+{
+	const int delimiterLength = placeholderDelimiter.length();
+	int literalStart = 0;
+	int position = mText.indexOf(placeholderDelimiter);
+	while (position != -1) {
+		const int nameStart = position + delimiterLength;
+		int nameEnd = nameStart;
+		while (nameEnd < mText.length() && isLabelCharacter(mText[nameEnd])) {
+			++nameEnd;
+		}
+
+		if (nameEnd == nameStart || !mText.midRef(nameEnd).startsWith(placeholderDelimiter)) {
+			// Not a placeholder, "@@" may still start one if it is followed by one more "@".
+			position = mText.indexOf(placeholderDelimiter, position + 1);
+			continue;
+		}
+
+		if (position > literalStart) {
+			mSegments << Segment{literalStart, position - literalStart, QString()};
+		}
+
+		const int end = nameEnd + delimiterLength;
+		mSegments << Segment{position, end - position, mText.mid(position, end - position)};
+		literalStart = end;
+		position = mText.indexOf(placeholderDelimiter, end);
+	}
+
+	if (literalStart < mText.length()) {
+		mSegments << Segment{literalStart, mText.length() - literalStart, QString()};
+	}
+}
+
+QString PrecompiledTemplate::text() const
+{
+	return mText;
+}
+
+QStringList PrecompiledTemplate::labels() const
+{
+	QStringList result;
+	for (const Segment &segment : mSegments) {
+		if (!segment.label.isNull() && !result.contains(segment.label)) {
+			result << segment.label;
+		}
+	}
+
+	return result;
+}
+
+bool PrecompiledTemplate::contains(const QString &label) const
+{
+	for (const Segment &segment : mSegments) {
+		if (segment.label == label) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+QString PrecompiledTemplate::substitute(const QHash<QString, QString> &values) const
+{
+	if (values.isEmpty()) {
+		return mText;
+	}
+
+	QString result;
+	result.reserve(mText.length());
+	for (const Segment &segment : mSegments) {
+		if (!segment.label.isNull()) {
+			const auto value = values.constFind(segment.label);
+			if (value != values.constEnd()) {
+				result += value.value();
+				continue;
+			}
+		}
+
+		result += mText.midRef(segment.start, segment.length);
+	}
+
+	return result;
+}
@@ -15,6 +15,8 @@
 #include "generatorBase/robotsGeneratorPluginBase.h"
 
 #include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QScopedPointer>
 
 #include <qrkernel/platformInfo.h>
 #include <qrutils/inFile.h>
@@ -54,6 +56,11 @@ QString RobotsGeneratorPluginBase::defaultProjectName() const
 	return filePath.isEmpty() ? "example" : QFileInfo(filePath).completeBaseName();
 }
 
+QString RobotsGeneratorPluginBase::normalizedProjectName() const
+{
+	return NameNormalizer::normalizeStrongly(defaultProjectName(), false);
+}
+
 bool RobotsGeneratorPluginBase::canGenerateTo(const QString &project)
 {
 	const QFileInfo fileInfo = generationTarget(project);
@@ -100,7 +107,7 @@ QFileInfo RobotsGeneratorPluginBase::srcPath()
 	QString projectName;
 
 	do {
-		projectName = NameNormalizer::normalizeStrongly(defaultProjectName(), false)
+		projectName = normalizedProjectName()
 				+ (exampleNumber > 0 ? QString::number(exampleNumber) : "");
 		++exampleNumber;
 	} while (!canGenerateTo(projectName));
@@ -187,16 +194,10 @@ bool RobotsGeneratorPluginBase::generateCode(bool openTab)
 	mMainWindowInterface->errorReporter()->clearErrors();
 	mMainWindowInterface->errorReporter()->clear();
 
-	MasterGeneratorBase * const generator = masterGenerator();
 	const QFileInfo path = srcPath();
-
-	generator->initialize();
-	generator->setProjectDir(path);
-
-	const QString generatedSrcPath = generator->generate(language().indent());
+	const QString generatedSrcPath = generateCodeTo(path);
 
 	if (mMainWindowInterface->errorReporter()->wereErrors()) {
-		delete generator;
 		return false;
 	}
 
@@ -211,10 +212,23 @@ bool RobotsGeneratorPluginBase::generateCode(bool openTab)
 		mMainWindowInterface->activateItemOrDiagram(activeDiagram);
 	}
 
-	delete generator;
 	return true;
 }
 
+QString RobotsGeneratorPluginBase::generateCodeTo(const QFileInfo &target)
+{
+	QScopedPointer<MasterGeneratorBase> generator(masterGenerator());
+	generator->initialize();
+	generator->setProjectDir(target);
+	return generator->generate(language().indent());
+}
+
+QString RobotsGeneratorPluginBase::generateCodeToFolder(const QString &folder)
+{
+	const QString fileName = normalizedProjectName() + "." + language().extension;
+	return generateCodeTo(QFileInfo(QDir(folder).absoluteFilePath(fileName)));
+}
+
 void RobotsGeneratorPluginBase::regenerateCode(const qReal::Id &diagram
 		, const QFileInfo &oldFileInfo
 		, const QFileInfo &newFileInfo)
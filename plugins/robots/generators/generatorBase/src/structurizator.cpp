@@ -14,6 +14,8 @@
 
 #include "structurizator.h"
 
+#include <algorithm>
+
 #include <QtCore/QQueue>
 
 #include "structurizatorNodes/intermediateStructurizatorNode.h"
@@ -30,6 +32,7 @@ using namespace generatorBase;
 
 Structurizator::Structurizator(QObject *parent)
 	: QObject(parent)
+	, mVerticesCount(0)
 	, mVerticesNumber(1)
 	, mStartVertex(-1)
 	, mMaxPostOrderTime(-1)
@@ -42,17 +45,24 @@ IntermediateStructurizatorNode *Structurizator::performStructurization(const QSe
 		, const QMap<qReal::Id, int> &vertexNumber
 		, int verticesNumber)
 {
+	mVerticesNumber = verticesNumber;
+	mStartVertex = startVertex;
+	reserveVertex(qMax(mVerticesNumber, mStartVertex));
+
 	for (const qReal::Id &id : verticesIds) {
 		mInitialIds.insert(id);
-		mMapIdToInt[id] = vertexNumber[id];
-		mVertices.insert(vertexNumber[id]);
+		const int v = vertexNumber[id];
+		reserveVertex(v);
+		mIds[v] = id;
+		if (!mVertices.testBit(v)) {
+			mVertices.setBit(v);
+			mVerticesCount++;
+		}
 	}
 
-	mVerticesNumber = verticesNumber;
-	mStartVertex = startVertex;
-
 	for (const int v : followers.keys()) {
 		for (const int u : followers[v]) {
+			reserveVertex(qMax(u, v));
 			mFollowers[v].push_back(u);
 			mPredecessors[u].push_back(v);
 		}
@@ -67,8 +77,8 @@ IntermediateStructurizatorNode *Structurizator::performStructurization(const QSe
 		somethingChanged = false;
 
 		int t = 0;
-		while (t <= mMaxPostOrderTime && (mVertices.size() > 1 || !mFollowers[mStartVertex].isEmpty())) {
-			int v = mPostOrder.key(t);
+		while (t <= mMaxPostOrderTime && (mVerticesCount > 1 || !mFollowers[mStartVertex].isEmpty())) {
+			int v = mPostOrderVertices[t];
 
 			QSet<int> reachUnder;
 			QSet<QPair<int, int>> edgesToRemove = {};
@@ -88,7 +98,7 @@ IntermediateStructurizatorNode *Structurizator::performStructurization(const QSe
 			} else if (isHeadOfCycle(v, reachUnder)) {
 				int minTime = -1;
 				for (const int vertex : reachUnder) {
-					if (minTime == -1 || minTime > mPostOrder[vertex]) {
+					if (mPostOrder[vertex] != -1 && (minTime == -1 || minTime > mPostOrder[vertex])) {
 						minTime = mPostOrder[vertex];
 					}
 				}
@@ -108,14 +118,14 @@ IntermediateStructurizatorNode *Structurizator::performStructurization(const QSe
 
 					for (const int vertexInsideLoop : nodesWithExits.keys()) {
 						for (const int vertexOutsideLoop : nodesWithExits[vertexInsideLoop]) {
-							if (minTime > mPostOrder[vertexOutsideLoop]) {
+							if (mPostOrder[vertexOutsideLoop] != -1 && minTime > mPostOrder[vertexOutsideLoop]) {
 								minTime = mPostOrder[vertexOutsideLoop];
 							}
 						}
 					}
 
 					reduceConditionsWithBreaks(v, nodesWithExits, commonExit);
-					t = minTime;
+					t = qMax(minTime, 0);
 					somethingChanged = true;
 					appendNodesDetectedAsNodeWithExit(verticesWithExits, v);
 					continue;
@@ -135,7 +145,7 @@ IntermediateStructurizatorNode *Structurizator::performStructurization(const QSe
 		}
 	}
 
-	if (mVertices.size() == 1) {
+	if (mVerticesCount == 1) {
 		return mTrees[mStartVertex];
 	}
 
@@ -149,7 +159,7 @@ bool Structurizator::isBlock(int v, QSet<QPair<int, int>> &edgesToRemove, QMap<Q
 	}
 
 	int u = mFollowers[v].first();
-	if (outgoingEdgesNumber(u) <= 1 && incomingEdgesNumber(u) == 1 && u != v && mDominators[u].contains(v)) {
+	if (outgoingEdgesNumber(u) <= 1 && incomingEdgesNumber(u) == 1 && u != v && mDominators[u].testBit(v)) {
 		verticesRoles["block1"] = v;
 		verticesRoles["block2"] = u;
 
@@ -168,8 +178,8 @@ bool Structurizator::isIfThenElse(int v, QSet<QPair<int, int>> &edgesToRemove, Q
 
 	int u1 = mFollowers[v].first();
 	int u2 = mFollowers[v].last();
-	if (incomingEdgesNumber(u1) != 1 || incomingEdgesNumber(u2) != 1 || mDominators[v].contains(u1)
-			|| mDominators[v].contains(u2)) {
+	if (incomingEdgesNumber(u1) != 1 || incomingEdgesNumber(u2) != 1 || mDominators[v].testBit(u1)
+			|| mDominators[v].testBit(u2)) {
 		return false;
 	}
 
@@ -211,7 +221,7 @@ bool Structurizator::isIfThen(int v, QSet<QPair<int, int>> &edgesToRemove, QMap<
 		elseNumber = u1;
 	}
 
-	if (thenNumber == -1 || elseNumber == v || mDominators[v].contains(thenNumber)) {
+	if (thenNumber == -1 || elseNumber == v || mDominators[v].testBit(thenNumber)) {
 		return false;
 	}
 
@@ -255,7 +265,7 @@ bool Structurizator::isSwitch(int v, QSet<QPair<int, int>> &edgesToRemove, QMap<
 			vertices.insert(u);
 		}
 
-		if (u != exit && mDominators[v].contains(u)) {
+		if (u != exit && mDominators[v].testBit(u)) {
 			return false;
 		}
 
@@ -315,7 +325,7 @@ bool Structurizator::isWhileLoop(int v, QSet<QPair<int, int>> &edgesToRemove, QM
 		return false;
 	}
 
-	if (mDominators[v].contains(bodyNumber)) {
+	if (mDominators[v].testBit(bodyNumber)) {
 		return false;
 	}
 
@@ -366,7 +376,7 @@ bool Structurizator::isHeadOfCycle(int v, QSet<int> &reachUnder)
 	QQueue<int> queueForReachUnder;
 
 	for (const int u : mPredecessors[v]) {
-		if (mDominators[u].contains(v)) {
+		if (mDominators[u].testBit(v)) {
 			queueForReachUnder.push_back(u);
 		}
 	}
@@ -376,7 +386,7 @@ bool Structurizator::isHeadOfCycle(int v, QSet<int> &reachUnder)
 		queueForReachUnder.pop_front();
 		reachUnder.insert(u);
 		for (const int w : mPredecessors[u]) {
-			if (mDominators[w].contains(v) && !reachUnder.contains(w)) {
+			if (mDominators[w].testBit(v) && !reachUnder.contains(w)) {
 				queueForReachUnder.push_back(w);
 			}
 		}
@@ -471,9 +481,13 @@ bool Structurizator::checkCommonExitUniqueness(int commonExit, const QMap<int, Q
 
 bool Structurizator::checkNodes(const QSet<int> &verticesWithExits)
 {
-	QSet<int> testSet = mWasPreviouslyDetectedAsNodeWithExit.keys().toSet();
-	testSet.intersect(verticesWithExits);
-	return testSet.isEmpty();
+	for (const int v : verticesWithExits) {
+		if (mWasPreviouslyDetectedAsNodeWithExit.contains(v)) {
+			return false;
+		}
+	}
+
+	return true;
 }
 
 void Structurizator::reduceBlock(QSet<QPair<int, int>> &edgesToRemove, QMap<QString, int> &verticesRoles)
@@ -584,10 +598,11 @@ void Structurizator::reduceConditionsWithBreaks(int &v, QMap<int, QSet<int>> &no
 
 		StructurizatorNodeWithBreaks *nodeWithBreaks = new StructurizatorNodeWithBreaks(mTrees[u]
 				, exitBranches, this);
-		replace(appendVertex(nodeWithBreaks), edgesToRemove, vertices);
+		const int newNodeNumber = appendVertex(nodeWithBreaks);
+		replace(newNodeNumber, edgesToRemove, vertices);
 
 		if (u == v) {
-			v = mTrees.key(nodeWithBreaks);
+			v = newNodeNumber;
 		}
 	}
 
@@ -621,93 +636,135 @@ void Structurizator::updateEdges(int newNodeNumber, QSet<QPair<int, int>> &edges
 		mPredecessors[p.second].removeAll(p.first);
 	}
 
-	const QMap<int, QVector<int>> followers = mFollowers;
-	for (const int v : mVertices) {
-		for (const int u : followers[v]) {
+	// Only edges incident to replaced vertices change. Edges coming into them from outside are redirected
+	// to the new vertex which takes the place after all the remaining followers of their source.
+	QVector<int> sources;
+	for (const int v : vertices) {
+		for (const int u : mPredecessors[v]) {
+			if (!vertices.contains(u) && !sources.contains(u)) {
+				sources.push_back(u);
+			}
+		}
+	}
 
-			int newV = vertices.contains(v) ? newNodeNumber : v;
-			int newU = vertices.contains(u) ? newNodeNumber : u;
+	for (const int u : sources) {
+		QVector<int> &followers = mFollowers[u];
+		followers.erase(std::remove_if(followers.begin(), followers.end(), [&vertices](int w) {
+			return vertices.contains(w);
+		}), followers.end());
 
-			if (newU == newNodeNumber || newV == newNodeNumber) {
-				// removing old information
-				mFollowers[v].removeAll(u);
+		followers.push_back(newNodeNumber);
+		mPredecessors[newNodeNumber].push_back(u);
+	}
+
+	// Edges going outside now start from the new vertex, edges between replaced vertices become its self-loop.
+	for (const int v : vertices) {
+		for (const int u : mFollowers[v]) {
+			const int newU = vertices.contains(u) ? newNodeNumber : u;
+			if (newU != newNodeNumber) {
 				mPredecessors[u].removeAll(v);
+			}
 
-				// inserting new information
-				if (!mFollowers[newV].contains(newU)) {
-					mFollowers[newV].push_back(newU);
-					mPredecessors[newU].push_back(newV);
-				}
+			if (!mFollowers[newNodeNumber].contains(newU)) {
+				mFollowers[newNodeNumber].push_back(newU);
+				mPredecessors[newU].push_back(newNodeNumber);
 			}
 		}
 	}
 
 	for (const int v : vertices) {
-		mFollowers.remove(v);
-		mPredecessors.remove(v);
+		mFollowers[v].clear();
+		mPredecessors[v].clear();
 	}
 }
 
 void Structurizator::updatePostOrder(int newNodeNumber, QSet<int> &verteces)
 {
-	int maximum = -1;
-	for (int v : verteces) {
-		if (maximum == -1 || maximum < mPostOrder[v]) {
-			maximum = mPostOrder[v];
+	Time minimum = -1;
+	Time maximum = -1;
+	for (const int v : verteces) {
+		if (mPostOrder[v] != -1) {
+			minimum = minimum == -1 ? mPostOrder[v] : qMin(minimum, mPostOrder[v]);
+			maximum = qMax(maximum, mPostOrder[v]);
 		}
 	}
 
-	mPostOrder[newNodeNumber] = maximum;
-
-	for (int v : verteces) {
-		mPostOrder.remove(v);
+	if (maximum == -1) {
+		return;
 	}
 
-	mMaxPostOrderTime = mMaxPostOrderTime - verteces.size() + 1;
+	// The new vertex takes the latest time of replaced ones, vertices after the first of them are shifted back.
+	Time current = minimum;
+	for (Time time = minimum; time < mPostOrderVertices.size(); ++time) {
+		int v = mPostOrderVertices[time];
+		if (verteces.contains(v)) {
+			if (time != maximum) {
+				continue;
+			}
 
-	QVector<int> times = mPostOrder.values().toVector();
-	std::sort(times.begin(), times.end());
+			v = newNodeNumber;
+		}
+
+		mPostOrderVertices[current] = v;
+		mPostOrder[v] = current;
+		++current;
+	}
 
-	for (int i = 0; i <= mMaxPostOrderTime; i++) {
-		int v = mPostOrder.key(times[i]);
-		mPostOrder[v] = i;
+	mPostOrderVertices.resize(current);
+	for (const int v : verteces) {
+		mPostOrder[v] = -1;
 	}
+
+	mMaxPostOrderTime = current - 1;
 }
 
 void Structurizator::updateDominators(int newNodeNumber, QSet<int> &vertices)
 {
 	// others
-	for (int v : mPostOrder.keys()) {
-		QSet<int> tempSet = mDominators[v];
-		tempSet.intersect(vertices);
-		if (!tempSet.isEmpty()) {
-			mDominators[v].subtract(vertices);
-			mDominators[v].insert(newNodeNumber);
+	for (const int v : mPostOrderVertices) {
+		QBitArray &dominators = mDominators[v];
+		bool isDominated = false;
+		for (const int u : vertices) {
+			if (dominators.testBit(u)) {
+				isDominated = true;
+				dominators.clearBit(u);
+			}
+		}
+
+		if (isDominated) {
+			dominators.setBit(newNodeNumber);
 		}
 	}
 
 	// new
-	QSet<int> doms = mVertices;
-	for (int v : vertices) {
-		doms.intersect(mDominators[v]);
+	QBitArray doms = mVertices;
+	for (const int v : vertices) {
+		doms &= mDominators[v];
+	}
+
+	for (const int v : vertices) {
+		doms.clearBit(v);
 	}
 
-	doms.subtract(vertices);
-	doms.insert(newNodeNumber);
+	doms.setBit(newNodeNumber);
 
 	mDominators[newNodeNumber] = doms;
 
 	// old
-	for (int v : vertices) {
-		mDominators.remove(v);
+	for (const int v : vertices) {
+		mDominators[v].fill(false);
 	}
 }
 
 void Structurizator::updateVertices(int newNodeNumber, QSet<int> &vertices)
 {
 	mStartVertex = vertices.contains(mStartVertex) ? newNodeNumber : mStartVertex;
-	mVertices.subtract(vertices);
-	mVertices.insert(newNodeNumber);
+	for (const int v : vertices) {
+		if (mVertices.testBit(v)) {
+			mVertices.clearBit(v);
+			mVerticesCount--;
+		}
+	}
 }
 
 void Structurizator::removeNodesPreviouslyDetectedAsNodeWithExit(QSet<int> &vertices)
@@ -719,27 +776,40 @@ void Structurizator::removeNodesPreviouslyDetectedAsNodeWithExit(QSet<int> &vert
 
 void Structurizator::calculateDominators()
 {
-	for (const int u : mVertices) {
-		mDominators[u] = mVertices;
+	// Vertices are visited in reverse post order, so the iterations converge after a couple of passes.
+	QVector<int> order;
+	order.reserve(mVerticesCount);
+	for (int time = mMaxPostOrderTime; time >= 0; --time) {
+		order.push_back(mPostOrderVertices[time]);
+	}
+
+	for (int u = 0; u < mVertices.size(); ++u) {
+		if (mVertices.testBit(u)) {
+			mDominators[u] = mVertices;
+			if (mPostOrder[u] == -1) {
+				order.push_back(u);
+			}
+		}
 	}
 
-	mDominators[mStartVertex] = { mStartVertex };
+	mDominators[mStartVertex].fill(false);
+	mDominators[mStartVertex].setBit(mStartVertex);
 
 	bool somethingChanged = true;
 	while (somethingChanged) {
 		somethingChanged = false;
 
-		for (const int v : mVertices) {
+		for (const int v : order) {
 			if (v == mStartVertex) {
 				continue;
 			}
 
-			QSet<int> doms = mVertices;
+			QBitArray doms = mVertices;
 			for (const int u : mPredecessors[v]) {
-				doms = doms.intersect(mDominators[u]);
+				doms &= mDominators[u];
 			}
 
-			doms.insert(v);
+			doms.setBit(v);
 
 			if (doms != mDominators[v]) {
 				mDominators[v] = doms;
@@ -747,14 +817,12 @@ void Structurizator::calculateDominators()
 			}
 		}
 	}
-
-
 }
 
 void Structurizator::findStartVertex()
 {
-	for (const int u : mVertices) {
-		if (mPredecessors[u].isEmpty()) {
+	for (int u = 0; u < mVertices.size(); ++u) {
+		if (mVertices.testBit(u) && mPredecessors[u].isEmpty()) {
 			mStartVertex = u;
 			return;
 		}
@@ -763,13 +831,10 @@ void Structurizator::findStartVertex()
 
 void Structurizator::calculatePostOrder()
 {
-	mPostOrder.clear();
-
-	QMap<int, bool> used;
-	for (const int v : mVertices) {
-		used[v] = false;
-	}
+	mPostOrderVertices.clear();
+	mPostOrder.fill(-1);
 
+	QBitArray used(mVertices.size());
 	int currentTime = 0;
 	dfs(mStartVertex, currentTime, used);
 
@@ -778,21 +843,24 @@ void Structurizator::calculatePostOrder()
 
 void Structurizator::createInitialNodesForIds()
 {
-	for (const int v : mVertices) {
-		mTrees[v] = new SimpleStructurizatorNode(mMapIdToInt.key(v), this);
+	for (int v = 0; v < mVertices.size(); ++v) {
+		if (mVertices.testBit(v)) {
+			mTrees[v] = new SimpleStructurizatorNode(mIds[v], this);
+		}
 	}
 }
 
-void Structurizator::dfs(int v, int &currentTime, QMap<int, bool> &used)
+void Structurizator::dfs(int v, int &currentTime, QBitArray &used)
 {
-	used[v] = true;
+	used.setBit(v);
 	for (const int u : mFollowers[v]) {
-		if (!used[u]) {
+		if (!used.testBit(u)) {
 			dfs(u, currentTime, used);
 		}
 	}
 
 	mPostOrder[v] = currentTime;
+	mPostOrderVertices.push_back(v);
 	currentTime++;
 }
 
@@ -806,12 +874,36 @@ void Structurizator::appendNodesDetectedAsNodeWithExit(QSet<int> &vertices, int
 int Structurizator::appendVertex(IntermediateStructurizatorNode *node)
 {
 	mVerticesNumber++;
+	reserveVertex(mVerticesNumber);
 	mTrees[mVerticesNumber] = node;
-	mVertices.insert(mVerticesNumber);
+	mVertices.setBit(mVerticesNumber);
+	mVerticesCount++;
 
 	return mVerticesNumber;
 }
 
+void Structurizator::reserveVertex(int v)
+{
+	const int oldCapacity = mTrees.size();
+	if (v < oldCapacity) {
+		return;
+	}
+
+	const int capacity = qMax(v + 1, 2 * oldCapacity);
+	mIds.resize(capacity);
+	mFollowers.resize(capacity);
+	mPredecessors.resize(capacity);
+	mTrees.resize(capacity);
+	mPostOrder.resize(capacity);
+	std::fill(mPostOrder.begin() + oldCapacity, mPostOrder.end(), -1);
+
+	mVertices.resize(capacity);
+	mDominators.resize(capacity);
+	for (QBitArray &dominators : mDominators) {
+		dominators.resize(capacity);
+	}
+}
+
 int Structurizator::outgoingEdgesNumber(int v) const
 {
 	return mFollowers[v].size();
@@ -14,8 +14,10 @@
 
 #pragma once
 
+#include <QtCore/QBitArray>
 #include <QtCore/QSet>
 #include <QtCore/QMap>
+#include <QtCore/QVector>
 
 #include <qrkernel/ids.h>
 
@@ -117,24 +119,36 @@ private:
 	void findStartVertex();
 	void calculatePostOrder();
 	void createInitialNodesForIds();
-	void dfs(int v, int &currentTime, QMap<int, bool> &used);
+	void dfs(int v, int &currentTime, QBitArray &used);
 
 	void appendNodesDetectedAsNodeWithExit(QSet<int> &vertices, int cycleHead);
 	void removeNodesPreviouslyDetectedAsNodeWithExit(QSet<int> &vertices);
 	int appendVertex(IntermediateStructurizatorNode *node);
 
+	/// Grows per-vertex arrays and all vertex sets so that they can hold vertex @a v.
+	void reserveVertex(int v);
+
 	int outgoingEdgesNumber(int v) const;
 	int incomingEdgesNumber(int v) const;
 
-	QMap<qReal::Id, int> mMapIdToInt;
-	QSet<VertexNumber> mVertices;
-	QMap<VertexNumber, QVector<VertexNumber>> mFollowers;
-	QMap<VertexNumber, QVector<VertexNumber>> mPredecessors;
-	QMap<VertexNumber, QSet<VertexNumber>> mDominators;
-	QMap<VertexNumber, Time> mPostOrder;
+	/// Per-vertex data is kept in arrays indexed by vertex numbers and sets of vertices are bit arrays
+	/// of the same capacity, so reducing a pattern touches only the replaced vertices and their neighbours.
+	QVector<qReal::Id> mIds;
+	QBitArray mVertices;
+	int mVerticesCount;
+	QVector<QVector<VertexNumber>> mFollowers;
+	QVector<QVector<VertexNumber>> mPredecessors;
+	QVector<QBitArray> mDominators;
+
+	/// Post order time of each vertex, -1 for vertices which are unreachable from the start one.
+	QVector<Time> mPostOrder;
+
+	/// Vertices in post order, inverse of mPostOrder.
+	QVector<VertexNumber> mPostOrderVertices;
+
 	QMap<VertexNumber, VertexNumber> mWasPreviouslyDetectedAsNodeWithExit;
 
-	QMap<int, IntermediateStructurizatorNode *> mTrees;
+	QVector<IntermediateStructurizatorNode *> mTrees;
 
 	QSet<qReal::Id> mInitialIds;
 	int mVerticesNumber;
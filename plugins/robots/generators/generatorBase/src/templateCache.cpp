@@ -0,0 +1,72 @@
+/* Copyright 2007-2015 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "templateCache.h"
+
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutexLocker>
+
+#include <qrutils/inFile.h>
+
+using namespace generatorBase;
+
+TemplateCache::TemplateCache()
+{
+}
+
+TemplateCache &TemplateCache::instance()
+{
+	static TemplateCache cache;
+	return cache;
+}
+
+bool TemplateCache::read(const QString &fullPath, PrecompiledTemplate &result, QString &errorMessage)
+{
+	// One stat() per lookup, as QFile::exists() did before, the file itself is read only when it has changed.
+	const QFileInfo info(fullPath);
+	if (!info.exists()) {
+		return false;
+	}
+
+	const QDateTime lastModified = info.lastModified();
+	const qint64 size = info.size();
+
+	{
+		QMutexLocker lock(&mMutex);
+		const auto entry = mEntries.constFind(fullPath);
+		if (entry != mEntries.constEnd() && entry->lastModified == lastModified && entry->size == size) {
+			result = entry->contents;
+			errorMessage.clear();
+			return true;
+		}
+	}
+
+	const QString text = utils::InFile::readAll(fullPath, &errorMessage);
+	if (!errorMessage.isEmpty()) {
+		result = PrecompiledTemplate();
+		return true;
+	}
+
+	result = PrecompiledTemplate(text);
+
+	QMutexLocker lock(&mMutex);
+	mEntries.insert(fullPath, Entry{lastModified, size, result});
+	return true;
+}
+
+void TemplateCache::clear()
+{
+	QMutexLocker lock(&mMutex);
+	mEntries.clear();
+}
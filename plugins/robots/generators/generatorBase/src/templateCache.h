@@ -0,0 +1,56 @@
+/* Copyright 2007-2015 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+
+#include "generatorBase/precompiledTemplate.h"
+
+namespace generatorBase {
+
+/// Process-wide cache of precompiled generator templates keyed by full path of a template file.
+/// A template is read from disk once and then reused while its file keeps its modification time and size,
+/// so changed templates are picked up without restart. Thread-safe.
+class TemplateCache
+{
+public:
+	/// Returns the only instance of the cache.
+	static TemplateCache &instance();
+
+	/// Returns false if there is no file with the given path. Otherwise returns true and puts the template
+	/// into @a result. If the file exists but can not be read, @a errorMessage gets the reason and @a result
+	/// is empty.
+	bool read(const QString &fullPath, PrecompiledTemplate &result, QString &errorMessage);
+
+	/// Forgets all the templates.
+	void clear();
+
+private:
+	struct Entry
+	{
+		QDateTime lastModified;
+		qint64 size;
+		PrecompiledTemplate contents;
+	};
+
+	TemplateCache();
+
+	QHash<QString, Entry> mEntries;
+	QMutex mMutex;
+};
+
+}
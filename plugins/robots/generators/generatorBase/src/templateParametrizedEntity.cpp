@@ -17,10 +17,12 @@
 #include <QtCore/QDebug>
 #include <QtCore/QUuid>
 
-#include <qrutils/inFile.h>
 #include <qrutils/nameNormalizer.h>
 #include <qrkernel/logging.h>
 
+#include "generatorBase/precompiledTemplate.h"
+#include "templateCache.h"
+
 using namespace generatorBase;
 
 TemplateParametrizedEntity::TemplateParametrizedEntity()
@@ -37,18 +39,23 @@ TemplateParametrizedEntity::~TemplateParametrizedEntity()
 }
 
 QString TemplateParametrizedEntity::readTemplate(const QString &pathFromRoot) const
+{
+	return readTemplate(pathFromRoot, QHash<QString, QString>());
+}
+
+QString TemplateParametrizedEntity::readTemplate(const QString &pathFromRoot
+		, const QHash<QString, QString> &values) const
 {
 	for (const QString &path: mPathsToRoot) {
-		const QString fullPath = path + '/' + pathFromRoot;
-		if (QFile::exists(fullPath)) {
-			QString errorMessage;
-			const QString result = utils::InFile::readAll(fullPath, &errorMessage);
+		PrecompiledTemplate precompiledTemplate;
+		QString errorMessage;
+		if (TemplateCache::instance().read(path + '/' + pathFromRoot, precompiledTemplate, errorMessage)) {
 			if (!errorMessage.isEmpty()) {
 				QLOG_ERROR() << "Reading from template while generating code failed";
 				qWarning() << "TemplateParametrizedEntity::readTemplate" << errorMessage;
 			}
 
-			return addRandomIds(result);
+			return instantiate(precompiledTemplate, values);
 		}
 	}
 
@@ -61,15 +68,14 @@ QString TemplateParametrizedEntity::readTemplate(const QString &pathFromRoot) co
 QString TemplateParametrizedEntity::readTemplateIfExists(const QString &pathFromRoot, const QString &fallback) const
 {
 	for (const QString &path: mPathsToRoot) {
-		const QString fullPath = path + '/' + pathFromRoot;
-		if (QFile::exists(fullPath)) {
-			QString errorMessage;
-			const QString result = utils::InFile::readAll(fullPath, &errorMessage);
+		PrecompiledTemplate precompiledTemplate;
+		QString errorMessage;
+		if (TemplateCache::instance().read(path + '/' + pathFromRoot, precompiledTemplate, errorMessage)) {
 			if (!errorMessage.isEmpty()) {
 				QLOG_ERROR() << "Reading from template while generating code failed";
 				qWarning() << "TemplateParametrizedEntity::readTemplate" << errorMessage;
 			} else {
-				return addRandomIds(result);
+				return instantiate(precompiledTemplate, {});
 			}
 		}
 	}
@@ -100,6 +106,33 @@ QString TemplateParametrizedEntity::addRandomIds(QString templateString) const
 	return templateString;
 }
 
+QString TemplateParametrizedEntity::instantiate(const PrecompiledTemplate &precompiledTemplate
+		, QHash<QString, QString> values) const
+{
+	// Same random ids as addRandomIds() gives: one for all @@RANDOM_ID@@ and one for each @@RANDOM_ID_<n>@@
+	// with n going from 1 without gaps.
+	const auto addRandomId = [&values](const QString &label) {
+		if (!values.contains(label)) {
+			values.insert(label, utils::NameNormalizer::normalizeStrongly(QUuid::createUuid().toString(), false));
+		}
+	};
+
+	if (precompiledTemplate.contains("@@RANDOM_ID@@")) {
+		addRandomId("@@RANDOM_ID@@");
+	}
+
+	for (int index = 1; ; ++index) {
+		const QString label = QString("@@RANDOM_ID_%1@@").arg(index);
+		if (!precompiledTemplate.contains(label)) {
+			break;
+		}
+
+		addRandomId(label);
+	}
+
+	return precompiledTemplate.substitute(values);
+}
+
 void TemplateParametrizedEntity::setPathsToTemplates(const QStringList &pathsTemplates)
 {
 	mPathsToRoot = pathsTemplates;
@@ -94,6 +94,10 @@ private:
 
 	void reportError(const QString &message);
 
+	/// Returns all identifiers that may be mentioned in textual properties of blocks of a program. It is a lexical
+	/// over-approximation, so sensor variables used by a program are surely among them.
+	QSet<QString> usedIdentifiers() const;
+
 	const qReal::GraphicalModelAssistInterface &mGraphicalModelApi;
 	qReal::LogicalModelAssistInterface &mLogicalModelApi;
 	qReal::gui::MainWindowInterpretersInterface &mInterpretersInterface;
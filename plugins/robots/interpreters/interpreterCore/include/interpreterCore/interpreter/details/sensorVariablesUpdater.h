@@ -17,6 +17,7 @@
 #include <QtCore/QTimer>
 #include <QtCore/QObject>
 #include <QtCore/QScopedPointer>
+#include <QtCore/QSet>
 
 #include <kitBase/robotModel/robotModelManagerInterface.h>
 
@@ -46,9 +47,15 @@ public:
 
 	~SensorVariablesUpdater();
 
-	/// Starts background polling process.
+	/// Starts background polling process, all the sensors with variables are polled on each tick.
 	void run();
 
+	/// Starts background polling process. If the robot model needs connection to a real robot, only sensors whose
+	/// variables are among @a usedIdentifiers are polled on each tick. Other sensors are polled once in
+	/// idlePollingFactor ticks, just to keep their values in watch window reasonably fresh. Models that need no
+	/// connection get all the sensors polled on each tick, like with run().
+	void run(const QSet<QString> &usedIdentifiers);
+
 	/// Stops background polling process.
 	void suspend();
 
@@ -59,6 +66,27 @@ private slots:
 	void onFailure();
 
 private:
+	/// Sensor polled by updater and how often it shall be polled.
+	struct PolledSensor
+	{
+		kitBase::robotModel::PortInfo port;
+
+		/// Number of ticks between two readings of a sensor.
+		int period;
+
+		/// Number of ticks left until next reading.
+		int countdown;
+	};
+
+	/// How many times rarer sensors not referenced by a program are polled.
+	static const int idlePollingFactor = 10;
+
+	/// Connects to sensors, initializes their variables and starts the timer.
+	void start();
+
+	/// Adds a sensor to the list of polled ones, with period depending on whether its variable is used.
+	void addPolledSensor(const kitBase::robotModel::PortInfo &port);
+
 	int updateInterval() const;
 
 	void updateScalarSensorVariables(const kitBase::robotModel::PortInfo &sensorPortInfo, int reading);
@@ -74,6 +102,11 @@ private:
 	QScopedPointer<utils::AbstractTimer> mUpdateTimer;
 	const kitBase::robotModel::RobotModelManagerInterface &mRobotModelManager;
 	qrtext::DebuggerInterface &mParser;
+
+	/// True if all the sensors shall be polled on each tick, used identifiers are ignored then.
+	bool mPollAllSensors;
+	QSet<QString> mUsedIdentifiers;
+	QList<PolledSensor> mPolledSensors;
 };
 
 }
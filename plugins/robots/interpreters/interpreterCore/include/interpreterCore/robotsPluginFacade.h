@@ -78,6 +78,12 @@ public:
 
 	const kitBase::EventsForKitPluginInterface &eventsForKitPlugins() const;
 
+	/// Returns all loaded kit plugins, code generators among them.
+	QList<kitBase::KitPluginInterface *> kitPlugins() const;
+
+	/// Returns the manager of currently selected robot model.
+	RobotModelManager &robotModelManager();
+
 	//tempory solution
 	bool interpretCode(const QString &inputs);
 
@@ -15,6 +15,7 @@
 #include "interpreterCore/interpreter/blockInterpreter.h"
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QRegularExpression>
 #include <QtWidgets/QAction>
 
 #include <qrtext/languageToolboxInterface.h>
@@ -174,7 +175,7 @@ void BlockInterpreter::devicesConfiguredSlot()
 		mState = interpreting;
 		mInterpretationStartedTimestamp = mRobotModelManager.model().timeline().timestamp();
 
-		mSensorVariablesUpdater.run();
+		mSensorVariablesUpdater.run(usedIdentifiers());
 
 		const Id &currentDiagramId = mInterpretersInterface.activeDiagram();
 
@@ -269,3 +270,28 @@ void BlockInterpreter::reportError(const QString &message)
 {
 	mInterpretersInterface.errorReporter()->addError(message);
 }
+
+QSet<QString> BlockInterpreter::usedIdentifiers() const
+{
+	static const QRegularExpression identifier("[A-Za-z_][A-Za-z0-9_]*");
+
+	// Properties are scanned lexically rather than parsed, expressions are parsed lazily by blocks during
+	// interpretation and parse errors shall be reported there, with block highlighting.
+	QSet<QString> result;
+	for (const Id &block : mLogicalModelApi.children(Id::rootId())) {
+		QMapIterator<QString, QVariant> property = mLogicalModelApi.logicalRepoApi().propertiesIterator(block);
+		while (property.hasNext()) {
+			property.next();
+			if (property.value().type() != QVariant::String) {
+				continue;
+			}
+
+			QRegularExpressionMatchIterator match = identifier.globalMatch(property.value().toString());
+			while (match.hasNext()) {
+				result.insert(match.next().captured());
+			}
+		}
+	}
+
+	return result;
+}
@@ -27,6 +27,7 @@ SensorVariablesUpdater::SensorVariablesUpdater(const RobotModelManagerInterface
 		)
 	: mRobotModelManager(robotModelManager)
 	, mParser(textLanguageToolbox)
+	, mPollAllSensors(true)
 {
 }
 
@@ -36,6 +37,23 @@ SensorVariablesUpdater::~SensorVariablesUpdater()
 
 void SensorVariablesUpdater::run()
 {
+	mPollAllSensors = true;
+	mUsedIdentifiers.clear();
+	start();
+}
+
+void SensorVariablesUpdater::run(const QSet<QString> &usedIdentifiers)
+{
+	// Only polling of a connected robot costs link bandwidth, models that need no connection (like 2D model)
+	// are cheap to poll and keep all their sensor variables fresh.
+	mPollAllSensors = !mRobotModelManager.model().needsConnection();
+	mUsedIdentifiers = usedIdentifiers;
+	start();
+}
+
+void SensorVariablesUpdater::start()
+{
+	mPolledSensors.clear();
 	mUpdateTimer.reset(mRobotModelManager.model().timeline().produceTimer());
 	connect(mUpdateTimer.data(), &utils::AbstractTimer::timeout, this, &SensorVariablesUpdater::onTimerTimeout);
 	resetVariables();
@@ -65,6 +83,7 @@ void SensorVariablesUpdater::run()
 					, Qt::UniqueConnection
 					);
 
+			addPolledSensor(scalarSensor->port());
 			continue;
 		}
 
@@ -92,15 +111,23 @@ void SensorVariablesUpdater::run()
 					, Qt::UniqueConnection
 					);
 
+			addPolledSensor(vectorSensor->port());
 			continue;
 		}
 	}
 
+	// Initial values are read for all the sensors regardless of usage, so the program starts with actual readings.
 	mRobotModelManager.model().updateSensorsValues();
 
 	mUpdateTimer->start(updateInterval());
 }
 
+void SensorVariablesUpdater::addPolledSensor(const PortInfo &port)
+{
+	const int period = mUsedIdentifiers.contains(port.reservedVariable()) ? 1 : idlePollingFactor;
+	mPolledSensors << PolledSensor{port, period, period};
+}
+
 void SensorVariablesUpdater::suspend()
 {
 	if (mUpdateTimer) {
@@ -132,7 +159,21 @@ void SensorVariablesUpdater::onVectorSensorResponse(const QVector<int> &reading)
 
 void SensorVariablesUpdater::onTimerTimeout()
 {
-	mRobotModelManager.model().updateSensorsValues();
+	if (mPollAllSensors) {
+		mRobotModelManager.model().updateSensorsValues();
+	} else {
+		QList<PortInfo> duePorts;
+		for (PolledSensor &sensor : mPolledSensors) {
+			if (--sensor.countdown <= 0) {
+				sensor.countdown = sensor.period;
+				duePorts << sensor.port;
+			}
+		}
+
+		if (!duePorts.isEmpty()) {
+			mRobotModelManager.model().updateSelectedSensorsValues(duePorts);
+		}
+	}
 
 	mUpdateTimer->start(updateInterval());
 }
@@ -285,6 +285,21 @@ const kitBase::EventsForKitPluginInterface &RobotsPluginFacade::eventsForKitPlug
 	return mEventsForKitPlugin;
 }
 
+QList<kitBase::KitPluginInterface *> RobotsPluginFacade::kitPlugins() const
+{
+	QList<kitBase::KitPluginInterface *> result;
+	for (const QString &kitId : mKitPluginManager.kitIds()) {
+		result << mKitPluginManager.kitsById(kitId);
+	}
+
+	return result;
+}
+
+RobotModelManager &RobotsPluginFacade::robotModelManager()
+{
+	return mRobotModelManager;
+}
+
 bool RobotsPluginFacade::interpretCode(const QString &inputs)
 {
 	auto logicalRepo = &mLogicalModelApi->logicalRepoApi();
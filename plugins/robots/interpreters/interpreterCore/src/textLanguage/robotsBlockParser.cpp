@@ -120,11 +120,11 @@ void RobotsBlockParser::addIntrinsicFuctions()
 {
 	const auto add0aryFunction = [this] (const QString &name
 			, qrtext::core::types::TypeExpression * const returnType
-			, std::function<QVariant()> const &function)
+			, std::function<LuaValue()> const &function)
 	{
-		addIntrinsicFunction(name, returnType
+		addNativeFunction(name, returnType
 				, {}
-				, [function] (const QList<QVariant> &params) {
+				, [function] (const QVector<LuaValue> &params) {
 						Q_UNUSED(params);
 						return function();
 				});
@@ -133,11 +133,11 @@ void RobotsBlockParser::addIntrinsicFuctions()
 	const auto add1aryFunction = [this] (const QString &name
 			, qrtext::core::types::TypeExpression * const returnType
 			, qrtext::core::types::TypeExpression * const argumentType
-			, std::function<QVariant(QVariant)> const &function)
+			, std::function<LuaValue(const LuaValue &)> const &function)
 	{
-		addIntrinsicFunction(name, returnType
+		addNativeFunction(name, returnType
 				, {argumentType}
-				, [function] (const QList<QVariant> &params) {
+				, [function] (const QVector<LuaValue> &params) {
 						Q_ASSERT(!params.isEmpty());
 						return function(params.first());
 				});
@@ -147,11 +147,11 @@ void RobotsBlockParser::addIntrinsicFuctions()
 			, qrtext::core::types::TypeExpression * const returnType
 			, qrtext::core::types::TypeExpression * const argument1Type
 			, qrtext::core::types::TypeExpression * const argument2Type
-			, std::function<QVariant(QVariant, QVariant)> const &function)
+			, std::function<LuaValue(const LuaValue &, const LuaValue &)> const &function)
 	{
-		addIntrinsicFunction(name, returnType
+		addNativeFunction(name, returnType
 				, {argument1Type, argument2Type}
-				, [function] (const QList<QVariant> &params) {
+				, [function] (const QVector<LuaValue> &params) {
 						Q_ASSERT(params.count() == 2);
 						return function(params.first(), params.last());
 				});
@@ -162,34 +162,34 @@ void RobotsBlockParser::addIntrinsicFuctions()
 			, std::function<qreal(qreal)> const &function)
 	{
 		add1aryFunction(name, new types::Float, new types::Float
-				, [function](const QVariant &arg) { return function(arg.toReal()); });
+				, [function](const LuaValue &arg) { return LuaValue(function(arg.toDouble())); });
 	};
 
 	const auto addIntegerFunction = [this, add1aryFunction] (const QString &name
 			, std::function<qreal(qreal)> const &function)
 	{
 		add1aryFunction(name, new types::Integer, new types::Integer
-				, [function](const QVariant &arg) { return function(arg.toInt()); });
+				, [function](const LuaValue &arg) { return LuaValue(function(arg.toInt())); });
 	};
 
 	const auto addFloatToIntegerFunction = [this, add1aryFunction] (const QString &name
 			, std::function<int(qreal)> const &function)
 	{
 		add1aryFunction(name, new types::Integer(), new types::Float()
-				, [function](const QVariant &arg) { return function(arg.toReal()); });
+				, [function](const LuaValue &arg) { return LuaValue(function(arg.toDouble())); });
 	};
 
-	add0aryFunction("time", new types::Integer(), [this]() { return mTimeComputer(); });
-	add1aryFunction("sensor", new types::Integer(), new types::String(), [this](const QVariant &port) {
+	add0aryFunction("time", new types::Integer(), [this]() { return LuaValue(mTimeComputer()); });
+	add1aryFunction("sensor", new types::Integer(), new types::String(), [this](const LuaValue &port) {
 		if (port.toString().isEmpty()) {
 			/// @todo: Add error reporting
-			return 0;
+			return LuaValue(0);
 		}
 
-		return interpret<int>("sensor" + port.toString());
+		return LuaValue(interpret<int>("sensor" + port.toString()));
 	});
 
-	add1aryFunction("print", new types::Nil, new qrtext::core::types::Any, [this](const QVariant &text) {
+	add1aryFunction("print", new types::Nil, new qrtext::core::types::Any, [this](const LuaValue &text) {
 		kitBase::robotModel::robotParts::Shell *shell = kitBase::robotModel::RobotModelUtils::findDevice
 				<kitBase::robotModel::robotParts::Shell>(mRobotModelManager.model(), "ShellPort");
 		if (shell) {
@@ -214,11 +214,11 @@ void RobotsBlockParser::addIntrinsicFuctions()
 	addIntegerFunction("random", [](int x) {return rand() % x; });
 
 	add2aryFunction("min", new types::Float(), new types::Float(), new types::Float()
-			, [](const QVariant &a, const QVariant &b) { return qMin(a.toReal(), b.toReal()); });
+			, [](const LuaValue &a, const LuaValue &b) { return LuaValue(qMin(a.toDouble(), b.toDouble())); });
 	add2aryFunction("max", new types::Float(), new types::Float(), new types::Float()
-			, [](const QVariant &a, const QVariant &b) { return qMax(a.toReal(), b.toReal()); });
+			, [](const LuaValue &a, const LuaValue &b) { return LuaValue(qMax(a.toDouble(), b.toDouble())); });
 	add2aryFunction("atan2", new types::Float(), new types::Float(), new types::Float()
-			, [](const QVariant &y, const QVariant &x) { return qAtan2(y.toReal(), x.toReal()); });
+			, [](const LuaValue &y, const LuaValue &x) { return LuaValue(qAtan2(y.toDouble(), x.toDouble())); });
 }
 
 void RobotsBlockParser::setVariableDependedOnDeviceType(const QString &variable
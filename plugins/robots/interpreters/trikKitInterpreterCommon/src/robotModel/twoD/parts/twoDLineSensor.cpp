@@ -16,8 +16,11 @@
 
 #include <QtGui/QImage>
 
+#include <twoDModel/engine/sensorImageKernels.h>
+
 using namespace trik::robotModel::twoD::parts;
 using namespace kitBase::robotModel;
+using twoDModel::engine::SensorImageKernels;
 
 // The color of the pixel
 const int tolerance = 10;
@@ -36,22 +39,15 @@ void LineSensor::init()
 
 void LineSensor::detectLine()
 {
-	const QImage image = mEngine.areaUnderSensor(port(), 0.2);
+	const QImage image = SensorImageKernels::toKernelFormat(mEngine.areaUnderSensor(port(), 0.2));
 
 	int size = 0;
-	int red = 0;
-	int green = 0;
-	int blue = 0;
-	for (int x = 0; x < image.width(); ++x) {
-		for (int y = 0; y < image.height(); ++y) {
-			const QRgb pixelColor = image.pixel(x, y);
-			if (qAlpha(pixelColor) > 0) {
-				++size;
-				red += qRed(pixelColor);
-				green += qGreen(pixelColor);
-				blue += qBlue(pixelColor);
-			}
-		}
+	quint64 red = 0;
+	quint64 green = 0;
+	quint64 blue = 0;
+	for (int y = 0; y < image.height(); ++y) {
+		const uint *row = reinterpret_cast<const uint *>(image.constScanLine(y));
+		size += SensorImageKernels::sumOpaqueChannels(row, image.width(), red, green, blue);
 	}
 
 	mLineColor = qRgb(red / size, green / size, blue / size);
@@ -59,7 +55,7 @@ void LineSensor::detectLine()
 
 void LineSensor::read()
 {
-	const QImage image = mEngine.areaUnderSensor(port(), 2.0);
+	const QImage image = SensorImageKernels::toKernelFormat(mEngine.areaUnderSensor(port(), 2.0));
 
 	if (image.isNull()) {
 		return;
@@ -74,15 +70,10 @@ void LineSensor::read()
 	int horizontalLineWidth = image.height() * 0.2;
 	qreal xCoordinates = 0;
 	for (int i = 0; i < height; ++i) {
-		int blacksInRow = 0;
-		qreal xSum = 0;
-
-		for (int j = 0; j < width; ++j) {
-			if (closeEnough(image.pixel(j, i))) {
-				++blacksInRow;
-				xSum += j - width / 2.0;
-			}
-		}
+		const uint *row = reinterpret_cast<const uint *>(image.constScanLine(i));
+		qint64 indexSum = 0;
+		const int blacksInRow = SensorImageKernels::countCloseColors(row, width, mLineColor, tolerance, indexSum);
+		const qreal xSum = indexSum - blacksInRow * (width / 2.0);
 
 		xCoordinates += (blacksInRow ? xSum * 100 / (width / 2.0) / blacksInRow : 0);
 		blacks += blacksInRow;
@@ -97,10 +88,3 @@ void LineSensor::read()
 	const int lineWidth = blacks / height;
 	emit newData({ x, cross, lineWidth });
 }
-
-bool LineSensor::closeEnough(QRgb color) const
-{
-	return qAlpha(color) > 0 && qMax(qAbs(qRed(color) - qRed(mLineColor))
-		, qMax(qAbs(qGreen(color) - qGreen(mLineColor))
-		, qAbs(qBlue(color) - qBlue(mLineColor)))) < tolerance;
-}
@@ -79,6 +79,13 @@ void RealRobotModel::updateSensorsValues() const
 	mRobotCommunicator.data()->requestData();
 }
 
+void RealRobotModel::updateSelectedSensorsValues(const QList<PortInfo> &ports) const
+{
+	// Robot sends all the sensor readings in one response anyway, so one request is cheaper than a request per port.
+	Q_UNUSED(ports)
+	mRobotCommunicator.data()->requestData();
+}
+
 bool RealRobotModel::needsConnection() const
 {
 	return true;
@@ -86,6 +93,7 @@ bool RealRobotModel::needsConnection() const
 
 void RealRobotModel::connectToRobot()
 {
+	mRobotCommunicator->subscribeToData(updateIntervalForInterpretation());
 	mRobotCommunicator->connect();
 }
 
@@ -79,6 +79,13 @@ void TrikV6RealRobotModel::updateSensorsValues() const
 	mRobotCommunicator.data()->requestData();
 }
 
+void TrikV6RealRobotModel::updateSelectedSensorsValues(const QList<PortInfo> &ports) const
+{
+	// Robot sends all the sensor readings in one response anyway, so one request is cheaper than a request per port.
+	Q_UNUSED(ports)
+	mRobotCommunicator.data()->requestData();
+}
+
 bool TrikV6RealRobotModel::needsConnection() const
 {
 	return true;
@@ -86,6 +93,7 @@ bool TrikV6RealRobotModel::needsConnection() const
 
 void TrikV6RealRobotModel::connectToRobot()
 {
+	mRobotCommunicator->subscribeToData(updateIntervalForInterpretation());
 	mRobotCommunicator->connect();
 }
 
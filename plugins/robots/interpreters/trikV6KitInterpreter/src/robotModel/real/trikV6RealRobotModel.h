@@ -33,6 +33,7 @@ public:
 	int priority() const override;
 
 	void updateSensorsValues() const override;
+	void updateSelectedSensorsValues(const QList<kitBase::robotModel::PortInfo> &ports) const override;
 	bool needsConnection() const override;
 	void connectToRobot() override;
 	void stopRobot() override;
@@ -54,8 +54,8 @@ public:
 };
 
 /// A helper trait for storing and accessing an existing collection of objects via Qt reflection.
-/// Just QObject wrapper arround the QList<T>.
-template<typename T>
+/// Just QObject wrapper arround the QList<T> or other Qt sequential container.
+template<typename T, typename Container = QList<T>>
 class ObjectsSet : public ObjectsSetBase
 {
 public:
@@ -63,14 +63,14 @@ public:
 	/// Creates new collection wraps some existing data source.
 	/// @param list A collection passed by reference. This list must not be temporal instance
 	/// cause it is not copied.
-	explicit ObjectsSet(const QList<T> &list, QObject *parent = nullptr)
+	explicit ObjectsSet(const Container &list, QObject *parent = nullptr)
 		: ObjectsSetBase(parent)
 		, mList(list)
 	{
 	}
 
 	/// Returns reference to original data source.
-	const QList<T> &data() const
+	const Container &data() const
 	{
 		return mList;
 	}
@@ -103,7 +103,7 @@ public:
 	}
 
 private:
-	const QList<T> &mList;  // Doesn`t take ownership.
+	const Container &mList;  // Doesn`t take ownership.
 };
 
 /// A wrapper arround the QVariantList for getting its properties and elements via Qt reflection.
@@ -51,6 +51,8 @@ public:
 
 	void requestData() override;
 
+	void subscribeToData(int interval) override;
+
 	void connect() override;
 
 	void disconnect() override;
@@ -49,6 +49,10 @@ public:
 	/// Requests telemetry data for all ports.
 	virtual void requestData() = 0;
 
+	/// Asks robot to push telemetry data for all ports every @a interval milliseconds in binary form, requestData()
+	/// is not needed while robot does so. Subscription is renewed on each connection, zero interval cancels it.
+	virtual void subscribeToData(int interval) = 0;
+
 	/// Establishes connection and initializes socket. If connection fails, leaves socket
 	/// in invalid state.
 	virtual void connect() = 0;
@@ -0,0 +1,83 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#pragma once
+
+#include <functional>
+
+#include <QtCore/QStringList>
+
+#include "utils/trajectory/trajectoryRecords.h"
+#include "utils/utilsDeclSpec.h"
+
+class QIODevice;
+
+namespace utils {
+namespace trajectory {
+
+class TrajectoryCursor;
+
+/// Reads binary log written by TrajectoryWriter chunk by chunk, so logs of any length can be processed in
+/// constant memory, also from pipes.
+class ROBOTS_UTILS_EXPORT TrajectoryReader
+{
+public:
+	typedef std::function<void(const TrajectoryPoint &point)> PointHandler;
+	typedef std::function<void(const DeviceState &state)> DeviceStateHandler;
+
+	/// Constructor.
+	/// @param device - a device opened for reading, must outlive the reader.
+	explicit TrajectoryReader(QIODevice &device);
+
+	/// Reads records until the end of the device and passes them to handlers in the order they were written.
+	/// Returns false if the log is malformed or truncated, records preceding the malformed chunk are reported anyway.
+	bool read(const PointHandler &onPoint, const DeviceStateHandler &onDeviceState);
+
+	/// Returns a human-readable description of the last error.
+	QString errorString() const;
+
+	/// Reads binary log from @a binary and writes the same trajectory into @a json, exactly as it would be written
+	/// in JSON format by 2D model checker. Returns false and fills @a errorMessage if the log is malformed.
+	static bool convertToJson(QIODevice &binary, QIODevice &json, QString &errorMessage);
+
+private:
+	bool readHeader();
+
+	/// Reads a chunk payload, returns false with empty error string on the end of the log.
+	bool readChunk(QByteArray &payload);
+
+	/// Reads exactly @a size bytes, waiting for them if the device is sequential.
+	bool readBytes(char *data, qint64 size);
+
+	bool decodeChunk(const QByteArray &payload, const PointHandler &onPoint
+			, const DeviceStateHandler &onDeviceState);
+
+	int readTimestamp(TrajectoryCursor &cursor, int &previous) const;
+	qreal readCoordinate(TrajectoryCursor &cursor, quint64 &previousBits) const;
+
+	QIODevice &mDevice;
+	QString mErrorString;
+	bool mDeltaEncoding = false;
+	QStringList mDictionary;
+
+	int mPreviousPointTimestamp = 0;
+	int mPreviousStateTimestamp = 0;
+	quint64 mPreviousX = 0;
+	quint64 mPreviousY = 0;
+	quint64 mPreviousRotation = 0;
+};
+
+}
+}
@@ -0,0 +1,71 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#pragma once
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonValue>
+#include <QtCore/QPointF>
+#include <QtCore/QString>
+
+#include "utils/utilsDeclSpec.h"
+
+namespace utils {
+namespace trajectory {
+
+/// Position of a robot at some moment of interpretation.
+struct ROBOTS_UTILS_EXPORT TrajectoryPoint
+{
+	QString robotId;
+
+	/// Count of milliseconds passed from the interpretation start.
+	int timestamp;
+
+	/// Position of the robot in scene coordinates.
+	QPointF position;
+
+	/// Rotation angle of the robot in degrees.
+	qreal rotation;
+
+	/// Returns JSON object describing the point, as it is written into JSON trajectory.
+	QJsonObject toJson() const;
+};
+
+/// Modification of some property of robot`s device at some moment of interpretation.
+struct ROBOTS_UTILS_EXPORT DeviceState
+{
+	QString robotId;
+
+	/// Count of milliseconds passed from the interpretation start.
+	int timestamp;
+
+	/// Type name of the device obtained by DeviceInfo::name().
+	QString device;
+
+	/// Name of the port the device is plugged into, obtained by PortInfo::name().
+	QString port;
+
+	/// Name of the modified Q_PROPERTY.
+	QString property;
+
+	/// New value of the property.
+	QJsonValue value;
+
+	/// Returns JSON object describing the modification, as it is written into JSON trajectory.
+	QJsonObject toJson() const;
+};
+
+}
+}
@@ -0,0 +1,82 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "utils/trajectory/trajectoryRecords.h"
+#include "utils/utilsDeclSpec.h"
+
+class QIODevice;
+
+namespace utils {
+namespace trajectory {
+
+/// Writes robot trajectory and device states into compact binary log, a much smaller and cheaper to produce
+/// alternative to JSON trajectory. Records are buffered and written in chunks, each chunk stores them column by
+/// column, strings like robot ids and port names are stored once per log. The log can be read by
+/// TrajectoryReader and converted by it to JSON trajectory.
+class ROBOTS_UTILS_EXPORT TrajectoryWriter
+{
+public:
+	/// Constructor, writes log header into @a device.
+	/// @param device - a device opened for writing, must outlive the writer.
+	/// @param deltaEncoding - if true, timestamps and coordinates are stored as differences with previous ones.
+	/// @param chunkSize - count of records buffered before they are written into the device.
+	explicit TrajectoryWriter(QIODevice &device, bool deltaEncoding = true, int chunkSize = 256);
+
+	/// Writes buffered records.
+	~TrajectoryWriter();
+
+	void writePoint(const TrajectoryPoint &point);
+	void writeDeviceState(const DeviceState &state);
+
+	/// Writes buffered records into the device and flushes it, so they become available to a reader on
+	/// the other side of a pipe.
+	void flush();
+
+private:
+	/// Returns an index of the string in the dictionary, adding it there if needed.
+	int intern(const QString &string);
+
+	/// Counts a record in runs of records of the same kind.
+	void addToRuns(bool isDeviceState);
+
+	void appendTimestamp(QByteArray &out, int timestamp, int &previous) const;
+	void appendCoordinate(QByteArray &out, qreal value, quint64 &previousBits) const;
+
+	QIODevice &mDevice;
+	const bool mDeltaEncoding;
+	const int mChunkSize;
+
+	QHash<QString, int> mDictionary;
+	QStringList mNewStrings;
+
+	QVector<int> mRuns;
+	QVector<TrajectoryPoint> mPoints;
+	QVector<DeviceState> mStates;
+
+	int mPreviousPointTimestamp = 0;
+	int mPreviousStateTimestamp = 0;
+	quint64 mPreviousX = 0;
+	quint64 mPreviousY = 0;
+	quint64 mPreviousRotation = 0;
+};
+
+}
+}
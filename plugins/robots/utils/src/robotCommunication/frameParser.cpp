@@ -0,0 +1,68 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include "frameParser.h"
+
+#include <qrkernel/logging.h>
+
+using namespace utils::robotCommunication;
+
+void FrameParser::append(const QByteArray &data)
+{
+	if (mPosition > 0 && mPosition >= mBuffer.size() - mPosition) {
+		mBuffer.remove(0, mPosition);
+		mPosition = 0;
+	}
+
+	mBuffer.append(data);
+}
+
+bool FrameParser::takeMessage(QByteArray &message)
+{
+	while (mExpectedBytes == 0) {
+		// Determining the length of a message.
+		const int delimiterIndex = mBuffer.indexOf(':', mPosition);
+		if (delimiterIndex == -1) {
+			// We did not receive full message length yet.
+			return false;
+		}
+
+		const QByteArray length = QByteArray::fromRawData(mBuffer.constData() + mPosition, delimiterIndex - mPosition);
+		mPosition = delimiterIndex + 1;
+		bool ok = false;
+		mExpectedBytes = length.toInt(&ok);
+		if (!ok || mExpectedBytes < 0) {
+			QLOG_ERROR() << "Malformed message, can not determine message length from this:" << length;
+			mExpectedBytes = 0;
+		}
+	}
+
+	if (mBuffer.size() - mPosition < mExpectedBytes) {
+		// We don't have all message yet.
+		return false;
+	}
+
+	message = mBuffer.mid(mPosition, mExpectedBytes);
+	mPosition += mExpectedBytes;
+	mExpectedBytes = 0;
+	return true;
+}
+
+void FrameParser::clear()
+{
+	mBuffer.clear();
+	mPosition = 0;
+	mExpectedBytes = 0;
+}
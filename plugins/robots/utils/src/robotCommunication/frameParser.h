@@ -0,0 +1,50 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#pragma once
+
+#include <QtCore/QByteArray>
+
+namespace utils {
+namespace robotCommunication {
+
+/// Splits a stream of bytes received from a socket into messages of "<data length in bytes>:<data>" form.
+/// Received bytes are kept in one buffer with a read position moving over it, so taking a message copies only that
+/// message and not the rest of the buffer. Consumed bytes are dropped when there are more of them than unread ones,
+/// so each byte is moved at most a constant number of times in average.
+class FrameParser
+{
+public:
+	/// Appends bytes received from a socket.
+	void append(const QByteArray &data);
+
+	/// Takes next complete message into @a message. Returns false if there is no complete message yet.
+	bool takeMessage(QByteArray &message);
+
+	/// Forgets all received bytes, for example when connection is reopened.
+	void clear();
+
+private:
+	QByteArray mBuffer;
+
+	/// Index of the first unread byte in the buffer.
+	int mPosition = 0;
+
+	/// Declared size of a current message, 0 if its length is not received yet.
+	int mExpectedBytes = 0;
+};
+
+}
+}
@@ -52,8 +52,7 @@ bool TcpConnectionHandler::connect(const QHostAddress &serverAddress)
 		mKeepAliveTimer.start();
 	}
 
-	mBuffer.clear();
-	mExpectedBytes = 0;
+	mParser.clear();
 
 	return result;
 }
@@ -97,38 +96,11 @@ void TcpConnectionHandler::onIncomingData()
 		return;
 	}
 
-	const QByteArray &data = mSocket.readAll();
-	mBuffer.append(data);
-
-	while (!mBuffer.isEmpty()) {
-		if (mExpectedBytes == 0) {
-			// Determining the length of a message.
-			const int delimiterIndex = mBuffer.indexOf(':');
-			if (delimiterIndex == -1) {
-				// We did not receive full message length yet.
-				return;
-			} else {
-				const QByteArray length = mBuffer.left(delimiterIndex);
-				mBuffer = mBuffer.mid(delimiterIndex + 1);
-				bool ok = false;
-				mExpectedBytes = length.toInt(&ok);
-				if (!ok) {
-					QLOG_ERROR() << "Malformed message, can not determine message length from this:" << length;
-					mExpectedBytes = 0;
-				}
-			}
-		} else {
-			if (mBuffer.size() >= mExpectedBytes) {
-				const QByteArray message = mBuffer.left(mExpectedBytes);
-				mBuffer = mBuffer.mid(mExpectedBytes);
-				emit messageReceived(message);
-
-				mExpectedBytes = 0;
-			} else {
-				// We don't have all message yet.
-				return;
-			}
-		}
+	mParser.append(mSocket.readAll());
+
+	QByteArray message;
+	while (mParser.takeMessage(message)) {
+		emit messageReceived(message);
 	}
 }
 
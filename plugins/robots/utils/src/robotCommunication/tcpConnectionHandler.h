@@ -17,6 +17,8 @@
 #include <QtNetwork/QTcpSocket>
 #include <QtCore/QTimer>
 
+#include "frameParser.h"
+
 namespace utils {
 namespace robotCommunication {
 
@@ -36,7 +38,7 @@ public:
 	void send(const QString &data);
 
 signals:
-	void messageReceived(const QString &message);
+	void messageReceived(const QByteArray &message);
 
 private slots:
 	void onIncomingData();
@@ -45,8 +47,7 @@ private slots:
 
 private:
 	QTcpSocket mSocket;
-	QByteArray mBuffer;
-	int mExpectedBytes = 0;
+	FrameParser mParser;
 	const int mPort;
 
 	/// Timer used to send "keepalive" packets for other side to be able to detect connection failure.
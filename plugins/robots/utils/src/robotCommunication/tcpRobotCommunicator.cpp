@@ -129,6 +129,11 @@ void TcpRobotCommunicator::requestData()
 	QMetaObject::invokeMethod(mWorker.data(), "requestData");
 }
 
+void TcpRobotCommunicator::subscribeToData(int interval)
+{
+	QMetaObject::invokeMethod(mWorker.data(), "subscribeToData", Q_ARG(int, interval));
+}
+
 void TcpRobotCommunicator::connect()
 {
 	QMetaObject::invokeMethod(mWorker.data(), "connect");
@@ -46,7 +46,9 @@ void TcpRobotCommunicatorWorker::init()
 	mTelemetryConnection.reset(new TcpConnectionHandler(telemetryPort));
 
 	QObject::connect(mControlConnection.data(), &TcpConnectionHandler::messageReceived
-			, this, &TcpRobotCommunicatorWorker::processControlMessage, Qt::DirectConnection);
+			, this, [this](const QByteArray &message) {
+				processControlMessage(QString::fromUtf8(message));
+			}, Qt::DirectConnection);
 	QObject::connect(mTelemetryConnection.data(), &TcpConnectionHandler::messageReceived
 			, this, &TcpRobotCommunicatorWorker::processTelemetryMessage, Qt::DirectConnection);
 }
@@ -124,13 +126,33 @@ void TcpRobotCommunicatorWorker::requestData(const QString &sensor)
 
 void TcpRobotCommunicatorWorker::requestData()
 {
-	if (!mTelemetryConnection->isConnected()) {
+	if (!mTelemetryConnection->isConnected() || mSubscribed) {
 		return;
 	}
 
 	mTelemetryConnection->send("data");
 }
 
+void TcpRobotCommunicatorWorker::subscribeToData(int interval)
+{
+	mTelemetryInterval = interval;
+	if (mTelemetryConnection->isConnected()) {
+		sendSubscription();
+	}
+}
+
+void TcpRobotCommunicatorWorker::sendSubscription()
+{
+	if (mTelemetryInterval > 0) {
+		mTelemetryConnection->send("subscribe:" + QString::number(mTelemetryInterval));
+	} else if (mSubscribed) {
+		mTelemetryConnection->send("unsubscribe");
+	}
+
+	// Robot confirms new subscription, polling is used until then.
+	mSubscribed = false;
+}
+
 void TcpRobotCommunicatorWorker::processControlMessage(const QString &message)
 {
 	const QString errorMarker("error: ");
@@ -167,25 +189,43 @@ void TcpRobotCommunicatorWorker::processControlMessage(const QString &message)
 	}
 }
 
-void TcpRobotCommunicatorWorker::processTelemetryMessage(const QString &message)
+void TcpRobotCommunicatorWorker::processTelemetryMessage(const QByteArray &message)
 {
+	const QByteArray frameMarker("frame:");
+	if (message.startsWith(frameMarker)) {
+		const bool ok = mTelemetryCodec.decode(message.constData() + frameMarker.size()
+				, message.size() - frameMarker.size()
+				, [this](const QString &port, int value) { emit newScalarSensorData(port, value); }
+				, [this](const QString &port, const QVector<int> &values) { emit newVectorSensorData(port, values); });
+		if (!ok) {
+			QLOG_ERROR() << "Malformed telemetry frame of" << message.size() << "bytes";
+		}
+
+		return;
+	}
+
+	const QString text = QString::fromUtf8(message);
 	const QString sensorMarker("sensor:");
 	const QString allDataMarker("allData:");
+	const QString subscribedMarker("subscribed:");
 
-	if (message.startsWith(sensorMarker)) {
-		QString data(message);
+	if (text.startsWith(sensorMarker)) {
+		QString data(text);
 		data.remove(0, sensorMarker.length());
 		handleValue(data);
-	} else if (message.startsWith(allDataMarker)) {
-		QString data(message);
+	} else if (text.startsWith(allDataMarker)) {
+		QString data(text);
 		data.remove(0, allDataMarker.length());
 		QStringList values = data.split(';');
 		for (QString value : values) {
 			handleValue(value);
 		}
 
+	} else if (text.startsWith(subscribedMarker)) {
+		mSubscribed = true;
+		QLOG_INFO() << "Robot pushes telemetry every" << text.mid(subscribedMarker.length()) << "ms";
 	} else {
-		QLOG_INFO() << "Incoming message of unknown type: " << message;
+		QLOG_INFO() << "Incoming message of unknown type: " << text;
 	}
 }
 
@@ -242,6 +282,10 @@ void TcpRobotCommunicatorWorker::connect()
 	const bool result = mControlConnection->connect(hostAddress) && mTelemetryConnection->connect(hostAddress);
 	if (result) {
 		versionRequest();
+		if (mTelemetryInterval > 0) {
+			sendSubscription();
+		}
+
 		emit connected();
 	} else {
 		emit connectionError(tr("Connection failed. IP: %1").arg(server));
@@ -252,6 +296,7 @@ void TcpRobotCommunicatorWorker::disconnectConnection()
 {
 	mControlConnection->disconnect();
 	mTelemetryConnection->disconnect();
+	mSubscribed = false;
 
 	emit disconnected();
 }
@@ -18,6 +18,7 @@
 #include <QtCore/QTimer>
 
 #include "tcpConnectionHandler.h"
+#include "telemetryCodec.h"
 
 namespace utils {
 namespace robotCommunication {
@@ -74,9 +75,14 @@ public:
 	/// Requests telemetry data for given sensor.
 	Q_INVOKABLE void requestData(const QString &sensor);
 
-	/// Requests telemetry data for all ports.
+	/// Requests telemetry data for all ports. Does nothing while robot pushes telemetry by subscription.
 	Q_INVOKABLE void requestData();
 
+	/// Asks robot to push telemetry data for all ports every @a interval milliseconds, now and after each
+	/// reconnection. Zero interval cancels the subscription. Robots that do not support subscriptions do not confirm
+	/// it and keep answering requestData().
+	Q_INVOKABLE void subscribeToData(int interval);
+
 	/// Establishes connection.
 	Q_INVOKABLE void connect();
 
@@ -132,7 +138,7 @@ private slots:
 	void processControlMessage(const QString &message);
 
 	/// Process telemetry message from robot. Emits signals with sensor data.
-	void processTelemetryMessage(const QString &message);
+	void processTelemetryMessage(const QByteArray &message);
 
 	/// TRIK Runtime version request timed out. Most likely caused by network problems.
 	void onVersionTimeOut();
@@ -147,6 +153,9 @@ private:
 	/// Sends version request and starts version timer
 	void versionRequest();
 
+	/// Sends "subscribe" or "unsubscribe" command on telemetry connection according to requested interval.
+	void sendSubscription();
+
 	/// Name of a registry key where robot IP addres is stored. Stored here instead of actual IP since IP may change
 	/// during the work and it is easier to get it from registry every time.
 	const QString mRobotIpRegistryKey;
@@ -162,6 +171,15 @@ private:
 
 	/// Timer for version request.
 	QScopedPointer<QTimer> mVersionTimer;
+
+	/// Decoder of binary telemetry frames, keeps port names between frames.
+	TelemetryCodec mTelemetryCodec;
+
+	/// Interval of telemetry pushing requested by subscribeToData(), 0 if telemetry is requested by polling.
+	int mTelemetryInterval = 0;
+
+	/// True if robot confirmed that it pushes telemetry, requestData() calls are not needed then.
+	bool mSubscribed = false;
 };
 
 }
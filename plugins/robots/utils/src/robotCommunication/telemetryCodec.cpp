@@ -0,0 +1,92 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include "telemetryCodec.h"
+
+#include <QtCore/QtEndian>
+
+using namespace utils::robotCommunication;
+
+bool TelemetryCodec::decode(const char *data, int size
+		, const ScalarHandler &onScalar, const VectorHandler &onVector)
+{
+	const uchar *current = reinterpret_cast<const uchar *>(data);
+	const uchar * const end = current + size;
+	while (current < end) {
+		const int portLength = *current++;
+		if (end - current < portLength + 1) {
+			return false;
+		}
+
+		const QString &port = portName(reinterpret_cast<const char *>(current), portLength);
+		current += portLength;
+
+		const int count = *current++;
+		const int valuesCount = count == 0 ? 1 : count;
+		if (end - current < valuesCount * 4) {
+			return false;
+		}
+
+		if (count == 0) {
+			onScalar(port, qFromLittleEndian<qint32>(current));
+			current += 4;
+			continue;
+		}
+
+		mValues.resize(count);
+		for (int i = 0; i < count; ++i, current += 4) {
+			mValues[i] = qFromLittleEndian<qint32>(current);
+		}
+
+		onVector(port, mValues);
+	}
+
+	return true;
+}
+
+void TelemetryCodec::appendScalar(QByteArray &frame, const QByteArray &port, int value)
+{
+	Q_ASSERT(port.size() <= 255);
+	uchar buffer[4];
+	frame.append(static_cast<char>(port.size()));
+	frame.append(port);
+	frame.append('\0');
+	qToLittleEndian<qint32>(value, buffer);
+	frame.append(reinterpret_cast<const char *>(buffer), 4);
+}
+
+void TelemetryCodec::appendVector(QByteArray &frame, const QByteArray &port, const QVector<int> &values)
+{
+	Q_ASSERT(port.size() <= 255 && !values.isEmpty() && values.size() <= 255);
+	uchar buffer[4];
+	frame.append(static_cast<char>(port.size()));
+	frame.append(port);
+	frame.append(static_cast<char>(values.size()));
+	for (const int value : values) {
+		qToLittleEndian<qint32>(value, buffer);
+		frame.append(reinterpret_cast<const char *>(buffer), 4);
+	}
+}
+
+const QString &TelemetryCodec::portName(const char *data, int size)
+{
+	const QByteArray key = QByteArray::fromRawData(data, size);
+	const auto known = mPortNames.constFind(key);
+	if (known != mPortNames.constEnd()) {
+		return known.value();
+	}
+
+	return mPortNames.insert(QByteArray(data, size), QString::fromLatin1(data, size)).value();
+}
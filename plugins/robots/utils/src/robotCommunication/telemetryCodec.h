@@ -0,0 +1,59 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#pragma once
+
+#include <functional>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+
+namespace utils {
+namespace robotCommunication {
+
+/// Encodes and decodes binary telemetry frames that robot pushes after "subscribe:<interval>" command.
+/// A frame is a sequence of readings, each of them is
+/// - length of port name (1 byte) and port name itself in Latin-1,
+/// - number of values (1 byte), zero stands for a scalar reading with exactly one value,
+/// - values as 4-byte little-endian signed integers.
+/// Robot may put several readings of the same port taken one after another into one frame, they are reported
+/// in the order of appearance.
+class TelemetryCodec
+{
+public:
+	typedef std::function<void(const QString &port, int value)> ScalarHandler;
+	typedef std::function<void(const QString &port, const QVector<int> &values)> VectorHandler;
+
+	/// Decodes a frame of @a size bytes reporting each reading to one of the handlers. Returns false if the frame
+	/// is malformed, readings preceding the malformed one are reported anyway.
+	bool decode(const char *data, int size, const ScalarHandler &onScalar, const VectorHandler &onVector);
+
+	/// Appends scalar reading of the given port to the frame. Port name shall be not longer than 255 bytes.
+	static void appendScalar(QByteArray &frame, const QByteArray &port, int value);
+
+	/// Appends vector reading of the given port to the frame. Vector shall contain from 1 to 255 values.
+	static void appendVector(QByteArray &frame, const QByteArray &port, const QVector<int> &values);
+
+private:
+	/// Returns a string with port name, port names are created once per connection and then shared.
+	const QString &portName(const char *data, int size);
+
+	QHash<QByteArray, QString> mPortNames;
+	QVector<int> mValues;
+};
+
+}
+}
@@ -0,0 +1,217 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include "trajectoryEncoding.h"
+
+#include <cmath>
+#include <cstring>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QtEndian>
+
+using namespace utils::trajectory;
+
+/// Doubles with greater absolute value may be not representable as integers exactly.
+const double maxExactInteger = 9007199254740992.0;
+
+QByteArray TrajectoryEncoding::magic()
+{
+	return QByteArray("TRJB", 4);
+}
+
+void TrajectoryEncoding::appendVarint(QByteArray &out, quint64 value)
+{
+	while (value >= 0x80) {
+		out.append(static_cast<char>((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+
+	out.append(static_cast<char>(value));
+}
+
+void TrajectoryEncoding::appendSignedVarint(QByteArray &out, qint64 value)
+{
+	appendVarint(out, (static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63));
+}
+
+void TrajectoryEncoding::appendDouble(QByteArray &out, double value)
+{
+	uchar bytes[8];
+	qToLittleEndian<quint64>(doubleToBits(value), bytes);
+	out.append(reinterpret_cast<const char *>(bytes), 8);
+}
+
+void TrajectoryEncoding::appendString(QByteArray &out, const QString &string)
+{
+	const QByteArray utf8 = string.toUtf8();
+	appendVarint(out, utf8.size());
+	out.append(utf8);
+}
+
+void TrajectoryEncoding::appendValue(QByteArray &out, const QJsonValue &value)
+{
+	switch (value.type()) {
+	case QJsonValue::Bool:
+		out.append(static_cast<char>(value.toBool() ? trueValue : falseValue));
+		return;
+	case QJsonValue::Double: {
+		const double number = value.toDouble();
+		if (std::floor(number) == number && std::fabs(number) < maxExactInteger
+				&& !(number == 0 && std::signbit(number)))
+		{
+			out.append(static_cast<char>(integerValue));
+			appendSignedVarint(out, static_cast<qint64>(number));
+		} else {
+			out.append(static_cast<char>(doubleValue));
+			appendDouble(out, number);
+		}
+
+		return;
+	}
+	case QJsonValue::String:
+		out.append(static_cast<char>(stringValue));
+		appendString(out, value.toString());
+		return;
+	case QJsonValue::Array:
+		out.append(static_cast<char>(jsonValue));
+		appendString(out, QString::fromUtf8(QJsonDocument(value.toArray()).toJson(QJsonDocument::Compact)));
+		return;
+	case QJsonValue::Object:
+		out.append(static_cast<char>(jsonValue));
+		appendString(out, QString::fromUtf8(QJsonDocument(value.toObject()).toJson(QJsonDocument::Compact)));
+		return;
+	default:
+		out.append(static_cast<char>(nullValue));
+		return;
+	}
+}
+
+quint64 TrajectoryEncoding::doubleToBits(double value)
+{
+	quint64 bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+double TrajectoryEncoding::bitsToDouble(quint64 bits)
+{
+	double value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+TrajectoryCursor::TrajectoryCursor(const QByteArray &data)
+	: mCurrent(reinterpret_cast<const uchar *>(data.constData()))
+	, mEnd(mCurrent + data.size())
+	, mOk(true)
+{
+}
+
+quint64 TrajectoryCursor::varint()
+{
+	quint64 result = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		if (mCurrent == mEnd) {
+			break;
+		}
+
+		const uchar byte = *mCurrent++;
+		result |= static_cast<quint64>(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			return result;
+		}
+	}
+
+	mOk = false;
+	return 0;
+}
+
+qint64 TrajectoryCursor::signedVarint()
+{
+	const quint64 value = varint();
+	return static_cast<qint64>(value >> 1) ^ -static_cast<qint64>(value & 1);
+}
+
+double TrajectoryCursor::doubleValue()
+{
+	if (mEnd - mCurrent < 8) {
+		mOk = false;
+		mCurrent = mEnd;
+		return 0;
+	}
+
+	const quint64 bits = qFromLittleEndian<quint64>(mCurrent);
+	mCurrent += 8;
+	return TrajectoryEncoding::bitsToDouble(bits);
+}
+
+QString TrajectoryCursor::string()
+{
+	const quint64 size = varint();
+	if (static_cast<quint64>(mEnd - mCurrent) < size) {
+		mOk = false;
+		mCurrent = mEnd;
+		return QString();
+	}
+
+	const QString result = QString::fromUtf8(reinterpret_cast<const char *>(mCurrent), static_cast<int>(size));
+	mCurrent += size;
+	return result;
+}
+
+QJsonValue TrajectoryCursor::value()
+{
+	if (mCurrent == mEnd) {
+		mOk = false;
+		return QJsonValue();
+	}
+
+	switch (*mCurrent++) {
+	case TrajectoryEncoding::nullValue:
+		return QJsonValue();
+	case TrajectoryEncoding::falseValue:
+		return false;
+	case TrajectoryEncoding::trueValue:
+		return true;
+	case TrajectoryEncoding::integerValue:
+		return static_cast<double>(signedVarint());
+	case TrajectoryEncoding::doubleValue:
+		return doubleValue();
+	case TrajectoryEncoding::stringValue:
+		return string();
+	case TrajectoryEncoding::jsonValue: {
+		const QJsonDocument document = QJsonDocument::fromJson(string().toUtf8());
+		if (document.isArray()) {
+			return document.array();
+		} else if (document.isObject()) {
+			return document.object();
+		}
+
+		break;
+	}
+	default:
+		break;
+	}
+
+	mOk = false;
+	return QJsonValue();
+}
+
+bool TrajectoryCursor::ok() const
+{
+	return mOk;
+}
@@ -0,0 +1,101 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonValue>
+#include <QtCore/QString>
+
+namespace utils {
+namespace trajectory {
+
+/// Layout of binary trajectory log and primitives it is built of.
+///
+/// A log starts with a header: "TRJB" magic, format version byte and flags byte. Then chunks follow, each of them
+/// is its payload size as varint and the payload itself:
+/// - count of strings added to the dictionary and the strings, each is referred later by its index in order
+///   of appearance among all the chunks;
+/// - count of runs and lengths of runs of records of the same kind, runs of points and device states alternate,
+///   the first run is a run of points and may be empty;
+/// - columns of points: robot ids, timestamps, x, y, rotations;
+/// - columns of device states: robot ids, timestamps, devices, ports, properties, values.
+///
+/// Integers are LEB128 varints, signed ones are zigzag-encoded first. Doubles are 8 little-endian bytes.
+/// With deltaEncoding flag timestamps are stored as differences with previous timestamp in the same column,
+/// and doubles are stored as varints of XOR of their bits with bits of previous value in the same column, so
+/// small moves of a robot take a few bytes and standing still takes one byte. Previous values are carried
+/// from chunk to chunk and start from zero.
+class TrajectoryEncoding
+{
+public:
+	enum Flag
+	{
+		deltaEncoding = 0x1
+	};
+
+	/// Tags of device state values.
+	enum ValueTag
+	{
+		nullValue = 0
+		, falseValue
+		, trueValue
+		/// Integral number, stored as signed varint.
+		, integerValue
+		, doubleValue
+		, stringValue
+		/// Array or object, stored as string with compact JSON.
+		, jsonValue
+	};
+
+	static const quint8 version = 1;
+
+	/// Returns magic bytes the log starts with.
+	static QByteArray magic();
+
+	static void appendVarint(QByteArray &out, quint64 value);
+	static void appendSignedVarint(QByteArray &out, qint64 value);
+	static void appendDouble(QByteArray &out, double value);
+	static void appendString(QByteArray &out, const QString &string);
+	static void appendValue(QByteArray &out, const QJsonValue &value);
+
+	static quint64 doubleToBits(double value);
+	static double bitsToDouble(quint64 bits);
+};
+
+/// Reads primitives of binary trajectory log one after another from a chunk payload. On malformed or truncated
+/// data returns zeros and empty values and remembers that an error occured.
+class TrajectoryCursor
+{
+public:
+	explicit TrajectoryCursor(const QByteArray &data);
+
+	quint64 varint();
+	qint64 signedVarint();
+	double doubleValue();
+	QString string();
+	QJsonValue value();
+
+	/// Returns false if some read went beyond the data or met malformed value.
+	bool ok() const;
+
+private:
+	const uchar *mCurrent;
+	const uchar *mEnd;
+	bool mOk;
+};
+
+}
+}
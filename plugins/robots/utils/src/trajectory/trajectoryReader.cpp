@@ -0,0 +1,261 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include "utils/trajectory/trajectoryReader.h"
+
+#include <QtCore/QIODevice>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QObject>
+
+#include "trajectoryEncoding.h"
+
+using namespace utils::trajectory;
+
+/// Chunks are small, so greater sizes are treated as malformed data rather than allocated.
+const quint64 maxChunkSize = 256 * 1024 * 1024;
+
+TrajectoryReader::TrajectoryReader(QIODevice &device)
+	: mDevice(device)
+{
+}
+
+bool TrajectoryReader::read(const PointHandler &onPoint, const DeviceStateHandler &onDeviceState)
+{
+	mErrorString.clear();
+	if (!readHeader()) {
+		return false;
+	}
+
+	QByteArray payload;
+	while (readChunk(payload)) {
+		if (!decodeChunk(payload, onPoint, onDeviceState)) {
+			return false;
+		}
+	}
+
+	return mErrorString.isEmpty();
+}
+
+QString TrajectoryReader::errorString() const
+{
+	return mErrorString;
+}
+
+bool TrajectoryReader::convertToJson(QIODevice &binary, QIODevice &json, QString &errorMessage)
+{
+	bool first = true;
+	const auto writeRecord = [&json, &first](const QJsonObject &record) {
+		json.write(first ? "" : ", ");
+		json.write(QJsonDocument(record).toJson());
+		first = false;
+	};
+
+	json.write("[\n");
+	TrajectoryReader reader(binary);
+	const bool result = reader.read(
+			[&writeRecord](const TrajectoryPoint &point) { writeRecord(point.toJson()); }
+			, [&writeRecord](const DeviceState &state) { writeRecord(state.toJson()); });
+	json.write("]\n");
+
+	errorMessage = reader.errorString();
+	return result;
+}
+
+bool TrajectoryReader::readHeader()
+{
+	const QByteArray magic = TrajectoryEncoding::magic();
+	QByteArray header(magic.size() + 2, '\0');
+	if (!readBytes(header.data(), header.size()) || !header.startsWith(magic)) {
+		mErrorString = QObject::tr("Not a binary trajectory");
+		return false;
+	}
+
+	if (static_cast<quint8>(header[magic.size()]) != TrajectoryEncoding::version) {
+		mErrorString = QObject::tr("Unsupported binary trajectory version");
+		return false;
+	}
+
+	mDeltaEncoding = header[magic.size() + 1] & TrajectoryEncoding::deltaEncoding;
+	return true;
+}
+
+bool TrajectoryReader::readChunk(QByteArray &payload)
+{
+	quint64 size = 0;
+	for (int shift = 0; ; shift += 7) {
+		char byte = 0;
+		if (!readBytes(&byte, 1)) {
+			if (shift > 0) {
+				mErrorString = QObject::tr("Binary trajectory is truncated");
+			}
+
+			return false;
+		}
+
+		size |= static_cast<quint64>(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			break;
+		}
+
+		if (shift > 56) {
+			mErrorString = QObject::tr("Binary trajectory is malformed");
+			return false;
+		}
+	}
+
+	if (size > maxChunkSize) {
+		mErrorString = QObject::tr("Binary trajectory is malformed");
+		return false;
+	}
+
+	payload.resize(static_cast<int>(size));
+	if (!readBytes(payload.data(), payload.size())) {
+		mErrorString = QObject::tr("Binary trajectory is truncated");
+		return false;
+	}
+
+	return true;
+}
+
+bool TrajectoryReader::readBytes(char *data, qint64 size)
+{
+	while (size > 0) {
+		const qint64 read = mDevice.read(data, size);
+		if (read < 0 || (read == 0 && !mDevice.waitForReadyRead(-1))) {
+			return false;
+		}
+
+		data += read;
+		size -= read;
+	}
+
+	return true;
+}
+
+bool TrajectoryReader::decodeChunk(const QByteArray &payload, const PointHandler &onPoint
+		, const DeviceStateHandler &onDeviceState)
+{
+	TrajectoryCursor cursor(payload);
+	const quint64 newStrings = cursor.varint();
+	for (quint64 i = 0; i < newStrings && cursor.ok(); ++i) {
+		mDictionary << cursor.string();
+	}
+
+	const quint64 runsCount = cursor.varint();
+	QVector<int> runs;
+	int pointsCount = 0;
+	int statesCount = 0;
+	for (quint64 i = 0; i < runsCount && cursor.ok(); ++i) {
+		const quint64 run = cursor.varint();
+		// Each record takes at least one byte in its robot ids column, so there can not be more records than bytes.
+		if (run > static_cast<quint64>(payload.size() - pointsCount - statesCount)) {
+			mErrorString = QObject::tr("Binary trajectory is malformed");
+			return false;
+		}
+
+		runs << static_cast<int>(run);
+		(i % 2 ? statesCount : pointsCount) += static_cast<int>(run);
+	}
+
+	const auto word = [this, &cursor]() {
+		const quint64 index = cursor.varint();
+		return index < static_cast<quint64>(mDictionary.size()) ? mDictionary[static_cast<int>(index)] : QString();
+	};
+
+	QVector<TrajectoryPoint> points(pointsCount);
+	for (TrajectoryPoint &point : points) {
+		point.robotId = word();
+	}
+
+	for (TrajectoryPoint &point : points) {
+		point.timestamp = readTimestamp(cursor, mPreviousPointTimestamp);
+	}
+
+	for (TrajectoryPoint &point : points) {
+		point.position.setX(readCoordinate(cursor, mPreviousX));
+	}
+
+	for (TrajectoryPoint &point : points) {
+		point.position.setY(readCoordinate(cursor, mPreviousY));
+	}
+
+	for (TrajectoryPoint &point : points) {
+		point.rotation = readCoordinate(cursor, mPreviousRotation);
+	}
+
+	QVector<DeviceState> states(statesCount);
+	for (DeviceState &state : states) {
+		state.robotId = word();
+	}
+
+	for (DeviceState &state : states) {
+		state.timestamp = readTimestamp(cursor, mPreviousStateTimestamp);
+	}
+
+	for (DeviceState &state : states) {
+		state.device = word();
+	}
+
+	for (DeviceState &state : states) {
+		state.port = word();
+	}
+
+	for (DeviceState &state : states) {
+		state.property = word();
+	}
+
+	for (DeviceState &state : states) {
+		state.value = cursor.value();
+	}
+
+	if (!cursor.ok()) {
+		mErrorString = QObject::tr("Binary trajectory is malformed");
+		return false;
+	}
+
+	int point = 0;
+	int state = 0;
+	for (int i = 0; i < runs.size(); ++i) {
+		for (int j = 0; j < runs[i]; ++j) {
+			if (i % 2) {
+				onDeviceState(states[state++]);
+			} else {
+				onPoint(points[point++]);
+			}
+		}
+	}
+
+	return true;
+}
+
+int TrajectoryReader::readTimestamp(TrajectoryCursor &cursor, int &previous) const
+{
+	if (mDeltaEncoding) {
+		previous += static_cast<int>(cursor.signedVarint());
+		return previous;
+	}
+
+	return static_cast<int>(cursor.signedVarint());
+}
+
+qreal TrajectoryReader::readCoordinate(TrajectoryCursor &cursor, quint64 &previousBits) const
+{
+	if (mDeltaEncoding) {
+		previousBits ^= cursor.varint();
+		return TrajectoryEncoding::bitsToDouble(previousBits);
+	}
+
+	return cursor.doubleValue();
+}
@@ -0,0 +1,41 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include "utils/trajectory/trajectoryRecords.h"
+
+using namespace utils::trajectory;
+
+QJsonObject TrajectoryPoint::toJson() const
+{
+	QJsonObject result;
+	result["robotId"] = robotId;
+	result["timestamp"] = timestamp;
+	result["x"] = position.x();
+	result["y"] = position.y();
+	result["rotation"] = rotation;
+	return result;
+}
+
+QJsonObject DeviceState::toJson() const
+{
+	QJsonObject result;
+	result["robotId"] = robotId;
+	result["timestamp"] = timestamp;
+	result["device"] = device;
+	result["port"] = port;
+	result["property"] = property;
+	result["value"] = value;
+	return result;
+}
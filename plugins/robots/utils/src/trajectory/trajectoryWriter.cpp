@@ -0,0 +1,182 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include "utils/trajectory/trajectoryWriter.h"
+
+#include <QtCore/QFileDevice>
+
+#include "trajectoryEncoding.h"
+
+using namespace utils::trajectory;
+
+TrajectoryWriter::TrajectoryWriter(QIODevice &device, bool deltaEncoding, int chunkSize)
+	: mDevice(device)
+	, mDeltaEncoding(deltaEncoding)
+	, mChunkSize(qMax(1, chunkSize))
+{
+	QByteArray header = TrajectoryEncoding::magic();
+	header.append(static_cast<char>(TrajectoryEncoding::version));
+	header.append(static_cast<char>(mDeltaEncoding ? TrajectoryEncoding::deltaEncoding : 0));
+	mDevice.write(header);
+}
+
+TrajectoryWriter::~TrajectoryWriter()
+{
+	flush();
+}
+
+void TrajectoryWriter::writePoint(const TrajectoryPoint &point)
+{
+	mPoints << point;
+	addToRuns(false);
+	if (mPoints.size() + mStates.size() >= mChunkSize) {
+		flush();
+	}
+}
+
+void TrajectoryWriter::writeDeviceState(const DeviceState &state)
+{
+	mStates << state;
+	addToRuns(true);
+	if (mPoints.size() + mStates.size() >= mChunkSize) {
+		flush();
+	}
+}
+
+void TrajectoryWriter::flush()
+{
+	if (!mRuns.isEmpty()) {
+		// Strings are interned before anything else is written, so new ones get into this chunk's dictionary part.
+		QByteArray columns;
+		for (const TrajectoryPoint &point : mPoints) {
+			TrajectoryEncoding::appendVarint(columns, intern(point.robotId));
+		}
+
+		for (const TrajectoryPoint &point : mPoints) {
+			appendTimestamp(columns, point.timestamp, mPreviousPointTimestamp);
+		}
+
+		for (const TrajectoryPoint &point : mPoints) {
+			appendCoordinate(columns, point.position.x(), mPreviousX);
+		}
+
+		for (const TrajectoryPoint &point : mPoints) {
+			appendCoordinate(columns, point.position.y(), mPreviousY);
+		}
+
+		for (const TrajectoryPoint &point : mPoints) {
+			appendCoordinate(columns, point.rotation, mPreviousRotation);
+		}
+
+		for (const DeviceState &state : mStates) {
+			TrajectoryEncoding::appendVarint(columns, intern(state.robotId));
+		}
+
+		for (const DeviceState &state : mStates) {
+			appendTimestamp(columns, state.timestamp, mPreviousStateTimestamp);
+		}
+
+		for (const DeviceState &state : mStates) {
+			TrajectoryEncoding::appendVarint(columns, intern(state.device));
+		}
+
+		for (const DeviceState &state : mStates) {
+			TrajectoryEncoding::appendVarint(columns, intern(state.port));
+		}
+
+		for (const DeviceState &state : mStates) {
+			TrajectoryEncoding::appendVarint(columns, intern(state.property));
+		}
+
+		for (const DeviceState &state : mStates) {
+			TrajectoryEncoding::appendValue(columns, state.value);
+		}
+
+		QByteArray payload;
+		TrajectoryEncoding::appendVarint(payload, mNewStrings.size());
+		for (const QString &string : mNewStrings) {
+			TrajectoryEncoding::appendString(payload, string);
+		}
+
+		TrajectoryEncoding::appendVarint(payload, mRuns.size());
+		for (const int run : mRuns) {
+			TrajectoryEncoding::appendVarint(payload, run);
+		}
+
+		payload.append(columns);
+
+		QByteArray chunk;
+		TrajectoryEncoding::appendVarint(chunk, payload.size());
+		chunk.append(payload);
+		mDevice.write(chunk);
+
+		mNewStrings.clear();
+		mRuns.clear();
+		mPoints.clear();
+		mStates.clear();
+	}
+
+	if (QFileDevice * const file = qobject_cast<QFileDevice *>(&mDevice)) {
+		file->flush();
+	}
+}
+
+int TrajectoryWriter::intern(const QString &string)
+{
+	const auto existing = mDictionary.constFind(string);
+	if (existing != mDictionary.constEnd()) {
+		return existing.value();
+	}
+
+	const int index = mDictionary.size();
+	mDictionary.insert(string, index);
+	mNewStrings << string;
+	return index;
+}
+
+void TrajectoryWriter::addToRuns(bool isDeviceState)
+{
+	// Runs of points have even indices and runs of device states have odd ones.
+	if (mRuns.isEmpty() && isDeviceState) {
+		mRuns << 0;
+	}
+
+	if (!mRuns.isEmpty() && ((mRuns.size() - 1) % 2 == 1) == isDeviceState) {
+		++mRuns.last();
+	} else {
+		mRuns << 1;
+	}
+}
+
+void TrajectoryWriter::appendTimestamp(QByteArray &out, int timestamp, int &previous) const
+{
+	if (mDeltaEncoding) {
+		TrajectoryEncoding::appendSignedVarint(out, static_cast<qint64>(timestamp) - previous);
+		previous = timestamp;
+	} else {
+		TrajectoryEncoding::appendSignedVarint(out, timestamp);
+	}
+}
+
+void TrajectoryWriter::appendCoordinate(QByteArray &out, qreal value, quint64 &previousBits) const
+{
+	if (mDeltaEncoding) {
+		const quint64 bits = TrajectoryEncoding::doubleToBits(value);
+		TrajectoryEncoding::appendVarint(out, bits ^ previousBits);
+		previousBits = bits;
+	} else {
+		TrajectoryEncoding::appendDouble(out, value);
+	}
+}
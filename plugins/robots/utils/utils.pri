@@ -47,13 +47,19 @@ HEADERS += \
 	$$PWD/include/utils/robotCommunication/tcpRobotCommunicator.h \
 	$$PWD/include/utils/robotCommunication/tcpRobotCommunicatorInterface.h \
 	$$PWD/include/utils/robotCommunication/uploadProgramProtocol.h \
+	$$PWD/include/utils/trajectory/trajectoryReader.h \
+	$$PWD/include/utils/trajectory/trajectoryRecords.h \
+	$$PWD/include/utils/trajectory/trajectoryWriter.h \
 	$$PWD/include/utils/widgets/comPortPicker.h \
 
 HEADERS += \
+	$$PWD/src/robotCommunication/frameParser.h \
 	$$PWD/src/robotCommunication/protocol.h \
 	$$PWD/src/robotCommunication/guardSignalGenerator.h \
 	$$PWD/src/robotCommunication/tcpConnectionHandler.h \
 	$$PWD/src/robotCommunication/tcpRobotCommunicatorWorker.h \
+	$$PWD/src/robotCommunication/telemetryCodec.h \
+	$$PWD/src/trajectory/trajectoryEncoding.h \
 	$$PWD/src/graphicsWatcher/keyPoint.h \
 	$$PWD/src/graphicsWatcher/pointsQueueProcessor.h \
 	$$PWD/src/graphicsWatcher/sensorViewer.h \
@@ -73,6 +79,7 @@ SOURCES += \
 	$$PWD/src/canvas/rectangleObject.cpp \
 	$$PWD/src/canvas/textObject.cpp \
 	$$PWD/src/widgets/comPortPicker.cpp \
+	$$PWD/src/robotCommunication/frameParser.cpp \
 	$$PWD/src/robotCommunication/networkCommunicationErrorReporter.cpp \
 	$$PWD/src/robotCommunication/protocol.cpp \
 	$$PWD/src/robotCommunication/robotCommunicator.cpp \
@@ -82,7 +89,12 @@ SOURCES += \
 	$$PWD/src/robotCommunication/tcpRobotCommunicator.cpp \
 	$$PWD/src/robotCommunication/tcpConnectionHandler.cpp \
 	$$PWD/src/robotCommunication/tcpRobotCommunicatorWorker.cpp \
+	$$PWD/src/robotCommunication/telemetryCodec.cpp \
 	$$PWD/src/robotCommunication/uploadProgramProtocol.cpp \
+	$$PWD/src/trajectory/trajectoryEncoding.cpp \
+	$$PWD/src/trajectory/trajectoryReader.cpp \
+	$$PWD/src/trajectory/trajectoryRecords.cpp \
+	$$PWD/src/trajectory/trajectoryWriter.cpp \
 	$$PWD/src/graphicsWatcher/keyPoint.cpp \
 	$$PWD/src/graphicsWatcher/pointsQueueProcessor.cpp \
 	$$PWD/src/graphicsWatcher/sensorsGraph.cpp \
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <QtCore/QSet>
+
 #include "qrgraph/node.h"
 #include "qrgraph/edge.h"
 
@@ -37,6 +39,10 @@ public:
 	/// Returns true if this multigraph instance has \a node vertex.
 	bool containsNode(Node &node) const;
 
+	/// Returns a number that changes each time when nodes or edges are added, removed, connected or disconnected.
+	/// Can be used to check that some data computed from multigraph (for example Snapshot) is still actual.
+	int revision() const;
+
 	/// Returns true if this multigraph instance has \a edge, no matter hanging or not.
 	bool containsEdge(Edge &edge) const;
 
@@ -93,7 +99,11 @@ public:
 
 private:
 	QList<Node *> mNodes;
+	QSet<Node *> mNodesSet;
 	QMultiHash<uint, Edge *> mEdges;
+	int mRevision = 0;
+
+	friend class Node;
 };
 
 }
@@ -0,0 +1,89 @@
+/* Copyright 2016 Dmitry Mordvinov
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QBitArray>
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+
+#include "qrgraph/multigraph.h"
+
+namespace qrgraph {
+
+/// Immutable compact copy of multigraph structure made at some moment. Edges of each type are kept in
+/// compressed sparse row form: followers (and predecessors) of each vertex lie in one contiguous array, so they are
+/// enumerated without building lists of edges. For requested edge types transitive closure is precomputed,
+/// reachability queries then take constant time.
+/// Snapshot does not track changes of multigraph, Multigraph::revision() can be used to find out that it must
+/// be rebuilt. Queries for nodes that were not in multigraph at the moment of snapshot are answered by Queries.
+class Snapshot
+{
+public:
+	/// Freezes current structure of \a graph.
+	/// @param closureTypes Types of edges for which transitive closure will be computed.
+	Snapshot(const Multigraph &graph, const QList<uint> &closureTypes = QList<uint>());
+
+	/// Returns revision of multigraph at the moment of snapshot.
+	int revision() const;
+
+	/// Returns a number of vertices in snapshot.
+	int verticesCount() const;
+
+	/// Returns index of \a node in snapshot or -1 if node was not in multigraph at the moment of snapshot.
+	/// Nodes are indexed in the order of Multigraph::vertices().
+	int indexOf(const Node &node) const;
+
+	/// Returns a node by its index in snapshot.
+	const Node &node(int index) const;
+
+	/// Returns a list of nodes reachable from \a node in one step towards edges of \a edgeType.
+	/// Same as Queries::immediateFollowers(), each node is met in resulting list not more than once.
+	QList<const Node *> immediateFollowers(const Node &node, uint edgeType) const;
+
+	/// Returns a list of such nodes that \a node is reachable from them in one step towards edges of \a edgeType.
+	/// Same as Queries::immediatePredecessors(), each node is met in resulting list not more than once.
+	QList<const Node *> immediatePredecessors(const Node &node, uint edgeType) const;
+
+	/// Returns true if \a to vertex is reachable from \a from vertex when transiting only by edges of type \a edgeType.
+	/// Takes constant time if transitive closure was computed for \a edgeType. Node is always reachable from itself.
+	bool isReachable(const Node &from, const Node &to, uint edgeType) const;
+
+	/// Returns a list of nodes reachable from \a node in any number of steps towards edges of \a edgeType.
+	/// \a node is always included into resulting list, each node is met there not more than once.
+	QList<const Node *> reachableSet(const Node &node, uint edgeType) const;
+
+private:
+	/// Edges of one type: ends of edges going from vertex i are targets[offsets[i]] .. targets[offsets[i + 1] - 1].
+	struct Adjacency
+	{
+		QVector<int> offsets;
+		QVector<int> targets;
+	};
+
+	static Adjacency buildAdjacency(int verticesCount, const QVector<QPair<int, int>> &edges);
+	QList<const Node *> neighbours(const QHash<uint, Adjacency> &adjacencies, int index, uint edgeType) const;
+	QBitArray reachable(int index, uint edgeType) const;
+
+	int mRevision;
+	QVector<const Node *> mNodes;
+	QHash<const Node *, int> mIndices;
+	QHash<uint, Adjacency> mFollowers;
+	QHash<uint, Adjacency> mPredecessors;
+
+	/// Bit j of mClosures[type][i] is set if vertex j is reachable from vertex i by edges of the type.
+	QHash<uint, QVector<QBitArray>> mClosures;
+};
+
+}
@@ -21,9 +21,11 @@ HEADERS += \
 	$$PWD/include/qrgraph/node.h \
 	$$PWD/include/qrgraph/edge.h \
 	$$PWD/include/qrgraph/queries.h \
+	$$PWD/include/qrgraph/snapshot.h \
 
 SOURCES += \
 	$$PWD/src/multigraph.cpp \
 	$$PWD/src/node.cpp \
 	$$PWD/src/edge.cpp \
 	$$PWD/src/queries.cpp \
+	$$PWD/src/snapshot.cpp \
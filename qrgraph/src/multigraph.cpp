@@ -37,7 +37,12 @@ const QList<Node *> &Multigraph::vertices() const
 
 bool Multigraph::containsNode(Node &node) const
 {
-	return mNodes.contains(&node);
+	return mNodesSet.contains(&node);
+}
+
+int Multigraph::revision() const
+{
+	return mRevision;
 }
 
 bool Multigraph::containsEdge(Edge &edge) const
@@ -72,29 +77,36 @@ void Multigraph::clear()
 	}
 
 	mNodes.clear();
+	mNodesSet.clear();
 	mEdges.clear();
+	++mRevision;
 }
 
 Node &Multigraph::produceNode()
 {
 	Node * const node = new Node(*this);
 	mNodes << node;
+	mNodesSet.insert(node);
+	++mRevision;
 	return *node;
 }
 
 void Multigraph::addNode(Node &node)
 {
-	if (&node.graph() != this || mNodes.contains(&node)) {
+	if (&node.graph() != this || mNodesSet.contains(&node)) {
 		return;
 	}
 
 	mNodes << &node;
+	mNodesSet.insert(&node);
+	++mRevision;
 }
 
 Edge &Multigraph::produceEdge(uint type)
 {
 	Edge * const edge = new Edge(*this, type);
 	mEdges.insert(type, edge);
+	++mRevision;
 	return *edge;
 }
 
@@ -119,13 +131,16 @@ void Multigraph::addEdge(Edge &edge)
 	}
 
 	mEdges.insert(edge.type(), &edge);
+	++mRevision;
 }
 
 void Multigraph::removeNode(Node &node, bool deleteHangingEdges)
 {
-	Q_ASSERT_X(mNodes.contains(&node), Q_FUNC_INFO, "Attepmt to remove nonexisting node");
+	Q_ASSERT_X(mNodesSet.contains(&node), Q_FUNC_INFO, "Attepmt to remove nonexisting node");
 	node.disconnectAll(deleteHangingEdges);
-	mNodes.removeAll(&node);
+	mNodes.removeOne(&node);
+	mNodesSet.remove(&node);
+	++mRevision;
 	delete &node;
 }
 
@@ -133,5 +148,6 @@ void Multigraph::removeEdge(Edge &edge)
 {
 	Q_ASSERT_X(mEdges.contains(edge.type(), &edge), Q_FUNC_INFO, "Attepmt to remove nonexisting edge");
 	mEdges.remove(edge.type(), &edge);
+	++mRevision;
 	delete &edge;
 }
@@ -78,24 +78,28 @@ void Node::connectBeginOf(Edge &edge)
 {
 	Q_ASSERT_X(!mOutgoingEdges.contains(edge.type(), &edge), Q_FUNC_INFO, "Edge begin is already connected");
 	mOutgoingEdges.insert(edge.type(), &edge);
+	++mParent.mRevision;
 }
 
 void Node::connectEndOf(Edge &edge)
 {
 	Q_ASSERT_X(!mIncomingEdges.contains(edge.type(), &edge), Q_FUNC_INFO, "Edge end is already connected");
 	mIncomingEdges.insert(edge.type(), &edge);
+	++mParent.mRevision;
 }
 
 void Node::disconnectBeginOf(Edge &edge)
 {
 	Q_ASSERT_X(mOutgoingEdges.contains(edge.type(), &edge), Q_FUNC_INFO, "Edge begin is not connected");
 	mOutgoingEdges.remove(edge.type(), &edge);
+	++mParent.mRevision;
 }
 
 void Node::disconnectEndOf(Edge &edge)
 {
 	Q_ASSERT_X(mIncomingEdges.contains(edge.type(), &edge), Q_FUNC_INFO, "Edge end is not connected");
 	mIncomingEdges.remove(edge.type(), &edge);
+	++mParent.mRevision;
 }
 
 void Node::disconnectOutgoing(bool deleteHangingEdges)
@@ -0,0 +1,207 @@
+/* Copyright 2016 Dmitry Mordvinov
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "qrgraph/snapshot.h"
+
+#include <algorithm>
+
+#include "qrgraph/queries.h"
+
+using namespace qrgraph;
+
+Snapshot::Snapshot(const Multigraph &graph, const QList<uint> &closureTypes)
+	: mRevision(graph.revision())
+{
+	for (const Node *node : graph.vertices()) {
+		mIndices[node] = mNodes.size();
+		mNodes << node;
+	}
+
+	QHash<uint, QVector<QPair<int, int>>> edges;
+	for (int from = 0; from < mNodes.size(); ++from) {
+		for (const Edge *edge : mNodes[from]->outgoingEdges()) {
+			const int to = edge->end() ? mIndices.value(edge->end(), -1) : -1;
+			if (to >= 0) {
+				edges[edge->type()] << qMakePair(from, to);
+			}
+		}
+	}
+
+	for (auto it = edges.begin(); it != edges.end(); ++it) {
+		mFollowers[it.key()] = buildAdjacency(mNodes.size(), it.value());
+		for (QPair<int, int> &edge : it.value()) {
+			qSwap(edge.first, edge.second);
+		}
+
+		mPredecessors[it.key()] = buildAdjacency(mNodes.size(), it.value());
+	}
+
+	for (const uint type : closureTypes) {
+		QVector<QBitArray> &closure = mClosures[type];
+		closure.reserve(mNodes.size());
+		for (int i = 0; i < mNodes.size(); ++i) {
+			closure << reachable(i, type);
+		}
+	}
+}
+
+Snapshot::Adjacency Snapshot::buildAdjacency(int verticesCount, const QVector<QPair<int, int>> &edges)
+{
+	// Counting sort by the begin of edge, parallel edges are then merged.
+	Adjacency result;
+	result.offsets.fill(0, verticesCount + 1);
+	for (const QPair<int, int> &edge : edges) {
+		++result.offsets[edge.first + 1];
+	}
+
+	for (int i = 0; i < verticesCount; ++i) {
+		result.offsets[i + 1] += result.offsets[i];
+	}
+
+	QVector<int> position = result.offsets;
+	QVector<int> targets(edges.size());
+	for (const QPair<int, int> &edge : edges) {
+		targets[position[edge.first]++] = edge.second;
+	}
+
+	result.targets.reserve(targets.size());
+	for (int i = 0; i < verticesCount; ++i) {
+		const int begin = result.offsets[i];
+		const int end = result.offsets[i + 1];
+		result.offsets[i] = result.targets.size();
+		for (int j = begin; j < end; ++j) {
+			if (!std::count(result.targets.constBegin() + result.offsets[i], result.targets.constEnd(), targets[j])) {
+				result.targets << targets[j];
+			}
+		}
+	}
+
+	result.offsets[verticesCount] = result.targets.size();
+	return result;
+}
+
+int Snapshot::revision() const
+{
+	return mRevision;
+}
+
+int Snapshot::verticesCount() const
+{
+	return mNodes.size();
+}
+
+int Snapshot::indexOf(const Node &node) const
+{
+	return mIndices.value(&node, -1);
+}
+
+const Node &Snapshot::node(int index) const
+{
+	return *mNodes[index];
+}
+
+QList<const Node *> Snapshot::immediateFollowers(const Node &node, uint edgeType) const
+{
+	const int index = indexOf(node);
+	return index < 0
+			? Queries::immediateFollowers(node, edgeType)
+			: neighbours(mFollowers, index, edgeType);
+}
+
+QList<const Node *> Snapshot::immediatePredecessors(const Node &node, uint edgeType) const
+{
+	const int index = indexOf(node);
+	return index < 0
+			? Queries::immediatePredecessors(node, edgeType)
+			: neighbours(mPredecessors, index, edgeType);
+}
+
+bool Snapshot::isReachable(const Node &from, const Node &to, uint edgeType) const
+{
+	if (&from == &to) {
+		return true;
+	}
+
+	const int fromIndex = indexOf(from);
+	const int toIndex = indexOf(to);
+	if (fromIndex < 0 || toIndex < 0) {
+		return Queries::isReachable(from, to, edgeType);
+	}
+
+	const auto closure = mClosures.constFind(edgeType);
+	return closure != mClosures.constEnd()
+			? closure.value()[fromIndex].testBit(toIndex)
+			: reachable(fromIndex, edgeType).testBit(toIndex);
+}
+
+QList<const Node *> Snapshot::reachableSet(const Node &node, uint edgeType) const
+{
+	const int index = indexOf(node);
+	if (index < 0) {
+		return Queries::reachableSet(node, edgeType);
+	}
+
+	const auto closure = mClosures.constFind(edgeType);
+	const QBitArray reachableNodes = closure != mClosures.constEnd()
+			? closure.value()[index]
+			: reachable(index, edgeType);
+
+	QList<const Node *> result;
+	for (int i = 0; i < reachableNodes.size(); ++i) {
+		if (reachableNodes.testBit(i)) {
+			result << mNodes[i];
+		}
+	}
+
+	return result;
+}
+
+QList<const Node *> Snapshot::neighbours(const QHash<uint, Adjacency> &adjacencies, int index, uint edgeType) const
+{
+	QList<const Node *> result;
+	const auto adjacency = adjacencies.constFind(edgeType);
+	if (adjacency == adjacencies.constEnd()) {
+		return result;
+	}
+
+	for (int i = adjacency->offsets[index]; i < adjacency->offsets[index + 1]; ++i) {
+		result << mNodes[adjacency->targets[i]];
+	}
+
+	return result;
+}
+
+QBitArray Snapshot::reachable(int index, uint edgeType) const
+{
+	QBitArray result(mNodes.size());
+	result.setBit(index);
+	const auto adjacency = mFollowers.constFind(edgeType);
+	if (adjacency == mFollowers.constEnd()) {
+		return result;
+	}
+
+	QVector<int> stack = { index };
+	while (!stack.isEmpty()) {
+		const int vertex = stack.takeLast();
+		for (int i = adjacency->offsets[vertex]; i < adjacency->offsets[vertex + 1]; ++i) {
+			const int follower = adjacency->targets[i];
+			if (!result.testBit(follower)) {
+				result.setBit(follower);
+				stack << follower;
+			}
+		}
+	}
+
+	return result;
+}
@@ -22,7 +22,7 @@
 #include <QtWidgets/QToolTip>
 #include <QtWidgets/QGraphicsDropShadowEffect>
 
-#include <math.h>
+#include <cmath>
 #include <qrkernel/logging.h>
 #include <qrutils/scalableItem.h>
 
@@ -47,6 +47,11 @@ using namespace qReal::commands;
 using namespace qReal::gui::editor;
 using namespace qReal::gui::editor::commands;
 
+/// Shapes are cached rendered at a power of two not less than the current zoom, so panning and small zoom changes
+/// reuse the cache. Zoomed-out views use the cache of minimal scale, zoomed-in views are drawn as vectors.
+const qreal minShapeCacheScale = 0.125;
+const qreal maxShapeCacheScale = 1.0;
+
 NodeElement::NodeElement(const NodeElementType &type, const Id &id, const models::Models &models)
 	: Element(type, id, models)
 	, mType(type)
@@ -183,6 +188,7 @@ void NodeElement::updateDynamicProperties(const Id &target)
 			mRenderer.load(picture);
 		}
 
+		invalidateShapeCache();
 		update();
 	}
 
@@ -859,6 +865,8 @@ QRectF NodeElement::boundingRect() const
 void NodeElement::updateData()
 {
 	Element::updateData();
+	// Shape may show some properties conditionally.
+	invalidateShapeCache();
 	if (!mMoving) {
 		QPointF newpos = mGraphicalAssistApi.position(id());
 		QPolygon newpoly = mGraphicalAssistApi.configuration(id());
@@ -931,7 +939,7 @@ void NodeElement::setPortsVisible(const QStringList &types)
 
 void NodeElement::paint(QPainter *painter, const QStyleOptionGraphicsItem *style, QWidget *)
 {
-	mRenderer.render(painter, mContents);
+	paintShape(painter);
 	paint(painter, style);
 
 	if (mSelectionNeeded) {
@@ -985,8 +993,12 @@ void NodeElement::paint(QPainter *painter, const QStyleOptionGraphicsItem *optio
 
 		if (mIsExpanded && mLogicalAssistApi.logicalRepoApi().outgoingExplosion(logicalId()) != Id()) {
 			QRectF rect = diagramRenderingRect();
-			painter->drawImage(rect, mRenderedDiagram.scaled(rect.size().toSize()
-					, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+			const QSize size = mRenderedDiagram.size().scaled(rect.size().toSize(), Qt::KeepAspectRatio);
+			if (mScaledRenderedDiagram.size() != size) {
+				mScaledRenderedDiagram = mRenderedDiagram.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+			}
+
+			painter->drawImage(rect, mScaledRenderedDiagram);
 		}
 	}
 }
@@ -1388,6 +1400,43 @@ AbstractCommand *NodeElement::changeParentCommand(const Id &newParent, const QPo
 void NodeElement::updateShape(const QDomElement &graphicsSdf)
 {
 	mRenderer.load(graphicsSdf);
+	invalidateShapeCache();
+}
+
+void NodeElement::paintShape(QPainter *painter)
+{
+	const QRectF area = boundingRect();
+	const qreal levelOfDetail = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+	if (levelOfDetail > maxShapeCacheScale || area.isEmpty()) {
+		mRenderer.render(painter, mContents);
+		return;
+	}
+
+	const qreal scale = qPow(2, qCeil(std::log2(qMax(levelOfDetail, minShapeCacheScale))))
+			* painter->device()->devicePixelRatio();
+	if (mShapeCache.isNull() || mShapeCacheScale != scale || mShapeCacheSize != area.size()) {
+		mShapeCache = QPixmap((area.size() * scale).toSize());
+		mShapeCache.fill(Qt::transparent);
+		QPainter cachePainter(&mShapeCache);
+		cachePainter.setRenderHints(painter->renderHints());
+		cachePainter.scale(scale, scale);
+		cachePainter.translate(-area.topLeft());
+		mRenderer.render(&cachePainter, mContents);
+		mShapeCacheScale = scale;
+		mShapeCacheSize = area.size();
+	}
+
+	painter->drawPixmap(area, mShapeCache, QRectF(mShapeCache.rect()));
+}
+
+void NodeElement::invalidateShapeCache()
+{
+	mShapeCache = QPixmap();
+}
+
+bool NodeElement::isShapeCached() const
+{
+	return !mShapeCache.isNull();
 }
 
 IdList NodeElement::sortedChildren() const
@@ -1441,6 +1490,7 @@ void NodeElement::initRenderedDiagram()
 	view.mutableScene().render(&painter);
 
 	mRenderedDiagram = image;
+	mScaledRenderedDiagram = QImage();
 }
 
 QRectF NodeElement::diagramRenderingRect() const
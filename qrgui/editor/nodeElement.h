@@ -25,6 +25,7 @@
 #include <QtWidgets/QWidget>
 #include <QtCore/QList>
 #include <QtCore/QTimer>
+#include <QtGui/QPixmap>
 
 #include <qrgui/plugins/pluginManager/sdfRenderer.h>
 #include <qrgui/models/nodeInfo.h>
@@ -65,6 +66,9 @@ public:
 
 	void paint(QPainter *p, const QStyleOptionGraphicsItem *opt, QWidget *w) override;
 
+	/// Returns true if rendered appearance of the element is cached and will be reused by the next paint().
+	bool isShapeCached() const;
+
 	QRectF boundingRect() const override;
 
 	/// Current value of mContents
@@ -241,6 +245,13 @@ private:
 	void paint(QPainter *p, const QStyleOptionGraphicsItem *opt);
 	void drawPorts(QPainter *painter, bool mouseOver);
 
+	/// Draws the shape of the element from the cache of its rendered appearance. The cache is rendered again
+	/// when it is invalidated or when the size of element or the zoom bucket changes.
+	void paintShape(QPainter *painter);
+
+	/// Forgets rendered appearance of the element, must be called when something shown by its shape may change.
+	void invalidateShapeCache();
+
 	/**
 	 * Recalculates mHighlightedNode according to current mouse scene position.
 	 * @param mouseScenePos Current mouse scene position.
@@ -305,8 +316,13 @@ private:
 	NodeElement *mHighlightedNode;
 
 	QImage mRenderedDiagram;
+	QImage mScaledRenderedDiagram;
 	QTimer mRenderTimer;
 
+	QPixmap mShapeCache;
+	QSizeF mShapeCacheSize;
+	qreal mShapeCacheScale = 0;
+
 	/// Used in updateDynamicProperties() for deleting old dynamic labels.
 	int mStartingLabelsCount;
 
@@ -14,10 +14,12 @@
 
 #pragma once
 
+#include <QtCore/QScopedPointer>
 #include <QtCore/QtPlugin>
 #include <QtGui/QIcon>
 
 #include <qrgraph/multigraph.h>
+#include <qrgraph/snapshot.h>
 
 #include "metaMetaModel/elementType.h"
 
@@ -153,6 +155,10 @@ public:
 	/// @note Metamodel will take ownership in created explosion.
 	void addExplosion(ElementType &source, ElementType &target, bool isReusable, bool requiresImmediateLinkage);
 
+	/// Returns frozen structure of this metamodel with precomputed transitive closure of generalization relation.
+	/// It is built on the first query after metamodel is loaded and rebuilt if metamodel was modified since then.
+	const qrgraph::Snapshot &snapshot() const;
+
 private:
 	QString mId;
 	QString mVersion;
@@ -168,6 +174,7 @@ private:
 	QMap<QString, QMap<QString, QStringList>> mPaletteGroupContents;
 	QMap<QString, QMap<QString, QString>> mPaletteGroupDescriptions;
 	QMap<QString, bool> mPaletteSorting;
+	mutable QScopedPointer<qrgraph::Snapshot> mSnapshot;
 };
 
 /// An interface for all objects that load information into metamodel.
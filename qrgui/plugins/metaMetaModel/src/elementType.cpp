@@ -89,22 +89,20 @@ const Id ElementType::typeId() const
 
 bool ElementType::isParent(const ElementType &parent) const
 {
-	return qrgraph::Queries::isReachableInTree(*this, parent, generalizationLinkType);
+	return metamodel().snapshot().isReachable(*this, parent, generalizationLinkType);
 }
 
 IdList ElementType::containedTypes() const
 {
 	QSet<Id> result;
-	qrgraph::Queries::treeLift(*this, [&result](const Node &parent) {
-		const QList<const Node *> nodes = qrgraph::Queries::immediateFollowers(parent, containmentLinkType);
-		for (const qrgraph::Node *node : nodes) {
+	const qrgraph::Snapshot &snapshot = metamodel().snapshot();
+	for (const Node *parent : snapshot.reachableSet(*this, generalizationLinkType)) {
+		for (const qrgraph::Node *node : snapshot.immediateFollowers(*parent, containmentLinkType)) {
 			if (const ElementType *type = dynamic_cast<const ElementType *>(node)) {
 				result.insert(type->typeId());
 			}
 		}
-
-		return false;
-	}, generalizationLinkType);
+	}
 
 	return result.toList();
 }
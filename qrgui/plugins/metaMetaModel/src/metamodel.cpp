@@ -204,3 +204,12 @@ void Metamodel::addExplosion(ElementType &source, ElementType &target, bool isRe
 	explosion->connectBegin(source);
 	explosion->connectEnd(target);
 }
+
+const qrgraph::Snapshot &Metamodel::snapshot() const
+{
+	if (!mSnapshot || mSnapshot->revision() != revision()) {
+		mSnapshot.reset(new qrgraph::Snapshot(*this, { ElementType::generalizationLinkType }));
+	}
+
+	return *mSnapshot;
+}
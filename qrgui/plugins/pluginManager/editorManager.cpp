@@ -22,7 +22,6 @@
 #include <qrkernel/platformInfo.h>
 #include <qrkernel/exception/exception.h>
 #include <qrrepo/repoApi.h>
-#include <qrgraph/queries.h>
 #include <metaMetaModel/metamodel.h>
 #include <metaMetaModel/nodeElementType.h>
 #include <metaMetaModel/edgeElementType.h>
@@ -577,7 +576,8 @@ QString EditorManager::propertyNameByDisplayedName(const Id &id, const QString &
 
 IdList EditorManager::children(const Id &parent) const
 {
-	const QList<const qrgraph::Node *> childNodes = qrgraph::Queries::immediatePredecessors(elementType(parent)
+	const ElementType &parentType = elementType(parent);
+	const QList<const qrgraph::Node *> childNodes = parentType.metamodel().snapshot().immediatePredecessors(parentType
 			, ElementType::generalizationLinkType);
 	IdList result;
 	for (const qrgraph::Node * const node : childNodes) {
@@ -14,6 +14,9 @@
 
 #include "sdfRenderer.h"
 
+#include <algorithm>
+
+#include <QtCore/QHash>
 #include <QtCore/QLineF>
 #include <QtCore/QTime>
 #include <QtCore/QDebug>
@@ -30,7 +33,7 @@
 using namespace qReal;
 
 SdfRenderer::SdfRenderer()
-	: mStartX(0), mStartY(0), mNeedScale(true), mElementRepo(0)
+	: mStartX(0), mStartY(0), mNeedScale(true)
 {
 	mWorkingDirName = SettingsManager::value("workingDir").toString();
 }
@@ -60,6 +63,7 @@ bool SdfRenderer::load(const QString &filename)
 	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
 		return false;
 
+	QDomDocument doc;
 	if (!doc.setContent(&file))
 	{
 		file.close();
@@ -70,26 +74,26 @@ bool SdfRenderer::load(const QString &filename)
 	QDomElement docElem = doc.documentElement();
 	first_size_x = docElem.attribute("sizex").toInt();
 	first_size_y = docElem.attribute("sizey").toInt();
+	compile(docElem);
 
 	return true;
 }
 
 bool SdfRenderer::load(const QDomDocument &document)
 {
-	doc = document;
-	const QDomElement docElem = doc.firstChildElement("picture");
+	const QDomElement docElem = document.firstChildElement("picture");
 	first_size_x = docElem.attribute("sizex").toInt();
 	first_size_y = docElem.attribute("sizey").toInt();
+	compile(document.documentElement());
 
 	return true;
 }
 
 bool SdfRenderer::load(const QDomElement &picture)
 {
-	doc.appendChild(doc.importNode(picture, true));
-	const QDomElement docElem = doc.firstChildElement("picture");
-	first_size_x = docElem.attribute("sizex").toInt();
-	first_size_y = docElem.attribute("sizey").toInt();
+	first_size_x = picture.attribute("sizex").toInt();
+	first_size_y = picture.attribute("sizey").toInt();
+	compile(picture);
 
 	return true;
 }
@@ -104,689 +108,598 @@ void SdfRenderer::setZoom(qreal zoomFactor)
 	mZoom = zoomFactor;
 }
 
-void SdfRenderer::render(QPainter *painter, const QRectF &bounds, bool isIcon)
+void SdfRenderer::compile(const QDomElement &picture)
 {
-	current_size_x = static_cast<int>(bounds.width());
-	current_size_y = static_cast<int>(bounds.height());
-	mStartX = static_cast<int>(bounds.x());
-	mStartY = static_cast<int>(bounds.y());
-	this->painter = painter;
-	QDomElement docElem = doc.documentElement();
-	QDomNode node = docElem.firstChild();
-	while(!node.isNull())
-	{
-		QDomElement elem = node.toElement();
-		if(!elem.isNull())
-		{
-			if (!checkShowConditions(elem, isIcon)) {
-				node = node.nextSibling();
-				continue;
-			}
-			if (elem.tagName()=="line")
-			{
-				line(elem);
-			}
-			else if(elem.tagName()=="ellipse")
-			{
-				ellipse(elem);
-			}
-			else if (elem.tagName() == "arc") {
-				arc(elem);
-			}
-			else if(elem.tagName()=="background")
-			{
-				background(elem);
-			}
-			else if(elem.tagName()=="text")
-			{
-				draw_text(elem);
-			}
-			else if (elem.tagName()=="rectangle")
-			{
-				rectangle(elem);
-			}
-			else if (elem.tagName()=="polygon")
-			{
-				polygon(elem);
-			}
-			else if (elem.tagName()=="point")
-			{
-				point(elem);
-			}
-			else if(elem.tagName()=="path")
-			{
-				path_draw(elem);
-			}
-			else if(elem.tagName()=="stylus")
-			{
-				stylus_draw(elem);
-			}
-			else if(elem.tagName()=="curve")
-			{
-				curve_draw(elem);
-			}
-			else if(elem.tagName()=="image")
-			{
-				image_draw(elem);
+	mPrimitives.clear();
+	QDomElement element = picture.firstChildElement();
+	while (!element.isNull()) {
+		compileElement(element, compileConditions(element));
+		element = element.nextSiblingElement();
+	}
+}
+
+void SdfRenderer::compileElement(const QDomElement &element, const QVector<Condition> &conditions)
+{
+	static const QHash<QString, Primitive::Type> types = {
+		{ "line", Primitive::line }
+		, { "ellipse", Primitive::ellipse }
+		, { "arc", Primitive::arc }
+		, { "background", Primitive::background }
+		, { "text", Primitive::text }
+		, { "rectangle", Primitive::rectangle }
+		, { "polygon", Primitive::polygon }
+		, { "point", Primitive::point }
+		, { "path", Primitive::path }
+		, { "curve", Primitive::curve }
+		, { "image", Primitive::image }
+	};
+
+	if (element.tagName() == "stylus") {
+		// Lines of a stylus have their own styles, but are shown by conditions of the stylus.
+		QDomElement line = element.firstChildElement("line");
+		while (!line.isNull()) {
+			compileElement(line, conditions);
+			line = line.nextSiblingElement("line");
+		}
+
+		return;
+	}
+
+	const auto type = types.constFind(element.tagName());
+	if (type == types.constEnd()) {
+		return;
+	}
+
+	Primitive primitive;
+	primitive.type = type.value();
+	primitive.style = compileStyle(element);
+	primitive.conditions = conditions;
+
+	switch (primitive.type) {
+	case Primitive::polygon: {
+		const int n = element.attribute("n").toInt();
+		for (int i = 1; i <= n; ++i) {
+			primitive.coordinates << compileCoordinate(element.attribute("x" + QString::number(i)))
+					<< compileCoordinate(element.attribute("y" + QString::number(i)));
+		}
+
+		break;
+	}
+	case Primitive::path:
+		primitive.pathSegments = compilePath(element.attribute("d"));
+		break;
+	case Primitive::curve: {
+		for (QDomElement point = element.firstChildElement(); !point.isNull(); point = point.nextSiblingElement()) {
+			if (point.tagName() == "start") {
+				primitive.curvePoints[0] = point.attribute("startx").toDouble();
+				primitive.curvePoints[1] = point.attribute("starty").toDouble();
+			} else if (point.tagName() == "end") {
+				primitive.curvePoints[2] = point.attribute("endx").toDouble();
+				primitive.curvePoints[3] = point.attribute("endy").toDouble();
+			} else if (point.tagName() == "ctrl") {
+				primitive.curvePoints[4] = point.attribute("x").toDouble();
+				primitive.curvePoints[5] = point.attribute("y").toDouble();
 			}
 		}
-		node = node.nextSibling();
+
+		break;
+	}
+	default:
+		for (const char * const name : { "x1", "y1", "x2", "y2" }) {
+			primitive.coordinates << compileCoordinate(element.attribute(name));
+		}
+
+		break;
+	}
+
+	if (primitive.type == Primitive::arc) {
+		primitive.startAngle = element.attribute("startAngle").toInt();
+		primitive.spanAngle = element.attribute("spanAngle").toInt();
+	} else if (primitive.type == Primitive::text) {
+		QString text = element.text();
+
+		// delete "\n" from the beginning and from the end of the string
+		if (text.startsWith('\n')) {
+			text.remove(0, 1);
+		}
+
+		if (text.endsWith('\n')) {
+			text.chop(1);
+		}
+
+		primitive.textLines = text.split('\n');
+	} else if (primitive.type == Primitive::image) {
+		primitive.imageName = element.attribute("name", "default");
 	}
-	this->painter = 0;
+
+	mPrimitives << primitive;
 }
 
-bool SdfRenderer::checkShowConditions(const QDomElement &element, bool isIcon) const
+SdfRenderer::Style SdfRenderer::compileStyle(const QDomElement &element)
 {
-	QDomNodeList showConditions = element.elementsByTagName("showIf");
-	// a hack, need to be removed when there is another version of icons
-	if (!showConditions.isEmpty() && isIcon) {
-		return false;
+	static const QHash<QString, Qt::PenStyle> penStyles = {
+		{ "solid", Qt::SolidLine }
+		, { "dot", Qt::DotLine }
+		, { "dash", Qt::DashLine }
+		, { "dashdot", Qt::DashDotLine }
+		, { "dashdotdot", Qt::DashDotDotLine }
+		, { "none", Qt::NoPen }
+	};
+
+	static const QHash<QString, Qt::BrushStyle> brushStyles = {
+		{ "none", Qt::NoBrush }
+		, { "solid", Qt::SolidPattern }
+	};
+
+	Style style;
+	if (element.hasAttribute("stroke-width")) {
+		style.attributes |= Style::strokeWidth;
+		style.strokeWidthValue = element.attribute("stroke-width").toInt();
 	}
-	if (showConditions.isEmpty() || !mElementRepo) {
-		return true;
+
+	if (element.hasAttribute("fill")) {
+		style.attributes |= Style::fill;
+		style.fillColor = QColor(element.attribute("fill"));
 	}
-	for (int i = 0; i < showConditions.length(); ++i) {
-		if (!checkCondition(showConditions.at(i).toElement())) {
-			return false;
+
+	if (element.hasAttribute("stroke")) {
+		style.attributes |= Style::stroke;
+		style.strokeColor = QColor(element.attribute("stroke"));
+	}
+
+	if (penStyles.contains(element.attribute("stroke-style"))) {
+		style.attributes |= Style::strokeStyle;
+		style.penStyle = penStyles[element.attribute("stroke-style")];
+	}
+
+	if (brushStyles.contains(element.attribute("fill-style"))) {
+		style.attributes |= Style::fillStyle;
+		style.brushStyle = brushStyles[element.attribute("fill-style")];
+	}
+
+	if (element.hasAttribute("font-fill")) {
+		style.attributes |= Style::fontFill;
+		style.fontColor = QColor(element.attribute("font-fill"));
+	}
+
+	if (element.hasAttribute("font-size")) {
+		style.attributes |= Style::fontSize;
+		QString fontSize = element.attribute("font-size");
+		if (fontSize.endsWith("%")) {
+			fontSize.chop(1);
+			style.fontSizeUnit = Coordinate::percent;
+		} else if (fontSize.endsWith("a")) {
+			fontSize.chop(1);
+			style.fontSizeUnit = Coordinate::absolute;
 		}
+
+		style.fontSizeValue = fontSize.toInt();
 	}
-	return true;
-}
 
-bool SdfRenderer::checkCondition(const QDomElement &condition) const
-{
-	QString sign = condition.attribute("sign");
-	QString realValue = mElementRepo->logicalProperty(condition.attribute("property"));
-	QString conditionValue = condition.attribute("value");
-
-	if (sign == "=~") {
-		return QRegExp(conditionValue).exactMatch(realValue);
-	} else if (sign == ">") {
-		return realValue.toInt() > conditionValue.toInt();
-	} else if (sign == "<") {
-		return realValue.toInt() < conditionValue.toInt();
-	} else if (sign == ">=") {
-		return realValue.toInt() >= conditionValue.toInt();
-	} else if (sign == "<=") {
-		return realValue.toInt() <= conditionValue.toInt();
-	} else if (sign == "!=") {
-		return realValue != conditionValue;
-	} else if (sign == "=") {
-		return realValue == conditionValue;
-	} else {
-		qDebug() << "Unsupported logical operator \"" + sign + "\"";
-		return false;
+	if (element.hasAttribute("font-name")) {
+		style.attributes |= Style::fontName;
+		style.fontFamily = element.attribute("font-name");
 	}
-}
 
-void SdfRenderer::line(QDomElement &element)
-{
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
-	QLineF line (x1,y1,x2,y2);
+	if (element.hasAttribute("b")) {
+		style.attributes |= Style::bold;
+		style.isBold = element.attribute("b").toInt();
+	}
 
-	parsestyle(element);
-	painter->drawLine(line);
-}
+	if (element.hasAttribute("i")) {
+		style.attributes |= Style::italic;
+		style.isItalic = element.attribute("i").toInt();
+	}
 
-void SdfRenderer::ellipse(QDomElement &element)
-{
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
+	if (element.hasAttribute("u")) {
+		style.attributes |= Style::underline;
+		style.isUnderlined = element.attribute("u").toInt();
+	}
 
-	QRectF rect(x1, y1, x2-x1, y2-y1);
-	parsestyle(element);
-	painter->drawEllipse(rect);
+	return style;
 }
 
-void SdfRenderer::arc(QDomElement &element)
+SdfRenderer::Coordinate SdfRenderer::compileCoordinate(const QString &coordinate)
 {
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
-	int startAngle = element.attribute("startAngle").toInt();
-	int spanAngle = element.attribute("spanAngle").toInt();
+	Coordinate result;
+	QString value = coordinate;
+	if (value.endsWith("%")) {
+		value.chop(1);
+		result.unit = Coordinate::percent;
+	} else if (value.endsWith("a")) {
+		value.chop(1);
+		result.unit = Coordinate::absolute;
+	}
 
-	QRectF rect(x1, y1, x2-x1, y2-y1);
-	parsestyle(element);
-	painter->drawArc(rect, startAngle, spanAngle);
+	result.value = value.toFloat();
+	return result;
 }
 
-void SdfRenderer::background(QDomElement &element)
+QVector<SdfRenderer::Condition> SdfRenderer::compileConditions(const QDomElement &element)
 {
-	parsestyle(element);
-	painter->setPen(brush.color());
-	painter->drawRect(painter->window());
-	defaultstyle();
+	static const QHash<QString, Condition::Sign> signs = {
+		{ "=~", Condition::matches }
+		, { ">", Condition::greater }
+		, { "<", Condition::less }
+		, { ">=", Condition::greaterOrEqual }
+		, { "<=", Condition::lessOrEqual }
+		, { "!=", Condition::notEqual }
+		, { "=", Condition::equal }
+	};
+
+	QVector<Condition> result;
+	const QDomNodeList showConditions = element.elementsByTagName("showIf");
+	for (int i = 0; i < showConditions.length(); ++i) {
+		const QDomElement conditionElement = showConditions.at(i).toElement();
+		Condition condition;
+		condition.signText = conditionElement.attribute("sign");
+		condition.sign = signs.value(condition.signText, Condition::unsupported);
+		condition.property = conditionElement.attribute("property");
+		condition.value = conditionElement.attribute("value");
+		if (condition.sign == Condition::matches) {
+			condition.regExp = QRegExp(condition.value);
+		}
+
+		result << condition;
+	}
+
+	return result;
 }
 
-void SdfRenderer::draw_text(QDomElement &element)
+QVector<SdfRenderer::PathSegment> SdfRenderer::compilePath(const QString &path)
 {
-	parsestyle(element);
-	pen.setStyle(Qt::SolidLine);
-	painter->setPen(pen);
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	QString str = element.text();
+	// Path is a sequence of commands like " M 15 15 L 5 15 C 5 20.5 9.5 25 15 25", only the last point (or the last
+	// three points for "C") of a command is used. Points not given by a command are taken from the previous one.
+	QVector<PathSegment> result;
+	PathSegment segment;
 
-	// delete "\n" from the beginning of the string
-	if (str[0] == '\n')
-		str.remove(0, 1);
+	QChar command;
+	QVector<float> numbers;
+	const auto flush = [&]() {
+		if (command == 'M' || command == 'L') {
+			for (int i = 0; i + 1 < numbers.size(); i += 2) {
+				segment.points[4] = numbers[i];
+				segment.points[5] = numbers[i + 1];
+			}
 
-	// delete "\n" from the end of the string
-	if (str[str.length() - 1] == '\n')
-		str.remove(str.length() - 1, 1);
+			segment.type = command == 'M' ? PathSegment::moveTo : PathSegment::lineTo;
+			result << segment;
+		} else if (command == 'C') {
+			for (int i = 0; i + 5 < numbers.size(); i += 6) {
+				std::copy(numbers.constBegin() + i, numbers.constBegin() + i + 6, segment.points);
+			}
 
-	while (str.contains('\n'))
-	{
-		int i = str.indexOf('\n');
-		QString temp = str.left(i);
-		str.remove(0, i + 1);
-		painter->drawText(static_cast<int>(x1), static_cast<int>(y1), temp);
-		y1 += painter->font().pixelSize() ;
+			segment.type = PathSegment::cubicTo;
+			result << segment;
+		} else if (command == 'Z') {
+			segment.type = PathSegment::closeSubpath;
+			result << segment;
+		}
+
+		numbers.clear();
+	};
+
+	for (const QString &token : path.split(' ', QString::SkipEmptyParts)) {
+		if (token == "M" || token == "L" || token == "C" || token == "Z") {
+			flush();
+			command = token[0];
+		} else {
+			numbers << token.toFloat();
+		}
 	}
-	QPointF point(x1, y1);
-	painter->drawText(point, str);
-	defaultstyle();
+
+	flush();
+	return result;
 }
 
-void SdfRenderer::rectangle(QDomElement &element)
+void SdfRenderer::render(QPainter *painter, const QRectF &bounds, bool isIcon)
 {
-	float x1 = x1_def(element);
-	float y1 = y1_def(element);
-	float x2 = x2_def(element);
-	float y2 = y2_def(element);
+	current_size_x = static_cast<int>(bounds.width());
+	current_size_y = static_cast<int>(bounds.height());
+	mStartX = static_cast<int>(bounds.x());
+	mStartY = static_cast<int>(bounds.y());
+	this->painter = painter;
+	for (const Primitive &primitive : mPrimitives) {
+		if (checkShowConditions(primitive, isIcon)) {
+			draw(primitive);
+		}
+	}
 
-	QRectF rect;
-	rect.adjust(x1, y1, x2, y2);
-	parsestyle(element);
-	painter->drawRect(rect);
-	defaultstyle();
+	this->painter = nullptr;
 }
 
-void SdfRenderer::polygon(QDomElement &element)
+bool SdfRenderer::checkShowConditions(const Primitive &primitive, bool isIcon) const
 {
-	parsestyle(element);
-	// FIXME: init points array here
-	QPoint *points = nullptr;
-	int n = element.attribute("n").toInt();
-	if (!element.isNull())
-	{
-		points = getpoints(element, n);
+	// a hack, need to be removed when there is another version of icons
+	if (!primitive.conditions.isEmpty() && isIcon) {
+		return false;
 	}
-	if (points != nullptr)
-	{
-		painter->drawConvexPolygon(points, n);
-		delete[] points;
+	if (primitive.conditions.isEmpty() || !mElementRepo) {
+		return true;
 	}
-	defaultstyle();
+	for (const Condition &condition : primitive.conditions) {
+		if (!checkCondition(condition)) {
+			return false;
+		}
+	}
+	return true;
 }
 
-void SdfRenderer::image_draw(QDomElement &element)
-{
-	float const x1 = x1_def(element);
-	float const y1 = y1_def(element);
-	float const x2 = x2_def(element);
-	float const y2 = y2_def(element);
-
-	const QString fileName = SettingsManager::value("pathToImages").toString() + "/"
-			+ element.attribute("name", "default");
+bool SdfRenderer::checkCondition(const Condition &condition) const
+{
+	const QString realValue = mElementRepo->logicalProperty(condition.property);
+
+	switch (condition.sign) {
+	case Condition::matches:
+		return condition.regExp.exactMatch(realValue);
+	case Condition::greater:
+		return realValue.toInt() > condition.value.toInt();
+	case Condition::less:
+		return realValue.toInt() < condition.value.toInt();
+	case Condition::greaterOrEqual:
+		return realValue.toInt() >= condition.value.toInt();
+	case Condition::lessOrEqual:
+		return realValue.toInt() <= condition.value.toInt();
+	case Condition::notEqual:
+		return realValue != condition.value;
+	case Condition::equal:
+		return realValue == condition.value;
+	case Condition::unsupported:
+		break;
+	}
 
-	const QRect rect(x1, y1, x2 - x1, y2 - y1);
-	utils::ImagesCache::instance().drawImage(fileName, *painter, rect, mZoom);
+	qDebug() << "Unsupported logical operator \"" + condition.signText + "\"";
+	return false;
 }
 
-void SdfRenderer::point(QDomElement &element)
+void SdfRenderer::draw(const Primitive &primitive)
 {
-	parsestyle(element);
-	float x = x1_def(element);
-	float y = y1_def(element);
-	QPointF pointf(x,y);
-	painter->drawLine(QPointF(pointf.x()-0.1, pointf.y()-0.1), QPointF(pointf.x()+0.1, pointf.y()+0.1));
-	defaultstyle();
+	switch (primitive.type) {
+	case Primitive::line: {
+		QLineF line(x(primitive, 0), y(primitive, 1), x(primitive, 2), y(primitive, 3));
+		applyStyle(primitive.style);
+		painter->drawLine(line);
+		break;
+	}
+	case Primitive::ellipse: {
+		const float x1 = x(primitive, 0);
+		const float y1 = y(primitive, 1);
+		QRectF rect(x1, y1, x(primitive, 2) - x1, y(primitive, 3) - y1);
+		applyStyle(primitive.style);
+		painter->drawEllipse(rect);
+		break;
+	}
+	case Primitive::arc: {
+		const float x1 = x(primitive, 0);
+		const float y1 = y(primitive, 1);
+		QRectF rect(x1, y1, x(primitive, 2) - x1, y(primitive, 3) - y1);
+		applyStyle(primitive.style);
+		painter->drawArc(rect, primitive.startAngle, primitive.spanAngle);
+		break;
+	}
+	case Primitive::background:
+		applyStyle(primitive.style);
+		painter->setPen(brush.color());
+		painter->drawRect(painter->window());
+		defaultstyle();
+		break;
+	case Primitive::text:
+		drawText(primitive);
+		break;
+	case Primitive::rectangle: {
+		QRectF rect;
+		rect.adjust(x(primitive, 0), y(primitive, 1), x(primitive, 2), y(primitive, 3));
+		applyStyle(primitive.style);
+		painter->drawRect(rect);
+		defaultstyle();
+		break;
+	}
+	case Primitive::polygon:
+		drawPolygon(primitive);
+		break;
+	case Primitive::point: {
+		applyStyle(primitive.style);
+		QPointF pointf(x(primitive, 0), y(primitive, 1));
+		painter->drawLine(QPointF(pointf.x()-0.1, pointf.y()-0.1), QPointF(pointf.x()+0.1, pointf.y()+0.1));
+		defaultstyle();
+		break;
+	}
+	case Primitive::path:
+		drawPath(primitive);
+		break;
+	case Primitive::curve:
+		drawCurve(primitive);
+		break;
+	case Primitive::image:
+		drawImage(primitive);
+		break;
+	}
 }
 
-QPoint *SdfRenderer::getpoints(QDomElement &element, int n)
+void SdfRenderer::drawText(const Primitive &primitive)
 {
-	QPoint *array = new QPoint[n];
-	float x = 0;
-	float y = 0;
-	for (int i = 0; i < n; i++)
-	{
-		QString str;
-		str.setNum(i + 1);
-		QDomElement elem = element;
-		QString xnum = elem.attribute(QString("x").append(str));
-		if (xnum.endsWith("%"))
-		{
-			xnum.chop(1);
-			x = current_size_x * xnum.toFloat() / 100 + mStartX;
-		}
-		else if (xnum.endsWith("a") && mNeedScale)
-		{
-			xnum.chop(1);
-			x = xnum.toFloat() + mStartX;
-		}
-		else if (xnum.endsWith("a") && !mNeedScale)
-		{
-			xnum.chop(1);
-			x = xnum.toFloat() * current_size_x / first_size_x + mStartX;
-		}
-		else
-			x = xnum.toFloat() * current_size_x / first_size_x + mStartX;
-
-		QString ynum = elem.attribute(QString("y").append(str));
-		if (ynum.endsWith("%"))
-		{
-			ynum.chop(1);
-			y = current_size_y * ynum.toFloat() / 100 + mStartY;
-		}
-		else if (ynum.endsWith("a") && mNeedScale)
-		{
-			ynum.chop(1);
-			y = ynum.toFloat() + mStartY;
-		}
-		else if (ynum.endsWith("a") && !mNeedScale)
-		{
-			ynum.chop(1);
-			y = ynum.toFloat() * current_size_y / first_size_y + mStartY;
-		}
-		else
-			y = ynum.toFloat() * current_size_y / first_size_y + mStartY;
+	applyStyle(primitive.style);
+	pen.setStyle(Qt::SolidLine);
+	painter->setPen(pen);
+	float x1 = x(primitive, 0);
+	float y1 = y(primitive, 1);
 
-		array[i].setX(static_cast<int>(x));
-		array[i].setY(static_cast<int>(y));
+	for (int i = 0; i < primitive.textLines.size() - 1; ++i) {
+		painter->drawText(static_cast<int>(x1), static_cast<int>(y1), primitive.textLines[i]);
+		y1 += painter->font().pixelSize();
 	}
-	return array;
-}
 
-void SdfRenderer::defaultstyle()
-{
-	pen.setColor(QColor(0,0,0));
-	brush.setColor(QColor(255,255,255));
-	pen.setStyle(Qt::SolidLine);
-	brush.setStyle(Qt::NoBrush);
-	pen.setWidth(1);
+	QPointF point(x1, y1);
+	painter->drawText(point, primitive.textLines.last());
+	defaultstyle();
 }
 
-bool SdfRenderer::isNotLCMZ(QString str, int i)
+void SdfRenderer::drawPolygon(const Primitive &primitive)
 {
-	return (str[i] != 'L') && (str[i] != 'C') && (str[i] != 'M')
-		&& (str[i] != 'Z') && (i != str.length());
+	applyStyle(primitive.style);
+	const int n = primitive.coordinates.size() / 2;
+	QVector<QPoint> points(n);
+	for (int i = 0; i < n; ++i) {
+		points[i].setX(static_cast<int>(x(primitive, 2 * i)));
+		points[i].setY(static_cast<int>(y(primitive, 2 * i + 1)));
+	}
+
+	painter->drawConvexPolygon(points.constData(), n);
+	defaultstyle();
 }
 
-void SdfRenderer::path_draw(QDomElement &element)
+void SdfRenderer::drawPath(const Primitive &primitive)
 {
-	QPointF end_point;
-	QPointF c1;
-	QPointF c2;
-	QDomElement elem = element;
-	QPainterPath path;
+	const auto point = [this](const PathSegment &segment, int index) {
+		return QPointF(segment.points[index] * current_size_x / first_size_x + mStartX
+				, segment.points[index + 1] * current_size_y / first_size_y + mStartY);
+	};
 
-	if (!elem.isNull())
-	{
-		QString d_cont;
-		d_cont = elem.attribute("d").remove(0, 1);
-		d_cont.append(" Z");
-
-		for (i = 0; i < d_cont.length() - 1;)
-		{
-			if (d_cont[i] == 'M')
-			{
-				j = i + 2;
-				while (isNotLCMZ(d_cont, j))
-				{
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					++j;
-					s1.clear();
-				}
-
-				path.moveTo(end_point);
-				i = j;
-			}
-			else if (d_cont[i] == 'L')
-			{
-				j = i + 2;
-				while (isNotLCMZ(d_cont, j))
-				{
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-					end_point.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					++j;
-					s1.clear();
-				}
-
-				 path.lineTo(end_point);
-				 i = j;
-			}
-			 else if (d_cont[i] == 'C')
-			{
-				j = i + 2;
-				while(isNotLCMZ(d_cont, j))
-				{
-					while (!(d_cont[j] == ' '))
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c1.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c1.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c2.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					c2.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setX(s1.toFloat() * current_size_x / first_size_x + mStartX);
-					s1.clear();
-					++j;
-
-					while (d_cont[j] != ' ')
-					{
-						s1.append(d_cont[j]);
-						++j;
-					}
-
-					end_point.setY(s1.toFloat() * current_size_y / first_size_y + mStartY);
-					s1.clear();
-					++j;
-				}
-
-				path.cubicTo(c1, c2, end_point);
-				i = j;
-
-			} else if (d_cont[i] == 'Z')
-			{
-				path.closeSubpath();
-				logger ("loggerZ.txt", "DONE");
-			}
+	QPainterPath path;
+	for (const PathSegment &segment : primitive.pathSegments) {
+		switch (segment.type) {
+		case PathSegment::moveTo:
+			path.moveTo(point(segment, 4));
+			break;
+		case PathSegment::lineTo:
+			path.lineTo(point(segment, 4));
+			break;
+		case PathSegment::cubicTo:
+			path.cubicTo(point(segment, 0), point(segment, 2), point(segment, 4));
+			break;
+		case PathSegment::closeSubpath:
+			path.closeSubpath();
+			break;
 		}
 	}
 
-	parsestyle(element);
+	applyStyle(primitive.style);
 	painter->drawPath(path);
 }
 
-void SdfRenderer::stylus_draw(QDomElement &element)
+void SdfRenderer::drawCurve(const Primitive &primitive)
 {
-	QDomNode node = element.firstChild();
-	while(!node.isNull())
-	{
-		QDomElement elem = node.toElement();
-		if(!elem.isNull())
-		{
-			if (elem.tagName()=="line")
-			{
-				line(elem);
-			}
-		}
-		node = node.nextSibling();
-	}
-}
-
-void SdfRenderer::curve_draw(QDomElement &element)
-{
-	QDomNode node = element.firstChild();
-	QPointF start(0, 0);
-	QPointF end(0, 0);
-	QPoint c1(0, 0);
-	while(!node.isNull())
-	{
-		QDomElement elem = node.toElement();
-		if(!elem.isNull())
-		{
-			if (elem.tagName() == "start")
-			{
-				start.setX(elem.attribute("startx").toDouble() * current_size_x / first_size_x);
-				start.setY(elem.attribute("starty").toDouble() * current_size_y / first_size_y);
-			}
-			else if (elem.tagName() == "end")
-			{
-				end.setX(elem.attribute("endx").toDouble() * current_size_x / first_size_x);
-				end.setY(elem.attribute("endy").toDouble() * current_size_y / first_size_y);
-			}
-			else if (elem.tagName() == "ctrl")
-			{
-				c1.setX(elem.attribute("x").toDouble() * current_size_x / first_size_x);
-				c1.setY(elem.attribute("y").toDouble() * current_size_y / first_size_y);
-			}
-		}
-		node = node.nextSibling();
-	}
+	const double * const points = primitive.curvePoints;
+	const QPointF start(points[0] * current_size_x / first_size_x, points[1] * current_size_y / first_size_y);
+	const QPointF end(points[2] * current_size_x / first_size_x, points[3] * current_size_y / first_size_y);
+	const QPoint c1(static_cast<int>(points[4] * current_size_x / first_size_x)
+			, static_cast<int>(points[5] * current_size_y / first_size_y));
 
 	QPainterPath path(start);
 	path.quadTo(c1, end);
-	parsestyle(element);
+	applyStyle(primitive.style);
 	painter->drawPath(path);
 }
 
-void SdfRenderer::parsestyle(QDomElement &element)
+void SdfRenderer::drawImage(const Primitive &primitive)
 {
-	QDomElement elem = element;
-	if(!elem.isNull())
-	{
-		if (elem.hasAttribute("stroke-width"))
-		{
-			if (mNeedScale)
-				pen.setWidth(elem.attribute("stroke-width").toInt());
-			else  // for painting icons. width of all lines should be set to 1
-				pen.setWidth(1);
-		}
-
-		if (elem.hasAttribute("fill"))
-		{
-			QColor color = elem.attribute("fill");
-			brush.setStyle(Qt::SolidPattern);
-			brush.setColor(color);
-		}
+	float const x1 = x(primitive, 0);
+	float const y1 = y(primitive, 1);
+	float const x2 = x(primitive, 2);
+	float const y2 = y(primitive, 3);
 
-		if (elem.hasAttribute("stroke"))
-		{
-			QColor color = elem.attribute("stroke");
-			pen.setColor(color);
-		}
+	const QString fileName = SettingsManager::value("pathToImages").toString() + "/" + primitive.imageName;
 
-		if (elem.hasAttribute("stroke-style"))
-		{
-			if (elem.attribute("stroke-style") == "solid")
-				pen.setStyle(Qt::SolidLine);
-			if (elem.attribute("stroke-style") == "dot")
-				pen.setStyle(Qt::DotLine);
-			if (elem.attribute("stroke-style") == "dash")
-				pen.setStyle(Qt::DashLine);
-			if (elem.attribute("stroke-style") == "dashdot")
-				pen.setStyle(Qt::DashDotLine);
-			if (elem.attribute("stroke-style") == "dashdotdot")
-				pen.setStyle(Qt::DashDotDotLine);
-			if (elem.attribute("stroke-style") == "none")
-				pen.setStyle(Qt::NoPen);
-		}
+	const QRect rect(x1, y1, x2 - x1, y2 - y1);
+	utils::ImagesCache::instance().drawImage(fileName, *painter, rect, mZoom);
+}
 
-		if (elem.hasAttribute("fill-style"))
-		{
-			if (elem.attribute("fill-style")=="none")
-				brush.setStyle(Qt::NoBrush);
-			else if(elem.attribute("fill-style")=="solid")
-				brush.setStyle(Qt::SolidPattern);
-		}
+void SdfRenderer::applyStyle(const Style &style)
+{
+	if (style.attributes & Style::strokeWidth) {
+		// for painting icons width of all lines should be set to 1
+		pen.setWidth(mNeedScale ? style.strokeWidthValue : 1);
+	}
 
-		if (elem.hasAttribute("font-fill"))
-		{
-			QColor color = elem.attribute("font-fill");
-			pen.setColor(color);
-		}
+	if (style.attributes & Style::fill) {
+		brush.setStyle(Qt::SolidPattern);
+		brush.setColor(style.fillColor);
+	}
 
-		if (elem.hasAttribute("font-size"))
-		{
-			QString fontsize = elem.attribute("font-size");
-			if (fontsize.endsWith("%"))
-			{
-				fontsize.chop(1);
-				font.setPixelSize(current_size_y * fontsize.toInt() / 100);
-			}
-			else if (fontsize.endsWith("a") && mNeedScale)
-			{
-				fontsize.chop(1);
-				font.setPixelSize(fontsize.toInt());
-			}
-			else if (fontsize.endsWith("a") && !mNeedScale)
-			{
-				fontsize.chop(1);
-				font.setPixelSize(fontsize.toInt() * current_size_y / first_size_y);
-			}
-			else
-				font.setPixelSize(fontsize.toInt() * current_size_y / first_size_y);
-		}
+	if (style.attributes & Style::stroke) {
+		pen.setColor(style.strokeColor);
+	}
 
-		if (elem.hasAttribute("font-name"))
-		{
-			font.setFamily(elem.attribute("font-name"));
-		}
+	if (style.attributes & Style::strokeStyle) {
+		pen.setStyle(style.penStyle);
+	}
 
-		if (elem.hasAttribute("b"))
-		{
-			font.setBold(elem.attribute("b").toInt());
-		}
+	if (style.attributes & Style::fillStyle) {
+		brush.setStyle(style.brushStyle);
+	}
 
-		if (elem.hasAttribute("i"))
-		{
-			font.setItalic(elem.attribute("i").toInt());
-		}
+	if (style.attributes & Style::fontFill) {
+		pen.setColor(style.fontColor);
+	}
 
-		if (elem.hasAttribute("u"))
-		{
-			font.setUnderline(elem.attribute("u").toInt());
+	if (style.attributes & Style::fontSize) {
+		switch (style.fontSizeUnit) {
+		case Coordinate::percent:
+			font.setPixelSize(current_size_y * style.fontSizeValue / 100);
+			break;
+		case Coordinate::absolute:
+			font.setPixelSize(mNeedScale
+					? style.fontSizeValue
+					: style.fontSizeValue * current_size_y / first_size_y);
+			break;
+		case Coordinate::scaled:
+			font.setPixelSize(style.fontSizeValue * current_size_y / first_size_y);
+			break;
 		}
-
-		painter->setFont(font);
 	}
-	painter->setPen(pen);
-	painter->setBrush(brush);
-}
-
-float SdfRenderer::coord_def(QDomElement &element, QString coordName, int current_size, int first_size)
-{
-	float coord = 0;
-	QString coordStr = element.attribute(coordName);
 
-	if (coordStr.endsWith("%"))
-	{
-		coordStr.chop(1);
-		coord = current_size * coordStr.toFloat() / 100;
-		return coord;
+	if (style.attributes & Style::fontName) {
+		font.setFamily(style.fontFamily);
 	}
-	else if (coordStr.endsWith("a") && mNeedScale)
-	{
-		coordStr.chop(1);
-		coord = coordStr.toFloat();
-		return coord;
+
+	if (style.attributes & Style::bold) {
+		font.setBold(style.isBold);
 	}
-	else if (coordStr.endsWith("a") && !mNeedScale)
-	{
-		coordStr.chop(1);
-		coord = coordStr.toFloat() * current_size / first_size;
-		return coord;
+
+	if (style.attributes & Style::italic) {
+		font.setItalic(style.isItalic);
 	}
-	else
-	{
-		coord = coordStr.toFloat() * current_size / first_size;
-		return coord;
+
+	if (style.attributes & Style::underline) {
+		font.setUnderline(style.isUnderlined);
 	}
-}
 
-float SdfRenderer::x1_def(QDomElement &element)
-{
-	return coord_def(element, "x1", current_size_x, first_size_x) + mStartX;
+	painter->setFont(font);
+	painter->setPen(pen);
+	painter->setBrush(brush);
 }
 
-float SdfRenderer::y1_def(QDomElement &element)
+void SdfRenderer::defaultstyle()
 {
-	return coord_def(element, "y1", current_size_y, first_size_y) + mStartY;
+	pen.setColor(QColor(0,0,0));
+	brush.setColor(QColor(255,255,255));
+	pen.setStyle(Qt::SolidLine);
+	brush.setStyle(Qt::NoBrush);
+	pen.setWidth(1);
 }
 
-float SdfRenderer::x2_def(QDomElement &element)
+float SdfRenderer::coordinate(const Coordinate &coordinate, int current_size, int first_size) const
 {
-	return coord_def(element, "x2", current_size_x, first_size_x) + mStartX;
+	switch (coordinate.unit) {
+	case Coordinate::percent:
+		return current_size * coordinate.value / 100;
+	case Coordinate::absolute:
+		return mNeedScale ? coordinate.value : coordinate.value * current_size / first_size;
+	case Coordinate::scaled:
+		break;
+	}
+
+	return coordinate.value * current_size / first_size;
 }
 
-float SdfRenderer::y2_def(QDomElement &element)
+float SdfRenderer::x(const Primitive &primitive, int index) const
 {
-	return coord_def(element, "y2", current_size_y, first_size_y) + mStartY;
+	return coordinate(primitive.coordinates[index], current_size_x, first_size_x) + mStartX;
 }
 
-void SdfRenderer::logger(QString path, QString string)
-{	log.setFileName(path);
-	log.open(QIODevice::Append | QIODevice::Text);
-	logtext.setDevice(&log);
-	logtext << string << "\n";
-	log.close();
+float SdfRenderer::y(const Primitive &primitive, int index) const
+{
+	return coordinate(primitive.coordinates[index], current_size_y, first_size_y) + mStartY;
 }
 
 void SdfRenderer::noScale()
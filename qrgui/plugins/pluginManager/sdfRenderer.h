@@ -21,7 +21,10 @@
 #include <QtCore/QFile>
 #include <QtCore/QTextStream>
 #include <QtCore/QFileInfo>
+#include <QtCore/QRegExp>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
 #include <QtGui/QIconEngine>
 #include <QtSvg/QSvgRenderer>
 
@@ -61,62 +64,169 @@ public slots:
 	void setZoom(qreal zoomFactor);
 
 private:
+	/// Coordinate of a picture element. "10%" is relative to the bounds, "10a" is an absolute one (it is scaled
+	/// only for icons), plain "10" is scaled from the picture size to the bounds.
+	struct Coordinate
+	{
+		enum Unit
+		{
+			percent
+			, absolute
+			, scaled
+		};
+
+		Unit unit = scaled;
+		float value = 0;
+	};
+
+	/// Pre-parsed "showIf" condition of a picture element.
+	struct Condition
+	{
+		enum Sign
+		{
+			matches
+			, greater
+			, less
+			, greaterOrEqual
+			, lessOrEqual
+			, notEqual
+			, equal
+			, unsupported
+		};
+
+		Sign sign = unsupported;
+		QString signText;
+		QString property;
+		QString value;
+		QRegExp regExp;
+	};
+
+	/// Pre-parsed style attributes of a picture element. Only given attributes are applied over current pen,
+	/// brush and font, others are inherited from previously drawn elements.
+	struct Style
+	{
+		enum Attribute
+		{
+			strokeWidth = 0x1
+			, fill = 0x2
+			, stroke = 0x4
+			, strokeStyle = 0x8
+			, fillStyle = 0x10
+			, fontFill = 0x20
+			, fontSize = 0x40
+			, fontName = 0x80
+			, bold = 0x100
+			, italic = 0x200
+			, underline = 0x400
+		};
+
+		int attributes = 0;
+		int strokeWidthValue = 0;
+		QColor fillColor;
+		QColor strokeColor;
+		Qt::PenStyle penStyle = Qt::SolidLine;
+		Qt::BrushStyle brushStyle = Qt::NoBrush;
+		QColor fontColor;
+		Coordinate::Unit fontSizeUnit = Coordinate::scaled;
+		int fontSizeValue = 0;
+		QString fontFamily;
+		bool isBold = false;
+		bool isItalic = false;
+		bool isUnderlined = false;
+	};
+
+	/// Segment of a path, points are in picture coordinates.
+	struct PathSegment
+	{
+		enum Type
+		{
+			moveTo
+			, lineTo
+			, cubicTo
+			, closeSubpath
+		};
+
+		Type type = closeSubpath;
+		float points[6] = {};
+	};
+
+	/// One element of a picture compiled at load, rendering just replays them with current bounds.
+	struct Primitive
+	{
+		enum Type
+		{
+			line
+			, ellipse
+			, arc
+			, background
+			, text
+			, rectangle
+			, polygon
+			, point
+			, path
+			, curve
+			, image
+		};
+
+		Type type;
+		Style style;
+		QVector<Condition> conditions;
+
+		/// x1, y1, x2, y2 for most of primitives, x and y of each vertex for polygon.
+		QVector<Coordinate> coordinates;
+
+		int startAngle = 0;
+		int spanAngle = 0;
+		QStringList textLines;
+		QString imageName;
+		QVector<PathSegment> pathSegments;
+
+		/// Start, end and control points of a curve.
+		double curvePoints[6] = {};
+	};
+
+	void compile(const QDomElement &picture);
+	void compileElement(const QDomElement &element, const QVector<Condition> &conditions);
+	static Style compileStyle(const QDomElement &element);
+	static Coordinate compileCoordinate(const QString &coordinate);
+	static QVector<Condition> compileConditions(const QDomElement &element);
+	static QVector<PathSegment> compilePath(const QString &path);
+
+	bool checkShowConditions(const Primitive &primitive, bool isIcon) const;
+	bool checkCondition(const Condition &condition) const;
+
+	void draw(const Primitive &primitive);
+	void drawText(const Primitive &primitive);
+	void drawPolygon(const Primitive &primitive);
+	void drawPath(const Primitive &primitive);
+	void drawCurve(const Primitive &primitive);
+	void drawImage(const Primitive &primitive);
+	void applyStyle(const Style &style);
+	void defaultstyle();
+	float coordinate(const Coordinate &coordinate, int current_size, int first_size) const;
+	float x(const Primitive &primitive, int index) const;
+	float y(const Primitive &primitive, int index) const;
+
 	QString mWorkingDirName;
 
-	int first_size_x;
-	int first_size_y;
-	int current_size_x;
-	int current_size_y;
+	int first_size_x = 0;
+	int first_size_y = 0;
+	int current_size_x = 0;
+	int current_size_y = 0;
 	int mStartX;
 	int mStartY;
-	int i;
-	int j;
-	int sep;
-	QPainter *painter;
+	QPainter *painter = nullptr;
 	QPen pen;
 	QBrush brush;
-	QString s1;
-	QString s2;
 	QFont font;
-	QFile log;
-	QTextStream logtext;
-	QDomDocument doc;
+	QVector<Primitive> mPrimitives;
 
 	/** @brief is false if we don't need to scale according to absolute
 	 * coords, is useful for rendering icons. default is true
 	**/
 	bool mNeedScale;
 	qreal mZoom = 1.0;
-	ElementRepoInterface *mElementRepo;
-
-	bool checkShowConditions(const QDomElement &element, bool isIcon) const;
-	bool checkCondition(const QDomElement &condition) const;
-
-	void line(QDomElement &element);
-	void ellipse(QDomElement &element);
-	void arc(QDomElement &element);
-	void parsestyle(QDomElement &element);
-	void background(QDomElement &element);
-	void draw_text(QDomElement &element);
-	void rectangle(QDomElement &element);
-	void polygon(QDomElement &element);
-	QPoint *getpoints(QDomElement &element, int n);
-	void point (QDomElement &element);
-	void defaultstyle();
-	void path_draw(QDomElement &element);
-	void stylus_draw(QDomElement &element);
-	void curve_draw(QDomElement &element);
-	void image_draw(QDomElement &element);
-	float x1_def(QDomElement &element);
-	float y1_def(QDomElement &element);
-	float x2_def(QDomElement &element);
-	float y2_def(QDomElement &element);
-	float coord_def(QDomElement &element, QString coordName, int current_size, int first_size);
-	void logger(QString path, QString string);
-
-	/// checks that str[i] is not L, C, M or Z
-	/// @todo Not so helpful comment
-	bool isNotLCMZ(QString str, int i);
+	ElementRepoInterface *mElementRepo = nullptr;
 };
 
 /// Constructs QIcon instance by a given sdf description
@@ -14,10 +14,97 @@
 
 #include "ids.h"
 
+#include <cstring>
+
 #include <QtCore/QVariant>
-#include <QtCore/QUuid>
+#include <QtCore/QHash>
+#include <QtCore/QReadWriteLock>
 
 using namespace qReal;
+using namespace qReal::details;
+
+namespace {
+
+/// Table of interned id types. Ids are created from many threads (interpreter, model loading),
+/// so access is guarded by lock.
+class IdTypesTable
+{
+public:
+	IdTypesTable()
+		: mEmptyType(create(QString(), QString(), QString()))
+	{
+		mTypes.insert(key(QString(), QString(), QString()), mEmptyType);
+	}
+
+	const IdType *emptyType() const
+	{
+		return mEmptyType;
+	}
+
+	const IdType *intern(const QString &editor, const QString &diagram, const QString &element)
+	{
+		if (editor.isEmpty() && diagram.isEmpty() && element.isEmpty()) {
+			return mEmptyType;
+		}
+
+		const QString typeKey = key(editor, diagram, element);
+		{
+			QReadLocker locker(&mLock);
+			const IdType * const result = mTypes.value(typeKey);
+			if (result) {
+				return result;
+			}
+		}
+
+		QWriteLocker locker(&mLock);
+		const IdType *&result = mTypes[typeKey];
+		if (!result) {
+			result = create(editor, diagram, element);
+		}
+
+		return result;
+	}
+
+private:
+	static QString key(const QString &editor, const QString &diagram, const QString &element)
+	{
+		// Parts can not contain '/', so the key is unique for each combination of parts.
+		return editor + '/' + diagram + '/' + element;
+	}
+
+	static const IdType *create(const QString &editor, const QString &diagram, const QString &element)
+	{
+		IdType * const type = new IdType;
+		type->editor = editor;
+		type->diagram = diagram;
+		type->element = element;
+		type->size = !element.isEmpty() ? 3 : !diagram.isEmpty() ? 2 : !editor.isEmpty() ? 1 : 0;
+		type->hash = qHash(key(editor, diagram, element));
+		return type;
+	}
+
+	QReadWriteLock mLock;
+	/// Interned types are never deleted, ids refer them by pointers.
+	QHash<QString, const IdType *> mTypes;
+	const IdType * const mEmptyType;
+};
+
+}
+
+Q_GLOBAL_STATIC(IdTypesTable, idTypes)
+
+/// Returns parsed UUID if given string is a UUID in exactly the form QUuid::toString() produces, null otherwise.
+static QUuid toCanonicalUuid(const QString &string)
+{
+	// "{xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx}"
+	const int canonicalLength = 38;
+	if (string.length() != canonicalLength || string[0] != '{') {
+		return QUuid();
+	}
+
+	const QUuid uuid(string);
+	return !uuid.isNull() && uuid.toString() == string ? uuid : QUuid();
+}
 
 Id Id::loadFromString(const QString &string)
 {
@@ -25,59 +112,51 @@ Id Id::loadFromString(const QString &string)
 	Q_ASSERT(path.count() > 0 && path.count() <= 5);
 	Q_ASSERT(path[0] == "qrm:");
 
-	Id result;
-	switch (path.count()) {
-	case 5: result.mId = path[4];
-		// Fall-thru
-	case 4: result.mElement = path[3];
-		// Fall-thru
-	case 3: result.mDiagram = path[2];
-		// Fall-thru
-	case 2: result.mEditor = path[1];
-		// Fall-thru
-	}
+	const int count = path.count();
+	const Id result(count > 1 ? path[1] : QString()
+			, count > 2 ? path[2] : QString()
+			, count > 3 ? path[3] : QString()
+			, count > 4 ? path[4] : QString());
+
 	Q_ASSERT(string == result.toString());
 	return result;
 }
 
 Id Id::createElementId(const QString &editor, const QString &diagram, const QString &element)
 {
-	return Id(editor, diagram, element, QUuid::createUuid().toString());
+	return Id(idTypes()->intern(editor, diagram, element), QUuid::createUuid(), QString());
 }
 
 Id Id::rootId()
 {
-	return Id("ROOT_ID", "ROOT_ID", "ROOT_ID", "ROOT_ID");
+	static const Id root("ROOT_ID", "ROOT_ID", "ROOT_ID", "ROOT_ID");
+	return root;
 }
 
 Id::Id(const QString &editor, QString  const &diagram, QString  const &element, QString  const &id)
-		: mEditor(editor)
-		, mDiagram(diagram)
-		, mElement(element)
-		, mId(id)
+		: mType(idTypes()->intern(editor, diagram, element))
+		, mUuid(toCanonicalUuid(id))
+		, mIdString(mUuid.isNull() ? id : QString())
 {
 	Q_ASSERT(checkIntegrity());
 }
 
 Id::Id(const Id &base, const QString &additional)
-		: mEditor(base.mEditor)
-		, mDiagram(base.mDiagram)
-		, mElement(base.mElement)
-		, mId(base.mId)
+		: Id(base)
 {
 	const unsigned baseSize = base.idSize();
 	switch (baseSize) {
 	case 0:
-		mEditor = additional;
+		*this = Id(additional);
 		break;
 	case 1:
-		mDiagram = additional;
+		*this = Id(editor(), additional);
 		break;
 	case 2:
-		mElement = additional;
+		*this = Id(editor(), diagram(), additional);
 		break;
 	case 3:
-		mId = additional;
+		*this = Id(editor(), diagram(), element(), additional);
 		break;
 	default:
 		Q_ASSERT(!"Can not add a part to Id, it will be too long");
@@ -86,64 +165,67 @@ Id::Id(const Id &base, const QString &additional)
 }
 
 Id::Id()
-	: Id("")
+	: mType(idTypes()->emptyType())
 {
 }
 
 Id::Id(const Id &other)
-	: Id(other.editor(), other.diagram(), other.element(), other.id())
+	: mType(other.mType)
+	, mUuid(other.mUuid)
+	, mIdString(other.mIdString)
 {
 }
 
+Id::Id(const IdType *type, const QUuid &uuid, const QString &idString)
+	: mType(type)
+	, mUuid(uuid)
+	, mIdString(idString)
+{
+}
 
 bool Id::isNull() const
 {
-	return mEditor.isEmpty() && mDiagram.isEmpty()
-			&& mElement.isEmpty() && mId.isEmpty();
+	return mType->size == 0 && !hasIdPart();
 }
 
 QString Id::editor() const
 {
-	return mEditor;
+	return mType->editor;
 }
 
 QString Id::diagram() const
 {
-	return mDiagram;
+	return mType->diagram;
 }
 
 QString Id::element() const
 {
-	return mElement;
+	return mType->element;
 }
 
 QString Id::id() const
 {
-	return mId;
+	return mUuid.isNull() ? mIdString : mUuid.toString();
 }
 
 Id Id::type() const
 {
-	return Id(mEditor, mDiagram, mElement);
+	return Id(mType, QUuid(), QString());
 }
 
 Id Id::sameTypeId() const
 {
-	return Id(mEditor, mDiagram, mElement, QUuid::createUuid().toString());
+	return Id(mType, QUuid::createUuid(), QString());
 }
 
 unsigned Id::idSize() const
 {
-	if (!mId.isEmpty()) {
-		return 4;
-	} if (!mElement.isEmpty()) {
-		return 3;
-	} if (!mDiagram.isEmpty()) {
-		return 2;
-	} if (!mEditor.isEmpty()) {
-		return 1;
-	}
-	return 0;
+	return hasIdPart() ? 4 : mType->size;
+}
+
+bool Id::hasIdPart() const
+{
+	return !mUuid.isNull() || !mIdString.isEmpty();
 }
 
 QUrl Id::toUrl() const
@@ -153,38 +235,70 @@ QUrl Id::toUrl() const
 
 QString Id::toString() const
 {
-	QString path = "qrm:/" + mEditor;
-	if (mDiagram != "") {
-		path += "/" + mDiagram;
-	} if (mElement != "") {
-		path += "/" + mElement;
-	} if (mId != "") {
-		path += "/" + mId;
+	QString path = "qrm:/" + mType->editor;
+	if (!mType->diagram.isEmpty()) {
+		path += "/" + mType->diagram;
+	} if (!mType->element.isEmpty()) {
+		path += "/" + mType->element;
+	} if (hasIdPart()) {
+		path += "/" + id();
 	}
 	return path;
 }
 
+bool Id::less(const Id &i1, const Id &i2)
+{
+	if (i1.mType != i2.mType) {
+		const IdType &t1 = *i1.mType;
+		const IdType &t2 = *i2.mType;
+		return t1.editor != t2.editor ? t1.editor < t2.editor
+				: t1.diagram != t2.diagram ? t1.diagram < t2.diagram
+				: t1.element < t2.element;
+	}
+
+	if (!i1.mUuid.isNull() && !i2.mUuid.isNull()) {
+		// Canonical UUID strings consist of fixed-width lowercase hex fields, so comparing fields as numbers
+		// gives the same order as comparing strings. QUuid::operator< can not be used since it compares
+		// variants first.
+		if (i1.mUuid.data1 != i2.mUuid.data1) {
+			return i1.mUuid.data1 < i2.mUuid.data1;
+		}
+
+		if (i1.mUuid.data2 != i2.mUuid.data2) {
+			return i1.mUuid.data2 < i2.mUuid.data2;
+		}
+
+		if (i1.mUuid.data3 != i2.mUuid.data3) {
+			return i1.mUuid.data3 < i2.mUuid.data3;
+		}
+
+		return std::memcmp(i1.mUuid.data4, i2.mUuid.data4, sizeof(i1.mUuid.data4)) < 0;
+	}
+
+	return i1.id() < i2.id();
+}
+
 bool Id::checkIntegrity() const
 {
 	bool emptyPartsAllowed = true;
 
-	if (!mId.isEmpty()) {
+	if (hasIdPart()) {
 		emptyPartsAllowed = false;
 	}
 
-	if (!mElement.isEmpty()) {
+	if (!mType->element.isEmpty()) {
 		emptyPartsAllowed = false;
 	} else if (!emptyPartsAllowed) {
 		return false;
 	}
 
-	if (!mDiagram.isEmpty()) {
+	if (!mType->diagram.isEmpty()) {
 		emptyPartsAllowed = false;
 	} else if (!emptyPartsAllowed) {
 		return false;
 	}
 
-	if (mEditor.isEmpty() && !emptyPartsAllowed) {
+	if (mType->editor.isEmpty() && !emptyPartsAllowed) {
 		return false;
 	}
 
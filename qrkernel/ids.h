@@ -15,16 +15,40 @@
 #pragma once
 
 #include <QtCore/QUrl>
+#include <QtCore/QUuid>
 #include <QtCore/QDebug>
 
 #include "kernelDeclSpec.h"
 
 namespace qReal {
 
+namespace details {
+
+/// Editor, diagram and element parts of an Id. Instances are interned: there is only one instance for each
+/// combination of parts, shared between all Ids of that type and never deleted, so types can be compared
+/// by pointer.
+struct IdType
+{
+	QString editor;
+	QString diagram;
+	QString element;
+
+	/// Number of non-empty parts.
+	unsigned size;
+
+	/// Precomputed hash of all parts.
+	uint hash;
+};
+
+}
+
 /// Identifier of model element or element type. Consists of four parts ---
 /// editor (metamodel to which our element belongs to), diagram in that editor
 /// (a tab in palette where this element will appear), element (type of
 /// an element, actually), id (id of an element).
+/// First three parts are interned (see details::IdType), unique part is stored as 128-bit UUID when it is
+/// a UUID in canonical form (that is true for all generated ids), so copying, comparison and hashing of ids
+/// do not touch strings.
 class QRKERNEL_EXPORT Id
 {
 public:
@@ -101,13 +125,26 @@ public:
 
 	// default destructor and copy constuctor are OK
 private:
+	/// Creates Id with given interned type and unique part.
+	Id(const details::IdType *type, const QUuid &uuid, const QString &idString);
+
 	/// Used only for debug. Checks that Id is correct.
 	bool checkIntegrity() const;
 
-	QString mEditor;
-	QString mDiagram;
-	QString mElement;
-	QString mId;
+	/// Returns true if unique part of this Id is not empty.
+	bool hasIdPart() const;
+
+	/// Implementation of operator<, does not compare strings for ids of the same type with UUIDs.
+	static bool less(const Id &i1, const Id &i2);
+
+	/// Interned editor, diagram and element parts, never null.
+	const details::IdType *mType;
+
+	/// Unique part of an Id if it is a UUID in canonical form, null otherwise.
+	QUuid mUuid;
+
+	/// Unique part of an Id if it is not a UUID (may be empty).
+	QString mIdString;
 
 	friend bool operator==(const Id &i1, const Id &i2);
 	friend bool operator<(const Id &i1, const Id &i2);
@@ -117,10 +154,9 @@ private:
 /// Id equality operator. Ids are equal when all their parts are equal.
 inline bool operator==(const Id &i1, const Id &i2)
 {
-	return i1.mEditor == i2.mEditor
-			&& i1.mDiagram == i2.mDiagram
-			&& i1.mElement == i2.mElement
-			&& i1.mId == i2.mId;
+	return i1.mType == i2.mType
+			&& i1.mUuid == i2.mUuid
+			&& i1.mIdString == i2.mIdString;
 }
 
 /// Id inequality operator.
@@ -129,20 +165,19 @@ inline bool operator!=(const Id &i1, const Id &i2)
 	return !(i1 == i2);
 }
 
-/// Comparison operator for using Id in maps
+/// Comparison operator for using Id in maps. Orders ids as their parts are ordered as strings.
 inline bool operator<(const Id &i1, const Id &i2)
 {
-	// Faster implementation then just comapring toString().
-	return i1.mEditor != i2.mEditor ? i1.mEditor < i2.mEditor
-			: i1.mDiagram != i2.mDiagram ? i1.mDiagram < i2.mDiagram
-			: i1.mElement != i2.mElement ? i1.mElement < i2.mElement
-			: i1.mId < i2.mId;
+	return Id::less(i1, i2);
 }
 
 /// Hash function for Id for using it in QHash.
 inline uint qHash(const Id &key)
 {
-	return qHash(key.mEditor) ^ qHash(key.mDiagram) ^ qHash(key.mElement) ^ qHash(key.mId);
+	uint result = key.mType->hash;
+	const uint idHash = key.mUuid.isNull() ? qHash(key.mIdString) : qHash(key.mUuid);
+	result ^= idHash + 0x9e3779b9 + (result << 6) + (result >> 2);
+	return result;
 }
 
 /// Operator for printing Id in QDebug.
@@ -83,6 +83,7 @@ void GraphicalObject::createGraphicalPart(int index)
 
 	GraphicalPart * const part = new GraphicalPart();
 	mGraphicalParts.insert(index, part);
+	touch();
 }
 
 QList<int> GraphicalObject::graphicalParts() const
@@ -106,6 +107,7 @@ void GraphicalObject::setGraphicalPartProperty(int index, const QString &name, c
 	}
 
 	mGraphicalParts[index]->setProperty(name, value);
+	touch();
 }
 
 Object *GraphicalObject::createClone() const
@@ -14,6 +14,8 @@
 
 #include "object.h"
 
+#include <atomic>
+
 #include <QtCore/QDebug>
 
 #include <qrkernel/exception/exception.h>
@@ -26,13 +28,18 @@
 using namespace qrRepo::details;
 using namespace qReal;
 
+/// Source of modification stamps, objects can be constructed concurrently while loading.
+static std::atomic<quint64> lastRevision(0);
+
 Object::Object(const Id &id)
 	: mId(id)
+	, mRevision(++lastRevision)
 {
 }
 
 Object::Object(const QDomElement &element)
 	: mId(Id::loadFromString(element.attribute("id", "")))
+	, mRevision(++lastRevision)
 {
 	if (mId.isNull()) {
 		throw Exception("Id deserialization failed");
@@ -62,6 +69,7 @@ void Object::replaceProperties(const QString &value, const QString &newValue)
 	for (const QVariant &val : mProperties.values()) {
 		if (val.toString().contains(value)) {
 			mProperties[mProperties.key(val)] = newValue;
+			touch();
 		}
 	}
 }
@@ -88,6 +96,7 @@ Object *Object::clone(QHash<Id, Object*> &objHash) const
 void Object::setParent(const Id &parent)
 {
 	mParent = parent;
+	touch();
 }
 
 void Object::addChild(const Id &child)
@@ -97,12 +106,14 @@ void Object::addChild(const Id &child)
 	}
 
 	mChildren.append(child);
+	touch();
 }
 
 void Object::removeChild(const Id &child)
 {
 	if (mChildren.contains(child)) {
 		mChildren.removeAll(child);
+		touch();
 	} else {
 		throw Exception("Object " + mId.toString() + ": removing nonexistent child " + child.toString());
 	}
@@ -111,6 +122,7 @@ void Object::removeChild(const Id &child)
 void Object::copyPropertiesFrom(const Object &src)
 {
 	mProperties = src.mProperties;
+	touch();
 }
 
 IdList Object::children() const
@@ -134,6 +146,7 @@ void Object::stackBefore(const qReal::Id &element, const qReal::Id &sibling)
 
 	mChildren.removeOne(element);
 	mChildren.insert(mChildren.indexOf(sibling), element);
+	touch();
 }
 
 Id Object::parent() const
@@ -150,11 +163,13 @@ void Object::setProperty(const QString &name, const QVariant &value)
 	}
 
 	mProperties.insert(name,value);
+	touch();
 }
 
 void Object::setProperties(QMap<QString, QVariant> const &properties)
 {
 	mProperties = properties;
+	touch();
 }
 
 QVariant Object::property(const QString &name) const
@@ -174,6 +189,7 @@ void Object::setBackReference(const qReal::Id &reference)
 	IdList references = mProperties["backReferences"].value<IdList>();
 	references << reference;
 	mProperties.insert("backReferences", qReal::IdListHelper::toVariant(references));
+	touch();
 }
 
 void Object::removeBackReference(const qReal::Id &reference)
@@ -189,6 +205,7 @@ void Object::removeBackReference(const qReal::Id &reference)
 
 	references.removeOne(reference);
 	mProperties.insert("backReferences", qReal::IdListHelper::toVariant(references));
+	touch();
 }
 
 void Object::setTemporaryRemovedLinks(const QString &direction, const qReal::IdList &listValue)
@@ -210,6 +227,7 @@ void Object::removeTemporaryRemovedLinksAt(const QString &direction)
 {
 	if (mTemporaryRemovedLinks.contains(direction)) {
 		mProperties.remove(direction);
+		touch();
 	}
 }
 
@@ -243,6 +261,7 @@ void Object::removeProperty(const QString &name)
 {
 	if (mProperties.contains(name)) {
 		mProperties.remove(name);
+		touch();
 	} else {
 		throw Exception("Object " + mId.toString() + ": removing nonexistent property " + name);
 	}
@@ -253,6 +272,16 @@ Id Object::id() const
 	return mId;
 }
 
+quint64 Object::revision() const
+{
+	return mRevision;
+}
+
+void Object::touch()
+{
+	mRevision = ++lastRevision;
+}
+
 QMapIterator<QString, QVariant> Object::propertiesIterator() const
 {
 	return QMapIterator<QString, QVariant>(mProperties);
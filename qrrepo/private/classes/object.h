@@ -86,15 +86,23 @@ public:
 	/// Returns true, if it is logical object, false, if graphical.
 	virtual bool isLogicalObject() const = 0;
 
+	/// Returns modification stamp of this object. Stamps are unique among all objects and are renewed on each
+	/// change of serialized data, so serializer can tell if an object was modified since it was last saved.
+	quint64 revision() const;
+
 protected:
 	/// Implemented in derived classes to create a clone and init it with specific fields.
 	virtual Object *createClone() const = 0;
 
+	/// Assigns new modification stamp to an object, must be called on each change of serialized data.
+	void touch();
+
 	const qReal::Id mId;
 	qReal::Id mParent;
 	qReal::IdList mChildren;
 	QMap<QString, QVariant> mProperties;
 	QMap<QString, qReal::IdList> mTemporaryRemovedLinks;
+	quint64 mRevision;
 };
 
 }
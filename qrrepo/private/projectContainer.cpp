@@ -0,0 +1,210 @@
+/* Copyright 2007-2016 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "projectContainer.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+
+#include "exceptions/corruptSavefileException.h"
+#include "exceptions/couldNotCreateDestinationFolderException.h"
+#include "exceptions/couldNotCreateOutFileException.h"
+#include "exceptions/couldNotOpenDestinationFileException.h"
+#include "exceptions/saveFileNotFoundException.h"
+#include "exceptions/saveFileNotReadableException.h"
+
+using namespace qrRepo;
+using namespace qrRepo::details;
+
+/// "QRSC" in ASCII. Old format files start with the length of the first file name in bytes,
+/// that can never be that large, so they never start with this value.
+const quint32 containerMagic = 0x51525343;
+const quint32 containerVersion = 1;
+
+/// Magic, version and offset of table of contents.
+const qint64 headerSize = sizeof(quint32) + sizeof(quint32) + sizeof(quint64);
+
+/// Offset of the table of contents offset field in header.
+const qint64 tocOffsetPosition = sizeof(quint32) + sizeof(quint32);
+
+const QDataStream::Version streamVersion = QDataStream::Qt_5_0;
+
+ProjectContainer::ProjectContainer(const QString &fileName)
+	: mFile(fileName)
+{
+	if (!mFile.exists()) {
+		throw SaveFileNotFoundException(fileName);
+	}
+
+	if (!mFile.open(QIODevice::ReadOnly)) {
+		throw SaveFileNotReadableException(fileName);
+	}
+
+	QDataStream stream(&mFile);
+	stream.setVersion(streamVersion);
+
+	quint32 magic = 0;
+	quint32 version = 0;
+	quint64 tocOffset = 0;
+	stream >> magic >> version >> tocOffset;
+	if (stream.status() != QDataStream::Ok || magic != containerMagic || version != containerVersion
+			|| tocOffset < static_cast<quint64>(headerSize) || tocOffset > static_cast<quint64>(mFile.size()))
+	{
+		throw CorruptSaveFileException(fileName);
+	}
+
+	mFile.seek(tocOffset);
+	quint32 count = 0;
+	stream >> count;
+	for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+		QString name;
+		Entry entry;
+		stream >> name >> entry.offset >> entry.size;
+		if (entry.offset + entry.size > tocOffset) {
+			throw CorruptSaveFileException(fileName);
+		}
+
+		mEntryNames << name;
+		mEntries.insert(name, entry);
+	}
+
+	if (stream.status() != QDataStream::Ok) {
+		throw CorruptSaveFileException(fileName);
+	}
+}
+
+bool ProjectContainer::isContainer(const QString &fileName)
+{
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return false;
+	}
+
+	QDataStream stream(&file);
+	quint32 magic = 0;
+	stream >> magic;
+	return stream.status() == QDataStream::Ok && magic == containerMagic;
+}
+
+QStringList ProjectContainer::entries() const
+{
+	return mEntryNames;
+}
+
+QString ProjectContainer::fileName() const
+{
+	return mFile.fileName();
+}
+
+bool ProjectContainer::contains(const QString &entry) const
+{
+	return mEntries.contains(entry);
+}
+
+QByteArray ProjectContainer::read(const QString &entry) const
+{
+	const QByteArray raw = readRaw(entry);
+	const QByteArray data = qUncompress(raw);
+	// qCompress() stores the size of uncompressed data in first 4 bytes, empty entries are legal.
+	if (data.isEmpty() && (raw.size() < 4 || raw.left(4) != QByteArray(4, '\0'))) {
+		throw CorruptSaveFileException(mFile.fileName());
+	}
+
+	return data;
+}
+
+QByteArray ProjectContainer::readRaw(const QString &entry) const
+{
+	const auto it = mEntries.constFind(entry);
+	if (it == mEntries.constEnd() || !mFile.seek(it->offset)) {
+		throw CorruptSaveFileException(mFile.fileName());
+	}
+
+	const QByteArray data = mFile.read(it->size);
+	if (static_cast<quint32>(data.size()) != it->size) {
+		throw CorruptSaveFileException(mFile.fileName());
+	}
+
+	return data;
+}
+
+void ProjectContainer::extractTo(const QString &destinationFolder) const
+{
+	QDir dir;
+	if (!dir.mkpath(destinationFolder)) {
+		throw CouldNotCreateDestinationFolderException(destinationFolder);
+	}
+
+	for (const QString &entry : mEntryNames) {
+		const QString filePath = destinationFolder + "/" + entry;
+		dir.mkpath(QFileInfo(filePath).absolutePath());
+
+		QFile outFile(filePath);
+		if (!outFile.open(QIODevice::WriteOnly)) {
+			throw CouldNotCreateOutFileException(outFile.fileName());
+		}
+
+		outFile.write(read(entry));
+		outFile.close();
+	}
+}
+
+ProjectContainerWriter::ProjectContainerWriter(const QString &fileName)
+	: mFile(fileName)
+{
+	if (!mFile.open(QIODevice::WriteOnly)) {
+		throw CouldNotOpenDestinationFileException(fileName);
+	}
+
+	QDataStream stream(&mFile);
+	stream.setVersion(streamVersion);
+	// Offset of table of contents is unknown yet, it will be filled in commit().
+	stream << containerMagic << containerVersion << quint64(0);
+}
+
+void ProjectContainerWriter::addEntry(const QString &entry, const QByteArray &data)
+{
+	addRawEntry(entry, qCompress(data));
+}
+
+void ProjectContainerWriter::addRawEntry(const QString &entry, const QByteArray &compressedData)
+{
+	const Entry record = {
+		entry
+		, static_cast<quint64>(mFile.pos())
+		, static_cast<quint32>(compressedData.size())
+	};
+
+	mFile.write(compressedData);
+	mEntries << record;
+}
+
+void ProjectContainerWriter::commit()
+{
+	const quint64 tocOffset = mFile.pos();
+	QDataStream stream(&mFile);
+	stream.setVersion(streamVersion);
+	stream << static_cast<quint32>(mEntries.size());
+	for (const Entry &entry : mEntries) {
+		stream << entry.name << entry.offset << entry.size;
+	}
+
+	mFile.seek(tocOffsetPosition);
+	stream << tocOffset;
+
+	if (stream.status() != QDataStream::Ok || !mFile.commit()) {
+		throw CouldNotOpenDestinationFileException(mFile.fileName());
+	}
+}
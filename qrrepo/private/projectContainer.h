@@ -0,0 +1,108 @@
+/* Copyright 2007-2016 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStringList>
+
+namespace qrRepo {
+namespace details {
+
+/// Reads single-file .qrs project container. Container consists of a header, a sequence of independently
+/// compressed entries and a table of contents with offsets of each entry, so any entry can be read
+/// without touching the others. Entries are named like files in old folder-based format
+/// ("/tree/logical/<editor>/<diagram>/<element>/<id>", "/metaInfo.xml").
+/// Save files of old format (produced by FolderCompressor) are not containers and should be detected
+/// with isContainer() before construction.
+class ProjectContainer
+{
+public:
+	/// Opens given container and reads its table of contents.
+	/// @throws SaveFileNotFoundException, SaveFileNotReadableException or CorruptSaveFileException.
+	explicit ProjectContainer(const QString &fileName);
+
+	/// Returns true if given file exists and is a container, false for old format save files.
+	static bool isContainer(const QString &fileName);
+
+	/// Returns names of all entries in the order they were written.
+	QStringList entries() const;
+
+	/// Returns true if container has an entry with the given name.
+	bool contains(const QString &entry) const;
+
+	/// Reads and decompresses the given entry.
+	/// @throws CorruptSaveFileException if entry is missing or damaged.
+	QByteArray read(const QString &entry) const;
+
+	/// Reads the given entry as it is stored in file, without decompression.
+	/// Can be passed to ProjectContainerWriter::addRawEntry() to copy an entry without recompression.
+	/// @throws CorruptSaveFileException if entry is missing or damaged.
+	QByteArray readRaw(const QString &entry) const;
+
+	/// Returns the name of container file.
+	QString fileName() const;
+
+	/// Writes all entries into the given folder as separate files, as FolderCompressor::decompressFolder() does.
+	/// @throws CouldNotCreateDestinationFolderException, CouldNotCreateOutFileException
+	///         or CorruptSaveFileException.
+	void extractTo(const QString &destinationFolder) const;
+
+private:
+	struct Entry
+	{
+		quint64 offset;
+		quint32 size;
+	};
+
+	mutable QFile mFile;
+	QStringList mEntryNames;
+	QHash<QString, Entry> mEntries;
+};
+
+/// Writes single-file .qrs project container (see ProjectContainer for format description).
+/// Data goes into temporary file that replaces destination file only when commit() succeeds,
+/// so failed save never damages previous one.
+class ProjectContainerWriter
+{
+public:
+	/// @throws CouldNotOpenDestinationFileException.
+	explicit ProjectContainerWriter(const QString &fileName);
+
+	/// Compresses and appends an entry with given name.
+	void addEntry(const QString &entry, const QByteArray &data);
+
+	/// Appends already compressed entry (obtained by ProjectContainer::readRaw()).
+	void addRawEntry(const QString &entry, const QByteArray &compressedData);
+
+	/// Writes table of contents and replaces destination file.
+	/// @throws CouldNotOpenDestinationFileException if writing failed.
+	void commit();
+
+private:
+	struct Entry
+	{
+		QString name;
+		quint64 offset;
+		quint32 size;
+	};
+
+	QSaveFile mFile;
+	QList<Entry> mEntries;
+};
+
+}
+}
@@ -33,6 +33,7 @@ void Repository::init()
 {
 	mObjects.insert(Id::rootId(), new LogicalObject(Id::rootId()));
 	mObjects[Id::rootId()]->setProperty("name", Id::rootId().toString());
+	reindex(Id::rootId());
 }
 
 Repository::~Repository()
@@ -48,24 +49,10 @@ Serializer &Repository::serializer()
 
 IdList Repository::findElementsByName(const QString &name, bool sensitivity, bool regExpression) const
 {
-	const Qt::CaseSensitivity caseSensitivity = sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive;
-
-	const QRegExp regExp(name, caseSensitivity);
 	IdList result;
-
-	if (regExpression){
-		for (Object * const element : mObjects.values()) {
-			if (element->property("name").toString().contains(regExp)
-					&& !isLogicalId(mObjects.key(element))) {
-				result.append(mObjects.key(element));
-			}
-		}
-	} else {
-		for (Object * const element : mObjects.values()) {
-			if (element->property("name").toString().contains(name, caseSensitivity)
-					&& !isLogicalId(mObjects.key(element))) {
-				result.append(mObjects.key(element));
-			}
+	for (const Id &id : mSearchIndex.byName(name, sensitivity, regExpression)) {
+		if (!isLogicalId(id)) {
+			result.append(id);
 		}
 	}
 
@@ -76,11 +63,9 @@ qReal::IdList Repository::elementsByProperty(const QString &property, bool sensi
 		, bool regExpression) const
 {
 	IdList result;
-
-	for (Object *element : mObjects.values()) {
-		if ((element->hasProperty(property, sensitivity, regExpression))
-				&& (!isLogicalId(mObjects.key(element)))) {
-			result.append(mObjects.key(element));
+	for (const Id &id : mSearchIndex.byProperty(property, sensitivity, regExpression)) {
+		if (!isLogicalId(id)) {
+			result.append(id);
 		}
 	}
 
@@ -90,37 +75,14 @@ qReal::IdList Repository::elementsByProperty(const QString &property, bool sensi
 qReal::IdList Repository::elementsByPropertyContent(const QString &propertyValue, bool sensitivity
 		, bool regExpression) const
 {
-	const Qt::CaseSensitivity caseSensitivity = sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive;
-
-	const QRegExp regExp(propertyValue, caseSensitivity);
-	IdList result;
-
-	for (Object * const element : mObjects.values()) {
-		QMapIterator<QString, QVariant> iterator = element->propertiesIterator();
-		if (regExpression) {
-			while (iterator.hasNext()) {
-				if (iterator.next().value().toString().contains(regExp)) {
-					result.append(mObjects.key(element));
-					break;
-				}
-			}
-		} else {
-			while (iterator.hasNext()) {
-				if (iterator.next().value().toString().contains(propertyValue, caseSensitivity)) {
-					result.append(mObjects.key(element));
-					break;
-				}
-			}
-		}
-	}
-
-	return result;
+	return mSearchIndex.byPropertyContent(propertyValue, sensitivity, regExpression).toList();
 }
 
 void Repository::replaceProperties(const qReal::IdList &toReplace, const QString &value, const QString &newValue)
 {
 	for (const qReal::Id &currentId : toReplace) {
 		mObjects[currentId]->replaceProperties(value, newValue);
+		reindex(currentId);
 	}
 }
 
@@ -145,6 +107,10 @@ Id Repository::parent(const Id &id) const
 Id Repository::cloneObject(const qReal::Id &id)
 {
 	const Object * const result = mObjects[id]->clone(mObjects);
+	for (const Id &clonedId : idsOfAllChildrenOf(result->id())) {
+		reindex(clonedId);
+	}
+
 	return result->id();
 }
 
@@ -238,7 +204,7 @@ void Repository::removeChild(const Id &id, const Id &child)
 	}
 }
 
-void Repository::setProperty(const Id &id, const QString &name, const QVariant &value ) const
+void Repository::setProperty(const Id &id, const QString &name, const QVariant &value)
 {
 	if (mObjects.contains(id)) {
 		// see Object::property() for details
@@ -246,6 +212,7 @@ void Repository::setProperty(const Id &id, const QString &name, const QVariant &
 //				 ? mObjects[id]->property(name).userType() == value.userType()
 //				 : true);
 		mObjects[id]->setProperty(name, value);
+		reindex(id);
 	} else {
 		throw Exception("Repository: Setting property of nonexistent object " + id.toString());
 	}
@@ -254,6 +221,7 @@ void Repository::setProperty(const Id &id, const QString &name, const QVariant &
 void Repository::copyProperties(const Id &dest, const Id &src)
 {
 	mObjects[dest]->copyPropertiesFrom(*mObjects[src]);
+	reindex(dest);
 }
 
 QMap<QString, QVariant> Repository::properties(const Id &id) const
@@ -264,6 +232,7 @@ QMap<QString, QVariant> Repository::properties(const Id &id) const
 void Repository::setProperties(const Id &id, QMap<QString, QVariant> const &properties)
 {
 	mObjects[id]->setProperties(properties);
+	reindex(id);
 }
 
 QVariant Repository::property(const Id &id, const QString &name) const
@@ -278,7 +247,8 @@ QVariant Repository::property(const Id &id, const QString &name) const
 void Repository::removeProperty(const Id &id, const QString &name)
 {
 	if (mObjects.contains(id)) {
-		return mObjects[id]->removeProperty(name);
+		mObjects[id]->removeProperty(name);
+		reindex(id);
 	} else {
 		throw Exception("Repository: Removing property of nonexistent object " + id.toString());
 	}
@@ -294,11 +264,12 @@ bool Repository::hasProperty(const Id &id, const QString &name, bool sensitivity
 	}
 }
 
-void Repository::setBackReference(const Id &id, const Id &reference) const
+void Repository::setBackReference(const Id &id, const Id &reference)
 {
 	if (mObjects.contains(id)) {
 		if (mObjects.contains(reference)) {
 			mObjects[id]->setBackReference(reference);
+			reindex(id);
 		} else {
 			throw Exception("Repository: setting nonexistent back reference " + reference.toString()
 							+ " to object " + id.toString());
@@ -308,11 +279,12 @@ void Repository::setBackReference(const Id &id, const Id &reference) const
 	}
 }
 
-void Repository::removeBackReference(const Id &id, const Id &reference) const
+void Repository::removeBackReference(const Id &id, const Id &reference)
 {
 	if (mObjects.contains(id)) {
 		if (mObjects.contains(reference)) {
 			mObjects[id]->removeBackReference(reference);
+			reindex(id);
 		} else {
 			throw Exception("Repository: removing nonexistent back reference " + reference.toString()
 							+ " of object " + id.toString());
@@ -352,7 +324,8 @@ IdList Repository::temporaryRemovedLinks(const Id &id) const
 void Repository::removeTemporaryRemovedLinks(const Id &id)
 {
 	if (mObjects.contains(id)) {
-		return mObjects[id]->removeTemporaryRemovedLinks();
+		mObjects[id]->removeTemporaryRemovedLinks();
+		reindex(id);
 	} else {
 		throw Exception("Repository: Removing temporaryRemovedLinks of nonexistent object " + id.toString());
 	}
@@ -362,6 +335,7 @@ void Repository::loadFromDisk()
 {
 	mSerializer.loadFromDisk(mObjects, mMetaInfo);
 	addChildrenToRootObject();
+	reindexAll();
 }
 
 void Repository::importFromDisk(const QString &importedFile)
@@ -382,6 +356,19 @@ void Repository::addChildrenToRootObject()
 	}
 }
 
+void Repository::reindex(const Id &id)
+{
+	mSearchIndex.update(id, mObjects[id]->properties());
+}
+
+void Repository::reindexAll()
+{
+	mSearchIndex.clear();
+	for (auto it = mObjects.constBegin(); it != mObjects.constEnd(); ++it) {
+		mSearchIndex.update(it.key(), it.value()->properties());
+	}
+}
+
 IdList Repository::idsOfAllChildrenOf(Id id) const
 {
 	IdList result;
@@ -486,6 +473,7 @@ void Repository::remove(const qReal::Id &id)
 	if (mObjects.contains(id)) {
 		delete mObjects[id];
 		mObjects.remove(id);
+		mSearchIndex.remove(id);
 	} else {
 		throw Exception("Repository: Trying to remove nonexistent object " + id.toString());
 	}
@@ -525,6 +513,7 @@ bool Repository::exterminate()
 {
 	printDebug();
 	mObjects.clear();
+	mSearchIndex.clear();
 	//serializer.clearWorkingDir();
 	bool result = !mWorkingFile.isEmpty() && mSerializer.saveToDisk(mObjects.values(), mMetaInfo);
 
@@ -537,6 +526,7 @@ bool Repository::exterminate()
 void Repository::open(const QString &saveFile)
 {
 	mObjects.clear();
+	mSearchIndex.clear();
 	init();
 	mSerializer.setWorkingFile(saveFile);
 	mWorkingFile = saveFile;
@@ -22,6 +22,7 @@
 #include "classes/graphicalObject.h"
 #include "classes/logicalObject.h"
 #include "serializer.h"
+#include "searchIndex.h"
 
 namespace qrRepo {
 namespace details {
@@ -71,7 +72,7 @@ public:
 	/// Stacks element child before sibling (element id shold be parent of them both)
 	void stackBefore(const qReal::Id &id, const qReal::Id &child, const qReal::Id &sibling);
 
-	void setProperty(const qReal::Id &id, const QString &name, const QVariant &value) const;
+	void setProperty(const qReal::Id &id, const QString &name, const QVariant &value);
 	void copyProperties(const qReal::Id &dest, const qReal::Id &src);
 	QVariant property(const qReal::Id &id, const QString &name) const;
 	QMap<QString, QVariant> properties(const qReal::Id &id) const;
@@ -81,8 +82,8 @@ public:
 	void removeProperty(const qReal::Id &id, const QString &name);
 	QMapIterator<QString, QVariant> propertiesIterator(const qReal::Id &id) const;
 
-	void setBackReference(const qReal::Id &id, const qReal::Id &reference) const;
-	void removeBackReference(const qReal::Id &id, const qReal::Id &reference) const;
+	void setBackReference(const qReal::Id &id, const qReal::Id &reference);
+	void removeBackReference(const qReal::Id &id, const qReal::Id &reference);
 
 	void setTemporaryRemovedLinks(const qReal::Id &id, const QString &direction, const qReal::IdList &linkIdList);
 	qReal::IdList temporaryRemovedLinksAt(const qReal::Id &id, const QString &direction) const;
@@ -158,6 +159,12 @@ private:
 	void loadFromDisk();
 	void addChildrenToRootObject();
 
+	/// Brings search index in accordance with current properties of the object with given id.
+	void reindex(const qReal::Id &id);
+
+	/// Rebuilds search index from scratch for all objects in repository.
+	void reindexAll();
+
 	qReal::IdList idsOfAllChildrenOf(qReal::Id id) const;
 	QList<Object*> allChildrenOf(qReal::Id id) const;
 	QList<Object*> allChildrenOfWithLogicalId(qReal::Id id) const;
@@ -165,6 +172,9 @@ private:
 	QHash<qReal::Id, Object *> mObjects;
 	QHash<QString, QVariant> mMetaInfo;
 
+	/// Secondary indexes used by search queries, must be updated on each modification of object properties.
+	SearchIndex mSearchIndex;
+
 	/// Name of the current save file for project.
 	QString mWorkingFile;
 	Serializer mSerializer;
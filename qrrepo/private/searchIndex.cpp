@@ -0,0 +1,245 @@
+/* Copyright 2007-2016 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "searchIndex.h"
+
+using namespace qReal;
+using namespace qrRepo::details;
+
+/// Length of substrings by which distinct strings are indexed.
+const int gramLength = 3;
+
+void StringIndex::insert(const QString &string, const Id &id)
+{
+	auto posting = mPostings.find(string);
+	if (posting == mPostings.end()) {
+		posting = mPostings.insert(string, QHash<Id, int>());
+		for (const QString &trigram : trigrams(string.toCaseFolded())) {
+			mTrigrams[trigram].insert(string);
+		}
+	}
+
+	++(*posting)[id];
+}
+
+void StringIndex::remove(const QString &string, const Id &id)
+{
+	const auto posting = mPostings.find(string);
+	if (posting == mPostings.end()) {
+		return;
+	}
+
+	const auto occurences = posting->find(id);
+	if (occurences == posting->end()) {
+		return;
+	}
+
+	if (--(*occurences) > 0) {
+		return;
+	}
+
+	posting->erase(occurences);
+	if (!posting->isEmpty()) {
+		return;
+	}
+
+	mPostings.erase(posting);
+	for (const QString &trigram : trigrams(string.toCaseFolded())) {
+		const auto strings = mTrigrams.find(trigram);
+		strings->remove(string);
+		if (strings->isEmpty()) {
+			mTrigrams.erase(strings);
+		}
+	}
+}
+
+void StringIndex::clear()
+{
+	mPostings.clear();
+	mTrigrams.clear();
+}
+
+QSet<Id> StringIndex::equalTo(const QString &string, Qt::CaseSensitivity sensitivity) const
+{
+	QSet<Id> result;
+	if (sensitivity == Qt::CaseSensitive) {
+		unite(result, string);
+		return result;
+	}
+
+	for (auto it = mPostings.constBegin(); it != mPostings.constEnd(); ++it) {
+		if (it.key().compare(string, Qt::CaseInsensitive) == 0) {
+			unite(result, it.key());
+		}
+	}
+
+	return result;
+}
+
+QSet<Id> StringIndex::containing(const QString &substring, Qt::CaseSensitivity sensitivity) const
+{
+	QSet<Id> result;
+	const QString folded = substring.toCaseFolded();
+	if (folded.length() < gramLength) {
+		// Too short to be looked up by trigrams, checking all distinct strings (but still not all the elements).
+		for (auto it = mPostings.constBegin(); it != mPostings.constEnd(); ++it) {
+			if (it.key().contains(substring, sensitivity)) {
+				unite(result, it.key());
+			}
+		}
+
+		return result;
+	}
+
+	// Each string containing the substring must contain all its trigrams, so candidates are taken from the
+	// rarest one.
+	const QSet<QString> *candidates = nullptr;
+	for (const QString &trigram : trigrams(folded)) {
+		const auto strings = mTrigrams.constFind(trigram);
+		if (strings == mTrigrams.constEnd()) {
+			return result;
+		}
+
+		if (!candidates || strings->size() < candidates->size()) {
+			candidates = &strings.value();
+		}
+	}
+
+	for (const QString &candidate : *candidates) {
+		if (candidate.contains(substring, sensitivity)) {
+			unite(result, candidate);
+		}
+	}
+
+	return result;
+}
+
+QSet<Id> StringIndex::matching(const QRegExp &regExp) const
+{
+	QSet<Id> result;
+	for (auto it = mPostings.constBegin(); it != mPostings.constEnd(); ++it) {
+		if (it.key().contains(regExp)) {
+			unite(result, it.key());
+		}
+	}
+
+	return result;
+}
+
+QSet<QString> StringIndex::trigrams(const QString &foldedString)
+{
+	QSet<QString> result;
+	for (int i = 0; i + gramLength <= foldedString.length(); ++i) {
+		result.insert(foldedString.mid(i, gramLength));
+	}
+
+	return result;
+}
+
+void StringIndex::unite(QSet<Id> &result, const QString &string) const
+{
+	const QHash<Id, int> posting = mPostings.value(string);
+	for (auto it = posting.constBegin(); it != posting.constEnd(); ++it) {
+		result.insert(it.key());
+	}
+}
+
+void SearchIndex::update(const Id &id, const QMap<QString, QVariant> &properties)
+{
+	QMap<QString, QString> &indexed = mIndexedProperties[id];
+
+	for (auto it = indexed.begin(); it != indexed.end();) {
+		if (!properties.contains(it.key())) {
+			removeProperty(id, it.key(), it.value());
+			it = indexed.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	for (auto it = properties.constBegin(); it != properties.constEnd(); ++it) {
+		const QString value = it.value().toString();
+		const auto old = indexed.find(it.key());
+		if (old != indexed.end()) {
+			if (old.value() == value) {
+				continue;
+			}
+
+			removeProperty(id, it.key(), old.value());
+		}
+
+		insertProperty(id, it.key(), value);
+		indexed[it.key()] = value;
+	}
+}
+
+void SearchIndex::remove(const Id &id)
+{
+	const QMap<QString, QString> indexed = mIndexedProperties.take(id);
+	for (auto it = indexed.constBegin(); it != indexed.constEnd(); ++it) {
+		removeProperty(id, it.key(), it.value());
+	}
+}
+
+void SearchIndex::clear()
+{
+	mNames.clear();
+	mKeys.clear();
+	mValues.clear();
+	mIndexedProperties.clear();
+}
+
+QSet<Id> SearchIndex::byName(const QString &name, bool sensitivity, bool regExpression) const
+{
+	const Qt::CaseSensitivity caseSensitivity = sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive;
+	return regExpression
+			? mNames.matching(QRegExp(name, caseSensitivity))
+			: mNames.containing(name, caseSensitivity);
+}
+
+QSet<Id> SearchIndex::byProperty(const QString &property, bool sensitivity, bool regExpression) const
+{
+	const Qt::CaseSensitivity caseSensitivity = sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive;
+	return regExpression
+			? mKeys.matching(QRegExp(property, caseSensitivity))
+			: mKeys.equalTo(property, caseSensitivity);
+}
+
+QSet<Id> SearchIndex::byPropertyContent(const QString &value, bool sensitivity, bool regExpression) const
+{
+	const Qt::CaseSensitivity caseSensitivity = sensitivity ? Qt::CaseSensitive : Qt::CaseInsensitive;
+	return regExpression
+			? mValues.matching(QRegExp(value, caseSensitivity))
+			: mValues.containing(value, caseSensitivity);
+}
+
+void SearchIndex::insertProperty(const Id &id, const QString &key, const QString &value)
+{
+	if (key == "name") {
+		mNames.insert(value, id);
+	}
+
+	mKeys.insert(key, id);
+	mValues.insert(value, id);
+}
+
+void SearchIndex::removeProperty(const Id &id, const QString &key, const QString &value)
+{
+	if (key == "name") {
+		mNames.remove(value, id);
+	}
+
+	mKeys.remove(key, id);
+	mValues.remove(value, id);
+}
@@ -0,0 +1,102 @@
+/* Copyright 2007-2016 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QRegExp>
+#include <QtCore/QSet>
+#include <QtCore/QVariant>
+
+#include <qrkernel/ids.h>
+
+namespace qrRepo {
+namespace details {
+
+/// Inverted index over distinct strings. Each distinct string keeps a reference-counted set of ids of
+/// elements that hold it, and is additionally indexed by its case-folded trigrams, so substring queries
+/// only have to check strings that contain every trigram of the query instead of scanning all elements.
+class StringIndex
+{
+public:
+	/// Registers one more occurence of @a string in the element with the given @a id.
+	void insert(const QString &string, const qReal::Id &id);
+
+	/// Removes one occurence of @a string from the element with the given @a id.
+	void remove(const QString &string, const qReal::Id &id);
+
+	/// Removes everything from the index.
+	void clear();
+
+	/// Returns ids of elements that hold a string equal to @a string.
+	QSet<qReal::Id> equalTo(const QString &string, Qt::CaseSensitivity sensitivity) const;
+
+	/// Returns ids of elements that hold a string containing @a substring.
+	QSet<qReal::Id> containing(const QString &substring, Qt::CaseSensitivity sensitivity) const;
+
+	/// Returns ids of elements that hold a string matched somewhere by @a regExp.
+	QSet<qReal::Id> matching(const QRegExp &regExp) const;
+
+private:
+	static QSet<QString> trigrams(const QString &foldedString);
+	void unite(QSet<qReal::Id> &result, const QString &string) const;
+
+	/// Maps each distinct string to ids of elements holding it and the number of such occurences in element.
+	QHash<QString, QHash<qReal::Id, int>> mPostings;
+
+	/// Maps each case-folded trigram to the distinct strings containing it.
+	QHash<QString, QSet<QString>> mTrigrams;
+};
+
+/// Secondary indexes for repository search: element names, property keys and property values.
+/// Kept up to date by repository on each mutation of element properties, so search queries do not need
+/// to walk through all the objects.
+class SearchIndex
+{
+public:
+	/// Brings the index for the element with the given @a id in accordance with its current @a properties.
+	/// Only the difference with the previously indexed properties of this element is applied.
+	void update(const qReal::Id &id, const QMap<QString, QVariant> &properties);
+
+	/// Removes all the information about the element with the given @a id from the index.
+	void remove(const qReal::Id &id);
+
+	/// Removes everything from the index.
+	void clear();
+
+	/// Returns ids of elements whose names contain given string or are matched by given regular expression.
+	QSet<qReal::Id> byName(const QString &name, bool sensitivity, bool regExpression) const;
+
+	/// Returns ids of elements that have property with the given name or matched by given regular expression.
+	QSet<qReal::Id> byProperty(const QString &property, bool sensitivity, bool regExpression) const;
+
+	/// Returns ids of elements having some property whose value contains given string
+	/// or is matched by given regular expression.
+	QSet<qReal::Id> byPropertyContent(const QString &value, bool sensitivity, bool regExpression) const;
+
+private:
+	void insertProperty(const qReal::Id &id, const QString &key, const QString &value);
+	void removeProperty(const qReal::Id &id, const QString &key, const QString &value);
+
+	StringIndex mNames;
+	StringIndex mKeys;
+	StringIndex mValues;
+
+	/// String representations of properties of each element as they were put into index.
+	QHash<qReal::Id, QMap<QString, QString>> mIndexedProperties;
+};
+
+}
+}
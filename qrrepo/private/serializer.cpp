@@ -14,18 +14,23 @@
 
 #include "serializer.h"
 
+#include <exception>
+
 #include <QtCore/QDir>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QUuid>
+#include <QtCore/QScopedPointer>
+#include <QtConcurrent/QtConcurrentMap>
 #include <QtCore/QFileInfo>
 
+#include <qrkernel/logging.h>
 #include <qrkernel/platformInfo.h>
 #include <qrkernel/exception/exception.h>
-#include <qrutils/outFile.h>
 #include <qrutils/xmlUtils.h>
 #include <qrutils/fileSystemUtils.h>
 
 #include "folderCompressor.h"
+#include "projectContainer.h"
 #include "classes/logicalObject.h"
 #include "classes/graphicalObject.h"
 
@@ -36,6 +41,10 @@ using namespace qReal;
 
 const QString unsavedDir = "%1/unsaved/%2";
 
+/// Names of save file entries, they are the same as paths of files in unpacked save of old format.
+const QString treeEntriesPrefix = "/tree/";
+const QString metaInfoEntry = "/metaInfo.xml";
+
 Serializer::Serializer(const QString &workingFile)
 	// Syncroniously running instances of QReal can clear temp dirs of each other.
 	// So generating new UUID as temp dir name.
@@ -81,34 +90,48 @@ bool Serializer::saveToDisk(QList<Object *> const &objects, QHash<QString, QVari
 		, "Serializer::saveToDisk(...)"
 		, "may be Repository of RepoApi (see Models constructor also) has been initialised with empty filename?");
 
-	clearWorkingDir();
-	for (const Object * const object : objects) {
-		const QString filePath = createDirectory(object->id(), object->isLogicalObject());
-
-		QDomDocument doc;
-		QDomElement root = object->serialize(doc);
-		doc.appendChild(root);
-
-		OutFile out(filePath);
-		doc.save(out(), 2);
-	}
-
-	saveMetaInfo(metaInfo);
-
 	const QFileInfo fileInfo(mWorkingFile);
 	const QString fileName = fileInfo.completeBaseName();
+	const QString filePath = fileInfo.absolutePath() + "/" + fileName + ".qrs";
 
-	const QDir compressDir(mWorkingDir);
-	const QDir dir = fileInfo.absolutePath();
-
-	QFile previousSave(dir.absolutePath() + "/" + fileName +".qrs");
-	if (previousSave.exists()) {
-		previousSave.remove();
+	// Entries of objects that were not modified since previous save into the same file are copied as is,
+	// without serialization and compression.
+	const SaveFileState previousState = mSaveFileStates.take(filePath);
+	QScopedPointer<ProjectContainer> previousSave;
+	if (!previousState.revisions.isEmpty() && isUpToDate(filePath, previousState)) {
+		try {
+			previousSave.reset(new ProjectContainer(filePath));
+		} catch (...) {
+			previousSave.reset();
+		}
 	}
 
-	const QString filePath = fileInfo.absolutePath() + "/" + fileName + ".qrs";
+	SaveStatistics statistics;
+	SaveFileState state;
 	try {
-		FolderCompressor::compressFolder(compressDir.absolutePath(), filePath);
+		ProjectContainerWriter container(filePath);
+		for (const Object * const object : objects) {
+			const QString entry = entryName(object->id(), object->isLogicalObject());
+			if (previousSave && previousState.revisions.value(object->id()) == object->revision()
+					&& previousSave->contains(entry))
+			{
+				container.addRawEntry(entry, previousSave->readRaw(entry));
+				++statistics.objectsReused;
+			} else {
+				const QByteArray data = qCompress(serializeObject(*object));
+				container.addRawEntry(entry, data);
+				++statistics.objectsWritten;
+				statistics.bytesWritten += data.size();
+			}
+
+			state.revisions[object->id()] = object->revision();
+		}
+
+		container.addEntry(metaInfoEntry, serializeMetaInfo(metaInfo));
+
+		// Previous save must be closed before it is replaced.
+		previousSave.reset();
+		container.commit();
 	} catch (...) {
 		return false;
 	}
@@ -118,14 +141,35 @@ bool Serializer::saveToDisk(QList<Object *> const &objects, QHash<QString, QVari
 		FileSystemUtils::makeHidden(filePath);
 	}
 
-	clearWorkingDir();
+	const QFileInfo savedFileInfo(filePath);
+	state.lastModified = savedFileInfo.lastModified();
+	state.size = savedFileInfo.size();
+	mSaveFileStates[filePath] = state;
+
+	statistics.fileSize = state.size;
+	mLastSaveStatistics = statistics;
+	QLOG_INFO() << "Saved" << filePath << ":" << statistics.objectsWritten << "objects serialized,"
+			<< statistics.objectsReused << "reused," << statistics.bytesWritten << "bytes of new data";
 
 	return true;
 }
 
+Serializer::SaveStatistics Serializer::lastSaveStatistics() const
+{
+	return mLastSaveStatistics;
+}
+
 void Serializer::loadFromDisk(QHash<qReal::Id, Object*> &objectsHash, QHash<QString, QVariant> &metaInfo)
 {
 	clearWorkingDir();
+	if (ProjectContainer::isContainer(mWorkingFile)) {
+		const QString filePath = QFileInfo(mWorkingFile).absoluteFilePath();
+		const SaveFileState state = loadFromContainer(ProjectContainer(filePath), objectsHash, metaInfo);
+		mSaveFileStates[filePath] = state;
+		return;
+	}
+
+	// Save files of older versions are unpacked into working directory first.
 	if (QFileInfo::exists(mWorkingFile)) {
 		decompressFile(mWorkingFile);
 	}
@@ -134,6 +178,94 @@ void Serializer::loadFromDisk(QHash<qReal::Id, Object*> &objectsHash, QHash<QStr
 	loadMetaInfo(metaInfo);
 }
 
+Serializer::SaveFileState Serializer::loadFromContainer(const ProjectContainer &container
+		, QHash<qReal::Id, Object *> &objectsHash, QHash<QString, QVariant> &metaInfo) const
+{
+	SaveFileState state;
+	const QFileInfo fileInfo(container.fileName());
+	state.lastModified = fileInfo.lastModified();
+	state.size = fileInfo.size();
+
+	metaInfo.clear();
+	QList<QByteArray> compressedObjects;
+	for (const QString &entry : container.entries()) {
+		if (entry == metaInfoEntry) {
+			QDomDocument document;
+			document.setContent(container.read(entry));
+			deserializeMetaInfo(document, metaInfo);
+		} else if (entry.startsWith(treeEntriesPrefix)) {
+			// Reading is sequential anyway, decompression and parsing are done concurrently.
+			compressedObjects << container.readRaw(entry);
+		}
+	}
+
+	const QList<DeserializedObject> objects = QtConcurrent::blockingMapped<QList<DeserializedObject>>(
+			compressedObjects, &Serializer::deserializeCompressedObject);
+	mergeObjects(objects, objectsHash);
+
+	for (const DeserializedObject &object : objects) {
+		state.revisions[object.object->id()] = object.object->revision();
+	}
+
+	return state;
+}
+
+Serializer::DeserializedObject Serializer::deserializeCompressedObject(const QByteArray &compressedData)
+{
+	return deserializeObject(qUncompress(compressedData));
+}
+
+Serializer::DeserializedObject Serializer::deserializeObjectFile(const QString &path)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return { nullptr, "Cannot open " + path + " for reading" };
+	}
+
+	return deserializeObject(file.readAll());
+}
+
+Serializer::DeserializedObject Serializer::deserializeObject(const QByteArray &data)
+{
+	// Runs in worker threads, so exceptions are passed to the loading thread as error messages.
+	try {
+		QDomDocument document;
+		document.setContent(data);
+		return { deserializeObject(document.documentElement()), QString() };
+	} catch (const Exception &exception) {
+		return { nullptr, exception.message() };
+	} catch (const std::exception &exception) {
+		return { nullptr, QString::fromLocal8Bit(exception.what()) };
+	} catch (...) {
+		return { nullptr, "Unknown error during object deserialization" };
+	}
+}
+
+void Serializer::mergeObjects(const QList<DeserializedObject> &objects, QHash<qReal::Id, Object *> &objectsHash)
+{
+	for (const DeserializedObject &object : objects) {
+		if (!object.object) {
+			for (const DeserializedObject &toDelete : objects) {
+				delete toDelete.object;
+			}
+
+			throw Exception(object.error);
+		}
+	}
+
+	// Merging in the order of save file entries, so the result does not depend on the number of threads.
+	for (const DeserializedObject &object : objects) {
+		objectsHash.insert(object.object->id(), object.object);
+	}
+}
+
+bool Serializer::isUpToDate(const QString &filePath, const SaveFileState &state)
+{
+	// Save file could be replaced by someone else, then its entries can not be reused.
+	const QFileInfo fileInfo(filePath);
+	return fileInfo.exists() && fileInfo.lastModified() == state.lastModified && fileInfo.size() == state.size;
+}
+
 void Serializer::loadFromDisk(const QString &currentPath, QHash<qReal::Id, Object*> &objectsHash)
 {
 	QDir dir(currentPath + "/tree");
@@ -146,28 +278,44 @@ void Serializer::loadFromDisk(const QString &currentPath, QHash<qReal::Id, Objec
 }
 
 void Serializer::loadModel(const QDir &dir, QHash<qReal::Id, Object*> &objectsHash)
+{
+	QStringList files;
+	collectFiles(dir, files);
+	mergeObjects(QtConcurrent::blockingMapped<QList<DeserializedObject>>(files, &Serializer::deserializeObjectFile)
+			, objectsHash);
+}
+
+void Serializer::collectFiles(const QDir &dir, QStringList &files)
 {
 	for (const QFileInfo &fileInfo : dir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot)) {
 		const QString path = fileInfo.filePath();
 		if (fileInfo.isDir()) {
-			loadModel(path, objectsHash);
+			collectFiles(path, files);
 		} else if (fileInfo.isFile()) {
-			QDomDocument doc = xmlUtils::loadDocument(path);
-			const QDomElement element = doc.documentElement();
-
-			// To ensure backwards compatibility. Replace this by separate tag names when save updating mechanism
-			// will be implemented.
-			Object * const object = element.hasAttribute("logicalId") && element.attribute("logicalId") != "qrm:/"
-					? dynamic_cast<Object *>(new GraphicalObject(element))
-					: dynamic_cast<Object *>(new LogicalObject(element))
-					;
-
-			objectsHash.insert(object->id(), object);
+			files << path;
 		}
 	}
 }
 
-void Serializer::saveMetaInfo(QHash<QString, QVariant> const &metaInfo) const
+QByteArray Serializer::serializeObject(const Object &object)
+{
+	QDomDocument doc;
+	QDomElement root = object.serialize(doc);
+	doc.appendChild(root);
+	return doc.toByteArray(2);
+}
+
+Object *Serializer::deserializeObject(const QDomElement &element)
+{
+	// To ensure backwards compatibility. Replace this by separate tag names when save updating mechanism
+	// will be implemented.
+	return element.hasAttribute("logicalId") && element.attribute("logicalId") != "qrm:/"
+			? dynamic_cast<Object *>(new GraphicalObject(element))
+			: dynamic_cast<Object *>(new LogicalObject(element))
+			;
+}
+
+QByteArray Serializer::serializeMetaInfo(QHash<QString, QVariant> const &metaInfo)
 {
 	QDomDocument document;
 	QDomElement root = document.createElement("metaInformation");
@@ -180,21 +328,23 @@ void Serializer::saveMetaInfo(QHash<QString, QVariant> const &metaInfo) const
 		root.appendChild(element);
 	}
 
-	const QString filePath = mWorkingDir + "/metaInfo.xml";
-	OutFile out(filePath);
-	out() << document.toString(4);
+	return document.toByteArray(4);
 }
 
 void Serializer::loadMetaInfo(QHash<QString, QVariant> &metaInfo) const
 {
 	metaInfo.clear();
 
-	const QString filePath = mWorkingDir + "/metaInfo.xml";
+	const QString filePath = mWorkingDir + metaInfoEntry;
 	if (!QFile::exists(filePath)) {
 		return;
 	}
 
-	const QDomDocument document = xmlUtils::loadDocument(filePath);
+	deserializeMetaInfo(xmlUtils::loadDocument(filePath), metaInfo);
+}
+
+void Serializer::deserializeMetaInfo(const QDomDocument &document, QHash<QString, QVariant> &metaInfo)
+{
 	for (QDomElement child = document.documentElement().firstChildElement("info")
 			; !child.isNull()
 			; child = child.nextSiblingElement("info"))
@@ -217,25 +367,25 @@ QString Serializer::pathToElement(const Id &id) const
 	return dirName + "/" + partsList[partsList.size() - 1];
 }
 
-QString Serializer::createDirectory(const Id &id, bool logical) const
+QString Serializer::entryName(const Id &id, bool logical)
 {
-	QString dirName = mWorkingDir + "/tree";
-	dirName += logical ? "/logical" : "/graphical";
+	QString result = treeEntriesPrefix;
+	result += logical ? "logical" : "graphical";
 
 	const QStringList partsList = id.toString().split('/');
 	Q_ASSERT(partsList.size() >= 1 && partsList.size() <= 5);
-	for (int i = 1; i < partsList.size() - 1; ++i) {
-		dirName += "/" + partsList[i];
+	for (int i = 1; i < partsList.size(); ++i) {
+		result += "/" + partsList[i];
 	}
 
-	QDir dir;
-	dir.rmdir(mWorkingDir);
-	dir.mkpath(dirName);
-
-	return dirName + "/" + partsList[partsList.size() - 1];
+	return result;
 }
 
 void Serializer::decompressFile(const QString &fileName)
 {
-	FolderCompressor::decompressFolder(fileName, mWorkingDir);
+	if (ProjectContainer::isContainer(fileName)) {
+		ProjectContainer(fileName).extractTo(mWorkingDir);
+	} else {
+		FolderCompressor::decompressFolder(fileName, mWorkingDir);
+	}
 }
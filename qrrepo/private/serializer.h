@@ -18,11 +18,13 @@
 #include <QtCore/QVariant>
 #include <QtCore/QFile>
 #include <QtCore/QDir>
+#include <QtCore/QDateTime>
 
 #include <qrkernel/roles.h>
 
 #include "classes/object.h"
 #include "valuesSerializer.h"
+#include "projectContainer.h"
 
 namespace qrRepo {
 namespace details {
@@ -31,6 +33,22 @@ namespace details {
 class Serializer
 {
 public:
+	/// Amount of work done by the last save operation.
+	struct SaveStatistics
+	{
+		/// Number of objects that were serialized anew because they were modified since previous save.
+		int objectsWritten = 0;
+
+		/// Number of objects copied from previous save file without serialization.
+		int objectsReused = 0;
+
+		/// Size of compressed data of serialized objects in bytes.
+		qint64 bytesWritten = 0;
+
+		/// Total size of resulting save file in bytes.
+		qint64 fileSize = 0;
+	};
+
 	explicit Serializer(const QString &workingFile);
 	~Serializer();
 
@@ -42,25 +60,73 @@ public:
 
 	void removeFromDisk(const qReal::Id &id) const;
 
-	/// Returns true if saving was successfull.
+	/// Returns true if saving was successfull. Only objects that were modified since previous save into the same
+	/// file (or since it was loaded) get serialized, others are copied from the previous save, removed objects
+	/// are dropped.
 	bool saveToDisk(QList<Object *> const &objects, QHash<QString, QVariant> const &metaInfo) const;
+
+	/// Returns the amount of work done by the last successful save.
+	SaveStatistics lastSaveStatistics() const;
 	void loadFromDisk(QHash<qReal::Id, Object *> &objectsHash, QHash<QString, QVariant> &metaInfo);
 
 	/// Decompresses given file into working directory.
 	void decompressFile(const QString &fileName);
 
 private:
+	/// Modification stamps of objects as they are stored in a save file written or read by this serializer.
+	struct SaveFileState
+	{
+		QDateTime lastModified;
+		qint64 size = 0;
+		QHash<qReal::Id, quint64> revisions;
+	};
+
+	/// Loads objects and meta-information straight from the save file, without unpacking it on disk.
+	/// Returns the state of loaded save file.
+	SaveFileState loadFromContainer(const ProjectContainer &container, QHash<qReal::Id, Object *> &objectsHash
+			, QHash<QString, QVariant> &metaInfo) const;
+
+	/// Returns true if save file was not changed since given state was recorded.
+	static bool isUpToDate(const QString &filePath, const SaveFileState &state);
+
+	/// Loads save file of old format unpacked into working directory.
 	void loadFromDisk(const QString &currentPath, QHash<qReal::Id, Object *> &objectsHash);
 	void loadModel(const QDir &dir, QHash<qReal::Id, Object *> &objectsHash);
-
-	void saveMetaInfo(const QHash<QString, QVariant> &metaInfo) const;
 	void loadMetaInfo(QHash<QString, QVariant> &metaInfo) const;
+	static void collectFiles(const QDir &dir, QStringList &files);
+
+	/// Result of object deserialization in a worker thread: either an object or an error message.
+	struct DeserializedObject
+	{
+		Object *object;
+		QString error;
+	};
+
+	/// Functions that are run concurrently on the global thread pool while loading a model.
+	static DeserializedObject deserializeCompressedObject(const QByteArray &compressedData);
+	static DeserializedObject deserializeObjectFile(const QString &path);
+	static DeserializedObject deserializeObject(const QByteArray &data);
+
+	/// Puts deserialized objects into the hash in the given order. If some object failed to load, deletes
+	/// all the others and throws an exception.
+	static void mergeObjects(const QList<DeserializedObject> &objects, QHash<qReal::Id, Object *> &objectsHash);
+
+	static QByteArray serializeObject(const Object &object);
+	static Object *deserializeObject(const QDomElement &element);
+	static QByteArray serializeMetaInfo(const QHash<QString, QVariant> &metaInfo);
+	static void deserializeMetaInfo(const QDomDocument &document, QHash<QString, QVariant> &metaInfo);
 
 	QString pathToElement(const qReal::Id &id) const;
-	QString createDirectory(const qReal::Id &id, bool logical) const;
+
+	/// Returns the name of save file entry for the given object.
+	static QString entryName(const qReal::Id &id, bool logical);
 
 	QString mWorkingDir;
 	QString mWorkingFile;
+
+	/// States of save files by their absolute paths.
+	mutable QHash<QString, SaveFileState> mSaveFileStates;
+	mutable SaveStatistics mLastSaveStatistics;
 };
 
 }
@@ -12,12 +12,14 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-links(qrkernel qrutils)
+links(qrkernel qslog qrutils)
 
 HEADERS += \
 	$$PWD/private/repository.h \
 	$$PWD/private/folderCompressor.h \
+	$$PWD/private/projectContainer.h \
 	$$PWD/private/qrRepoGlobal.h \
+	$$PWD/private/searchIndex.h \
 	$$PWD/private/serializer.h \
 	$$PWD/private/singleXmlSerializer.h \
 	$$PWD/private/valuesSerializer.h \
@@ -29,7 +31,9 @@ HEADERS += \
 SOURCES += \
 	$$PWD/private/repository.cpp \
 	$$PWD/private/folderCompressor.cpp \
+	$$PWD/private/projectContainer.cpp \
 	$$PWD/private/repoApi.cpp \
+	$$PWD/private/searchIndex.cpp \
 	$$PWD/private/serializer.cpp \
 	$$PWD/private/singleXmlSerializer.cpp \
 	$$PWD/private/valuesSerializer.cpp \
@@ -57,4 +61,4 @@ HEADERS += \
 
 DEFINES += QRREPO_LIBRARY
 
-QT += xml
+QT += xml concurrent
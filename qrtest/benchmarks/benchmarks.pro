@@ -0,0 +1,23 @@
+# Copyright 2016 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Performance measurements of separate algorithms. They are not unit tests: they take long, their results depend
+# on a machine, and they are not run with tests, so they are built only with CONFIG+=benchmarks.
+
+TEMPLATE = subdirs
+
+SUBDIRS = \
+	luaLexerBenchmark \
+	sensorImageKernelsBenchmark \
+	structurizatorBenchmark \
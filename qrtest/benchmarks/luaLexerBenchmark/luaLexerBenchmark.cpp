@@ -0,0 +1,69 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QStringList>
+#include <QtCore/QTextStream>
+
+#include "qrtext/src/lua/luaLexer.h"
+
+using namespace qrtext::core;
+using namespace qrtext::lua::details;
+
+/// Tokenizes all @a snippets @a iterations times, returns time it took in microseconds and total number of
+/// tokens in @a tokens.
+static qint64 measure(const QStringList &snippets, int iterations, LuaLexer::Matcher matcher, int &tokens)
+{
+	QList<Error> errors;
+	LuaLexer lexer(errors, matcher);
+	QElapsedTimer timer;
+	timer.start();
+	tokens = 0;
+	for (int i = 0; i < iterations; ++i) {
+		for (const QString &snippet : snippets) {
+			tokens += lexer.tokenize(snippet).size();
+		}
+	}
+
+	return timer.nsecsElapsed() / 1000;
+}
+
+/// Measures how fast Lua lexer tokenizes code of example projects with regexps and with hand-written scanner.
+/// Usage: qrtext_lexer_benchmark [path to code snippets separated by "--8<--" lines] [iterations]
+int main(int argc, char *argv[])
+{
+	QTextStream out(stdout);
+	const QString path = argc > 1 ? QString::fromLocal8Bit(argv[1]) : QString("unittests/luaExamplesCode.lua");
+	const int iterations = argc > 2 ? QString(argv[2]).toInt() : 20;
+
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		out << "Can not open " << path << endl;
+		return 1;
+	}
+
+	// Code generation and interpretation tokenize every property of every block separately, so does the benchmark.
+	const QStringList snippets = QString::fromUtf8(file.readAll()).split("\n--8<--\n");
+
+	int regexpsTokens = 0;
+	int scannerTokens = 0;
+	const qint64 regexpsTime = measure(snippets, iterations, LuaLexer::Matcher::regexps, regexpsTokens);
+	const qint64 scannerTime = measure(snippets, iterations, LuaLexer::Matcher::scanner, scannerTokens);
+
+	out << "Tokenizing " << snippets.size() << " snippets " << iterations << " times" << endl;
+	out << "regexps: " << regexpsTime << " us, " << regexpsTokens << " tokens" << endl;
+	out << "scanner: " << scannerTime << " us, " << scannerTokens << " tokens" << endl;
+	return regexpsTokens == scannerTokens ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+# Copyright 2016 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+TARGET = qrtext_lexer_benchmark
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../../../global.pri)
+
+QT -= gui
+
+include(../../../qrtext/qrtext.pri)
+
+links(qslog)
+
+INCLUDEPATH += \
+	$$PWD/../../../ \
+	$$PWD/../../../qrtext/include \
+
+SOURCES += \
+	$$PWD/luaLexerBenchmark.cpp \
+
+copyToDestdir($$PWD/../../unitTests/qrtextTests/support/testData/unittests, NOW)
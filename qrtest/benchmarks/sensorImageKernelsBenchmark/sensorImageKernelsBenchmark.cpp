@@ -0,0 +1,144 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QTextStream>
+#include <QtGui/QImage>
+
+#include <twoDModel/engine/sensorImageKernels.h>
+
+using namespace twoDModel::engine;
+
+/// Line sensor check for a pixel, as it was done by QImage::pixel() calls before.
+static bool closeEnough(QRgb color, QRgb lineColor, int tolerance)
+{
+	return qAlpha(color) > 0 && qMax(qAbs(qRed(color) - qRed(lineColor))
+		, qMax(qAbs(qGreen(color) - qGreen(lineColor))
+		, qAbs(qBlue(color) - qBlue(lineColor)))) < tolerance;
+}
+
+/// Returns a picture of a floor under sensor with a black line on white background.
+static QImage floorImage(int side)
+{
+	QImage image(side, side, QImage::Format_RGB32);
+	image.fill(0xFFFFFFFF);
+	for (int y = 0; y < side; ++y) {
+		for (int x = side / 3; x < side / 2; ++x) {
+			image.setPixel(x, y, 0xFF000000 | ((x + y) % 5) * 0x010101);
+		}
+	}
+
+	return image;
+}
+
+/// TRIK line sensor looks at a square twice as wide as its image rect, so side is about 2 * 20 + 1 pixels.
+/// Compares per pixel checks with countCloseColors() kernel.
+static void lineSensor(QTextStream &out, int iterations)
+{
+	const QImage image = floorImage(41);
+	const uint lineColor = 0xFF000000;
+	const int tolerance = 10;
+
+	QElapsedTimer timer;
+	timer.start();
+	qint64 expected = 0;
+	for (int iteration = 0; iteration < iterations; ++iteration) {
+		for (int y = 0; y < image.height(); ++y) {
+			for (int x = 0; x < image.width(); ++x) {
+				if (closeEnough(image.pixel(x, y), lineColor, tolerance)) {
+					expected += x + 1;
+				}
+			}
+		}
+	}
+
+	const qint64 pixelTime = timer.nsecsElapsed() / 1000;
+
+	timer.restart();
+	qint64 actual = 0;
+	for (int iteration = 0; iteration < iterations; ++iteration) {
+		for (int y = 0; y < image.height(); ++y) {
+			const uint *row = reinterpret_cast<const uint *>(image.constScanLine(y));
+			qint64 indexSum = 0;
+			actual += SensorImageKernels::countCloseColors(row, image.width(), lineColor, tolerance, indexSum);
+			actual += indexSum;
+		}
+	}
+
+	const qint64 kernelTime = timer.nsecsElapsed() / 1000;
+
+	out << "TRIK line sensor: per pixel " << pixelTime << " us, kernels " << kernelTime << " us"
+			<< (expected == actual ? "" : ", RESULTS DIFFER") << endl;
+}
+
+/// EV3 and NXT color sensors look at a square of about 2 * 10 + 1 pixels, in full color and single color modes.
+/// Compares histogram of all colors with counting of palette colors only.
+static void colorSensor(QTextStream &out, int iterations)
+{
+	const QImage image = floorImage(21);
+	const uint *pixels = reinterpret_cast<const uint *>(image.constBits());
+	const int count = image.width() * image.height();
+	const uint palette[] = { 0xFF000000, 0xFFFF0000, 0xFF008000, 0xFF0000FF
+			, 0xFFFFFF00, 0xFFFFFFFF, 0xFF00FFFF, 0xFFFF00FF };
+	const int paletteSize = sizeof(palette) / sizeof(palette[0]);
+	const uint white = palette[5];
+
+	QElapsedTimer timer;
+	timer.start();
+	qint64 expected = 0;
+	for (int iteration = 0; iteration < iterations; ++iteration) {
+		QHash<uint, int> histogram;
+		SensorImageKernels::countColors(pixels, count, histogram);
+		for (const uint color : palette) {
+			expected += histogram.value(color);
+		}
+
+		// Single color mode.
+		expected += histogram.value(white);
+	}
+
+	const qint64 histogramTime = timer.nsecsElapsed() / 1000;
+
+	timer.restart();
+	qint64 actual = 0;
+	for (int iteration = 0; iteration < iterations; ++iteration) {
+		int counts[paletteSize];
+		SensorImageKernels::countPaletteColors(pixels, count, palette, paletteSize, counts);
+		for (const int colorCount : counts) {
+			actual += colorCount;
+		}
+
+		// Single color mode.
+		int whiteCount = 0;
+		SensorImageKernels::countPaletteColors(pixels, count, &white, 1, &whiteCount);
+		actual += whiteCount;
+	}
+
+	const qint64 paletteTime = timer.nsecsElapsed() / 1000;
+
+	out << "EV3/NXT color sensor: histogram " << histogramTime << " us, palette " << paletteTime << " us"
+			<< (expected == actual ? "" : ", RESULTS DIFFER") << endl;
+}
+
+/// Measures pixel processing of 2D model sensors: old per pixel and histogram code against the kernels.
+/// Usage: robots_sensor_image_kernels_benchmark [iterations]
+int main(int argc, char *argv[])
+{
+	QTextStream out(stdout);
+	const int iterations = argc > 1 ? qMax(1, QString(argv[1]).toInt()) : 20000;
+	lineSensor(out, iterations / 10);
+	colorSensor(out, iterations);
+	return 0;
+}
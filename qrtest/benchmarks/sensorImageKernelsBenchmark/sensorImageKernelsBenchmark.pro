@@ -0,0 +1,36 @@
+# Copyright 2016 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+TARGET = robots_sensor_image_kernels_benchmark
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../../../global.pri)
+
+TWO_D_MODEL_PATH = $$PWD/../../../plugins/robots/common/twoDModel
+
+INCLUDEPATH += \
+	$$TWO_D_MODEL_PATH/include \
+
+# Kernels are compiled into the benchmark, so it does not need the whole 2D model library with its dependencies.
+DEFINES += TWO_D_MODEL_LIBRARY
+
+HEADERS += \
+	$$TWO_D_MODEL_PATH/include/twoDModel/engine/sensorImageKernels.h \
+
+SOURCES += \
+	$$PWD/sensorImageKernelsBenchmark.cpp \
+	$$TWO_D_MODEL_PATH/src/engine/sensorImageKernels.cpp \
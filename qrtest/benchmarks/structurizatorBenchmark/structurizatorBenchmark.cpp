@@ -0,0 +1,73 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <random>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTextStream>
+
+#include <structurizator.h>
+
+#include "support/controlFlowGraphs.h"
+
+using namespace generatorBase;
+using namespace qrTest::robotsTests::generatorBaseTests;
+
+/// Adds @a count random edges to a graph with @a verticesNumber vertices, so it gets jumps into loops and
+/// conditions that can not be structurized.
+static void addIrregularEdges(int count, int verticesNumber, unsigned seed, QMap<int, QSet<int>> &followers)
+{
+	std::mt19937 random(seed);
+	for (int i = 0; i < count; ++i) {
+		const int from = 1 + random() % (verticesNumber - 1);
+		const int to = 2 + random() % (verticesNumber - 1);
+		followers[from].insert(to);
+	}
+}
+
+/// Structurizes the graph @a repeats times and prints mean time of one structurization.
+static void measure(QTextStream &out, const QString &name, const QMap<int, QSet<int>> &followers
+		, int verticesNumber, int repeats)
+{
+	QElapsedTimer timer;
+	timer.start();
+	bool structurized = false;
+	for (int i = 0; i < repeats; ++i) {
+		Structurizator structurizator;
+		structurized = ControlFlowGraphs::structurize(structurizator, followers, verticesNumber) != nullptr;
+	}
+
+	out << name << ", " << verticesNumber << " vertices: " << timer.nsecsElapsed() / 1000 / repeats << " us"
+			<< (structurized ? "" : ", not structurized") << endl;
+}
+
+/// Measures structural analysis of big generated control flow graphs: graphs of structured programs with deeply
+/// nested loops and conditions, and the same graphs with random extra edges.
+/// Usage: robots_structurizator_benchmark [repeats]
+int main(int argc, char *argv[])
+{
+	QTextStream out(stdout);
+	const int repeats = argc > 1 ? qMax(1, QString(argv[1]).toInt()) : 5;
+
+	for (const int size : {100, 500, 2000, 5000}) {
+		QMap<int, QSet<int>> followers;
+		const int verticesNumber = ControlFlowGraphs::generateGraph(size, size, followers);
+		measure(out, "Structured", followers, verticesNumber, repeats);
+
+		addIrregularEdges(size / 20, verticesNumber, size, followers);
+		measure(out, "Irregular", followers, verticesNumber, repeats);
+	}
+
+	return 0;
+}
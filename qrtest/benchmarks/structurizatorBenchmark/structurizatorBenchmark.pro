@@ -0,0 +1,61 @@
+# Copyright 2016 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+TARGET = robots_structurizator_benchmark
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../../../global.pri)
+
+QT -= gui
+
+links(qrkernel)
+
+GENERATOR_BASE_TESTS_PATH = $$PWD/../../unitTests/pluginsTests/robotsTests/generatorsTests/generatorBaseTests
+STRUCTURIZATOR_PATH = $$PWD/../../../plugins/robots/generators/generatorBase/src
+
+INCLUDEPATH += \
+	$$PWD/../../../ \
+	$$PWD/../../../plugins/robots/generators/generatorBase/include \
+	$$STRUCTURIZATOR_PATH \
+	$$GENERATOR_BASE_TESTS_PATH \
+
+HEADERS += \
+	$$GENERATOR_BASE_TESTS_PATH/support/controlFlowGraphs.h \
+	$$STRUCTURIZATOR_PATH/structurizator.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/intermediateStructurizatorNode.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/simpleStructurizatorNode.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/breakStructurizatorNode.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/ifStructurizatorNode.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/structurizatorNodeWithBreaks.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/switchStructurizatorNode.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/blockStructurizatorNode.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/whileStructurizatorNode.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/selfLoopStructurizatorNode.h \
+
+SOURCES += \
+	$$PWD/structurizatorBenchmark.cpp \
+	$$GENERATOR_BASE_TESTS_PATH/support/controlFlowGraphs.cpp \
+	$$STRUCTURIZATOR_PATH/structurizator.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/intermediateStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/simpleStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/breakStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/ifStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/structurizatorNodeWithBreaks.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/switchStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/blockStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/whileStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/selfLoopStructurizatorNode.cpp \
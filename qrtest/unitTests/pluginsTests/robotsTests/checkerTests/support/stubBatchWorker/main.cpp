@@ -0,0 +1,76 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <cstdlib>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QThread>
+
+#include <batchTask.h>
+
+using namespace twoDModel;
+
+/// Prefix of lines with results of tasks, must be the same as BatchWorker::finishedMarker.
+const char *finishedMarker = "@@2D-model-batch finished";
+
+/// Exit code of a run that exceeded time limit, must be the same as Runner::timeLimitExceededExitCode.
+const int timeLimitExceededExitCode = 3;
+
+/// Stub of batch worker process of 2D model runner. Speaks the same protocol as the real worker, but instead of
+/// interpreting a solution behaves as the identifier of the solution tells: "pass", "fail" and "timeout" report
+/// corresponding exit code, "hang" never reports anything, "crash" aborts the worker.
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+
+	const QStringList arguments = app.arguments();
+	const int manifestIndex = arguments.indexOf("--batch-worker") + 1;
+	QList<BatchTask> tasks;
+	QString errorMessage;
+	if (manifestIndex == 0 || manifestIndex >= arguments.size()
+			|| !BatchTask::loadManifest(arguments[manifestIndex], tasks, errorMessage))
+	{
+		return 1;
+	}
+
+	QFile input;
+	QFile output;
+	if (!input.open(stdin, QIODevice::ReadOnly) || !output.open(stdout, QIODevice::WriteOnly)) {
+		return 1;
+	}
+
+	while (true) {
+		const QByteArray line = input.readLine().trimmed();
+		if (line.isEmpty()) {
+			break;
+		}
+
+		const int index = line.toInt();
+		const QString behaviour = tasks.value(index).solution;
+		if (behaviour == "crash") {
+			std::abort();
+		} else if (behaviour == "hang") {
+			forever {
+				QThread::sleep(1);
+			}
+		}
+
+		const int exitCode = behaviour == "pass" ? 0 : behaviour == "timeout" ? timeLimitExceededExitCode : 1;
+		output.write(QString("%1 %2 %3\n").arg(finishedMarker).arg(index).arg(exitCode).toUtf8());
+		output.flush();
+	}
+
+	return 0;
+}
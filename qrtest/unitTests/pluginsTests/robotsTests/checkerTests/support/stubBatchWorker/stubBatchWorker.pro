@@ -0,0 +1,34 @@
+# Copyright 2016 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+TARGET = stub-batch-worker
+
+include(../../../../../../../global.pri)
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= app_bundle
+QT -= gui
+
+TWO_D_MODEL_RUNNER_PATH = $$PWD/../../../../../../../plugins/robots/checker/twoDModelRunner
+
+INCLUDEPATH += \
+	$$TWO_D_MODEL_RUNNER_PATH \
+
+HEADERS += \
+	$$TWO_D_MODEL_RUNNER_PATH/batchTask.h \
+
+SOURCES += \
+	$$PWD/main.cpp \
+	$$TWO_D_MODEL_RUNNER_PATH/batchTask.cpp \
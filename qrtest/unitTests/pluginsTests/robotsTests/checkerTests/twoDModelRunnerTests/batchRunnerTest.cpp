@@ -0,0 +1,118 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "batchRunnerTest.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QEventLoop>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTimer>
+
+#include <batchRunner.h>
+
+using namespace qrTest::robotsTests::twoDModelRunnerTests;
+using namespace twoDModel;
+
+/// Time limit of one run, workers that hanged are killed after twice of it and grace time.
+const int timeLimit = 100;
+const int hangGraceTime = 500;
+
+/// Time after which the batch is considered stuck.
+const int batchTimeout = 30000;
+
+int BatchRunnerTest::run(const QStringList &solutions, int jobs)
+{
+	QJsonArray solutionsArray;
+	for (const QString &solution : solutions) {
+		solutionsArray.append(QJsonObject({ { "id", solution }, { "file", solution + ".qrs" } }));
+	}
+
+	const QDir root(mDirectory.path());
+	const QString manifest = root.absoluteFilePath("manifest.json");
+	QFile manifestFile(manifest);
+	if (!mDirectory.isValid() || !manifestFile.open(QIODevice::WriteOnly)) {
+		return -1;
+	}
+
+	manifestFile.write(QJsonDocument(QJsonObject({ { "solutions", solutionsArray } })).toJson());
+	manifestFile.close();
+
+	QList<BatchTask> tasks;
+	QString errorMessage;
+	if (!BatchTask::loadManifest(manifest, tasks, errorMessage)) {
+		return -1;
+	}
+
+	const QString summary = root.absoluteFilePath("summary.json");
+	int exitCode = -1;
+	{
+		BatchRunner runner(manifest, tasks, jobs, timeLimit, 0, summary, TrajectoryFormat::json);
+		runner.setWorkerProgram(QDir(QCoreApplication::applicationDirPath()).absoluteFilePath(STUB_BATCH_WORKER)
+				, hangGraceTime);
+
+		QEventLoop loop;
+		QObject::connect(&runner, &BatchRunner::finished, &loop, [&](int code) {
+			exitCode = code;
+			loop.quit();
+		});
+
+		QTimer::singleShot(batchTimeout, &loop, SLOT(quit()));
+		runner.start();
+		loop.exec();
+	}
+
+	mStatuses.clear();
+	QFile summaryFile(summary);
+	if (summaryFile.open(QIODevice::ReadOnly)) {
+		for (const QJsonValue &run : QJsonDocument::fromJson(summaryFile.readAll()).array()) {
+			mStatuses[run.toObject()["solution"].toString()] = run.toObject()["status"].toString();
+		}
+	}
+
+	return exitCode;
+}
+
+TEST_F(BatchRunnerTest, allPassedTest)
+{
+	ASSERT_EQ(0, run({ "pass", "pass" }, 2));
+	EXPECT_EQ("passed", mStatuses["pass"]);
+}
+
+TEST_F(BatchRunnerTest, statusesTest)
+{
+	ASSERT_EQ(1, run({ "pass", "fail", "timeout" }, 1));
+	EXPECT_EQ("passed", mStatuses["pass"]);
+	EXPECT_EQ("failed", mStatuses["fail"]);
+	EXPECT_EQ("timeout", mStatuses["timeout"]);
+}
+
+TEST_F(BatchRunnerTest, hangedWorkerTest)
+{
+	// Hanged worker is killed by watchdog, the task after it is given to a new worker.
+	ASSERT_EQ(1, run({ "hang", "pass" }, 1));
+	EXPECT_EQ("timeout", mStatuses["hang"]);
+	EXPECT_EQ("passed", mStatuses["pass"]);
+}
+
+TEST_F(BatchRunnerTest, crashedWorkerTest)
+{
+	ASSERT_EQ(1, run({ "crash", "pass", "fail" }, 2));
+	EXPECT_EQ("crashed", mStatuses["crash"]);
+	EXPECT_EQ("passed", mStatuses["pass"]);
+	EXPECT_EQ("failed", mStatuses["fail"]);
+}
@@ -0,0 +1,42 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+namespace qrTest {
+namespace robotsTests {
+namespace twoDModelRunnerTests {
+
+/// Checks batch runner with a stub worker that behaves as identifiers of solutions tell, see stubBatchWorker.
+class BatchRunnerTest : public testing::Test
+{
+protected:
+	/// Runs the given solutions on their own fields with a pool of stub workers and waits for the end of the batch.
+	/// @returns Exit code of the batch or -1 if it did not finish in time.
+	int run(const QStringList &solutions, int jobs);
+
+	/// Statuses of runs from the summary report of the last batch by solutions.
+	QHash<QString, QString> mStatuses;
+
+	QTemporaryDir mDirectory;
+};
+
+}
+}
+}
@@ -0,0 +1,171 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "batchTaskTest.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+using namespace qrTest::robotsTests::twoDModelRunnerTests;
+using namespace twoDModel;
+
+bool BatchTaskTest::loadManifest(const QByteArray &manifest)
+{
+	QFile file(path("manifest.json"));
+	if (!mDirectory.isValid() || !file.open(QIODevice::WriteOnly)) {
+		return false;
+	}
+
+	file.write(manifest);
+	file.close();
+	return BatchTask::loadManifest(file.fileName(), mTasks, mErrorMessage);
+}
+
+QString BatchTaskTest::path(const QString &fileName) const
+{
+	return QDir(mDirectory.path()).absoluteFilePath(fileName);
+}
+
+TEST_F(BatchTaskTest, solutionsOnFieldsTest)
+{
+	ASSERT_TRUE(loadManifest(R"({
+		"solutions": [ { "id": "first", "file": "first.qrs", "input": "first.txt" }
+				, { "file": "second.qrs", "mode": "js" } ],
+		"fields": [ { "id": "box", "file": "fields/box.xml", "input": "box.txt" }, { "file": "maze.xml" } ]
+	})"));
+
+	ASSERT_EQ(6, mTasks.size());
+
+	const BatchTask &ownField = mTasks[0];
+	EXPECT_EQ("first", ownField.solution);
+	EXPECT_TRUE(ownField.field.isEmpty());
+	EXPECT_EQ(path("first.qrs"), ownField.saveFile);
+	EXPECT_TRUE(ownField.fieldFile.isEmpty());
+	EXPECT_EQ(path("first.txt"), ownField.input);
+	EXPECT_EQ("diagram", ownField.mode);
+	EXPECT_EQ(path("reports/first/_first"), ownField.report);
+	EXPECT_EQ(path("trajectories/first/_first"), ownField.trajectory);
+
+	const BatchTask &box = mTasks[1];
+	EXPECT_EQ("first", box.solution);
+	EXPECT_EQ("box", box.field);
+	EXPECT_EQ(path("fields/box.xml"), box.fieldFile);
+	EXPECT_EQ(path("box.txt"), box.input);
+	EXPECT_EQ(path("reports/first/box"), box.report);
+	EXPECT_EQ(path("trajectories/first/box"), box.trajectory);
+
+	// Identifiers are taken from file names when omitted.
+	const BatchTask &maze = mTasks[5];
+	EXPECT_EQ("second", maze.solution);
+	EXPECT_EQ("maze", maze.field);
+	EXPECT_EQ("js", maze.mode);
+	EXPECT_TRUE(maze.input.isEmpty());
+	EXPECT_EQ(path("reports/second/maze"), maze.report);
+}
+
+TEST_F(BatchTaskTest, withoutOwnFieldTest)
+{
+	ASSERT_TRUE(loadManifest(R"({
+		"solutions": [ { "file": "solution.qrs" } ],
+		"fields": [ { "file": "box.xml" } ],
+		"checkOwnField": false,
+		"reports": "out/reports",
+		"trajectories": "/tmp/trajectories"
+	})"));
+
+	ASSERT_EQ(1, mTasks.size());
+	EXPECT_EQ("box", mTasks[0].field);
+	EXPECT_EQ(path("out/reports/solution/box"), mTasks[0].report);
+	EXPECT_EQ(QDir("/tmp/trajectories").absoluteFilePath("solution/box"), mTasks[0].trajectory);
+}
+
+TEST_F(BatchTaskTest, generationTest)
+{
+	ASSERT_TRUE(loadManifest(R"({
+		"solutions": [ { "file": "first.qrs" }, { "file": "second.qrs" } ],
+		"generate": { "targets": [ "trikQts", "trikPython" ], "output": "code" }
+	})"));
+
+	ASSERT_EQ(4, mTasks.size());
+	EXPECT_EQ("diagram", mTasks[0].mode);
+	EXPECT_TRUE(mTasks[0].targets.isEmpty());
+
+	const BatchTask &generation = mTasks[1];
+	EXPECT_EQ("first", generation.solution);
+	EXPECT_EQ("generate", generation.mode);
+	EXPECT_EQ(path("first.qrs"), generation.saveFile);
+	EXPECT_EQ(QStringList({ "trikQts", "trikPython" }), generation.targets);
+	EXPECT_EQ(path("code/first"), generation.outputFolder);
+	EXPECT_EQ(path("reports/first/generation"), generation.report);
+
+	EXPECT_EQ("generate", mTasks[3].mode);
+	EXPECT_EQ(path("code/second"), mTasks[3].outputFolder);
+}
+
+TEST_F(BatchTaskTest, generationDefaultsTest)
+{
+	ASSERT_TRUE(loadManifest(R"({
+		"solutions": [ { "file": "solution.qrs" } ],
+		"checkOwnField": false,
+		"generate": { "targets": [ "ev3Rbf" ] }
+	})"));
+
+	ASSERT_EQ(1, mTasks.size());
+	EXPECT_EQ("generate", mTasks[0].mode);
+	EXPECT_EQ(path("generated/solution"), mTasks[0].outputFolder);
+}
+
+TEST_F(BatchTaskTest, emptyGenerationSectionTest)
+{
+	ASSERT_TRUE(loadManifest(R"({
+		"solutions": [ { "file": "solution.qrs" } ],
+		"generate": { "targets": [] }
+	})"));
+
+	ASSERT_EQ(1, mTasks.size());
+	EXPECT_EQ("diagram", mTasks[0].mode);
+}
+
+TEST_F(BatchTaskTest, missingManifestTest)
+{
+	EXPECT_FALSE(BatchTask::loadManifest(path("missing.json"), mTasks, mErrorMessage));
+	EXPECT_FALSE(mErrorMessage.isEmpty());
+}
+
+TEST_F(BatchTaskTest, malformedJsonTest)
+{
+	EXPECT_FALSE(loadManifest(R"({ "solutions": [ { "file": "solution.qrs" } )"));
+	EXPECT_FALSE(mErrorMessage.isEmpty());
+}
+
+TEST_F(BatchTaskTest, notObjectTest)
+{
+	EXPECT_FALSE(loadManifest(R"([ { "file": "solution.qrs" } ])"));
+	EXPECT_FALSE(mErrorMessage.isEmpty());
+}
+
+TEST_F(BatchTaskTest, solutionWithoutFileTest)
+{
+	EXPECT_FALSE(loadManifest(R"({ "solutions": [ { "id": "alongTheBox" } ] })"));
+	EXPECT_TRUE(mErrorMessage.contains("alongTheBox"));
+}
+
+TEST_F(BatchTaskTest, fieldWithoutFileTest)
+{
+	EXPECT_FALSE(loadManifest(R"({
+		"solutions": [ { "file": "solution.qrs" } ],
+		"fields": [ { "id": "box" } ]
+	})"));
+	EXPECT_TRUE(mErrorMessage.contains("box"));
+}
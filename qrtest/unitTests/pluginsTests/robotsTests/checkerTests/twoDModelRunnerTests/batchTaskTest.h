@@ -0,0 +1,43 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QTemporaryDir>
+
+#include <batchTask.h>
+
+#include <gtest/gtest.h>
+
+namespace qrTest {
+namespace robotsTests {
+namespace twoDModelRunnerTests {
+
+class BatchTaskTest : public testing::Test
+{
+protected:
+	/// Writes the given manifest into temporary folder and loads tasks from it.
+	bool loadManifest(const QByteArray &manifest);
+
+	/// Returns an absolute path to the given file in the folder of the manifest.
+	QString path(const QString &fileName) const;
+
+	QTemporaryDir mDirectory;
+	QList<twoDModel::BatchTask> mTasks;
+	QString mErrorMessage;
+};
+
+}
+}
+}
@@ -0,0 +1,33 @@
+# Copyright 2016 CyberTech Labs Ltd.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+TARGET = robots_twoDModelRunner_unittests
+
+include(../../../../common.pri)
+
+include(../../../../../../plugins/robots/checker/twoDModelRunner/twoDModelRunner.pri)
+
+INCLUDEPATH += \
+	../../../../../../plugins/robots/checker/twoDModelRunner \
+
+# Batch runner is checked with a stub worker process built from support/stubBatchWorker.
+DEFINES += STUB_BATCH_WORKER=\\\"stub-batch-worker$$CONFIGURATION_SUFFIX\\\"
+
+HEADERS += \
+	$$PWD/batchTaskTest.h \
+	$$PWD/batchRunnerTest.h \
+
+SOURCES += \
+	$$PWD/batchTaskTest.cpp \
+	$$PWD/batchRunnerTest.cpp \
@@ -0,0 +1,56 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include <QtCore/QTemporaryDir>
+#include <QtGui/QImage>
+
+#include <twoDModel/engine/model/image.h>
+#include <twoDModel/engine/model/worldModel.h>
+#include <src/engine/items/imageItem.h>
+#include <src/engine/view/scene/fakeScene.h>
+
+#include "gtest/gtest.h"
+
+using namespace twoDModel;
+
+/// Writes an image of the given color into the given directory and returns a path to it.
+static QString writeImage(const QTemporaryDir &directory, const QString &name, const QColor &color)
+{
+	QImage image(10, 10, QImage::Format_RGB32);
+	image.fill(color);
+	const QString path = directory.filePath(name);
+	image.save(path);
+	return path;
+}
+
+TEST(FakeSceneTest, imageChangeTest)
+{
+	QTemporaryDir directory;
+	ASSERT_TRUE(directory.isValid());
+	const QString redPath = writeImage(directory, "red.png", Qt::red);
+	const QString bluePath = writeImage(directory, "blue.png", Qt::blue);
+
+	model::WorldModel world;
+	view::FakeScene scene(world);
+	QScopedPointer<items::ImageItem> item(new items::ImageItem(new model::Image(redPath, false)
+			, QRect(0, 0, 40, 40)));
+	world.addImageItem(item.data());
+
+	// Sensor looks at the image, so raster tiles with it get cached.
+	ASSERT_EQ(QColor(Qt::red).rgb(), scene.sample(QPointF(20, 20), 0, QSize(5, 5)).pixel(2, 2));
+
+	item->setPath(bluePath);
+	ASSERT_EQ(QColor(Qt::blue).rgb(), scene.sample(QPointF(20, 20), 0, QSize(5, 5)).pixel(2, 2));
+}
@@ -0,0 +1,118 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "solidGeometryTests.h"
+
+#include <QtGui/QTransform>
+
+using namespace qrTest::robotsTests::commonTwoDModelTests;
+
+const qreal halfAngle = 10.0;
+
+QPainterPath SolidGeometryTests::sector(const QPointF &position, qreal direction, qreal range)
+{
+	QPainterPath rayPath;
+	rayPath.arcTo(QRectF(-range, -range, 2 * range, 2 * range), -direction - halfAngle, 2 * halfAngle);
+	rayPath.closeSubpath();
+	return QTransform().translate(position.x(), position.y()).map(rayPath);
+}
+
+TEST_F(SolidGeometryTests, coneCastTest)
+{
+	QPainterPath wall;
+	wall.addRect(100, -50, 10, 100);
+	mGeometry.setBody(&mFirstItem, wall);
+
+	ASSERT_NEAR(mGeometry.coneCast(QPointF(0, 0), 0, halfAngle, 500), 100.0, 1e-6);
+	ASSERT_NEAR(mGeometry.coneCast(QPointF(50, 0), 0, halfAngle, 500), 50.0, 1e-6);
+	ASSERT_LT(mGeometry.coneCast(QPointF(0, 0), 180, halfAngle, 500), 0);
+	ASSERT_LT(mGeometry.coneCast(QPointF(0, 0), 0, halfAngle, 90), 0);
+
+	// Scene y axis is directed down, so direction of 90 degrees looks down.
+	ASSERT_LT(mGeometry.coneCast(QPointF(105, -200), -90, halfAngle, 500), 0);
+	ASSERT_NEAR(mGeometry.coneCast(QPointF(105, -200), 90, halfAngle, 500), 150.0, 1e-6);
+}
+
+TEST_F(SolidGeometryTests, coneBoundaryTest)
+{
+	// Small box seen at about 8 degrees from sonar axis.
+	QPainterPath box;
+	box.addRect(QRectF(QPointF(99, 13), QSizeF(2, 2)));
+	mGeometry.setBody(&mFirstItem, box);
+
+	ASSERT_GT(mGeometry.coneCast(QPointF(0, 0), 0, halfAngle, 500), 0);
+	ASSERT_LT(mGeometry.coneCast(QPointF(0, 0), -5, halfAngle, 500), 0);
+	ASSERT_GT(mGeometry.coneCast(QPointF(0, 0), 15, halfAngle, 500), 0);
+}
+
+TEST_F(SolidGeometryTests, insideBodyTest)
+{
+	QPainterPath ball;
+	ball.addEllipse(QPointF(0, 0), 20, 20);
+	mGeometry.setBody(&mFirstItem, ball);
+
+	ASSERT_EQ(mGeometry.coneCast(QPointF(5, 5), 45, halfAngle, 500), 0);
+}
+
+TEST_F(SolidGeometryTests, agreesWithScanningRegionTest)
+{
+	QPainterPath firstWall;
+	firstWall.moveTo(300, -400);
+	firstWall.lineTo(420, 380);
+	QPainterPathStroker stroker;
+	stroker.setWidth(15);
+	mGeometry.setBody(&mFirstItem, stroker.createStroke(firstWall));
+
+	QPainterPath ball;
+	ball.addEllipse(QPointF(-150, 220), 25, 25);
+	mGeometry.setBody(&mSecondItem, ball);
+
+	const QPainterPath solids = mGeometry.united();
+	const QPointF position(10, 20);
+	for (int direction = 0; direction < 360; direction += 15) {
+		const qreal distance = mGeometry.coneCast(position, direction, halfAngle, 1000);
+		if (distance < 0) {
+			ASSERT_FALSE(sector(position, direction, 1000).intersects(solids)) << direction;
+		} else {
+			ASSERT_TRUE(sector(position, direction, distance + 1).intersects(solids)) << direction;
+			ASSERT_FALSE(sector(position, direction, distance - 1).intersects(solids)) << direction;
+		}
+	}
+}
+
+TEST_F(SolidGeometryTests, intersectsAndRemoveTest)
+{
+	QPainterPath wall;
+	wall.addRect(0, 0, 1000, 10);
+	mGeometry.setBody(&mFirstItem, wall);
+
+	QPainterPath robot;
+	robot.addRect(500, -5, 20, 20);
+	QPainterPath farRobot;
+	farRobot.addRect(500, 200, 20, 20);
+
+	ASSERT_TRUE(mGeometry.intersects(robot));
+	ASSERT_FALSE(mGeometry.intersects(farRobot));
+
+	QPainterPath movedWall;
+	movedWall.addRect(0, 200, 1000, 10);
+	mGeometry.setBody(&mFirstItem, movedWall);
+	ASSERT_FALSE(mGeometry.intersects(robot));
+	ASSERT_TRUE(mGeometry.intersects(farRobot));
+
+	mGeometry.removeBody(&mFirstItem);
+	ASSERT_FALSE(mGeometry.contains(&mFirstItem));
+	ASSERT_FALSE(mGeometry.intersects(farRobot));
+	ASSERT_LT(mGeometry.coneCast(QPointF(510, 100), 90, halfAngle, 500), 0);
+}
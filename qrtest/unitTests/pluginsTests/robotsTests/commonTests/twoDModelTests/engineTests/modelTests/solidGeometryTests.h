@@ -0,0 +1,43 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtWidgets/QGraphicsRectItem>
+
+#include <gtest/gtest.h>
+
+#include <src/engine/model/solidGeometry.h>
+
+namespace qrTest {
+namespace robotsTests {
+namespace commonTwoDModelTests {
+
+/// Tests for SolidGeometry.
+class SolidGeometryTests : public testing::Test
+{
+protected:
+	/// Returns the region seen by sonar at the given range, built the same way as WorldModel does.
+	static QPainterPath sector(const QPointF &position, qreal direction, qreal range);
+
+	twoDModel::model::SolidGeometry mGeometry;
+
+	/// Items are used only as keys of bodies.
+	QGraphicsRectItem mFirstItem;
+	QGraphicsRectItem mSecondItem;
+};
+
+}
+}
+}
@@ -0,0 +1,225 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <random>
+
+#include <QtCore/QVector>
+#include <QtGui/QImage>
+
+#include <twoDModel/engine/sensorImageKernels.h>
+
+#include "gtest/gtest.h"
+
+using namespace twoDModel::engine;
+
+/// Returns pixels of random colors, some of them transparent, and some close to @a base.
+static QVector<uint> randomPixels(int count, uint base, unsigned seed)
+{
+	std::mt19937 random(seed);
+	QVector<uint> result;
+	for (int i = 0; i < count; ++i) {
+		const uint alpha = random() % 4 ? 0xFF000000 : (random() % 2) << 24;
+		uint color = random() & 0x00FFFFFF;
+		if (random() % 2) {
+			// Shifts channels of a base color by up to 12 in both directions, clamping them to [0..255].
+			color = 0;
+			for (int shift = 0; shift < 24; shift += 8) {
+				const int channel = static_cast<int>((base >> shift) & 0xFF) + static_cast<int>(random() % 25) - 12;
+				color |= static_cast<uint>(qBound(0, channel, 255)) << shift;
+			}
+		}
+
+		result << (alpha | color);
+	}
+
+	return result;
+}
+
+/// Line sensor check for a pixel, as it was done by QImage::pixel() calls before.
+static bool closeEnough(QRgb color, QRgb lineColor, int tolerance)
+{
+	return qAlpha(color) > 0 && qMax(qAbs(qRed(color) - qRed(lineColor))
+		, qMax(qAbs(qGreen(color) - qGreen(lineColor))
+		, qAbs(qBlue(color) - qBlue(lineColor)))) < tolerance;
+}
+
+/// Returns a picture of a floor under sensor with a black line on white background.
+static QImage floorImage(int side)
+{
+	QImage image(side, side, QImage::Format_RGB32);
+	image.fill(0xFFFFFFFF);
+	for (int y = 0; y < side; ++y) {
+		for (int x = side / 3; x < side / 2; ++x) {
+			image.setPixel(x, y, 0xFF000000 | ((x + y) % 5) * 0x010101);
+		}
+	}
+
+	return image;
+}
+
+TEST(SensorImageKernelsTest, brightnessSumTest)
+{
+	ASSERT_EQ(0u, SensorImageKernels::brightnessSum(nullptr, 0));
+
+	QVector<uint> pixels;
+	// All channel values in all positions, plus tail that is not a multiple of vector width.
+	for (uint value = 0; value < 256; ++value) {
+		pixels << (0xFF000000 | (value << 16)) << (0xFF000000 | (value << 8)) << (0xFF000000 | value)
+				<< (0xFF000000 | (value << 16) | (value << 8) | value);
+	}
+
+	pixels << 0xFFFFFFFF << 0xFF102030 << 0xFF7F7F7F;
+
+	quint64 expected = 0;
+	for (const uint pixel : pixels) {
+		expected += SensorImageKernels::brightness(pixel);
+	}
+
+	ASSERT_EQ(expected, SensorImageKernels::brightnessSum(pixels.constData(), pixels.size()));
+}
+
+TEST(SensorImageKernelsTest, countColorsTest)
+{
+	const QVector<uint> pixels = { 1, 1, 1, 2, 1, 3, 3, 2 };
+	QHash<uint, int> histogram;
+	histogram[2] = 10;
+	SensorImageKernels::countColors(pixels.constData(), pixels.size(), histogram);
+
+	ASSERT_EQ(3, histogram.size());
+	ASSERT_EQ(4, histogram[1]);
+	ASSERT_EQ(12, histogram[2]);
+	ASSERT_EQ(2, histogram[3]);
+}
+
+TEST(SensorImageKernelsTest, toKernelFormatTest)
+{
+	QImage rgb(3, 3, QImage::Format_RGB32);
+	ASSERT_EQ(rgb, SensorImageKernels::toKernelFormat(rgb));
+
+	QImage rgb16(3, 3, QImage::Format_RGB16);
+	rgb16.fill(Qt::red);
+	const QImage converted = SensorImageKernels::toKernelFormat(rgb16);
+	ASSERT_EQ(QImage::Format_ARGB32, converted.format());
+	ASSERT_EQ(qRgb(255, 0, 0), converted.pixel(1, 1));
+}
+
+TEST(SensorImageKernelsTest, sumOpaqueChannelsTest)
+{
+	const QVector<uint> pixels = randomPixels(1003, 0xFF406080, 1);
+	quint64 expectedRed = 0;
+	quint64 expectedGreen = 0;
+	quint64 expectedBlue = 0;
+	int expectedOpaque = 0;
+	for (const uint pixel : pixels) {
+		if (qAlpha(pixel) > 0) {
+			++expectedOpaque;
+			expectedRed += qRed(pixel);
+			expectedGreen += qGreen(pixel);
+			expectedBlue += qBlue(pixel);
+		}
+	}
+
+	quint64 red = 1;
+	quint64 green = 2;
+	quint64 blue = 3;
+	ASSERT_EQ(expectedOpaque, SensorImageKernels::sumOpaqueChannels(pixels.constData(), pixels.size()
+			, red, green, blue));
+	ASSERT_EQ(expectedRed + 1, red);
+	ASSERT_EQ(expectedGreen + 2, green);
+	ASSERT_EQ(expectedBlue + 3, blue);
+}
+
+TEST(SensorImageKernelsTest, countCloseColorsTest)
+{
+	const uint lineColor = 0xFF0A80F5;
+	const QVector<uint> pixels = randomPixels(1003, lineColor, 2);
+	for (const int tolerance : {-1, 0, 1, 10, 13, 255, 256, 300}) {
+		int expected = 0;
+		qint64 expectedIndexSum = 0;
+		for (int i = 0; i < pixels.size(); ++i) {
+			if (closeEnough(pixels[i], lineColor, tolerance)) {
+				++expected;
+				expectedIndexSum += i;
+			}
+		}
+
+		qint64 indexSum = 0;
+		ASSERT_EQ(expected, SensorImageKernels::countCloseColors(pixels.constData(), pixels.size(), lineColor
+				, tolerance, indexSum)) << "tolerance " << tolerance;
+		ASSERT_EQ(expectedIndexSum, indexSum) << "tolerance " << tolerance;
+	}
+}
+
+TEST(SensorImageKernelsTest, countPaletteColorsTest)
+{
+	const QVector<uint> pixels = { 1, 1, 1, 2, 1, 3, 3, 2, 5, 1, 4 };
+	const uint palette[] = { 1, 2, 6 };
+	int counts[3];
+	ASSERT_EQ(4, SensorImageKernels::countPaletteColors(pixels.constData(), pixels.size(), palette, 3, counts));
+	ASSERT_EQ(5, counts[0]);
+	ASSERT_EQ(2, counts[1]);
+	ASSERT_EQ(0, counts[2]);
+}
+
+TEST(SensorImageKernelsTest, lineSensorTest)
+{
+	// TRIK line sensor looks at a square twice as wide as its image rect, so side is about 2 * 20 + 1 pixels.
+	const QImage image = floorImage(41);
+	const uint lineColor = 0xFF000000;
+	const int tolerance = 10;
+
+	qint64 expected = 0;
+	for (int y = 0; y < image.height(); ++y) {
+		for (int x = 0; x < image.width(); ++x) {
+			if (closeEnough(image.pixel(x, y), lineColor, tolerance)) {
+				expected += x + 1;
+			}
+		}
+	}
+
+	qint64 actual = 0;
+	for (int y = 0; y < image.height(); ++y) {
+		const uint *row = reinterpret_cast<const uint *>(image.constScanLine(y));
+		qint64 indexSum = 0;
+		actual += SensorImageKernels::countCloseColors(row, image.width(), lineColor, tolerance, indexSum);
+		actual += indexSum;
+	}
+
+	ASSERT_GT(expected, 0);
+	ASSERT_EQ(expected, actual);
+}
+
+TEST(SensorImageKernelsTest, colorSensorTest)
+{
+	// EV3 and NXT color sensors look at a square of about 2 * 10 + 1 pixels, in full color and single color modes.
+	const QImage image = floorImage(21);
+	const uint *pixels = reinterpret_cast<const uint *>(image.constBits());
+	const int count = image.width() * image.height();
+	const uint palette[] = { 0xFF000000, 0xFFFF0000, 0xFF008000, 0xFF0000FF
+			, 0xFFFFFF00, 0xFFFFFFFF, 0xFF00FFFF, 0xFFFF00FF };
+
+	QHash<uint, int> histogram;
+	SensorImageKernels::countColors(pixels, count, histogram);
+
+	int counts[8];
+	SensorImageKernels::countPaletteColors(pixels, count, palette, 8, counts);
+	for (int i = 0; i < 8; ++i) {
+		ASSERT_EQ(histogram.value(palette[i]), counts[i]);
+	}
+
+	// Single color mode.
+	int white = 0;
+	SensorImageKernels::countPaletteColors(pixels, count, &palette[5], 1, &white);
+	ASSERT_EQ(histogram.value(palette[5]), white);
+}
@@ -0,0 +1,68 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include <QtGui/QPainter>
+#include <QtWidgets/QStyleOptionGraphicsItem>
+
+#include <src/engine/view/scene/traceLayer.h>
+
+#include "gtest/gtest.h"
+
+using namespace twoDModel;
+
+/// Renders given piece of the trace layer into an image of the same size.
+static QImage render(view::TraceLayer &layer, const QRect &piece)
+{
+	QImage result(piece.size(), QImage::Format_ARGB32_Premultiplied);
+	result.fill(Qt::transparent);
+	QPainter painter(&result);
+	painter.translate(-piece.topLeft());
+	QStyleOptionGraphicsItem option;
+	option.exposedRect = piece;
+	layer.paint(&painter, &option, nullptr);
+	return result;
+}
+
+TEST(TraceLayerTest, appendTest)
+{
+	view::TraceLayer layer;
+	ASSERT_TRUE(layer.boundingRect().isNull());
+
+	// Crosses the border of tiles with negative and positive coordinates.
+	layer.append(model::TraceSegment{QLineF(-100, 10, 100, 10), Qt::red, 6});
+	layer.append(model::TraceSegment{QLineF(50, -300, 50, -200), Qt::blue, 2});
+
+	ASSERT_TRUE(layer.boundingRect().contains(QRectF(-100, -300, 200, 310)));
+
+	const QImage image = render(layer, QRect(-200, -400, 400, 500));
+	ASSERT_EQ(QColor(Qt::red).rgba(), image.pixel(200 - 100 + 10, 400 + 10));
+	ASSERT_EQ(QColor(Qt::red).rgba(), image.pixel(200 + 90, 400 + 11));
+	ASSERT_EQ(QColor(Qt::blue).rgba(), image.pixel(200 + 50, 400 - 250));
+	ASSERT_EQ(0u, image.pixel(200 + 50, 400 + 30));
+	ASSERT_EQ(0u, image.pixel(200 - 150, 400 + 10));
+}
+
+TEST(TraceLayerTest, clearTest)
+{
+	view::TraceLayer layer;
+	for (int i = 0; i < 1000; ++i) {
+		layer.append(model::TraceSegment{QLineF(i, 0, i + 1, 1), Qt::black, 6});
+	}
+
+	layer.clear();
+	ASSERT_TRUE(layer.boundingRect().isNull());
+	const QImage image = render(layer, QRect(0, 0, 1000, 10));
+	ASSERT_EQ(0u, image.pixel(500, 0));
+}
@@ -27,9 +27,14 @@ INCLUDEPATH += \
 # Tests
 HEADERS += \
 	$$PWD/engineTests/constraintsTests/constraintsParserTests.h \
+	$$PWD/engineTests/modelTests/solidGeometryTests.h \
 
 SOURCES += \
 	$$PWD/engineTests/constraintsTests/constraintsParserTests.cpp \
+	$$PWD/engineTests/fakeSceneTest.cpp \
+	$$PWD/engineTests/modelTests/solidGeometryTests.cpp \
+	$$PWD/engineTests/sensorImageKernelsTest.cpp \
+	$$PWD/engineTests/traceLayerTest.cpp \
 
 # Support classes
 HEADERS += \
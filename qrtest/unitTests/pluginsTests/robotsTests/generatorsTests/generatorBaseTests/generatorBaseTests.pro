@@ -0,0 +1,65 @@
+# Copyright 2007-2015 QReal Research Group
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+TARGET = robots_generator_base_unittests
+
+include($$PWD/../../../../common.pri)
+
+links(qrkernel qslog qrutils)
+
+GENERATOR_BASE_PATH = $$PWD/../../../../../../plugins/robots/generators/generatorBase
+STRUCTURIZATOR_PATH = $$GENERATOR_BASE_PATH/src
+
+INCLUDEPATH += \
+	$$GENERATOR_BASE_PATH/include \
+	$$STRUCTURIZATOR_PATH \
+
+# Templates code is compiled into tests, TemplateCache is not exported from generator base library.
+DEFINES += ROBOTS_GENERATOR_LIBRARY
+
+HEADERS += \
+	$$PWD/structurizatorTest.h \
+	$$PWD/support/controlFlowGraphs.h \
+	$$STRUCTURIZATOR_PATH/structurizator.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/intermediateStructurizatorNode.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/simpleStructurizatorNode.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/breakStructurizatorNode.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/ifStructurizatorNode.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/structurizatorNodeWithBreaks.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/switchStructurizatorNode.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/blockStructurizatorNode.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/whileStructurizatorNode.h \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/selfLoopStructurizatorNode.h \
+	$$GENERATOR_BASE_PATH/include/generatorBase/precompiledTemplate.h \
+	$$GENERATOR_BASE_PATH/include/generatorBase/templateParametrizedEntity.h \
+	$$STRUCTURIZATOR_PATH/templateCache.h \
+
+SOURCES += \
+	$$PWD/structurizatorTest.cpp \
+	$$PWD/precompiledTemplateTest.cpp \
+	$$PWD/templateCacheTest.cpp \
+	$$PWD/support/controlFlowGraphs.cpp \
+	$$STRUCTURIZATOR_PATH/structurizator.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/intermediateStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/simpleStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/breakStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/ifStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/structurizatorNodeWithBreaks.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/switchStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/blockStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/whileStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/structurizatorNodes/selfLoopStructurizatorNode.cpp \
+	$$STRUCTURIZATOR_PATH/precompiledTemplate.cpp \
+	$$STRUCTURIZATOR_PATH/templateCache.cpp \
+	$$STRUCTURIZATOR_PATH/templateParametrizedEntity.cpp \
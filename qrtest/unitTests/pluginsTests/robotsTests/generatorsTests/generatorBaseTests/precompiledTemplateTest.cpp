@@ -0,0 +1,69 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include <gtest/gtest.h>
+
+#include <generatorBase/precompiledTemplate.h>
+
+using namespace generatorBase;
+
+TEST(PrecompiledTemplateTest, labelsTest)
+{
+	const PrecompiledTemplate precompiledTemplate("@@A@@ text @@B_1@@ @@A@@");
+	ASSERT_EQ(QStringList({"@@A@@", "@@B_1@@"}), precompiledTemplate.labels());
+	ASSERT_TRUE(precompiledTemplate.contains("@@A@@"));
+	ASSERT_TRUE(precompiledTemplate.contains("@@B_1@@"));
+	ASSERT_FALSE(precompiledTemplate.contains("@@C@@"));
+	ASSERT_EQ("@@A@@ text @@B_1@@ @@A@@", precompiledTemplate.text());
+}
+
+TEST(PrecompiledTemplateTest, adjacentLabelsTest)
+{
+	const PrecompiledTemplate precompiledTemplate("@@A@@@@B@@");
+	ASSERT_EQ(QStringList({"@@A@@", "@@B@@"}), precompiledTemplate.labels());
+	ASSERT_EQ("12", precompiledTemplate.substitute({{"@@A@@", "1"}, {"@@B@@", "2"}}));
+}
+
+TEST(PrecompiledTemplateTest, extraDelimiterCharactersTest)
+{
+	const PrecompiledTemplate leading("@@@X@@");
+	ASSERT_EQ(QStringList({"@@X@@"}), leading.labels());
+	ASSERT_EQ("@value", leading.substitute({{"@@X@@", "value"}}));
+
+	const PrecompiledTemplate trailing("@@X@@@");
+	ASSERT_EQ(QStringList({"@@X@@"}), trailing.labels());
+	ASSERT_EQ("value@", trailing.substitute({{"@@X@@", "value"}}));
+}
+
+TEST(PrecompiledTemplateTest, unknownLabelsTest)
+{
+	const PrecompiledTemplate precompiledTemplate("a = @@UNKNOWN@@; b = @@A@@;");
+	ASSERT_EQ("a = @@UNKNOWN@@; b = 1;", precompiledTemplate.substitute({{"@@A@@", "1"}}));
+	ASSERT_EQ("a = @@UNKNOWN@@; b = @@A@@;", precompiledTemplate.substitute({}));
+}
+
+TEST(PrecompiledTemplateTest, notPlaceholdersTest)
+{
+	const QString text = "@@ @@ a@@b @@-@@ @@@@ @@";
+	const PrecompiledTemplate precompiledTemplate(text);
+	ASSERT_TRUE(precompiledTemplate.labels().isEmpty());
+	ASSERT_EQ(text, precompiledTemplate.substitute({{"@@b@@", "1"}}));
+}
+
+TEST(PrecompiledTemplateTest, valuesAreNotScannedTest)
+{
+	const PrecompiledTemplate precompiledTemplate("@@A@@ @@B@@");
+	ASSERT_EQ("@@B@@ b", precompiledTemplate.substitute({{"@@A@@", "@@B@@"}, {"@@B@@", "b"}}));
+}
@@ -0,0 +1,96 @@
+/* Copyright 2007-2015 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "structurizatorTest.h"
+
+#include <structurizator.h>
+#include <structurizatorNodes/intermediateStructurizatorNode.h>
+
+using namespace qrTest::robotsTests::generatorBaseTests;
+using namespace generatorBase;
+
+TEST_F(StructurizatorTest, block)
+{
+	Structurizator structurizator;
+	const IntermediateStructurizatorNode *tree = structurize(structurizator, {{1, {2}}, {2, {3}}}, 3);
+	ASSERT_NE(nullptr, tree);
+	EXPECT_EQ(QSet<int>({1, 2, 3}), vertices(tree));
+	EXPECT_EQ(IntermediateStructurizatorNode::block, tree->type());
+}
+
+TEST_F(StructurizatorTest, ifThenElse)
+{
+	Structurizator structurizator;
+	const IntermediateStructurizatorNode *tree = structurize(structurizator
+			, {{1, {2}}, {2, {3, 4}}, {3, {5}}, {4, {5}}}, 5);
+	ASSERT_NE(nullptr, tree);
+	EXPECT_EQ(QSet<int>({1, 2, 3, 4, 5}), vertices(tree));
+	EXPECT_TRUE(dump(tree).contains("if(2; "));
+}
+
+TEST_F(StructurizatorTest, whileLoop)
+{
+	Structurizator structurizator;
+	const IntermediateStructurizatorNode *tree = structurize(structurizator
+			, {{1, {2}}, {2, {3, 4}}, {3, {2}}}, 4);
+	ASSERT_NE(nullptr, tree);
+	EXPECT_TRUE(dump(tree).contains("while(2; 3; 4)"));
+}
+
+TEST_F(StructurizatorTest, loopWithBreak)
+{
+	Structurizator structurizator;
+	const IntermediateStructurizatorNode *tree = structurize(structurizator
+			, {{1, {2}}, {2, {3, 6}}, {3, {4, 5}}, {4, {2}}, {5, {7}}, {6, {7}}}, 7);
+	ASSERT_NE(nullptr, tree);
+	EXPECT_EQ(QSet<int>({1, 2, 3, 4, 5, 6, 7}), vertices(tree));
+	EXPECT_TRUE(dump(tree).contains("breaks(3; block(5; break); )"));
+}
+
+TEST_F(StructurizatorTest, generatedGraphs)
+{
+	for (unsigned seed = 0; seed < 300; ++seed) {
+		QMap<int, QSet<int>> followers;
+		const int verticesNumber = generateGraph(10 + seed % 50, seed, followers);
+
+		Structurizator first;
+		const IntermediateStructurizatorNode *tree = structurize(first, followers, verticesNumber);
+		ASSERT_NE(nullptr, tree) << "seed " << seed;
+
+		QSet<int> expected;
+		for (int v = 1; v <= verticesNumber; ++v) {
+			expected.insert(v);
+		}
+
+		ASSERT_EQ(expected, vertices(tree)) << "seed " << seed;
+
+		Structurizator second;
+		ASSERT_EQ(dump(tree), dump(structurize(second, followers, verticesNumber))) << "seed " << seed;
+	}
+}
+
+TEST_F(StructurizatorTest, largeGraphsTest)
+{
+	// Graphs of big diagrams with deeply nested loops and conditions, reductions used to be quadratic in their size.
+	for (const int size : {100, 500, 2000}) {
+		QMap<int, QSet<int>> followers;
+		const int verticesNumber = generateGraph(size, size, followers);
+
+		Structurizator structurizator;
+		const IntermediateStructurizatorNode *tree = structurize(structurizator, followers, verticesNumber);
+
+		ASSERT_NE(nullptr, tree);
+		EXPECT_EQ(verticesNumber, vertices(tree).size());
+	}
+}
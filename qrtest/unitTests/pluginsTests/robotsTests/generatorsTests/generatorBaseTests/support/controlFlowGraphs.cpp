@@ -0,0 +1,215 @@
+/* Copyright 2007-2015 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "controlFlowGraphs.h"
+
+#include <functional>
+#include <random>
+
+#include <QtCore/QRegExp>
+#include <QtCore/QStringList>
+
+#include <structurizator.h>
+#include <structurizatorNodes/blockStructurizatorNode.h>
+#include <structurizatorNodes/breakStructurizatorNode.h>
+#include <structurizatorNodes/ifStructurizatorNode.h>
+#include <structurizatorNodes/selfLoopStructurizatorNode.h>
+#include <structurizatorNodes/simpleStructurizatorNode.h>
+#include <structurizatorNodes/structurizatorNodeWithBreaks.h>
+#include <structurizatorNodes/switchStructurizatorNode.h>
+#include <structurizatorNodes/whileStructurizatorNode.h>
+
+using namespace qrTest::robotsTests::generatorBaseTests;
+using namespace generatorBase;
+
+static qReal::Id idOf(int vertex)
+{
+	return qReal::Id("editor", "diagram", "element", QString::number(vertex));
+}
+
+IntermediateStructurizatorNode *ControlFlowGraphs::structurize(Structurizator &structurizator
+		, const QMap<int, QSet<int>> &followers, int verticesNumber)
+{
+	QSet<qReal::Id> ids;
+	QMap<qReal::Id, int> numbers;
+	for (int v = 1; v <= verticesNumber; ++v) {
+		ids.insert(idOf(v));
+		numbers[idOf(v)] = v;
+	}
+
+	return structurizator.performStructurization(ids, 1, followers, numbers, verticesNumber);
+}
+
+QSet<int> ControlFlowGraphs::vertices(const IntermediateStructurizatorNode *node)
+{
+	QSet<int> result;
+	const QString text = dump(node);
+	for (const QString &token : text.split(QRegExp("[^0-9]+"), QString::SkipEmptyParts)) {
+		result.insert(token.toInt());
+	}
+
+	return result;
+}
+
+QString ControlFlowGraphs::dump(const IntermediateStructurizatorNode *node)
+{
+	if (!node) {
+		return "_";
+	}
+
+	const auto list = [](const QList<IntermediateStructurizatorNode *> &nodes) {
+		QStringList result;
+		for (const IntermediateStructurizatorNode *item : nodes) {
+			result << dump(item);
+		}
+
+		return result.join(", ");
+	};
+
+	switch (node->type()) {
+	case IntermediateStructurizatorNode::simple:
+		return static_cast<const SimpleStructurizatorNode *>(node)->id().id();
+	case IntermediateStructurizatorNode::breakNode:
+		return "break";
+	case IntermediateStructurizatorNode::block: {
+		const auto block = static_cast<const BlockStructurizatorNode *>(node);
+		return QString("block(%1; %2)").arg(dump(block->firstNode()), dump(block->secondNode()));
+	}
+	case IntermediateStructurizatorNode::ifThenElseCondition: {
+		const auto ifNode = static_cast<const IfStructurizatorNode *>(node);
+		return QString("if(%1; %2; %3; %4)").arg(dump(ifNode->condition()), dump(ifNode->thenBranch())
+				, dump(ifNode->elseBranch()), dump(ifNode->exit()));
+	}
+	case IntermediateStructurizatorNode::switchCondition: {
+		const auto switchNode = static_cast<const SwitchStructurizatorNode *>(node);
+		return QString("switch(%1; %2; %3)").arg(dump(switchNode->condition()), list(switchNode->branches())
+				, dump(switchNode->exit()));
+	}
+	case IntermediateStructurizatorNode::infiniteloop:
+		return QString("loop(%1)").arg(dump(static_cast<const SelfLoopStructurizatorNode *>(node)->bodyNode()));
+	case IntermediateStructurizatorNode::whileloop: {
+		const auto whileNode = static_cast<const WhileStructurizatorNode *>(node);
+		return QString("while(%1; %2; %3)").arg(dump(whileNode->headNode()), dump(whileNode->bodyNode())
+				, dump(whileNode->exitNode()));
+	}
+	case IntermediateStructurizatorNode::nodeWithBreaks: {
+		const auto nodeWithBreaks = static_cast<const StructurizatorNodeWithBreaks *>(node);
+		return QString("breaks(%1; %2; %3)").arg(dump(nodeWithBreaks->condition())
+				, list(nodeWithBreaks->exitBranches()), list(nodeWithBreaks->restBranches()));
+	}
+	}
+
+	return "?";
+}
+
+int ControlFlowGraphs::generateGraph(int size, unsigned seed, QMap<int, QSet<int>> &followers)
+{
+	std::mt19937 random(seed);
+	int verticesNumber = 0;
+	int budget = size;
+	const auto newVertex = [&verticesNumber]() { return ++verticesNumber; };
+	const auto connect = [&followers](const QList<int> &from, int to) {
+		for (const int v : from) {
+			followers[v].insert(to);
+		}
+	};
+
+	// Generates a statement, returns its entry vertex and fills vertices from which control leaves it.
+	// Vertices jumping out of the innermost loop are added to breaks, if there is such a loop.
+	std::function<int(int, QList<int> &, QList<int> *)> statement;
+	statement = [&](int depth, QList<int> &exits, QList<int> *breaks) {
+		const int kind = budget <= 0 ? 0 : depth > 40 ? 2 : random() % 8;
+		--budget;
+		switch (kind) {
+		case 2: {
+			QList<int> firstExits;
+			const int first = statement(depth + 1, firstExits, breaks);
+			const int second = statement(depth + 1, exits, breaks);
+			connect(firstExits, second);
+			return first;
+		}
+		case 3: {
+			const int condition = newVertex();
+			connect({condition}, statement(depth + 1, exits, breaks));
+			if (random() % 2) {
+				QList<int> elseExits;
+				connect({condition}, statement(depth + 1, elseExits, breaks));
+				exits << elseExits;
+			} else {
+				exits << condition;
+			}
+
+			return condition;
+		}
+		case 4: {
+			const int condition = newVertex();
+			const int branches = 3 + random() % 3;
+			for (int i = 0; i < branches; ++i) {
+				QList<int> branchExits;
+				connect({condition}, statement(depth + 1, branchExits, breaks));
+				exits << branchExits;
+			}
+
+			return condition;
+		}
+		case 5: {
+			const int head = newVertex();
+			QList<int> bodyExits;
+			connect({head}, statement(depth + 1, bodyExits, nullptr));
+			connect(bodyExits, head);
+			exits = {head};
+			return head;
+		}
+		case 6: {
+			const int head = newVertex();
+			QList<int> bodyExits;
+			connect({head}, statement(depth + 1, bodyExits, &exits));
+			connect(bodyExits, head);
+			const int exit = newVertex();
+			connect({head}, exit);
+			exits << exit;
+			return head;
+		}
+		case 7: {
+			const int condition = newVertex();
+			connect({condition}, statement(depth + 1, exits, breaks));
+			if (breaks) {
+				const int breakVertex = newVertex();
+				connect({condition}, breakVertex);
+				*breaks << breakVertex;
+			} else {
+				exits << condition;
+			}
+
+			return condition;
+		}
+		default: {
+			const int vertex = newVertex();
+			exits = {vertex};
+			return vertex;
+		}
+		}
+	};
+
+	QList<int> exits;
+	statement(0, exits, nullptr);
+	while (budget > 0) {
+		QList<int> nextExits;
+		connect(exits, statement(0, nextExits, nullptr));
+		exits = nextExits;
+	}
+
+	connect(exits, newVertex());
+	return verticesNumber;
+}
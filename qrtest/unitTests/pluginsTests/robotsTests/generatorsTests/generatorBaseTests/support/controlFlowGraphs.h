@@ -0,0 +1,51 @@
+/* Copyright 2007-2015 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QMap>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+
+namespace generatorBase {
+class IntermediateStructurizatorNode;
+class Structurizator;
+}
+
+namespace qrTest {
+namespace robotsTests {
+namespace generatorBaseTests {
+
+/// Control flow graphs for structural analysis tests and benchmark: generation and checks of resulting trees.
+class ControlFlowGraphs
+{
+public:
+	/// Structurizes a graph with vertices from 1 to @a verticesNumber, vertex 1 is the start one.
+	static generatorBase::IntermediateStructurizatorNode *structurize(generatorBase::Structurizator &structurizator
+			, const QMap<int, QSet<int>> &followers, int verticesNumber);
+
+	/// Returns numbers of all the diagram vertices mentioned in a tree.
+	static QSet<int> vertices(const generatorBase::IntermediateStructurizatorNode *node);
+
+	/// Returns text representation of a tree to compare trees with each other.
+	static QString dump(const generatorBase::IntermediateStructurizatorNode *node);
+
+	/// Generates control flow graph of a random structured program with about @a size statements: sequences,
+	/// conditions, switches, loops and loops with breaks from nested conditions. Returns number of vertices.
+	static int generateGraph(int size, unsigned seed, QMap<int, QSet<int>> &followers);
+};
+
+}
+}
+}
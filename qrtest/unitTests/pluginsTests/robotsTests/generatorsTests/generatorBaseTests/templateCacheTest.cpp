@@ -0,0 +1,128 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThread>
+
+#include <gtest/gtest.h>
+
+#include <generatorBase/templateParametrizedEntity.h>
+#include <templateCache.h>
+
+using namespace generatorBase;
+
+/// Gives access to templates reading.
+class TestEntity : public TemplateParametrizedEntity
+{
+public:
+	explicit TestEntity(const QString &pathToTemplates)
+		: TemplateParametrizedEntity(QStringList({pathToTemplates}))
+	{
+	}
+
+	using TemplateParametrizedEntity::readTemplate;
+};
+
+static void writeFile(const QString &path, const QString &text)
+{
+	QFile file(path);
+	ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+	file.write(text.toUtf8());
+}
+
+/// Rewrites the file with @a text until its modification time changes, file systems may store it coarsely.
+static void rewriteFile(const QString &path, const QString &text)
+{
+	const QDateTime lastModified = QFileInfo(path).lastModified();
+	for (int attempt = 0; attempt < 300 && QFileInfo(path).lastModified() == lastModified; ++attempt) {
+		QThread::msleep(10);
+		writeFile(path, text);
+	}
+
+	ASSERT_NE(lastModified, QFileInfo(path).lastModified());
+}
+
+TEST(TemplateCacheTest, missingFileTest)
+{
+	QTemporaryDir directory;
+	PrecompiledTemplate result;
+	QString errorMessage;
+	ASSERT_FALSE(TemplateCache::instance().read(directory.path() + "/missing.t", result, errorMessage));
+}
+
+TEST(TemplateCacheTest, sizeChangeTest)
+{
+	QTemporaryDir directory;
+	const QString path = directory.path() + "/template.t";
+	writeFile(path, "@@A@@;");
+
+	PrecompiledTemplate result;
+	QString errorMessage;
+	ASSERT_TRUE(TemplateCache::instance().read(path, result, errorMessage));
+	ASSERT_TRUE(errorMessage.isEmpty());
+	ASSERT_EQ("@@A@@;", result.text());
+
+	writeFile(path, "@@A@@ + @@B@@;");
+	ASSERT_TRUE(TemplateCache::instance().read(path, result, errorMessage));
+	ASSERT_EQ("@@A@@ + @@B@@;", result.text());
+	ASSERT_EQ(QStringList({"@@A@@", "@@B@@"}), result.labels());
+}
+
+TEST(TemplateCacheTest, modificationTimeChangeTest)
+{
+	QTemporaryDir directory;
+	const QString path = directory.path() + "/template.t";
+	writeFile(path, "@@A@@;");
+
+	PrecompiledTemplate result;
+	QString errorMessage;
+	ASSERT_TRUE(TemplateCache::instance().read(path, result, errorMessage));
+	ASSERT_EQ("@@A@@;", result.text());
+
+	// Same size, so only modification time tells that the template has changed.
+	rewriteFile(path, "@@B@@;");
+	ASSERT_TRUE(TemplateCache::instance().read(path, result, errorMessage));
+	ASSERT_EQ("@@B@@;", result.text());
+}
+
+TEST(TemplateCacheTest, randomIdTest)
+{
+	QTemporaryDir directory;
+	writeFile(directory.path() + "/template.t", "@@RANDOM_ID@@ @@RANDOM_ID@@ @@RANDOM_ID_1@@ @@VALUE@@");
+	const TestEntity entity(directory.path());
+
+	const QStringList generated = entity.readTemplate("template.t").split(' ');
+	ASSERT_EQ(4, generated.size());
+	ASSERT_FALSE(generated[0].isEmpty());
+	ASSERT_FALSE(generated[0].contains("@@"));
+	ASSERT_FALSE(generated[2].contains("@@"));
+	ASSERT_EQ(generated[0], generated[1]);
+	ASSERT_NE(generated[0], generated[2]);
+	ASSERT_EQ("@@VALUE@@", generated[3]);
+
+	// Each reading gets fresh ids.
+	ASSERT_NE(generated[0], entity.readTemplate("template.t").split(' ')[0]);
+
+	const QStringList supplied = entity.readTemplate("template.t"
+			, {{"@@RANDOM_ID@@", "id"}, {"@@VALUE@@", "value"}}).split(' ');
+	ASSERT_EQ(4, supplied.size());
+	ASSERT_EQ("id", supplied[0]);
+	ASSERT_EQ("id", supplied[1]);
+	ASSERT_FALSE(supplied[2].contains("@@"));
+	ASSERT_NE("id", supplied[2]);
+	ASSERT_EQ("value", supplied[3]);
+}
@@ -15,4 +15,5 @@
 TEMPLATE = subdirs
 
 SUBDIRS = \
+	generatorBaseTests \
 	trikV62QtsGeneratorTests \
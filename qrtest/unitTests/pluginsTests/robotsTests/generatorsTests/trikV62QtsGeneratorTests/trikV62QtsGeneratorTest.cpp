@@ -14,6 +14,9 @@
 
 #include "trikV62QtsGeneratorTest.h"
 
+#include <QtCore/QDir>
+#include <QtCore/QTemporaryDir>
+
 #include <trikV62QtsGeneratorPlugin.h>
 
 #include <gmock/gmock.h>
@@ -96,6 +99,11 @@ tcpRobotSimulator::TcpRobotSimulator &TrikV62QtsGeneratorTest::controlSimulator(
 	return *mControlConnectionSimulator;
 }
 
+QrguiFacade &TrikV62QtsGeneratorTest::facade()
+{
+	return *mFacade;
+}
+
 TEST_F(TrikV62QtsGeneratorTest, runProgramTest)
 {
 	TrikV62QtsGeneratorPlugin plugin;
@@ -137,3 +145,21 @@ TEST_F(TrikV62QtsGeneratorTest, incorrectCasingVersionTest)
 	EXPECT_FALSE(controlSimulator().runProgramRequestReceived());
 	EXPECT_TRUE(errorReporter->wereErrors());
 }
+
+TEST_F(TrikV62QtsGeneratorTest, generateCodeToFolderTest)
+{
+	// Console generation must name files like GUI does it, dots of a save file name shall not cut the name.
+	ProjectManagementInterfaceMock &projectManager
+			= static_cast<ProjectManagementInterfaceMock &>(facade().projectManagementInterface());
+	ON_CALL(projectManager, saveFilePath()).WillByDefault(Return(QString("unittests/smile.v2.qrs")));
+
+	TrikV62QtsGeneratorPlugin plugin;
+	plugin.init(kitPluginConfigurer());
+
+	QTemporaryDir output;
+	const QString folder = QDir(output.path()).absoluteFilePath("trikQts");
+	const QString generatedFile = plugin.generateCodeToFolder(folder);
+
+	EXPECT_EQ(QDir(folder).absoluteFilePath("smilev2.js"), generatedFile);
+	EXPECT_TRUE(QFileInfo(generatedFile).exists());
+}
@@ -64,6 +64,9 @@ protected:
 	/// Provides access to network robot simulator simulating control connection.
 	tcpRobotSimulator::TcpRobotSimulator &controlSimulator();
 
+	/// Provides access to emulated GUI, so tests can tune its mocks.
+	QrguiFacade &facade();
+
 private:
 	/// Network server that simulates control connection to robot (on which all commands to robot are sent).
 	QScopedPointer<tcpRobotSimulator::TcpRobotSimulator> mControlConnectionSimulator;
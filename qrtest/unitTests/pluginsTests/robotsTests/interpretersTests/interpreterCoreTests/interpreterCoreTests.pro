@@ -31,6 +31,7 @@ HEADERS += \
 	kitPluginManagerTest.h \
 	interpreterTests/interpreterTest.h \
 	interpreterTests/detailsTests/blocksTableTest.h \
+	interpreterTests/detailsTests/sensorVariablesUpdaterTest.h \
 	managersTests/sensorsConfigurationManagerTest.h \
 	support/dummySensorsConfigurer.h \
 
@@ -38,6 +39,7 @@ SOURCES += \
 	kitPluginManagerTest.cpp \
 	interpreterTests/interpreterTest.cpp \
 	interpreterTests/detailsTests/blocksTableTest.cpp \
+	interpreterTests/detailsTests/sensorVariablesUpdaterTest.cpp \
 	managersTests/sensorsConfigurationManagerTest.cpp \
 	support/dummySensorsConfigurer.cpp \
 
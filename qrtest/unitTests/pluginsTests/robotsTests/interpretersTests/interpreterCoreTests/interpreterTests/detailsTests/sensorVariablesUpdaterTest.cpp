@@ -0,0 +1,116 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include "sensorVariablesUpdaterTest.h"
+
+#include <QtCore/QTimer>
+
+#include "interpreterCore/interpreter/details/sensorVariablesUpdater.h"
+
+using namespace qrTest::robotsTests::interpreterCoreTests::detailsTests;
+using namespace interpreterCore::interpreter::details;
+using namespace kitBase::robotModel;
+
+using namespace ::testing;
+
+/// Sensors with unused variables are polled once in this number of ticks by updater.
+static const int idlePollingFactor = 10;
+
+TestSensor::TestSensor(const PortInfo &port)
+	: ScalarSensor(DeviceInfo(), port)
+{
+}
+
+void TestSensor::read()
+{
+}
+
+void SensorVariablesUpdaterTest::SetUp()
+{
+	mUsedSensor.reset(new TestSensor(PortInfo("A1", input, {}, "usedSensor")));
+	mUnusedSensor.reset(new TestSensor(PortInfo("A2", input, {}, "unusedSensor")));
+
+	ON_CALL(mConfigurationInterfaceMock, devices()).WillByDefault(
+			Return(QList<robotParts::Device *>({mUsedSensor.data(), mUnusedSensor.data()}))
+			);
+	EXPECT_CALL(mConfigurationInterfaceMock, devices()).Times(AtLeast(1));
+
+	ON_CALL(mModel, configuration()).WillByDefault(ReturnRef(mConfigurationInterfaceMock));
+	EXPECT_CALL(mModel, configuration()).Times(AtLeast(1));
+
+	ON_CALL(mModel, timeline()).WillByDefault(ReturnRef(mTimeline));
+	EXPECT_CALL(mModel, timeline()).Times(AtLeast(1));
+
+	ON_CALL(mModel, updateIntervalForInterpretation()).WillByDefault(Return(1));
+	EXPECT_CALL(mModel, updateIntervalForInterpretation()).Times(AtLeast(1));
+
+	EXPECT_CALL(mModel, needsConnection()).Times(AtLeast(0));
+
+	ON_CALL(mModelManager, model()).WillByDefault(ReturnRef(mModel));
+	EXPECT_CALL(mModelManager, model()).Times(AtLeast(1));
+
+	// Guards against hanging if expected polls never come.
+	QTimer::singleShot(5000, &mEventLoop, SLOT(quit()));
+}
+
+TEST_F(SensorVariablesUpdaterTest, realRobotPollsUnusedSensorsRarelyTest)
+{
+	ON_CALL(mModel, needsConnection()).WillByDefault(Return(true));
+
+	// Initial values are read for all the sensors.
+	EXPECT_CALL(mModel, updateSensorsValues()).Times(1);
+
+	QList<QList<PortInfo>> polls;
+	EXPECT_CALL(mModel, updateSelectedSensorsValues(_)).Times(AtLeast(idlePollingFactor)).WillRepeatedly(
+			Invoke([&](const QList<PortInfo> &ports) {
+				polls << ports;
+				if (polls.size() == idlePollingFactor) {
+					mEventLoop.quit();
+				}
+			})
+			);
+
+	SensorVariablesUpdater updater(mModelManager, mToolbox);
+	updater.run({"usedSensor"});
+	mEventLoop.exec();
+	updater.suspend();
+
+	ASSERT_GE(polls.size(), idlePollingFactor);
+	for (int i = 0; i < idlePollingFactor; ++i) {
+		EXPECT_TRUE(polls[i].contains(mUsedSensor->port()));
+		EXPECT_EQ(i == idlePollingFactor - 1, polls[i].contains(mUnusedSensor->port()));
+	}
+}
+
+TEST_F(SensorVariablesUpdaterTest, modelWithoutConnectionPollsAllSensorsTest)
+{
+	ON_CALL(mModel, needsConnection()).WillByDefault(Return(false));
+	EXPECT_CALL(mModel, updateSelectedSensorsValues(_)).Times(0);
+
+	const int pollsCount = 3;
+	int polls = 0;
+	EXPECT_CALL(mModel, updateSensorsValues()).Times(AtLeast(pollsCount)).WillRepeatedly(
+			Invoke([&]() {
+				if (++polls == pollsCount) {
+					mEventLoop.quit();
+				}
+			})
+			);
+
+	SensorVariablesUpdater updater(mModelManager, mToolbox);
+	updater.run({"usedSensor"});
+	mEventLoop.exec();
+	updater.suspend();
+}
@@ -0,0 +1,61 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QEventLoop>
+#include <QtCore/QScopedPointer>
+
+#include <gtest/gtest.h>
+
+#include <kitBase/robotModel/robotParts/scalarSensor.h>
+#include <kitBase/robotModel/robotModelInterfaceMock.h>
+#include <kitBase/robotModel/robotModelManagerInterfaceMock.h>
+#include <kitBase/robotModel/configurationInterfaceMock.h>
+#include <qrtext/lua/luaToolbox.h>
+#include <utils/realTimeline.h>
+
+namespace qrTest {
+namespace robotsTests {
+namespace interpreterCoreTests {
+namespace detailsTests {
+
+/// Sensor that does nothing when asked for readings, reading requests are checked on robot model mock.
+class TestSensor : public kitBase::robotModel::robotParts::ScalarSensor
+{
+public:
+	explicit TestSensor(const kitBase::robotModel::PortInfo &port);
+
+	void read() override;
+};
+
+class SensorVariablesUpdaterTest : public testing::Test
+{
+protected:
+	void SetUp() override;
+
+	utils::RealTimeline mTimeline;
+	RobotModelInterfaceMock mModel;
+	RobotModelManagerInterfaceMock mModelManager;
+	ConfigurationInterfaceMock mConfigurationInterfaceMock;
+	qrtext::lua::LuaToolbox mToolbox;
+	QScopedPointer<TestSensor> mUsedSensor;
+	QScopedPointer<TestSensor> mUnusedSensor;
+	QEventLoop mEventLoop;
+};
+
+}
+}
+}
+}
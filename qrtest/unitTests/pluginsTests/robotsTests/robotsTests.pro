@@ -15,6 +15,7 @@
 TEMPLATE = subdirs
 
 SUBDIRS = \
+	checkerTests \
 	commonTests \
 	generatorsTests \
 	interpretersTests \
@@ -22,3 +23,4 @@ SUBDIRS = \
 	utilsTests \
 
 generatorsTests.depends = tcpRobotSimulator
+utilsTests.depends = tcpRobotSimulator
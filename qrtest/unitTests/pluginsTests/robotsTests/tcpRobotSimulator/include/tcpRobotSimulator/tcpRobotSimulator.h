@@ -49,6 +49,9 @@ public:
 	/// Check that server received "version" command.
 	bool versionRequestReceived() const;
 
+	/// Check that server received "subscribe" command for telemetry.
+	bool telemetrySubscriptionReceived() const;
+
 signals:
 	/// Emitted when "run" command received.
 	void runProgramRequestReceivedSignal();
@@ -17,6 +17,8 @@
 #include <QtNetwork/QTcpSocket>
 #include <QtCore/QTimer>
 #include <QtCore/QThread>
+#include <QtCore/QtEndian>
+#include <QtCore/QVector>
 
 #include <QtCore/QDebug>
 
@@ -25,6 +27,19 @@ static const QString trikRuntimeVersion = "3.1.3";
 static const int keepaliveTime = 3000;
 static const int heartbeatTime = 5000;
 
+/// Appends a reading to telemetry frame, format is described in TelemetryCodec class of robots utils.
+static void appendReading(QByteArray &frame, const QByteArray &port, const QVector<int> &values, bool isScalar)
+{
+	frame.append(static_cast<char>(port.size()));
+	frame.append(port);
+	frame.append(static_cast<char>(isScalar ? 0 : values.size()));
+	for (const int value : values) {
+		uchar buffer[4];
+		qToLittleEndian<qint32>(value, buffer);
+		frame.append(reinterpret_cast<const char *>(buffer), 4);
+	}
+}
+
 using namespace tcpRobotSimulator;
 
 Connection::Connection(Protocol connectionProtocol, Heartbeat useHeartbeat, const QString &configVersion)
@@ -80,6 +95,10 @@ void Connection::closeConnection()
 {
 	mKeepAliveTimer->stop();
 	mHeartbeatTimer->stop();
+	if (mTelemetryTimer) {
+		mTelemetryTimer->stop();
+	}
+
 	mSocket->close();
 	thread()->quit();
 }
@@ -213,6 +232,14 @@ void Connection::onHeartbeatTimeout()
 	mSocket->disconnectFromHost();
 }
 
+void Connection::pushTelemetry()
+{
+	QByteArray frame("frame:");
+	appendReading(frame, "A1", {42}, true);
+	appendReading(frame, "AccelerometerPort", {1, 2, 3}, false);
+	send(frame);
+}
+
 void Connection::connectSlots()
 {
 	connect(mSocket.data(), SIGNAL(readyRead()), this, SLOT(onReadyRead()));
@@ -233,6 +260,10 @@ void Connection::doDisconnect()
 		mHeartbeatTimer->stop();
 	}
 
+	if (mTelemetryTimer) {
+		mTelemetryTimer->stop();
+	}
+
 	mDisconnectReported = true;
 
 	emit disconnected();
@@ -276,6 +307,20 @@ void Connection::processData(const QByteArray &data)
 	} else if (command == "configVersion") {
 		mConfigVersionRequestReceived = true;
 		send(("configVersion: " + mConfigVersion).toUtf8());
+	} else if (command.startsWith("subscribe:")) {
+		mTelemetrySubscriptionReceived = true;
+		const int interval = command.mid(QString("subscribe:").length()).toInt();
+		send(("subscribed:" + QString::number(interval)).toUtf8());
+		if (!mTelemetryTimer) {
+			mTelemetryTimer.reset(new QTimer);
+			connect(mTelemetryTimer.data(), SIGNAL(timeout()), this, SLOT(pushTelemetry()));
+		}
+
+		mTelemetryTimer->start(interval);
+	} else if (command == "unsubscribe") {
+		if (mTelemetryTimer) {
+			mTelemetryTimer->stop();
+		}
 	}
 }
 
@@ -293,3 +338,8 @@ bool Connection::versionRequestReceived() const
 {
 	return mVersionRequestReceived;
 }
+
+bool Connection::telemetrySubscriptionReceived() const
+{
+	return mTelemetrySubscriptionReceived;
+}
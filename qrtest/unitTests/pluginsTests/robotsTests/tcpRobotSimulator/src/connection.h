@@ -46,7 +46,8 @@ enum class Heartbeat
 
 /// Somewhat modified Connection class from TRIK Runtime, simulates its behavior (actually can use different protocols
 /// and simulate heartbeat). processData() is implemented to simulate control connection (TrikCommunicator class
-/// in trikRuntime).
+/// in trikRuntime) and telemetry subscription: after "subscribe:<interval>" command connection pushes binary frames
+/// with scalar reading 42 of port "A1" and vector reading (1, 2, 3) of port "AccelerometerPort".
 class Connection: public QObject
 {
 	Q_OBJECT
@@ -81,6 +82,9 @@ public:
 	/// Check that server received "version" command.
 	bool versionRequestReceived() const;
 
+	/// Check that server received "subscribe" command.
+	bool telemetrySubscriptionReceived() const;
+
 signals:
 	/// Emitted after connection becomes closed.
 	void disconnected();
@@ -114,6 +118,9 @@ private slots:
 	/// Heartbeat timer timed out, close connection.
 	void onHeartbeatTimeout();
 
+	/// Sends a frame with telemetry data to subscribed peer.
+	void pushTelemetry();
+
 private:
 	/// Processes received data.
 	virtual void processData(const QByteArray &data);
@@ -151,6 +158,9 @@ private:
 	/// Timer that is used to check that keepalive packets from other end of the line were properly received.
 	QScopedPointer<QTimer> mHeartbeatTimer;
 
+	/// Timer that is used to push telemetry frames after subscription.
+	QScopedPointer<QTimer> mTelemetryTimer;
+
 	/// Flag that ensures that "disconnected" signal will be sent only once.
 	bool mDisconnectReported = false;
 
@@ -166,6 +176,9 @@ private:
 	/// Boolean flag that becomes true when we receive "version" command.
 	bool mVersionRequestReceived = false;
 
+	/// Boolean flag that becomes true when we receive "subscribe" command.
+	bool mTelemetrySubscriptionReceived = false;
+
 	/// Simulated config version.
 	const QString mConfigVersion;
 };
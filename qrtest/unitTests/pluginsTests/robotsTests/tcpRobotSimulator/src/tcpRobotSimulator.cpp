@@ -65,6 +65,11 @@ bool TcpRobotSimulator::versionRequestReceived() const
 	return mConnection && mConnection->versionRequestReceived();
 }
 
+bool TcpRobotSimulator::telemetrySubscriptionReceived() const
+{
+	return mConnection && mConnection->telemetrySubscriptionReceived();
+}
+
 void TcpRobotSimulator::setConfigVersion(const QString &configVersion)
 {
 	mConfigVersion = configVersion;
@@ -0,0 +1,127 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include "telemetryTest.h"
+
+#include <QtCore/QPair>
+#include <QtCore/QStringList>
+
+#include <utils/robotCommunication/tcpRobotCommunicator.h>
+#include <src/robotCommunication/frameParser.h>
+#include <src/robotCommunication/telemetryCodec.h>
+
+#include <testUtils/testRegistry.h>
+#include <testUtils/wait.h>
+#include <tcpRobotSimulator/tcpRobotSimulator.h>
+
+using namespace utils::robotCommunication;
+using namespace qrTest;
+using namespace qrTest::robotsTests::utilsTests;
+
+TEST_F(TelemetryTest, frameParserTest)
+{
+	QByteArray stream = "5:hello0:x:3:abc";
+	for (int i = 0; i < 1000; ++i) {
+		stream += "2:" + QByteArray::number(i % 100).rightJustified(2, '0');
+	}
+
+	FrameParser parser;
+	QList<QByteArray> messages;
+	QByteArray message;
+	// Bytes come one by one, so each message is split between reads.
+	for (const char byte : stream) {
+		parser.append(QByteArray(1, byte));
+		while (parser.takeMessage(message)) {
+			messages << message;
+		}
+	}
+
+	ASSERT_EQ(1002, messages.size());
+	ASSERT_EQ("hello", messages[0]);
+	ASSERT_EQ("abc", messages[1]);
+	ASSERT_EQ("07", messages[9]);
+	ASSERT_EQ("99", messages[1001]);
+
+	// And now all the messages come at once.
+	parser.clear();
+	parser.append(stream);
+	int count = 0;
+	while (parser.takeMessage(message)) {
+		++count;
+	}
+
+	ASSERT_EQ(1002, count);
+	ASSERT_EQ("99", message);
+}
+
+TEST_F(TelemetryTest, telemetryCodecTest)
+{
+	QByteArray frame;
+	TelemetryCodec::appendScalar(frame, "A1", -5);
+	TelemetryCodec::appendVector(frame, "AccelerometerPort", {1, -2, 100000});
+	TelemetryCodec::appendScalar(frame, "A1", 7);
+
+	QStringList scalarPorts;
+	QList<int> scalars;
+	QList<QVector<int>> vectors;
+	const auto onScalar = [&](const QString &port, int value) { scalarPorts << port; scalars << value; };
+	const auto onVector = [&](const QString &port, const QVector<int> &values) {
+		ASSERT_EQ("AccelerometerPort", port);
+		vectors << values;
+	};
+
+	TelemetryCodec codec;
+	ASSERT_TRUE(codec.decode(frame.constData(), frame.size(), onScalar, onVector));
+	ASSERT_EQ(QStringList({"A1", "A1"}), scalarPorts);
+	ASSERT_EQ(QList<int>({-5, 7}), scalars);
+	ASSERT_EQ(1, vectors.size());
+	ASSERT_EQ(QVector<int>({1, -2, 100000}), vectors.first());
+
+	// Truncated frame, all complete readings are still reported.
+	scalars.clear();
+	vectors.clear();
+	ASSERT_FALSE(codec.decode(frame.constData(), frame.size() - 1, onScalar, onVector));
+	ASSERT_EQ(QList<int>({-5}), scalars);
+	ASSERT_EQ(1, vectors.size());
+}
+
+TEST_F(TelemetryTest, subscriptionTest)
+{
+	tcpRobotSimulator::TcpRobotSimulator controlSimulator(8888);
+	tcpRobotSimulator::TcpRobotSimulator telemetrySimulator(9000);
+	TestRegistry registry;
+	registry.set("TelemetryTestServer", "127.0.0.1");
+
+	TcpRobotCommunicator communicator("TelemetryTestServer");
+	QList<QPair<QString, int>> scalars;
+	QList<QPair<QString, QVector<int>>> vectors;
+	QObject::connect(&communicator, &TcpRobotCommunicator::newScalarSensorData
+			, [&](const QString &port, int value) { scalars << qMakePair(port, value); });
+	QObject::connect(&communicator, &TcpRobotCommunicator::newVectorSensorData
+			, [&](const QString &port, const QVector<int> &values) { vectors << qMakePair(port, values); });
+
+	communicator.subscribeToData(20);
+	communicator.connect();
+
+	Wait waiter(5000);
+	waiter.stopAt(&communicator, &TcpRobotCommunicator::newVectorSensorData);
+	waiter.wait();
+
+	ASSERT_TRUE(telemetrySimulator.telemetrySubscriptionReceived());
+	ASSERT_FALSE(scalars.isEmpty());
+	ASSERT_EQ(qMakePair(QString("A1"), 42), scalars.first());
+	ASSERT_FALSE(vectors.isEmpty());
+	ASSERT_EQ(qMakePair(QString("AccelerometerPort"), QVector<int>({1, 2, 3})), vectors.first());
+}
@@ -0,0 +1,139 @@
+/* Copyright 2016 CyberTech Labs Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+
+#include "trajectoryTest.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/qmath.h>
+
+#include <utils/trajectory/trajectoryReader.h>
+#include <utils/trajectory/trajectoryWriter.h>
+
+using namespace utils::trajectory;
+using namespace qrTest::robotsTests::utilsTests;
+
+/// Writes a trajectory of a robot riding a circle with a motor and a display changing their states,
+/// both into binary log and into JSON as 2D model checker does. Returns JSON.
+static QByteArray writeTrajectory(QIODevice &binary, int pointsCount, bool deltaEncoding, int chunkSize)
+{
+	QByteArray json = "[\n";
+	bool first = true;
+	const auto writeJson = [&json, &first](const QJsonObject &record) {
+		json += (first ? "" : ", ") + QJsonDocument(record).toJson();
+		first = false;
+	};
+
+	TrajectoryWriter writer(binary, deltaEncoding, chunkSize);
+	for (int i = 0; i < pointsCount; ++i) {
+		const qreal angle = i / 100.0;
+		const TrajectoryPoint point{"trikKitRobot", i * 10, QPointF(100 * qCos(angle), 100 * qSin(angle)), angle * 57};
+		writer.writePoint(point);
+		writeJson(point.toJson());
+		if (i % 7 == 0) {
+			const DeviceState state{"trikKitRobot", i * 10, "TrikPowerMotor", "M" + QString::number(i % 4 + 1)
+					, "power", QJsonValue(i % 200 - 100)};
+			writer.writeDeviceState(state);
+			writeJson(state.toJson());
+		}
+
+		if (i % 50 == 0) {
+			const DeviceState state{"trikKitRobot", i * 10, "TrikDisplay", "DisplayPort", "labels"
+					, QJsonArray({QJsonObject{{"x", i}, {"text", "hello"}}, 0.5, true})};
+			writer.writeDeviceState(state);
+			writeJson(state.toJson());
+		}
+	}
+
+	// Records of different kinds at the very beginning of a chunk and values of all the types.
+	const DeviceState state{"trikKitRobot", pointsCount * 10, "TrikLed", "LedPort", "color", "red"};
+	writer.writeDeviceState(state);
+	writeJson(state.toJson());
+	for (const QJsonValue &value : {QJsonValue(), QJsonValue(false), QJsonValue(-0.0), QJsonValue(1e300)
+			, QJsonValue(-123456789012.0), QJsonValue(QJsonObject{{"a", "b"}})})
+	{
+		const DeviceState other{"otherRobot", pointsCount * 10, "Device", "Port", "property", value};
+		writer.writeDeviceState(other);
+		writeJson(other.toJson());
+	}
+
+	json += "]\n";
+	return json;
+}
+
+TEST_F(TrajectoryTest, roundTripTest)
+{
+	for (const bool deltaEncoding : {true, false}) {
+		for (const int chunkSize : {1, 5, 256, 100000}) {
+			QBuffer binary;
+			binary.open(QIODevice::WriteOnly);
+			const QByteArray expected = writeTrajectory(binary, 1000, deltaEncoding, chunkSize);
+			binary.close();
+
+			binary.open(QIODevice::ReadOnly);
+			QBuffer json;
+			json.open(QIODevice::WriteOnly);
+			QString errorMessage;
+			ASSERT_TRUE(TrajectoryReader::convertToJson(binary, json, errorMessage)) << errorMessage.toStdString();
+			ASSERT_TRUE(errorMessage.isEmpty());
+			ASSERT_EQ(expected, json.data()) << "delta " << deltaEncoding << ", chunk " << chunkSize;
+		}
+	}
+}
+
+TEST_F(TrajectoryTest, sizeTest)
+{
+	const int pointsCount = 10000;
+	QBuffer plain;
+	plain.open(QIODevice::WriteOnly);
+	writeTrajectory(plain, pointsCount, false, 256);
+	QBuffer delta;
+	delta.open(QIODevice::WriteOnly);
+	const QByteArray json = writeTrajectory(delta, pointsCount, true, 256);
+
+	// Coordinates take 8 bytes each without delta encoding, so binary log must be several times smaller than JSON.
+	ASSERT_LT(plain.size() * 3, json.size());
+	ASSERT_LT(delta.size(), plain.size());
+}
+
+TEST_F(TrajectoryTest, malformedLogTest)
+{
+	QBuffer binary;
+	binary.open(QIODevice::WriteOnly);
+	writeTrajectory(binary, 100, true, 16);
+	binary.close();
+
+	int pointsCount = 0;
+	const auto countPoints = [&pointsCount](const TrajectoryPoint &) { ++pointsCount; };
+	const auto ignoreStates = [](const DeviceState &) {};
+
+	QByteArray truncated = binary.data();
+	truncated.chop(3);
+	QBuffer truncatedBinary(&truncated);
+	truncatedBinary.open(QIODevice::ReadOnly);
+	TrajectoryReader truncatedReader(truncatedBinary);
+	ASSERT_FALSE(truncatedReader.read(countPoints, ignoreStates));
+	ASSERT_FALSE(truncatedReader.errorString().isEmpty());
+	// All the chunks except the last one are read.
+	ASSERT_GT(pointsCount, 80);
+
+	QByteArray text = "[\n]\n";
+	QBuffer textBinary(&text);
+	textBinary.open(QIODevice::ReadOnly);
+	TrajectoryReader textReader(textBinary);
+	ASSERT_FALSE(textReader.read(countPoints, ignoreStates));
+	ASSERT_FALSE(textReader.errorString().isEmpty());
+}
@@ -18,15 +18,21 @@ include(../../../common.pri)
 
 include(../../../../../plugins/robots/utils/utils.pri)
 
-links(qslog test-utils)
+links(qslog test-utils tcp-robot-simulator)
 
 includes(plugins/robots/utils)
 
+INCLUDEPATH += $$PWD/../tcpRobotSimulator/include
+
 # Tests
 HEADERS += \
 	$$PWD/circularQueueTest.h \
 	$$PWD/robotCommunicationTests/runProgramProtocolTest.h \
+	$$PWD/robotCommunicationTests/telemetryTest.h \
+	$$PWD/trajectoryTests/trajectoryTest.h \
 
 SOURCES += \
 	$$PWD/circularQueueTest.cpp \
 	$$PWD/robotCommunicationTests/runProgramProtocolTest.cpp \
+	$$PWD/robotCommunicationTests/telemetryTest.cpp \
+	$$PWD/trajectoryTests/trajectoryTest.cpp \
@@ -0,0 +1,105 @@
+/* Copyright 2016 Dmitry Mordvinov
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <QtCore/QSet>
+
+#include <qrgraph/queries.h>
+#include <qrgraph/snapshot.h>
+#include "multigraphTest.h"
+
+using namespace qrTest;
+using namespace qrgraph;
+
+static QSet<const Node *> toSet(const QList<const Node *> &nodes)
+{
+	return QSet<const Node *>::fromList(nodes);
+}
+
+static void checkSameAsQueries(const Multigraph &graph, const Snapshot &snapshot)
+{
+	for (const uint type : {0, 1}) {
+		for (const Node *from : graph.vertices()) {
+			ASSERT_EQ(Queries::immediateFollowers(*from, type).count()
+					, snapshot.immediateFollowers(*from, type).count());
+			ASSERT_EQ(toSet(Queries::immediateFollowers(*from, type))
+					, toSet(snapshot.immediateFollowers(*from, type)));
+			ASSERT_EQ(Queries::immediatePredecessors(*from, type).count()
+					, snapshot.immediatePredecessors(*from, type).count());
+			ASSERT_EQ(toSet(Queries::immediatePredecessors(*from, type))
+					, toSet(snapshot.immediatePredecessors(*from, type)));
+			ASSERT_EQ(toSet(Queries::reachableSet(*from, type)), toSet(snapshot.reachableSet(*from, type)));
+			for (const Node *to : graph.vertices()) {
+				ASSERT_EQ(Queries::isReachable(*from, *to, type), snapshot.isReachable(*from, *to, type));
+			}
+		}
+	}
+}
+
+TEST(SnapshotTest, sameAsQueriesTest)
+{
+	Multigraph graph;
+	MultigraphTest::setUpCase1(graph);
+
+	checkSameAsQueries(graph, Snapshot(graph));
+	checkSameAsQueries(graph, Snapshot(graph, {0}));
+	checkSameAsQueries(graph, Snapshot(graph, {0, 1}));
+
+	MultigraphTest::setUpCase2(graph);
+	checkSameAsQueries(graph, Snapshot(graph));
+	checkSameAsQueries(graph, Snapshot(graph, {0, 1}));
+}
+
+TEST(SnapshotTest, indicesTest)
+{
+	Multigraph graph;
+	MultigraphTest::setUpCase1(graph);
+	const Snapshot snapshot(graph, {1});
+
+	ASSERT_EQ(snapshot.verticesCount(), 5);
+	for (int i = 0; i < graph.verticesCount(); ++i) {
+		ASSERT_EQ(snapshot.indexOf(*graph.vertices()[i]), i);
+		ASSERT_EQ(&snapshot.node(i), graph.vertices()[i]);
+	}
+
+	const Node &nodeA = *graph.vertices()[0];
+	const Node &nodeD = *graph.vertices()[3];
+	const Node &nodeE = *graph.vertices()[4];
+	ASSERT_TRUE(snapshot.isReachable(nodeA, nodeE, 1));
+	ASSERT_FALSE(snapshot.isReachable(nodeA, nodeD, 1));
+	ASSERT_FALSE(snapshot.isReachable(nodeE, nodeA, 1));
+}
+
+TEST(SnapshotTest, revisionTest)
+{
+	Multigraph graph;
+	MultigraphTest::setUpCase1(graph);
+	const Snapshot snapshot(graph, {0});
+	ASSERT_EQ(snapshot.revision(), graph.revision());
+
+	Node &nodeA = *graph.vertices()[0];
+	Node &nodeE = *graph.vertices()[4];
+	ASSERT_FALSE(snapshot.isReachable(nodeE, nodeA, 0));
+
+	Edge &edge = graph.produceEdge(0);
+	ASSERT_NE(snapshot.revision(), graph.revision());
+	edge.connect(nodeE, nodeA);
+	ASSERT_TRUE(Snapshot(graph, {0}).isReachable(nodeE, nodeA, 0));
+
+	// Nodes added after snapshot was made are still answered correctly.
+	Node &nodeF = graph.produceNode();
+	graph.produceEdge(nodeE, nodeF, 0);
+	ASSERT_EQ(snapshot.indexOf(nodeF), -1);
+	ASSERT_TRUE(snapshot.isReachable(nodeF, nodeF, 0));
+	ASSERT_EQ(snapshot.immediateFollowers(nodeF, 0).count(), 0);
+}
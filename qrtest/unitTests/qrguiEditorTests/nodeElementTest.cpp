@@ -0,0 +1,109 @@
+/* Copyright 2007-2016 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "nodeElementTest.h"
+
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
+#include <QtWidgets/QStyleOptionGraphicsItem>
+#include <QtXml/QDomDocument>
+
+#include <metaMetaModel/nodeElementType.h>
+
+using namespace qrguiTests;
+using namespace qReal;
+using namespace qReal::gui::editor;
+
+const Id diagram("TestEditor", "TestEditor");
+const Id nodeType("TestEditor", "TestEditor", "Node");
+
+const QString otherShape =
+		"<picture sizex=\"50\" sizey=\"50\">\n"
+		"    <rectangle x1=\"0\" y1=\"0\" x2=\"50\" y2=\"50\" fill=\"#ff0000\" fill-style=\"solid\"/>\n"
+		"</picture>\n";
+
+void NodeElementTest::SetUp()
+{
+	ASSERT_TRUE(mPluginsDirectory.isValid());
+	mEditorManager.reset(new EditorManager(mPluginsDirectory.path()));
+	mEditorManager->createEditorAndDiagram(diagram.editor());
+	mEditorManager->addNodeElement(diagram, nodeType.element(), nodeType.element(), false);
+	mModels.reset(new models::Models(QString(), *mEditorManager));
+
+	const NodeElementType &type = dynamic_cast<const NodeElementType &>(mEditorManager->elementType(nodeType));
+	mNode.reset(new NodeElement(type, createElement(), *mModels));
+}
+
+Id NodeElementTest::createElement()
+{
+	return mModels->graphicalModelAssistApi().createElement(Id::rootId(), Id::createElementId(
+			nodeType.editor(), nodeType.diagram(), nodeType.element()), false, "node", QPointF());
+}
+
+void NodeElementTest::paint()
+{
+	QImage image(200, 200, QImage::Format_ARGB32_Premultiplied);
+	image.fill(Qt::transparent);
+	QPainter painter(&image);
+	painter.translate(100, 100);
+	const QStyleOptionGraphicsItem option;
+	mNode->paint(&painter, &option, nullptr);
+}
+
+TEST_F(NodeElementTest, shapeCacheReuseTest)
+{
+	EXPECT_FALSE(mNode->isShapeCached());
+	paint();
+	EXPECT_TRUE(mNode->isShapeCached());
+	paint();
+	EXPECT_TRUE(mNode->isShapeCached());
+}
+
+TEST_F(NodeElementTest, invalidationOnUpdateDataTest)
+{
+	paint();
+	ASSERT_TRUE(mNode->isShapeCached());
+
+	// Shape may show properties conditionally, so it must be drawn again when they change.
+	mNode->updateData();
+	EXPECT_FALSE(mNode->isShapeCached());
+}
+
+TEST_F(NodeElementTest, invalidationOnUpdateShapeTest)
+{
+	paint();
+	ASSERT_TRUE(mNode->isShapeCached());
+
+	QDomDocument shape;
+	shape.setContent(otherShape);
+	mNode->updateShape(shape.documentElement());
+	EXPECT_FALSE(mNode->isShapeCached());
+}
+
+TEST_F(NodeElementTest, invalidationOnDynamicPropertiesChangeTest)
+{
+	// Shape of an element may be defined by the diagram it is exploded to.
+	const Id target = mModels->graphicalModelAssistApi().logicalId(createElement());
+	mModels->mutableLogicalRepoApi().addExplosion(mNode->logicalId(), target);
+
+	paint();
+	ASSERT_TRUE(mNode->isShapeCached());
+
+	mNode->updateDynamicProperties(target);
+	EXPECT_TRUE(mNode->isShapeCached());
+
+	mModels->mutableLogicalRepoApi().setProperty(target, "shape", otherShape);
+	mNode->updateDynamicProperties(target);
+	EXPECT_FALSE(mNode->isShapeCached());
+}
@@ -0,0 +1,45 @@
+/* Copyright 2007-2016 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QScopedPointer>
+#include <QtCore/QTemporaryDir>
+
+#include <gtest/gtest.h>
+#include <qrgui/editor/nodeElement.h>
+#include <qrgui/models/models.h>
+#include <qrgui/plugins/pluginManager/editorManager.h>
+
+namespace qrguiTests {
+
+/// Tests for NodeElement on an element of a metamodel created in memory, no editor plugins are loaded.
+class NodeElementTest : public testing::Test
+{
+protected:
+	void SetUp() override;
+
+	/// Creates one more element of the test type, returns its graphical id.
+	qReal::Id createElement();
+
+	/// Paints the node as a scene without zoom does it, so its shape gets cached.
+	void paint();
+
+	QTemporaryDir mPluginsDirectory;
+	QScopedPointer<qReal::EditorManager> mEditorManager;
+	QScopedPointer<qReal::models::Models> mModels;
+	QScopedPointer<qReal::gui::editor::NodeElement> mNode;
+};
+
+}
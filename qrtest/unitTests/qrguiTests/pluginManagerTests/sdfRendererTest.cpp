@@ -0,0 +1,238 @@
+/* Copyright 2007-2016 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "sdfRendererTest.h"
+
+#include <QtXml/QDomDocument>
+
+#include <plugins/pluginManager/sdfRenderer.h>
+
+#include "support/legacySdfRenderer.h"
+
+using namespace qrguiTests;
+using namespace qReal;
+
+namespace {
+
+template<typename Renderer>
+QImage renderBy(const QString &sdf, const QRectF &bounds, const QSize &imageSize
+		, ElementRepoInterface *element, bool needScale, bool isIcon)
+{
+	QDomDocument document;
+	document.setContent(sdf);
+	Renderer renderer;
+	renderer.load(document);
+	renderer.setElementRepo(element);
+	if (!needScale) {
+		renderer.noScale();
+	}
+
+	QImage image(imageSize, QImage::Format_ARGB32_Premultiplied);
+	image.fill(Qt::white);
+	{
+		QPainter painter(&image);
+		painter.setRenderHint(QPainter::Antialiasing, isIcon);
+		// Renderers keep pen, brush and font between renders, so the picture is rendered twice to check that too.
+		renderer.render(&painter, bounds, isIcon);
+		renderer.render(&painter, bounds.translated(bounds.width() / 2, bounds.height() / 2), isIcon);
+	}
+
+	return image;
+}
+
+const QString shapes =
+		"<picture sizex=\"100\" sizey=\"80\">"
+		"	<background fill=\"#f0f0f0\"/>"
+		"	<line x1=\"0\" y1=\"0\" x2=\"100%\" y2=\"80\" stroke=\"#ff0000\" stroke-width=\"3\""
+		"			stroke-style=\"dash\"/>"
+		"	<line x1=\"10a\" y1=\"70a\" x2=\"90\" y2=\"10%\" stroke-style=\"dashdotdot\"/>"
+		"	<ellipse x1=\"20\" y1=\"20\" x2=\"60\" y2=\"50\" fill=\"#00ff00\" stroke=\"blue\" stroke-width=\"2\"/>"
+		"	<arc x1=\"5%\" y1=\"5%\" x2=\"95%\" y2=\"95%\" startAngle=\"480\" spanAngle=\"2400\""
+		"			stroke-style=\"dot\"/>"
+		"	<rectangle x1=\"50\" y1=\"10\" x2=\"90a\" y2=\"40a\" fill=\"#0000ff\" fill-style=\"none\""
+		"			stroke-style=\"dashdot\"/>"
+		"	<rectangle x1=\"30%\" y1=\"60\" x2=\"70%\" y2=\"75\" fill=\"#ffff00\" stroke-style=\"none\"/>"
+		"	<point x1=\"50\" y1=\"40\" stroke=\"#000000\" stroke-width=\"5\"/>"
+		"	<polygon n=\"4\" x1=\"10\" y1=\"40\" x2=\"25%\" y2=\"30\" x3=\"40a\" y3=\"45a\" x4=\"20\" y4=\"90%\""
+		"			fill=\"#ff00ff\" stroke=\"#008080\"/>"
+		"</picture>";
+
+const QString texts =
+		"<picture sizex=\"120\" sizey=\"60\">"
+		"	<text x1=\"5\" y1=\"15\" font-size=\"12\" font-fill=\"#800000\" b=\"1\">Scaled</text>"
+		"	<text x1=\"5%\" y1=\"50%\" font-size=\"20%\" i=\"1\" u=\"1\">Two\nlines</text>"
+		"	<text x1=\"60a\" y1=\"55a\" font-size=\"10a\" font-name=\"Arial\" b=\"0\" i=\"0\" u=\"0\">Absolute</text>"
+		"	<text x1=\"70\" y1=\"20\" stroke-style=\"none\">\nSame style\n</text>"
+		"</picture>";
+
+const QString paths =
+		"<picture sizex=\"50\" sizey=\"40\">"
+		"	<path d=\" M 15 15 L 5 15 C 5 20.5 9.5 25 15 25\" stroke=\"#000080\" stroke-width=\"2\"/>"
+		"	<path d=\" M 20 5 L 45 5 45 35 L 20 35 C 30 30 30 10 20 5\" fill=\"#c0c0c0\" stroke-style=\"dash\"/>"
+		"	<curve stroke=\"#008000\" stroke-width=\"2\">"
+		"		<start startx=\"0\" starty=\"40\"/>"
+		"		<ctrl x=\"25\" y=\"0\"/>"
+		"		<end endx=\"50\" endy=\"40\"/>"
+		"	</curve>"
+		"	<stylus>"
+		"		<line x1=\"0\" y1=\"20\" x2=\"10\" y2=\"30\" stroke=\"#ff0000\" stroke-width=\"3\"/>"
+		"		<line x1=\"10\" y1=\"30\" x2=\"20a\" y2=\"10a\" stroke-style=\"dot\"/>"
+		"		<line x1=\"20a\" y1=\"10a\" x2=\"50%\" y2=\"100%\"/>"
+		"	</stylus>"
+		"</picture>";
+
+const QString conditions =
+		"<picture sizex=\"100\" sizey=\"100\">"
+		"	<rectangle x1=\"0\" y1=\"0\" x2=\"20\" y2=\"20\" fill=\"#ff0000\">"
+		"		<showIf sign=\"=\" property=\"kind\" value=\"sensor\"/>"
+		"	</rectangle>"
+		"	<ellipse x1=\"20\" y1=\"0\" x2=\"40\" y2=\"20\" fill=\"#00ff00\">"
+		"		<showIf sign=\"!=\" property=\"kind\" value=\"sensor\"/>"
+		"	</ellipse>"
+		"	<rectangle x1=\"40\" y1=\"0\" x2=\"60\" y2=\"20\" fill=\"#0000ff\">"
+		"		<showIf sign=\"=~\" property=\"kind\" value=\"sen.*\"/>"
+		"	</rectangle>"
+		"	<rectangle x1=\"60\" y1=\"0\" x2=\"80\" y2=\"20\" fill=\"#ffff00\">"
+		"		<showIf sign=\"=~\" property=\"kind\" value=\"motor|button\"/>"
+		"	</rectangle>"
+		"	<line x1=\"0\" y1=\"30\" x2=\"100\" y2=\"30\" stroke-width=\"4\">"
+		"		<showIf sign=\"&gt;\" property=\"port\" value=\"2\"/>"
+		"	</line>"
+		"	<line x1=\"0\" y1=\"40\" x2=\"100\" y2=\"40\" stroke-width=\"4\">"
+		"		<showIf sign=\"&lt;\" property=\"port\" value=\"3\"/>"
+		"	</line>"
+		"	<line x1=\"0\" y1=\"50\" x2=\"100\" y2=\"50\" stroke-width=\"4\">"
+		"		<showIf sign=\"&gt;=\" property=\"port\" value=\"3\"/>"
+		"	</line>"
+		"	<line x1=\"0\" y1=\"60\" x2=\"100\" y2=\"60\" stroke-width=\"4\">"
+		"		<showIf sign=\"&lt;=\" property=\"port\" value=\"2\"/>"
+		"	</line>"
+		"	<rectangle x1=\"0\" y1=\"70\" x2=\"50\" y2=\"100\" fill=\"#00ffff\">"
+		"		<showIf sign=\"=\" property=\"kind\" value=\"sensor\"/>"
+		"		<showIf sign=\"=\" property=\"port\" value=\"4\"/>"
+		"	</rectangle>"
+		"	<rectangle x1=\"50\" y1=\"70\" x2=\"100\" y2=\"100\" fill=\"#ff00ff\">"
+		"		<showIf sign=\"&lt;&gt;\" property=\"port\" value=\"4\"/>"
+		"	</rectangle>"
+		"	<stylus>"
+		"		<line x1=\"0\" y1=\"0\" x2=\"100\" y2=\"100\" stroke=\"#808080\" stroke-width=\"2\"/>"
+		"		<line x1=\"100\" y1=\"0\" x2=\"0\" y2=\"100\"/>"
+		"		<showIf sign=\"=\" property=\"port\" value=\"3\"/>"
+		"	</stylus>"
+		"	<text x1=\"40\" y1=\"90\" font-size=\"15\">Always</text>"
+		"</picture>";
+
+}
+
+QString SdfRendererTest::Element::logicalProperty(const QString &roleName) const
+{
+	return properties.value(roleName);
+}
+
+Id SdfRendererTest::Element::id() const
+{
+	return Id();
+}
+
+QString SdfRendererTest::Element::name() const
+{
+	return QString();
+}
+
+void SdfRendererTest::expectSameRendering(const QString &sdf, const QRectF &bounds, const QSize &imageSize
+		, ElementRepoInterface *element, bool isIcon)
+{
+	for (const bool needScale : { true, false }) {
+		const QImage expected = renderBy<LegacySdfRenderer>(sdf, bounds, imageSize, element, needScale, isIcon);
+		const QImage actual = renderBy<SdfRenderer>(sdf, bounds, imageSize, element, needScale, isIcon);
+		EXPECT_TRUE(expected == actual) << "Rendering differs in bounds " << bounds.x() << " " << bounds.y()
+				<< " " << bounds.width() << " " << bounds.height() << (needScale ? "" : " without scaling");
+	}
+}
+
+void SdfRendererTest::expectSameRenderingInAllBounds(const QString &sdf, ElementRepoInterface *element)
+{
+	const QSize imageSize(300, 300);
+	QDomDocument document;
+	ASSERT_TRUE(document.setContent(sdf));
+	const QDomElement picture = document.documentElement();
+	const qreal width = picture.attribute("sizex").toDouble();
+	const qreal height = picture.attribute("sizey").toDouble();
+
+	expectSameRendering(sdf, QRectF(0, 0, width, height), imageSize, element);
+	expectSameRendering(sdf, QRectF(10, 20, width * 2.5, height * 1.5), imageSize, element);
+	expectSameRendering(sdf, QRectF(3, 7, width * 0.37, height * 0.61), imageSize, element);
+	expectSameRendering(sdf, QRectF(0, 0, 16, 16), imageSize, element, true);
+}
+
+QImage SdfRendererTest::render(const QString &sdf, const QRectF &bounds, const QSize &imageSize
+		, ElementRepoInterface *element)
+{
+	return renderBy<SdfRenderer>(sdf, bounds, imageSize, element, true, false);
+}
+
+TEST_F(SdfRendererTest, shapesAndStyles)
+{
+	expectSameRenderingInAllBounds(shapes);
+}
+
+TEST_F(SdfRendererTest, texts)
+{
+	expectSameRenderingInAllBounds(texts);
+}
+
+TEST_F(SdfRendererTest, pathsCurvesAndStylus)
+{
+	expectSameRenderingInAllBounds(paths);
+}
+
+TEST_F(SdfRendererTest, conditions)
+{
+	Element element;
+	element.properties["kind"] = "sensor";
+	element.properties["port"] = "3";
+	expectSameRenderingInAllBounds(conditions, &element);
+
+	element.properties["kind"] = "motor";
+	element.properties["port"] = "2";
+	expectSameRenderingInAllBounds(conditions, &element);
+
+	expectSameRenderingInAllBounds(conditions);
+}
+
+TEST_F(SdfRendererTest, conditionsAreChecked)
+{
+	const QRectF bounds(0, 0, 100, 100);
+	const QSize imageSize(100, 100);
+	Element sensor;
+	sensor.properties["kind"] = "sensor";
+	Element motor;
+	motor.properties["kind"] = "motor";
+
+	EXPECT_FALSE(render(conditions, bounds, imageSize, &sensor) == render(conditions, bounds, imageSize, &motor));
+	EXPECT_TRUE(render(conditions, bounds, imageSize, &sensor).pixel(10, 10) == qRgb(255, 0, 0));
+	EXPECT_TRUE(render(conditions, bounds, imageSize, &motor).pixel(10, 10) == qRgb(255, 255, 255));
+}
+
+TEST_F(SdfRendererTest, scaling)
+{
+	const QString sdf =
+			"<picture sizex=\"10\" sizey=\"10\">"
+			"	<rectangle x1=\"2\" y1=\"2\" x2=\"50a\" y2=\"50a\" fill=\"#000000\" stroke-style=\"none\"/>"
+			"</picture>";
+
+	const QImage image = render(sdf, QRectF(0, 0, 100, 100), QSize(100, 100), nullptr);
+	EXPECT_TRUE(image.pixel(30, 30) == qRgb(0, 0, 0));
+	EXPECT_TRUE(image.pixel(60, 60) == qRgb(255, 255, 255));
+}
@@ -0,0 +1,54 @@
+/* Copyright 2007-2016 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QMap>
+#include <QtGui/QImage>
+
+#include <gtest/gtest.h>
+#include <metaMetaModel/elementRepoInterface.h>
+
+namespace qrguiTests {
+
+/// Tests for SdfRenderer, compares pictures rendered by it with the ones rendered by LegacySdfRenderer.
+class SdfRendererTest : public testing::Test
+{
+protected:
+	/// Element whose logical properties are checked by "showIf" conditions of pictures.
+	class Element : public qReal::ElementRepoInterface
+	{
+	public:
+		QString logicalProperty(const QString &roleName) const override;
+		qReal::Id id() const override;
+		QString name() const override;
+
+		QMap<QString, QString> properties;
+	};
+
+	/// Renders @a sdf by both renderers with and without scaling into the given @a bounds of the image of
+	/// @a imageSize and checks that results are the same.
+	/// @param element - element for checking conditions, renderers check no conditions if it is nullptr.
+	void expectSameRendering(const QString &sdf, const QRectF &bounds, const QSize &imageSize
+			, qReal::ElementRepoInterface *element = nullptr, bool isIcon = false);
+
+	/// Checks that both renderers give the same results for @a sdf in bounds of different sizes and positions.
+	void expectSameRenderingInAllBounds(const QString &sdf, qReal::ElementRepoInterface *element = nullptr);
+
+	/// Renders @a sdf into @a bounds of the image of @a imageSize by the current renderer.
+	static QImage render(const QString &sdf, const QRectF &bounds, const QSize &imageSize
+			, qReal::ElementRepoInterface *element);
+};
+
+}
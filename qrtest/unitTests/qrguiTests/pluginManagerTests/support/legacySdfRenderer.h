@@ -0,0 +1,96 @@
+/* Copyright 2007-2016 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtXml/QDomDocument>
+#include <QtGui/QPainter>
+#include <QtGui/QFont>
+
+namespace qReal {
+class ElementRepoInterface;
+}
+
+namespace qrguiTests {
+
+/// SdfRenderer as it was before SDF pictures were compiled into display lists, interpreting DOM of a picture
+/// on each render. Serves as a reference for the current renderer in tests, so shall not be changed.
+class LegacySdfRenderer
+{
+public:
+	LegacySdfRenderer();
+
+	bool load(const QDomDocument &document);
+	bool load(const QDomElement &picture);
+	void render(QPainter *painter, const QRectF &bounds, bool isIcon = false);
+	void noScale();
+
+	int pictureWidth() { return first_size_x; }
+	int pictureHeight() { return first_size_y; }
+
+	void setElementRepo(qReal::ElementRepoInterface *elementRepo);
+
+private:
+	int first_size_x;
+	int first_size_y;
+	int current_size_x;
+	int current_size_y;
+	int mStartX;
+	int mStartY;
+	int i;
+	int j;
+	QPainter *painter;
+	QPen pen;
+	QBrush brush;
+	QString s1;
+	QFont font;
+	QDomDocument doc;
+
+	/** @brief is false if we don't need to scale according to absolute
+	 * coords, is useful for rendering icons. default is true
+	**/
+	bool mNeedScale;
+	qreal mZoom = 1.0;
+	qReal::ElementRepoInterface *mElementRepo;
+
+	bool checkShowConditions(const QDomElement &element, bool isIcon) const;
+	bool checkCondition(const QDomElement &condition) const;
+
+	void line(QDomElement &element);
+	void ellipse(QDomElement &element);
+	void arc(QDomElement &element);
+	void parsestyle(QDomElement &element);
+	void background(QDomElement &element);
+	void draw_text(QDomElement &element);
+	void rectangle(QDomElement &element);
+	void polygon(QDomElement &element);
+	QPoint *getpoints(QDomElement &element, int n);
+	void point (QDomElement &element);
+	void defaultstyle();
+	void path_draw(QDomElement &element);
+	void stylus_draw(QDomElement &element);
+	void curve_draw(QDomElement &element);
+	void image_draw(QDomElement &element);
+	float x1_def(QDomElement &element);
+	float y1_def(QDomElement &element);
+	float x2_def(QDomElement &element);
+	float y2_def(QDomElement &element);
+	float coord_def(QDomElement &element, QString coordName, int current_size, int first_size);
+
+	/// checks that str[i] is not L, C, M or Z
+	/// @todo Not so helpful comment
+	bool isNotLCMZ(QString str, int i);
+};
+
+}
@@ -27,4 +27,6 @@ INCLUDEPATH += \
 
 include(modelsTests/modelsTests.pri)
 
+include(pluginManagerTests/pluginManagerTests.pri)
+
 include(helpers/helpers.pri)
@@ -162,3 +162,28 @@ TEST(IdsTest, idInputOutputStreamTest) {
 
 	EXPECT_EQ(in, out);
 }
+
+TEST(IdsTest, uuidIdsTest) {
+	const Id id = Id::createElementId("editor", "diagram", "element");
+	const Id loaded = Id::loadFromString(id.toString());
+	EXPECT_EQ(loaded, id);
+	EXPECT_EQ(qHash(loaded), qHash(id));
+	EXPECT_EQ(loaded.id(), id.id());
+	EXPECT_EQ(loaded.toString(), id.toString());
+
+	const Id sameType = id.sameTypeId();
+	EXPECT_NE(sameType, id);
+	EXPECT_EQ(sameType.type(), id.type());
+
+	// Ordering of ids must be the same as ordering of their string representations.
+	for (int i = 0; i < 100; ++i) {
+		const Id first = id.sameTypeId();
+		const Id second = id.sameTypeId();
+		EXPECT_EQ(first < second, first.id() < second.id());
+	}
+
+	const Id withStringPart("editor", "diagram", "element", "{not-a-uuid}");
+	EXPECT_EQ(withStringPart.id(), "{not-a-uuid}");
+	EXPECT_EQ(Id::loadFromString(withStringPart.toString()), withStringPart);
+	EXPECT_EQ(withStringPart < id, withStringPart.id() < id.id());
+}
@@ -227,6 +227,28 @@ TEST_F(RepositoryTest, elementsByPropertyContentTest) {
 	EXPECT_TRUE(list.contains(root));
 }
 
+TEST_F(RepositoryTest, searchIndexUpdateTest) {
+	mRepository->setProperty(child2, "name", "renamed");
+	EXPECT_TRUE(mRepository->findElementsByName("child2", false, false).contains(child2_child));
+	EXPECT_EQ(mRepository->elementsByPropertyContent("renamed", false, false), IdList() << child2);
+
+	mRepository->setProperty(child2, "property4", "brandNewValue");
+	EXPECT_EQ(mRepository->elementsByProperty("property4", false, false), IdList() << child2);
+	EXPECT_EQ(mRepository->elementsByPropertyContent("newval", false, false), IdList() << child2);
+
+	mRepository->removeProperty(child2, "property4");
+	EXPECT_TRUE(mRepository->elementsByProperty("property4", false, false).isEmpty());
+	EXPECT_TRUE(mRepository->elementsByPropertyContent("newval", false, false).isEmpty());
+
+	mRepository->replaceProperties(IdList() << root, "value", "replacedValue");
+	EXPECT_EQ(mRepository->elementsByPropertyContent("replaced", false, false), IdList() << root);
+
+	mRepository->removeChild(child3, child3_child);
+	mRepository->remove(child3_child);
+	EXPECT_TRUE(mRepository->elementsByPropertyContent("value2", false, false).isEmpty());
+	EXPECT_FALSE(mRepository->elementsByPropertyContent("child3_child", false, false).contains(child3_child));
+}
+
 TEST_F(RepositoryTest, parentOperationsTest) {
 	EXPECT_EQ(mRepository->parent(child1), root);
 	EXPECT_EQ(mRepository->parent(child2), root);
@@ -17,10 +17,16 @@
 #include <QtCore/QFile>
 #include <QtCore/QDir>
 #include <QtCore/QPointF>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtXml/QDomDocument>
 
 #include <qrrepo/private/classes/logicalObject.h>
 #include <qrrepo/private/classes/graphicalObject.h>
+#include <qrrepo/private/folderCompressor.h>
+#include <qrrepo/private/projectContainer.h>
 #include <qrkernel/settingsManager.h>
+#include <qrkernel/exception/exception.h>
 
 using namespace qrRepo;
 using namespace details;
@@ -95,6 +101,94 @@ TEST_F(SerializerTest, saveAndLoadFromDiskTest)
 	ASSERT_EQ(metaInfo["key2"], 2);
 }
 
+TEST_F(SerializerTest, containerRandomAccessTest)
+{
+	const Id id1("editor1", "diagram1", "element1", "id1");
+	LogicalObject obj1(id1);
+	obj1.setProperty("property1", "value1");
+
+	const Id id2("editor1", "diagram2", "element2", "id2");
+	LogicalObject obj2(id2);
+	obj2.setProperty("property2", "value2");
+
+	QList<Object *> list;
+	list.push_back(&obj1);
+	list.push_back(&obj2);
+
+	ASSERT_TRUE(mSerializer->saveToDisk(list, QHash<QString, QVariant>()));
+	ASSERT_TRUE(ProjectContainer::isContainer("saveFile.qrs"));
+
+	const ProjectContainer container("saveFile.qrs");
+	EXPECT_TRUE(container.contains("/tree/logical/editor1/diagram1/element1/id1"));
+	EXPECT_TRUE(container.contains("/metaInfo.xml"));
+
+	const QByteArray data = container.read("/tree/logical/editor1/diagram2/element2/id2");
+	EXPECT_TRUE(data.contains("value2"));
+	EXPECT_FALSE(data.contains("value1"));
+
+	EXPECT_FALSE(QDir(mSerializer->workingDirectory() + "/tree").exists());
+}
+
+TEST_F(SerializerTest, incrementalSaveTest)
+{
+	const Id id1("editor1", "diagram1", "element1", "id1");
+	LogicalObject obj1(id1);
+	obj1.setProperty("property1", "value1");
+
+	const Id id2("editor1", "diagram2", "element2", "id2");
+	LogicalObject obj2(id2);
+	obj2.setProperty("property2", "value2");
+
+	const Id id3("editor1", "diagram2", "element2", "id3");
+	LogicalObject obj3(id3);
+
+	ASSERT_TRUE(mSerializer->saveToDisk(QList<Object *>() << &obj1 << &obj2 << &obj3, QHash<QString, QVariant>()));
+	EXPECT_EQ(mSerializer->lastSaveStatistics().objectsWritten, 3);
+	EXPECT_EQ(mSerializer->lastSaveStatistics().objectsReused, 0);
+
+	obj2.setProperty("property2", "newValue");
+	ASSERT_TRUE(mSerializer->saveToDisk(QList<Object *>() << &obj1 << &obj2, QHash<QString, QVariant>()));
+	EXPECT_EQ(mSerializer->lastSaveStatistics().objectsWritten, 1);
+	EXPECT_EQ(mSerializer->lastSaveStatistics().objectsReused, 1);
+
+	QHash<Id, Object *> map;
+	QHash<QString, QVariant> metaInfo;
+	mSerializer->setWorkingFile("saveFile.qrs");
+	mSerializer->loadFromDisk(map, metaInfo);
+
+	ASSERT_TRUE(map.contains(id1));
+	ASSERT_TRUE(map.contains(id2));
+	EXPECT_FALSE(map.contains(id3));
+	EXPECT_EQ(map.value(id1)->property("property1").toString(), "value1");
+	EXPECT_EQ(map.value(id2)->property("property2").toString(), "newValue");
+
+	ASSERT_TRUE(mSerializer->saveToDisk(map.values(), metaInfo));
+	EXPECT_EQ(mSerializer->lastSaveStatistics().objectsWritten, 0);
+	EXPECT_EQ(mSerializer->lastSaveStatistics().objectsReused, 2);
+	qDeleteAll(map);
+}
+
+TEST_F(SerializerTest, loadOldFormatTest)
+{
+	const Id id("editor1", "diagram1", "element1", "id1");
+	LogicalObject obj(id);
+	obj.setProperty("property1", "value1");
+
+	mSerializer->saveToDisk(QList<Object *>() << &obj, QHash<QString, QVariant>());
+	mSerializer->decompressFile("saveFile.qrs");
+	QFile::remove("saveFile.qrs");
+	FolderCompressor::compressFolder(mSerializer->workingDirectory(), "saveFile.qrs");
+	ASSERT_FALSE(ProjectContainer::isContainer("saveFile.qrs"));
+
+	QHash<Id, Object *> map;
+	QHash<QString, QVariant> metaInfo;
+	mSerializer->setWorkingFile("saveFile.qrs");
+	mSerializer->loadFromDisk(map, metaInfo);
+
+	ASSERT_TRUE(map.contains(id));
+	EXPECT_EQ(map.value(id)->property("property1").toString(), "value1");
+}
+
 // Decomment EXPECT_FALSE and delete EXPECT_TRUE(true) when removeFromDisk will be fixed. pathToElement(id) returns
 // path without parent folder /tree and /logical or /graphical according to id type.
 TEST_F(SerializerTest, removeFromDiskTest)
@@ -150,3 +244,83 @@ TEST_F(SerializerTest, saveAndLoadGraphicalPartsTest)
 
 	ASSERT_EQ(QPointF(10, 20), deserializedGraphicalObject->graphicalPartProperty(0, "Coord"));
 }
+
+TEST_F(SerializerTest, loadWithDifferentThreadCountsTest)
+{
+	QList<Object *> list;
+	for (int i = 0; i < 200; ++i) {
+		LogicalObject * const logicalObj = new LogicalObject(Id("editor", "diagram", "element", QString::number(i)));
+		logicalObj->setProperty("name", QString("element %1").arg(i));
+		GraphicalObject * const graphicalObj = new GraphicalObject(
+				Id("editor", "diagram", "element", QString("graphical%1").arg(i)), Id(), logicalObj->id());
+		graphicalObj->createGraphicalPart(0);
+		graphicalObj->setGraphicalPartProperty(0, "Coord", QPointF(i, -i));
+		list << logicalObj << graphicalObj;
+	}
+
+	ASSERT_TRUE(mSerializer->saveToDisk(list, QHash<QString, QVariant>()));
+	qDeleteAll(list);
+	mSerializer->setWorkingFile("saveFile.qrs");
+
+	const auto serialize = [](const Object *object) {
+		QDomDocument document;
+		document.appendChild(object->serialize(document));
+		return document.toByteArray();
+	};
+
+	const int maxThreadCount = QThreadPool::globalInstance()->maxThreadCount();
+	QHash<QString, QVariant> metaInfo;
+
+	QHash<Id, Object *> sequentialMap;
+	QThreadPool::globalInstance()->setMaxThreadCount(1);
+	mSerializer->loadFromDisk(sequentialMap, metaInfo);
+
+	QHash<Id, Object *> concurrentMap;
+	QThreadPool::globalInstance()->setMaxThreadCount(qMax(4, QThread::idealThreadCount()));
+	mSerializer->loadFromDisk(concurrentMap, metaInfo);
+
+	QThreadPool::globalInstance()->setMaxThreadCount(maxThreadCount);
+
+	ASSERT_EQ(400, sequentialMap.count());
+	ASSERT_EQ(sequentialMap.count(), concurrentMap.count());
+	for (const Id &id : sequentialMap.keys()) {
+		ASSERT_TRUE(concurrentMap.contains(id));
+		EXPECT_EQ(serialize(sequentialMap[id]), serialize(concurrentMap[id]));
+	}
+
+	qDeleteAll(sequentialMap);
+	qDeleteAll(concurrentMap);
+}
+
+TEST_F(SerializerTest, loadCorruptedContainerTest)
+{
+	QList<Object *> list;
+	for (int i = 0; i < 10; ++i) {
+		list << new LogicalObject(Id("editor", "diagram", "element", QString::number(i)));
+	}
+
+	ASSERT_TRUE(mSerializer->saveToDisk(list, QHash<QString, QVariant>()));
+	qDeleteAll(list);
+
+	{
+		// Rewriting the save file with one more entry that has no properties list, so it fails to load after
+		// all the correct objects are created.
+		const ProjectContainer container("saveFile.qrs");
+		ProjectContainerWriter writer("corrupted.qrs");
+		for (const QString &entry : container.entries()) {
+			writer.addRawEntry(entry, container.readRaw(entry));
+		}
+
+		writer.addEntry("/tree/logical/editor/diagram/element/corrupted"
+				, "<object id=\"qrm:/editor/diagram/element/corrupted\"/>");
+		writer.commit();
+	}
+
+	QHash<Id, Object *> map;
+	QHash<QString, QVariant> metaInfo;
+	mSerializer->setWorkingFile("corrupted.qrs");
+	EXPECT_THROW(mSerializer->loadFromDisk(map, metaInfo), Exception);
+	EXPECT_TRUE(map.isEmpty());
+
+	QFile::remove("corrupted.qrs");
+}
@@ -57,8 +57,8 @@ TEST_F(LuaInterpreterTest, intrinsicFunction)
 			{QSharedPointer<core::types::TypeExpression>(new types::Integer())}
 			)));
 
-	mInterpreter->addIntrinsicFunction("f", [](QList<QVariant> params) {
-			return params[0].toInt() * params[0].toInt();
+	mInterpreter->addIntrinsicFunction("f", [](const QVector<LuaValue> &params) {
+			return LuaValue(params[0].toInt() * params[0].toInt());
 			});
 
 	int result = interpret<int>("f(5)");
@@ -521,3 +521,49 @@ TEST_F(LuaInterpreterTest, negativOutOfRangeAssignment)
 	EXPECT_EQ(1, mErrors.size());
 	mErrors.clear();
 }
+
+TEST_F(LuaInterpreterTest, compiledProgramGivesSameResults)
+{
+	interpret<int>("a = 7; b = 2.5; s = 'str'");
+	const QStringList expressions = {
+		"1 + 2 * 3", "a * b - 1", "(a + 1) / (b - 2.5)", "a // 2", "a % 3", "-a", "2 ^ 10", "not a"
+		, "a & 3", "a | 8", "a ~ 5", "a << 2", "a >> 1", "s .. a", "#s", "a < b", "a >= 7", "a == 7"
+		, "a ~= 7", "a and b", "nil or a", "0x10 + 1.5", "a = a + 1; a"
+	};
+
+	for (const QString &expression : expressions) {
+		const auto ast = parseAndAnalyze(expression);
+		ASSERT_TRUE(mErrors.isEmpty()) << expression.toStdString();
+
+		const QVariant expected = mInterpreter->interpret(ast, *mAnalyzer).toVariant();
+		const int expectedErrors = mErrors.size();
+		mErrors.clear();
+
+		// Undoing side effects of the interpretation.
+		mInterpreter->setVariableValue("a", LuaValue(7));
+
+		const QVariant actual = mInterpreter->compile(ast, *mAnalyzer)().toVariant();
+		EXPECT_EQ(expected, actual) << expression.toStdString();
+		EXPECT_EQ(expected.type(), actual.type()) << expression.toStdString();
+		EXPECT_EQ(expectedErrors, mErrors.size()) << expression.toStdString();
+		mErrors.clear();
+		mInterpreter->setVariableValue("a", LuaValue(7));
+	}
+}
+
+TEST_F(LuaInterpreterTest, compiledProgramUsesCurrentState)
+{
+	interpret<int>("a = 1");
+	const auto program = mInterpreter->compile(parseAndAnalyze("a = a + 1; a"), *mAnalyzer);
+	EXPECT_EQ(2, program().toInt());
+	EXPECT_EQ(3, program().toInt());
+
+	mInterpreter->setVariableValue("a", LuaValue(10));
+	EXPECT_EQ(11, program().toInt());
+	EXPECT_EQ(11, interpret<int>("a"));
+
+	mInterpreter->addReadOnlyVariable("a");
+	program();
+	EXPECT_EQ(1, mErrors.size());
+	EXPECT_EQ(11, interpret<int>("a"));
+}
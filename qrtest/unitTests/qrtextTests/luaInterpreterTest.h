@@ -36,7 +36,7 @@ protected:
 	T interpret(const QString &code) {
 		auto const ast = parseAndAnalyze(code);
 		if (mErrors.isEmpty()) {
-			return mInterpreter->interpret(ast, *mAnalyzer).value<T>();
+			return mInterpreter->interpret(ast, *mAnalyzer).toVariant().value<T>();
 		} else {
 			return {};
 		}
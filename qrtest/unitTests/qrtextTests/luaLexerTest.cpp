@@ -14,12 +14,40 @@
 
 #include "luaLexerTest.h"
 
+#include <QtCore/QFile>
+
 #include "gtest/gtest.h"
 
 using namespace qrtext::lua::details;
 using namespace qrtext::core;
 using namespace qrTest;
 
+/// Tokenizes given code by hand-written scanner and by regexps and checks that results are the same.
+static void expectSameResults(const QString &code)
+{
+	QList<Error> scannerErrors;
+	QList<Error> regexpsErrors;
+	LuaLexer scanner(scannerErrors, LuaLexer::Matcher::scanner);
+	LuaLexer regexps(regexpsErrors, LuaLexer::Matcher::regexps);
+
+	const auto scannerTokens = scanner.tokenize(code) + scanner.comments();
+	const auto regexpsTokens = regexps.tokenize(code) + regexps.comments();
+
+	ASSERT_EQ(regexpsTokens.size(), scannerTokens.size()) << code.toStdString();
+	for (int i = 0; i < regexpsTokens.size(); ++i) {
+		EXPECT_EQ(regexpsTokens[i].token(), scannerTokens[i].token()) << code.toStdString();
+		EXPECT_EQ(regexpsTokens[i].lexeme(), scannerTokens[i].lexeme()) << code.toStdString();
+		EXPECT_EQ(regexpsTokens[i].range().start(), scannerTokens[i].range().start()) << code.toStdString();
+		EXPECT_EQ(regexpsTokens[i].range().end(), scannerTokens[i].range().end()) << code.toStdString();
+	}
+
+	ASSERT_EQ(regexpsErrors.size(), scannerErrors.size()) << code.toStdString();
+	for (int i = 0; i < regexpsErrors.size(); ++i) {
+		EXPECT_EQ(regexpsErrors[i].connection(), scannerErrors[i].connection()) << code.toStdString();
+		EXPECT_EQ(regexpsErrors[i].errorMessage(), scannerErrors[i].errorMessage()) << code.toStdString();
+	}
+}
+
 void LuaLexerTest::SetUp()
 {
 	mErrors.clear();
@@ -363,3 +391,43 @@ TEST_F(LuaLexerTest, comments)
 	EXPECT_EQ(Connection(57, 3, 0), comments[2].range().start());
 	EXPECT_EQ(Connection(58, 3, 1), comments[2].range().end());
 }
+
+TEST_F(LuaLexerTest, scannerGivesSameResultsAsRegexps)
+{
+	const QStringList codes = {
+		"a = 1 + 2 * 3 // 4 / 5 % 6 ^ 7 - #t"
+		, "a.b:c(d, ...) .. e; f[1] = {g = 2}; ::label::"
+		, "x = ~y & z | w << 1 >> 2 && u || v"
+		, "a == b ~= c != d <= e >= f < g > h"
+		, "3   345   0xff   0xBEBADA 0x 0xg 09 1. 1.. 1..2 1...2"
+		, "3.0 3.1416 314.16e-2 0.31416E1 34e1 1e 1e+ 1ea 1.5e+x 1.5f"
+		, "0x0.1E  0xA23p-4   0X1.921FB54442D18P+1 0x1p 0x1p+ 0x1.p1 0x.1 0x1e5 0x1P-f"
+		, "a = 'alo\\n123\"'\n   a = \"alo\\n123\\\"\"\n   a = '\\97lo\\10\\04923\"'"
+		, "a = 'multiline \\\n string' b = \"unterminated"
+		, "s = '' .. \"\" .. '\\'' .. 'tail\\"
+		, "a = 1 --ololo\n---- x\na = 'no -- comment in a string' end\n--"
+		, "if x then return true elseif not y and z or w then break else goto l end"
+		, "ололо русский\n язык abcабв абвabc _я я_1 1я"
+		, "a = 'строка' -- комментарий\n b = \"\\я\""
+		, "a = $ b @@ c\n d ? e ` f ! g"
+		, "a = 1\r\nb = 2\t\t; c = '\\\r' -- \r comment"
+		, "\t\n\n  \n"
+		, ""
+	};
+
+	for (const QString &code : codes) {
+		expectSameResults(code);
+	}
+}
+
+TEST_F(LuaLexerTest, examplesCodeTest)
+{
+	QFile file("unittests/luaExamplesCode.lua");
+	ASSERT_TRUE(file.open(QIODevice::ReadOnly | QIODevice::Text));
+	const QStringList snippets = QString::fromUtf8(file.readAll()).split("\n--8<--\n");
+	ASSERT_FALSE(snippets.isEmpty());
+
+	for (const QString &snippet : snippets) {
+		expectSameResults(snippet);
+	}
+}
@@ -64,6 +64,18 @@ TEST_F(LuaToolboxTest, intrinsicFunction)
 	EXPECT_EQ(3, result);
 }
 
+TEST_F(LuaToolboxTest, nativeFunction)
+{
+	mToolbox->addNativeFunction("f", new types::Float(), {new types::Float(), new types::Integer()}
+			, [] (const QVector<LuaValue> &params) { return LuaValue(params[0].toDouble() * params[1].toInt()); }
+			);
+
+	mToolbox->setVariableValue("x", 1.5);
+	const auto result = mToolbox->interpret<double>("f(x, 3)");
+	EXPECT_TRUE(mToolbox->errors().isEmpty());
+	EXPECT_DOUBLE_EQ(4.5, result);
+}
+
 TEST_F(LuaToolboxTest, intrinsicFunctionAsIdentifier)
 {
 	mToolbox->addIntrinsicFunction("f", new types::Integer(), {new types::Integer()}
@@ -177,3 +189,34 @@ TEST_F(LuaToolboxTest, twoFunctions)
 	mToolbox->interpret<int>("cos(1)");
 	ASSERT_TRUE(mToolbox->errors().isEmpty());
 }
+
+TEST_F(LuaToolboxTest, reanalysisOfUnchangedCode)
+{
+	const qReal::Id first = qReal::Id("1", "2", "3", "first");
+	const qReal::Id second = qReal::Id("1", "2", "3", "second");
+
+	// Code with errors is analyzed again and again until the error is fixed somewhere else.
+	mToolbox->interpret<int>(first, "test", "b = a + 1");
+	EXPECT_FALSE(mToolbox->errors().isEmpty());
+	mToolbox->interpret<int>(first, "test", "b = a + 1");
+	EXPECT_FALSE(mToolbox->errors().isEmpty());
+
+	mToolbox->interpret<int>(second, "test", "a = 2");
+	EXPECT_TRUE(mToolbox->errors().isEmpty());
+	mToolbox->interpret<int>(first, "test", "b = a + 1");
+	EXPECT_TRUE(mToolbox->errors().isEmpty());
+	EXPECT_EQ(3, mToolbox->interpret<int>("b"));
+
+	// Unchanged code is still interpreted correctly.
+	for (int i = 0; i < 3; ++i) {
+		mToolbox->interpret<int>(first, "test", "b = a + 1");
+		EXPECT_TRUE(mToolbox->errors().isEmpty());
+	}
+
+	// Type change of an identifier is seen by all code using it.
+	mToolbox->interpret<int>(second, "test", "a = 2.5");
+	EXPECT_TRUE(mToolbox->errors().isEmpty());
+	mToolbox->interpret<int>(first, "test", "b = a + 1");
+	EXPECT_TRUE(mToolbox->errors().isEmpty());
+	EXPECT_DOUBLE_EQ(3.5, mToolbox->interpret<double>("b"));
+}
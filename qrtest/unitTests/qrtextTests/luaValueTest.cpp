@@ -0,0 +1,66 @@
+/* Copyright 2007-2016 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include <QtCore/QStringList>
+
+#include <qrtext/lua/luaValue.h>
+
+#include "gtest/gtest.h"
+
+using namespace qrtext::lua;
+
+TEST(LuaValueTest, conversionsAreTheSameAsInQVariant)
+{
+	const QList<QVariant> variants = {
+		QVariant(), QVariant(true), QVariant(false), QVariant(0), QVariant(-7), QVariant(2.5), QVariant(-0.5)
+		, QVariant(QString()), QVariant(QString("")), QVariant(QString("0")), QVariant(QString("false"))
+		, QVariant(QString("12")), QVariant(QString("1.5")), QVariant(QString("abc"))
+	};
+
+	for (const QVariant &variant : variants) {
+		const LuaValue value = LuaValue::fromVariant(variant);
+		EXPECT_EQ(variant, value.toVariant());
+		EXPECT_EQ(variant.isNull(), value.isNull()) << variant.toString().toStdString();
+		EXPECT_EQ(variant.toBool(), value.toBool()) << variant.toString().toStdString();
+		EXPECT_EQ(variant.toInt(), value.toInt()) << variant.toString().toStdString();
+		EXPECT_EQ(variant.toDouble(), value.toDouble()) << variant.toString().toStdString();
+		EXPECT_EQ(variant.toString(), value.toString()) << variant.toString().toStdString();
+	}
+}
+
+TEST(LuaValueTest, tables)
+{
+	const LuaValue table = LuaValue::fromVariant(QVariantList{1, QVariantList{2.5, "a"}});
+	ASSERT_EQ(LuaValue::Type::table, table.type());
+	ASSERT_EQ(2, table.toTable().size());
+	EXPECT_EQ(1, table.toTable()[0].toInt());
+	EXPECT_EQ(QString("a"), table.toTable()[1].toTable()[1].toString());
+	EXPECT_EQ(QVariant(QVariantList{1, QVariantList{2.5, "a"}}), table.toVariant());
+
+	const LuaValue strings = LuaValue::fromVariant(QStringList{"1", "2"});
+	ASSERT_EQ(2, strings.toTable().size());
+	EXPECT_EQ(2, strings.toTable()[1].toInt());
+
+	EXPECT_TRUE(LuaValue(7).toTable().isEmpty());
+}
+
+TEST(LuaValueTest, comparison)
+{
+	EXPECT_EQ(LuaValue(), LuaValue());
+	EXPECT_EQ(LuaValue(2), LuaValue(2.0));
+	EXPECT_EQ(LuaValue(QString("asd")), LuaValue(QString("asd")));
+	EXPECT_NE(LuaValue(QString("asd")), LuaValue(QString("fgh")));
+	EXPECT_EQ(LuaValue(LuaValue::Table{LuaValue(1), LuaValue(2)}), LuaValue(LuaValue::Table{LuaValue(1), LuaValue(2)}));
+	EXPECT_NE(LuaValue(LuaValue::Table{LuaValue(1), LuaValue(2)}), LuaValue(LuaValue::Table{LuaValue(1), LuaValue(3)}));
+}
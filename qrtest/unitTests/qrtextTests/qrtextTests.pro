@@ -40,4 +40,6 @@ SOURCES += \
 	luaToolboxTest.cpp \
 	luaLexerTest.cpp \
 	luaStringEscapeUtilsTest.cpp \
+	luaValueTest.cpp \
 
+copyToDestdir($$PWD/support/testData/unittests, NOW)
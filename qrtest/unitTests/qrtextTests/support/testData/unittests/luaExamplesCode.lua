@@ -0,0 +1,1361 @@
+true
+--8<--
+sensor2
+--8<--
+1
+--8<--
+1
+--8<--
+300
+--8<--
+100
+--8<--
+true
+--8<--
+x[2]
+--8<--
+1
+--8<--
+30
+--8<--
+true
+--8<--
+x[0]
+--8<--
+1
+--8<--
+1
+--8<--
+true
+--8<--
+x[3]
+--8<--
+1
+--8<--
+45
+--8<--
+true
+--8<--
+x[1]
+--8<--
+1
+--8<--
+15
+--8<--
+true
+--8<--
+x[4]
+--8<--
+1
+--8<--
+60
+--8<--
+true
+--8<--
+x[5]
+--8<--
+1
+--8<--
+75
+--8<--
+1000
+--8<--
+20000
+--8<--
+{1,2,3,4,5,6}
+--8<--
+x
+--8<--
+sensor2
+--8<--
+x
+--8<--
+true
+--8<--
+x[2]
+--8<--
+1
+--8<--
+20
+--8<--
+true
+--8<--
+x[0]
+--8<--
+1
+--8<--
+1
+--8<--
+true
+--8<--
+x[3]
+--8<--
+1
+--8<--
+30
+--8<--
+true
+--8<--
+x[1]
+--8<--
+1
+--8<--
+10
+--8<--
+1000
+--8<--
+200
+--8<--
+{1,2,3,4,5,6}
+--8<--
+x
+--8<--
+sensor2
+--8<--
+x
+--8<--
+true
+--8<--
+x[2]
+--8<--
+1
+--8<--
+20
+--8<--
+true
+--8<--
+x[4]
+--8<--
+1
+--8<--
+40
+--8<--
+true
+--8<--
+x[0]
+--8<--
+1
+--8<--
+1
+--8<--
+true
+--8<--
+x[3]
+--8<--
+1
+--8<--
+30
+--8<--
+true
+--8<--
+x[1]
+--8<--
+1
+--8<--
+10
+--8<--
+1000
+--8<--
+200
+--8<--
+{1,2,3,4,5,6}
+--8<--
+x
+--8<--
+sensor2
+--8<--
+x
+--8<--
+true
+--8<--
+x[2]
+--8<--
+1
+--8<--
+20
+--8<--
+true
+--8<--
+x[0]
+--8<--
+1
+--8<--
+1
+--8<--
+true
+--8<--
+x[3]
+--8<--
+1
+--8<--
+30
+--8<--
+true
+--8<--
+x[1]
+--8<--
+1
+--8<--
+10
+--8<--
+1000
+--8<--
+200
+--8<--
+{1,2,3,4,5,6}
+--8<--
+x
+--8<--
+sensor2
+--8<--
+x
+--8<--
+70 - u
+--8<--
+70 + u
+--8<--
+errold = err;
+err = d - sensor1;
+u = kp * err + kd * (err - errold);
+--8<--
+d = sensor1;
+kp = 1.5;
+kd = -1.0;
+err = 0.0;
+--8<--
+50
+--8<--
+100
+--8<--
+50
+--8<--
+50
+--8<--
+false
+--8<--
+Place sensor on black area
+--8<--
+1
+--8<--
+1
+--8<--
+false
+--8<--
+Place sensor on white area
+--8<--
+1
+--8<--
+1
+--8<--
+5000
+--8<--
+1000
+--8<--
+pw
+--8<--
+pw
+--8<--
+5000
+--8<--
+pw
+--8<--
+pw
+--8<--
+5000
+--8<--
+1000
+--8<--
+100
+--8<--
+100
+--8<--
+2000
+--8<--
+u = k * (sensor1 - distance)
+--8<--
+50 - u
+--8<--
+50 + u
+--8<--
+10
+--8<--
+40
+--8<--
+distance
+--8<--
+1.5
+--8<--
+k
+--8<--
+u = k * (sensor1 - sensor2)
+--8<--
+50 + u
+--8<--
+50 - u
+--8<--
+10
+--8<--
+1.5
+--8<--
+k
+--8<--
+100
+--8<--
+100
+--8<--
+30000
+--8<--
+5000
+--8<--
+100
+--8<--
+40
+--8<--
+10000
+--8<--
+50
+--8<--
+100
+--8<--
+100
+--8<--
+1000
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+7
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+4
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+5
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+6
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+6
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+5
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+6
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+7
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+4
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+7
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+5
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+6
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+4
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+5
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+5
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+7
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+6
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+4
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+7
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+4
+--8<--
+0.0
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+-1
+--8<--
+-1
+--8<--
+1
+--8<--
+1
+--8<--
+1
+--8<--
+1
+--8<--
+1
+--8<--
+-1
+--8<--
+1
+--8<--
+-1
+--8<--
+1
+--8<--
+1
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+2
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+1
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1
+--8<--
+1.0
+--8<--
+1.0
+--8<--
+1.0
+--8<--
+2
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+3
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+1
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+0
+--8<--
+1.0
+--8<--
+1.0
+--8<--
+1.0
+--8<--
+1
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+1
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+3
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+3
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+0
+--8<--
+1.0
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+2
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+2
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+1
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+2
+--8<--
+1.0
+--8<--
+1.0
+--8<--
+1.0
+--8<--
+0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+1.0
+--8<--
+3
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+3
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+2
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+3
+--8<--
+0.0
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+1
+--8<--
+1
+--8<--
+1
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+3
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+3
+--8<--
+1.0
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+2
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+3
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+1
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+2
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+3
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+2
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+1
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+2
+--8<--
+1.0
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+1000
+--8<--
+true
+--8<--
+10
+--8<--
+0
+--8<--
+10
+--8<--
+10
+--8<--
+0
+--8<--
+10
+--8<--
+z == 10
+--8<--
+x
+--8<--
+y
+--8<--
+z
+--8<--
+true
+--8<--
+x > 0.5
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+1
+--8<--
+1.0
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+0
+--8<--
+0.0
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+0
+--8<--
+1.0
+--8<--
+0.0
+--8<--
+0.0
+--8<--
+2
+--8<--
+1.0
+--8<--
+x
+--8<--
+1000
+--8<--
+u=2.5*(S-sensorA1)+5*(Sold-sensorA1); Sold=sensorA1;
+--8<--
+S=sensorA1; Sold=S;
+--8<--
+100
+--8<--
+30
+--8<--
+50-u
+--8<--
+50+u
+--8<--
+u = k * (sensor1 - sensor2)
+--8<--
+left = sensorA1; right = sensorA2; k = 1.3
+--8<--
+u = k * ((sensorA1 - left) - (sensorA2 - right))
+--8<--
+50 + u
+--8<--
+50 - u
+--8<--
+30
+--8<--
+10
+--8<--
+50 + u
+--8<--
+50 - u
+--8<--
+1.5
+--8<--
+k
+--8<--
+k = 1
+--8<--
+false
+--8<--
+Press Enter
+--8<--
+40
+--8<--
+100
+--8<--
+false
+--8<--
+when ready
+--8<--
+40
+--8<--
+120
+--8<--
+30
+--8<--
+u
+--8<--
+50 + k * u
+--8<--
+50 - k * u
+--8<--
+2080
+--8<--
+1500
+--8<--
+3400
+--8<--
+50
+--8<--
+100
+--8<--
+100
+--8<--
+100
+--8<--
+true
+--8<--
+true
+--8<--
+true
+--8<--
+true
+--8<--
+true
+--8<--
+true
+--8<--
+true
+--8<--
+true
+--8<--
+true
+--8<--
+true
+--8<--
+true
+--8<--
+direction = {1, 0};
+directionAngle = 0;
+--8<--
+direction = {0, 1};
+directionAngle = 270;
+--8<--
+mouthOpened = 1 - mouthOpened
+--8<--
+direction = {-1, 0};
+directionAngle = 180;
+--8<--
+direction = {0, -1};
+directionAngle = 90;
+--8<--
+foodX = pacmanSize + random(width - 2 * pacmanSize);
+foodY = pacmanSize + random(height - 2 * pacmanSize);
+--8<--
+direction = {1, 0};
+directionAngle = 0;
+--8<--
+direction = {0, 1};
+directionAngle = 270;
+--8<--
+congratulations = {
+"Good job!",
+"Nice work!",
+"Eat me again!",
+"Good boy",
+"Wow!",
+"You are genius!",
+"Tasty!",
+"Feed me again!"
+};
+congratulationsCount = 8;
+--8<--
+score = score + 10;
+velocity = velocity + 1;
+--8<--
+x = gamepadPad2[0];
+y = gamepadPad2[1];
+--8<--
+pacmanX = pacmanX + direction[0] * velocity;
+pacmanY = pacmanY + direction[1] * velocity;
+--8<--
+direction = {-1, 0};
+directionAngle = 180;
+--8<--
+foodX = 0;
+foodY = 0;
+direction = {1, 0};
+directionAngle = 0;
+pacmanX = pacmanSize + 5;
+pacmanY = width // 2;
+score = 0;
+velocity = 2;
+mouthOpened = 1;
+--8<--
+width = 170;
+height = 170;
+pacmanSize = 20;
+foodSize = 6;
+delay = 100;
+topLeftX = 20;
+topLeftY = 50;
+--8<--
+direction = {0, -1};
+directionAngle = 90;
+--8<--
+x >= 0
+--8<--
+buttonRight > 0
+--8<--
+abs(y) >= abs(x) && y >= 0
+--8<--
+buttonUp > 0
+--8<--
+pacmanX + pacmanSize > width
+|| pacmanY + pacmanSize > height
+|| pacmanX - pacmanSize < 0
+|| pacmanY - pacmanSize < 0
+--8<--
+gamepadPad2Pressed > 0
+--8<--
+buttonDown > 0
+--8<--
+abs(y) >= abs(x) && y < 0
+--8<--
+x < 0
+--8<--
+(pacmanX - foodX) * (pacmanX - foodX) +
+(pacmanY - foodY) * (pacmanY - foodY)
+< pacmanSize * pacmanSize
+--8<--
+buttonLeft > 0
+--8<--
+true
+--8<--
+"Your score: " .. score
+--8<--
+40
+--8<--
+125
+--8<--
+true
+--8<--
+"Score: " .. score
+--8<--
+40
+--8<--
+15
+--8<--
+true
+--8<--
+"Game over!"
+--8<--
+50
+--8<--
+100
+--8<--
+5000
+--8<--
+delay
+--8<--
+pacmanSize * 2
+--8<--
+360 - mouthOpened * 60;
+--8<--
+directionAngle + mouthOpened * 30;
+--8<--
+pacmanSize * 2
+--8<--
+pacmanX + topLeftX - pacmanSize
+--8<--
+pacmanY + topLeftY - pacmanSize
+--8<--
+topLeftX + pacmanX
+--8<--
+topLeftX + pacmanX + pacmanSize * cos((360 + directionAngle - mouthOpened * 30) * pi / 180.0)
+--8<--
+topLeftY + pacmanY
+--8<--
+topLeftY + pacmanY - pacmanSize * sin((360 + directionAngle - mouthOpened * 30) * pi / 180.0)
+--8<--
+topLeftX + pacmanX
+--8<--
+topLeftX + pacmanX + pacmanSize * cos((directionAngle + mouthOpened * 30) * pi / 180.0 )
+--8<--
+topLeftY + pacmanY
+--8<--
+topLeftY + pacmanY - pacmanSize * sin((directionAngle + mouthOpened * 30) * pi / 180.0)
+--8<--
+height
+--8<--
+width
+--8<--
+topLeftX
+--8<--
+topLeftY
+--8<--
+foodSize
+--8<--
+foodSize
+--8<--
+foodX - foodSize // 2 + topLeftX;
+--8<--
+foodY - foodSize // 2 + topLeftY;
+--8<--
+true
+--8<--
+congratulations[random(congratulationsCount)]
+--8<--
+2
+--8<--
+2
+--8<--
+2
+--8<--
+true
+--8<--
+x = 0; y = 0;
+--8<--
+x = gamepadPad1[0];
+y = gamepadPad1[1];
+--8<--
+gamepadPad1Pressed
+--8<--
+100
+--8<--
+y + x
+--8<--
+y - x
+--8<--
+false
+--8<--
+Hello, i am trik
+--8<--
+false
+--8<--
+iteration
+--8<--
+true
+--8<--
+true
+--8<--
+false
+--8<--
+c_ck = 0.0044;
+c_pk = 10;
+c_ik = 2;
+c_dk = 12;
+--8<--
+g_bc = 1;
+g_gd = 0;
+g_od = 0;
+g_angle2 = 0;
+g_angle3 = 0;
+g_offset = 0;
+g_cnt = 0;
+g_te = time();
+--8<--
+accd = -atan2(accelerometer[2], -accelerometer[0]) * 180.0 / pi;
+tmp = time() - g_te;
+gyrd = (gyroscope[0] - g_gd) * tmp * c_p2d/1000.0;
+g_te = time();
+g_od = (1 - c_ck) * (g_od + gyrd) + c_ck * accd;
+angle = g_od - g_offset;
+yaw = g_bc*(sgn(angle)*c_minpower + angle*c_pk + (angle - g_angle2)*c_dk + (angle + g_angle2 + g_angle3)*c_ik);
+g_angle3 = g_angle2;
+g_angle2 = angle;
+--8<--
+g_offset = g_od;
+print("resetting axis!");
+--8<--
+g_gd = gd / c_itnum;
+print("Gyro drift is: " .. g_gd);
+--8<--
+gd = gd + gyroscope[0];
+--8<--
+c_p2d = 0.0175;
+c_itnum = 100;
+c_mainperiod = 12;
+c_minpower = 5;
+--8<--
+g_cnt  = g_cnt + 1;
+--8<--
+print("Calibrating gyroscope drift...");
+gd = 0;
+--8<--
+print(yaw .. " " .. angle .. " "..  tmp);
+g_cnt = 0;
+--8<--
+print("balancing started");
+--8<--
+buttonUp > 0
+--8<--
+g_cnt == 20
+--8<--
+buttonDown > 0
+--8<--
+abs(angle) < 45
+--8<--
+c_itnum
+--8<--
+c_mainperiod
+--8<--
+50
+--8<--
+yaw
+--8<--
+1990/3
+--8<--
+1990/3
+--8<--
+1036
+--8<--
+1036
+--8<--
+1960
+--8<--
+100
+--8<--
+100
+--8<--
+100
+--8<--
+100
+--8<--
+100
+--8<--
+3000
+--8<--
+"wpa_passphrase "..ИмяСети.." "..Пароль.." >> /etc/wpa_supplicant.conf"
+--8<--
+true
+--8<--
+'example-password'
+--8<--
+Пароль
+--8<--
+'Example'
+--8<--
+ИмяСети
+--8<--
+1000
+--8<--
+100
+--8<--
+100
+--8<--
+30
@@ -18,6 +18,7 @@ SUBDIRS = \
 	exampleTests \
 	pluginsTests \
 	qrguiTests \
+	qrguiEditorTests \
 	qrkernelTests \
 	qrgraphTests \
 	qrrepoTests \
@@ -28,6 +29,7 @@ SUBDIRS = \
 exampleTests.depends = testUtils
 pluginsTests.depends = testUtils
 qrguiTests.depends = testUtils
+qrguiEditorTests.depends = testUtils
 qrkernelTests.depends = testUtils
 qrrepoTests.depends = testUtils
 qrutilsTests.depends = testUtils
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtCore/QString>
 #include <QtCore/QSet>
@@ -35,7 +36,7 @@ namespace core {
 /// not fiddle with them much.
 /// In case of error skips symbols until next whitespace or newline and reports error.
 /// Can be quite slow due to use of regexp matching with every regexp in patterns list, so do not use this lexer
-/// on really large files.
+/// on really large files, or redefine findBestMatch() in a language lexer with a scanner specialized for its tokens.
 ///
 /// It is parameterized by TokenType --- enum class with all token types of a language. Token types may be arbitrary,
 /// but shall always contain TokenType::whitespace, TokenType::newline, TokenType::comment, TokenType::string,
@@ -67,8 +68,14 @@ public:
 				}
 			}
 		}
+
+		for (const TokenType keyword : mPatterns.allKeywords()) {
+			mKeywords.insert(mPatterns.keywordPattern(keyword), keyword);
+		}
 	}
 
+	virtual ~Lexer() {}
+
 	/// Tokenizes input string, returns list of detected tokens, list of errors and separate list of comments.
 	QList<Token<TokenType>> tokenize(const QString &input)
 	{
@@ -81,23 +88,25 @@ public:
 		int line = 0;
 		int column = 0;
 
-		// Scanning input string, trying to find longest match with regexp from a list of lexemes.
+		// Scanning input string, trying to find longest match with a lexeme.
 		while (absolutePosition < input.length()) {
-			CandidateMatch bestMatch = findBestMatch(input, absolutePosition);
+			TokenType candidate = TokenType::whitespace;
+			const int matchLength = findBestMatch(input, absolutePosition, candidate);
 
-			if (bestMatch.match.hasMatch()) {
+			if (matchLength > 0) {
+				const QString lexeme = input.mid(absolutePosition, matchLength);
+				const int absoluteTokenEnd = absolutePosition + matchLength - 1;
 				int tokenEndLine = line;
 				int tokenEndColumn = column;
 
-				if (bestMatch.candidate != TokenType::whitespace
-						&& bestMatch.candidate != TokenType::newline
-						&& bestMatch.candidate != TokenType::comment)
+				if (candidate != TokenType::whitespace
+						&& candidate != TokenType::newline
+						&& candidate != TokenType::comment)
 				{
 					// Determining connection of the lexeme. String is the only token that can span multiple lines so
 					// special care is needed to maintain connection.
-					if (bestMatch.candidate == TokenType::string) {
-						QRegularExpressionMatchIterator matchIterator = mNewLineRegexp.globalMatch(
-								bestMatch.match.captured());
+					if (candidate == TokenType::string) {
+						QRegularExpressionMatchIterator matchIterator = mNewLineRegexp.globalMatch(lexeme);
 
 						QRegularExpressionMatch match;
 
@@ -109,48 +118,43 @@ public:
 						if (match.hasMatch()) {
 							const int relativeLastNewLineOffset = match.capturedEnd() - 1;
 							const int absoluteLastNewLineOffset = absolutePosition + relativeLastNewLineOffset;
-							const int absoluteTokenEnd = bestMatch.match.capturedEnd() - 1;
 							tokenEndColumn = absoluteTokenEnd - absoluteLastNewLineOffset - 1;
 						} else {
-							tokenEndColumn += bestMatch.match.capturedLength() - 1;
+							tokenEndColumn += matchLength - 1;
 						}
 					} else {
-						tokenEndColumn += bestMatch.match.capturedLength() - 1;
+						tokenEndColumn += matchLength - 1;
 					}
 
-					const Range range(Connection(bestMatch.match.capturedStart(), line, column)
-							, Connection(bestMatch.match.capturedEnd() - 1, tokenEndLine, tokenEndColumn));
+					const Range range(Connection(absolutePosition, line, column)
+							, Connection(absoluteTokenEnd, tokenEndLine, tokenEndColumn));
 
-					if (bestMatch.candidate == TokenType::identifier) {
+					if (candidate == TokenType::identifier) {
 						// Keyword is an identifier which is separate lexeme.
-						bestMatch.candidate = checkForKeyword(bestMatch.match.captured());
+						candidate = checkForKeyword(lexeme);
 					}
 
-					result << Token<TokenType>(bestMatch.candidate
-							, range
-							, bestMatch.match.captured());
-				} else if (bestMatch.candidate == TokenType::comment) {
-					tokenEndColumn += bestMatch.match.capturedLength() - 1;
-					const Range range(Connection(bestMatch.match.capturedStart(), line, column)
-							, Connection(bestMatch.match.capturedEnd() - 1, tokenEndLine, tokenEndColumn));
-
-					mComments << Token<TokenType>(bestMatch.candidate
-							, range
-							, bestMatch.match.captured());
+					result << Token<TokenType>(candidate, range, lexeme);
+				} else if (candidate == TokenType::comment) {
+					tokenEndColumn += matchLength - 1;
+					const Range range(Connection(absolutePosition, line, column)
+							, Connection(absoluteTokenEnd, tokenEndLine, tokenEndColumn));
+
+					mComments << Token<TokenType>(candidate, range, lexeme);
 				}
 
 				// Keeping connection updated.
-				if (bestMatch.candidate == TokenType::newline) {
+				if (candidate == TokenType::newline) {
 					++line;
 					column = 0;
-				} else if (bestMatch.candidate == TokenType::whitespace || bestMatch.candidate == TokenType::comment) {
-					column += bestMatch.match.capturedLength();
+				} else if (candidate == TokenType::whitespace || candidate == TokenType::comment) {
+					column += matchLength;
 				} else {
 					line = tokenEndLine;
 					column = tokenEndColumn + 1;
 				}
 
-				absolutePosition += bestMatch.match.capturedLength();
+				absolutePosition += matchLength;
 			} else {
 				const auto errorConnection = Connection(absolutePosition, line, column);
 				QString skippedSymbols;
@@ -189,27 +193,17 @@ public:
 		return mPatterns.tokenUserFriendlyNames();
 	}
 
-private:
-	struct CandidateMatch {
-		TokenType candidate;
-		QRegularExpressionMatch match;
-	};
-
-	TokenType checkForKeyword(const QString &identifier) const
+protected:
+	/// Finds the longest lexeme starting at given position of input string.
+	/// Default implementation tries every regexp from token patterns, so it is a reference for all other matchers.
+	/// Languages may redefine it with a faster hand-written scanner, which shall give exactly the same results.
+	/// @param input - string being tokenized.
+	/// @param absolutePosition - position in input string where lexeme starts.
+	/// @param tokenType - out parameter, type of matched token (identifier for keywords).
+	/// @returns length of matched lexeme or 0 if no token pattern matches at given position.
+	virtual int findBestMatch(const QString &input, int absolutePosition, TokenType &tokenType) const
 	{
-		for (const TokenType keyword : mPatterns.allKeywords()) {
-			if (mPatterns.keywordPattern(keyword) == identifier) {
-				return keyword;
-			}
-		}
-
-		return TokenType::identifier;
-	}
-
-	CandidateMatch findBestMatch(const QString &input, const int absolutePosition) const
-	{
-		TokenType candidate = TokenType::whitespace;
-		QRegularExpressionMatch bestMatch;
+		int bestMatchLength = 0;
 
 		for (const TokenType token : mPatterns.allPatterns()) {
 			const QRegularExpression &regExp = mPatterns.tokenPattern(token);
@@ -221,14 +215,20 @@ private:
 					, QRegularExpression::AnchoredMatchOption);
 
 			if (match.hasMatch()) {
-				if (match.capturedLength() > bestMatch.capturedLength()) {
-					bestMatch = match;
-					candidate = token;
+				if (match.capturedLength() > bestMatchLength) {
+					bestMatchLength = match.capturedLength();
+					tokenType = token;
 				}
 			}
 		}
 
-		return CandidateMatch{candidate, bestMatch};
+		return bestMatchLength;
+	}
+
+private:
+	TokenType checkForKeyword(const QString &identifier) const
+	{
+		return mKeywords.value(identifier, TokenType::identifier);
 	}
 
 	TokenPatterns<TokenType> const mPatterns;
@@ -236,6 +236,9 @@ private:
 	QRegularExpression mWhitespaceRegexp;
 	QRegularExpression mNewLineRegexp;
 
+	/// Maps keyword lexemes to their token types.
+	QHash<QString, TokenType> mKeywords;
+
 	QList<Error> &mErrors;
 	QList<Token<TokenType>> mComments;
 };
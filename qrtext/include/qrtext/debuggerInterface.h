@@ -14,7 +14,10 @@
 
 #pragma once
 
+#include <functional>
+
 #include <QtCore/QString>
+#include <QtCore/QStringList>
 #include <QtCore/QVariant>
 
 namespace qrtext {
@@ -39,7 +42,8 @@ public:
 	template<typename T>
 	void setVariableValue(const QString &name, T value)
 	{
-		setVariableValue(name, QString("%1 = %2").arg(name).arg(value), QVariant(value));
+		setVariableValue(name, [&name, &value]() { return QString("%1 = %2").arg(name).arg(value); }
+				, QVariant(value));
 	}
 
 	/// Sets a value of given identifier in interpreter to given vector value.
@@ -51,11 +55,11 @@ public:
 			valueStringList.append(QString("%1").arg(valueItem));
 		}
 
-		const QString valueString = QString("{ %1 }").arg(valueStringList.join(", "));
-		QVariant variant;
-		variant.setValue(value);
+		const auto initCode = [&name, &valueStringList]() {
+			return QString("%1 = { %2 }").arg(name).arg(valueStringList.join(", "));
+		};
 
-		setVariableValue(name, QString("%1 = %2").arg(name).arg(valueString), valueStringList);
+		setVariableValue(name, initCode, valueStringList);
 	}
 
 private:
@@ -64,8 +68,10 @@ private:
 
 	/// Non-generic variant of setVariableValue(), sets value as QVariant. Also requires textual code for initialization
 	/// of a variable if it is not known to an interpreter. This code will be parsed and interpreted before value will
-	/// be set.
-	virtual void setVariableValue(const QString &name, const QString &initCode, const QVariant &value) = 0;
+	/// be set. Code is generated by @a initCode only when needed, since values are set much more often than
+	/// variables are introduced (sensor variables are updated on every reading, for example).
+	virtual void setVariableValue(const QString &name, const std::function<QString()> &initCode
+			, const QVariant &value) = 0;
 };
 
 }
@@ -16,8 +16,10 @@
 
 #include <QtCore/QSharedPointer>
 #include <QtCore/QScopedPointer>
+#include <QtCore/QSet>
 
 #include "qrtext/languageToolboxInterface.h"
+#include "qrtext/lua/luaValue.h"
 
 #include "qrtext/declSpec.h"
 
@@ -90,6 +92,14 @@ public:
 			, const QList<core::types::TypeExpression *> &parameterTypes
 			, std::function<QVariant(const QList<QVariant> &)> const &semantic) override;
 
+	/// Registers intrinsic function working directly with interpreter values, without conversions to and from
+	/// QVariant on each call. Preferable for functions called often, like sensor or math functions.
+	/// Parameters have the same meaning as in addIntrinsicFunction().
+	void addNativeFunction(const QString &name
+			, core::types::TypeExpression * const returnType
+			, const QList<core::types::TypeExpression *> &parameterTypes
+			, const std::function<LuaValue(const QVector<LuaValue> &)> &semantic);
+
 	QStringList identifiers() const override;
 
 	QMap<QString, QSharedPointer<core::types::TypeExpression>> variableTypes() const override;
@@ -131,10 +141,24 @@ private:
 	QVariant interpret(const QSharedPointer<core::ast::Node> &root) override;
 	QVariant value(const QString &identifier) const override;
 
-	void setVariableValue(const QString &name, const QString &initCode, const QVariant &value) override;
+	void setVariableValue(const QString &name, const std::function<QString()> &initCode
+			, const QVariant &value) override;
 
 	void reportErrors();
 
+	/// Analyzes given AST unless it was successfully analyzed before and no identifier it uses has changed its type
+	/// or read-only status since then.
+	void analyze(const QSharedPointer<core::ast::Node> &root);
+
+	/// Forgets that given AST was analyzed, used when it is replaced.
+	void forgetAnalysis(const QSharedPointer<core::ast::Node> &root);
+
+	/// Makes all ASTs using given identifier be analyzed again on next parse.
+	void invalidateAnalysis(const QString &identifier);
+
+	/// Returns string representations of types of all known identifiers.
+	QHash<QString, QString> variableTypeNames() const;
+
 	QList<core::Error> mErrors;
 
 	QScopedPointer<details::LuaLexer> mLexer;
@@ -145,6 +169,15 @@ private:
 	QHash<qReal::Id, QHash<QString, QSharedPointer<core::ast::Node>>> mAstRoots;
 	QHash<qReal::Id, QHash<QString, QString>> mParsedCache;
 
+	/// ASTs from mAstRoots that were analyzed without errors and need no reanalysis, with identifiers used in them.
+	QHash<const core::ast::Node *, QSet<QString>> mAnalyzedRoots;
+
+	/// Maps identifiers to ASTs from mAnalyzedRoots that use them.
+	QHash<QString, QSet<const core::ast::Node *>> mIdentifierUsers;
+
+	/// Compiled forms of ASTs from mAstRoots, compiled on first interpretation and dropped when AST is replaced.
+	QHash<const core::ast::Node *, std::function<LuaValue()>> mPrograms;
+
 	QStringList mSpecialConstants;
 	QStringList mSpecialIdentifiers;
 };
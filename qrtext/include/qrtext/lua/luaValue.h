@@ -0,0 +1,107 @@
+/* Copyright 2007-2016 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#pragma once
+
+#include <QtCore/QSharedPointer>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+
+#include "qrtext/declSpec.h"
+
+namespace qrtext {
+namespace lua {
+
+/// Value of Lua interpreter. Numbers and booleans are stored as they are, so arithmetics does not need any
+/// allocations or type switches of QVariant, tables are immutable and shared between copies of a value.
+/// Conversions between types follow the rules of QVariant, so values behave exactly as QVariants used to before.
+/// Values of types unknown to the interpreter (passed from the outside, for example) are kept in QVariant as they are.
+class QRTEXT_EXPORT LuaValue
+{
+public:
+	/// Kinds of values.
+	enum class Type
+	{
+		nil
+		, boolean
+		, integer
+		, number
+		, string
+		, table
+		/// Value of some other type kept in QVariant.
+		, variant
+	};
+
+	/// Elements of a table, indexed from 0 as in QVariantList.
+	typedef QVector<LuaValue> Table;
+
+	/// Constructs nil value.
+	LuaValue();
+
+	explicit LuaValue(bool value);
+	explicit LuaValue(int value);
+	explicit LuaValue(double value);
+	explicit LuaValue(const QString &value);
+	explicit LuaValue(const Table &value);
+
+	/// Converts QVariant into interpreter value. Lists (including string lists) are converted to tables.
+	static LuaValue fromVariant(const QVariant &value);
+
+	/// Converts interpreter value into QVariant. Tables are converted into QVariantList.
+	QVariant toVariant() const;
+
+	/// Returns the kind of this value.
+	Type type() const;
+
+	/// Returns true if value is nil or a null string, as QVariant::isNull() does.
+	bool isNull() const;
+
+	/// Converts value to bool as QVariant::toBool() does.
+	bool toBool() const;
+
+	/// Converts value to int as QVariant::toInt() does (numbers are rounded, for example).
+	int toInt() const;
+
+	/// Converts value to double as QVariant::toDouble() does.
+	double toDouble() const;
+
+	/// Converts value to string as QVariant::toString() does.
+	QString toString() const;
+
+	/// Returns elements of a table, or the result of QVariant::value<QVariantList>() for other values.
+	Table toTable() const;
+
+	/// Compares values as QVariants are compared.
+	bool operator ==(const LuaValue &other) const;
+	bool operator !=(const LuaValue &other) const;
+
+private:
+	Type mType;
+
+	union {
+		bool mBoolean;
+		int mInteger;
+		double mNumber;
+	};
+
+	QString mString;
+	QSharedPointer<const Table> mTable;
+	QVariant mVariant;
+};
+
+}
+}
+
+Q_DECLARE_TYPEINFO(qrtext::lua::LuaValue, Q_MOVABLE_TYPE);
@@ -56,6 +56,7 @@ HEADERS += \
 	$$PWD/include/qrtext/lua/luaAstVisitorInterface.h \
 	$$PWD/include/qrtext/lua/luaStringEscapeUtils.h \
 	$$PWD/include/qrtext/lua/luaToolbox.h \
+	$$PWD/include/qrtext/lua/luaValue.h \
 	$$PWD/include/qrtext/lua/ast/number.h \
 	$$PWD/include/qrtext/lua/ast/unaryMinus.h \
 	$$PWD/include/qrtext/lua/ast/not.h \
@@ -131,6 +132,7 @@ SOURCES += \
 	$$PWD/src/lua/luaSemanticAnalyzer.cpp \
 	$$PWD/src/lua/luaStringEscapeUtils.cpp \
 	$$PWD/src/lua/luaToolbox.cpp \
+	$$PWD/src/lua/luaValue.cpp \
 
 TRANSLATIONS = \
 	$$PWD/../qrtranslations/ru/qrtext_ru.ts \
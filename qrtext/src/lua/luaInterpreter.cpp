@@ -61,19 +61,26 @@
 
 using namespace qrtext::lua::details;
 using namespace qrtext;
+using qrtext::lua::LuaValue;
+
+/// Unary minus has always been calculated in single precision, keeping it that way.
+static LuaValue negate(const LuaValue &operand)
+{
+	return LuaValue(static_cast<double>(-static_cast<float>(operand.toDouble())));
+}
 
 LuaInterpreter::LuaInterpreter(QList<core::Error> &errors)
 	: mErrors(errors)
 {
 }
 
-QVariant LuaInterpreter::interpret(const QSharedPointer<core::ast::Node> &root
+LuaValue LuaInterpreter::interpret(const QSharedPointer<core::ast::Node> &root
 		, const core::SemanticAnalyzer &semanticAnalyzer)
 {
 	Q_UNUSED(semanticAnalyzer);
 
 	if (!root) {
-		return QVariant();
+		return LuaValue();
 	}
 
 	if (root->is<ast::Block>()) {
@@ -84,15 +91,15 @@ QVariant LuaInterpreter::interpret(const QSharedPointer<core::ast::Node> &root
 			}
 		}
 
-		return !statements.isEmpty() ? interpret(statements.last(), semanticAnalyzer) : QVariant();
+		return !statements.isEmpty() ? interpret(statements.last(), semanticAnalyzer) : LuaValue();
 	} else if (root->is<ast::IntegerNumber>()) {
 		/// @todo Integer and float literals may differ from those recognized in toInt() and toDouble().
 		bool ok = false;
-		return as<ast::IntegerNumber>(root)->stringRepresentation().toInt(&ok, 0);
+		return LuaValue(as<ast::IntegerNumber>(root)->stringRepresentation().toInt(&ok, 0));
 	} else if (root->is<ast::FloatNumber>()) {
-		return as<ast::FloatNumber>(root)->stringRepresentation().toDouble();
+		return LuaValue(as<ast::FloatNumber>(root)->stringRepresentation().toDouble());
 	} else if (root->is<ast::String>()) {
-		return as<ast::String>(root)->string();
+		return LuaValue(as<ast::String>(root)->string());
 	} else if (root->is<ast::TableConstructor>()) {
 		return constructTable(root, semanticAnalyzer);
 	} else if (root->is<ast::Assignment>()) {
@@ -101,40 +108,31 @@ QVariant LuaInterpreter::interpret(const QSharedPointer<core::ast::Node> &root
 		auto interpretedValue = interpret(value, semanticAnalyzer);
 
 		if (variable->is<ast::Identifier>()) {
-			const auto name = as<ast::Identifier>(variable)->name();
-
-			if (mReadOnlyVariables.contains(name)) {
-				mErrors.append(core::Error(root->start(), QObject::tr("Variable %1 is read-only")
-						, core::ErrorType::runtimeError, core::Severity::error));
-
-				return QVariant();
-			}
-
-			mIdentifierValues.insert(name, interpretedValue);
-			return QVariant();
+			assign(slot(as<ast::Identifier>(variable)->name()), interpretedValue, root);
+			return LuaValue();
 		} else if (variable->is<ast::IndexingExpression>()) {
 			assignToTableElement(variable, interpretedValue, semanticAnalyzer);
-			return QVariant();
+			return LuaValue();
 		} else {
 			mErrors.append(core::Error(root->start(), QObject::tr("This construction is not supported by interpreter")
 					, core::ErrorType::runtimeError, core::Severity::error));
 		}
 
-		return QVariant();
+		return LuaValue();
 
 	} else if (root->is<ast::Identifier>()) {
-		return mIdentifierValues.value(as<ast::Identifier>(root)->name());
+		return value(as<ast::Identifier>(root)->name());
 	} else if (root->is<ast::FunctionCall>()) {
 		auto function = as<ast::FunctionCall>(root)->function();
 		auto name = as<ast::Identifier>(function)->name();
 		auto parameters = as<ast::FunctionCall>(root)->arguments();
 
-		QList<QVariant> actualParameters;
+		QVector<LuaValue> actualParameters;
 		for (auto parameter : parameters) {
 			actualParameters << interpret(parameter, semanticAnalyzer);
 		}
 
-		return mIntrinsicFunctions[name](actualParameters);
+		return mIntrinsicFunctions[functionIndex(name)](actualParameters);
 	} else if (root->is<ast::IndexingExpression>()) {
 		return slice(root, semanticAnalyzer);
 	} else if (root->is<ast::UnaryOperator>()) {
@@ -142,207 +140,505 @@ QVariant LuaInterpreter::interpret(const QSharedPointer<core::ast::Node> &root
 	} else if (root->is<ast::BinaryOperator>()) {
 		return interpretBinaryOperator(root, semanticAnalyzer);
 	} else if (root->is<ast::True>()) {
-		return true;
+		return LuaValue(true);
 	} else if (root->is<ast::False>()) {
-		return false;
+		return LuaValue(false);
 	} else if (root->is<ast::Nil>()) {
-		return QVariant();
+		return LuaValue();
 	} else {
 		mErrors.append(core::Error(root->start(), QObject::tr("This construction is not supported by interpreter")
 				, core::ErrorType::runtimeError, core::Severity::error));
 
-		return QVariant();
+		return LuaValue();
 	}
 }
 
-void LuaInterpreter::addIntrinsicFunction(const QString &name
-		, std::function<QVariant(const QList<QVariant> &)> const &semantic)
+LuaInterpreter::Program LuaInterpreter::compile(const QSharedPointer<core::ast::Node> &root
+		, const core::SemanticAnalyzer &semanticAnalyzer)
 {
-	mIntrinsicFunctions.insert(name, semantic);
+	if (!root) {
+		return []() { return LuaValue(); };
+	}
+
+	if (root->is<ast::Block>()) {
+		QVector<Program> statements;
+		for (const auto &statement : as<ast::Block>(root)->children()) {
+			statements << compile(statement, semanticAnalyzer);
+		}
+
+		if (statements.size() == 1) {
+			return statements.first();
+		}
+
+		return [statements]() {
+			for (int i = 0; i < statements.size() - 1; ++i) {
+				statements[i]();
+			}
+
+			return !statements.isEmpty() ? statements.last()() : LuaValue();
+		};
+	} else if (root->is<ast::IntegerNumber>() || root->is<ast::FloatNumber>() || root->is<ast::String>()
+			|| root->is<ast::True>() || root->is<ast::False>() || root->is<ast::Nil>())
+	{
+		// Literals do not depend on execution state, so they are calculated once.
+		const LuaValue value = interpret(root, semanticAnalyzer);
+		return [value]() { return value; };
+	} else if (root->is<ast::Identifier>()) {
+		const int variableSlot = slot(as<ast::Identifier>(root)->name());
+		return [this, variableSlot]() { return mValues[variableSlot]; };
+	} else if (root->is<ast::Assignment>()) {
+		const auto variable = as<ast::Assignment>(root)->variable();
+		const Program value = compile(as<ast::Assignment>(root)->value(), semanticAnalyzer);
+		if (variable->is<ast::Identifier>()) {
+			const int variableSlot = slot(as<ast::Identifier>(variable)->name());
+			return [this, variableSlot, value, root]() {
+				assign(variableSlot, value(), root);
+				return LuaValue();
+			};
+		} else if (variable->is<ast::IndexingExpression>()) {
+			return [this, variable, value, &semanticAnalyzer]() {
+				assignToTableElement(variable, value(), semanticAnalyzer);
+				return LuaValue();
+			};
+		}
+	} else if (root->is<ast::FunctionCall>()) {
+		const auto function = as<ast::FunctionCall>(root)->function();
+		const int index = functionIndex(as<ast::Identifier>(function)->name());
+		QVector<Program> parameters;
+		for (const auto &parameter : as<ast::FunctionCall>(root)->arguments()) {
+			parameters << compile(parameter, semanticAnalyzer);
+		}
+
+		// Buffer for actual parameters is allocated once per call site, call sites are never reentered.
+		const QSharedPointer<QVector<LuaValue>> actualParameters(new QVector<LuaValue>(parameters.size()));
+		return [this, index, parameters, actualParameters]() {
+			for (int i = 0; i < parameters.size(); ++i) {
+				(*actualParameters)[i] = parameters[i]();
+			}
+
+			return mIntrinsicFunctions[index](*actualParameters);
+		};
+	} else if (root->is<ast::UnaryOperator>()) {
+		return compileUnaryOperator(root, semanticAnalyzer);
+	} else if (root->is<ast::BinaryOperator>()) {
+		return compileBinaryOperator(root, semanticAnalyzer);
+	}
+
+	// Tables, indexing and unsupported constructs are rare in block properties, they are interpreted as they are.
+	return [this, root, &semanticAnalyzer]() { return interpret(root, semanticAnalyzer); };
+}
+
+void LuaInterpreter::addIntrinsicFunction(const QString &name, const IntrinsicFunction &semantic)
+{
+	mIntrinsicFunctions[functionIndex(name)] = semantic;
 }
 
 QStringList LuaInterpreter::identifiers() const
 {
-	return mIdentifierValues.keys();
+	QStringList result;
+	for (auto it = mSlots.constBegin(); it != mSlots.constEnd(); ++it) {
+		if (mDefined[it.value()]) {
+			result << it.key();
+		}
+	}
+
+	return result;
+}
+
+bool LuaInterpreter::isDefined(const QString &identifier) const
+{
+	const auto it = mSlots.constFind(identifier);
+	return it != mSlots.constEnd() && mDefined[it.value()];
 }
 
 void LuaInterpreter::forgetIdentifier(const QString &identifier)
 {
-	mIdentifierValues.remove(identifier);
+	const auto it = mSlots.constFind(identifier);
+	if (it != mSlots.constEnd()) {
+		mValues[it.value()] = LuaValue();
+		mDefined[it.value()] = false;
+	}
 }
 
-QVariant LuaInterpreter::value(const QString &identifier) const
+LuaValue LuaInterpreter::value(const QString &identifier) const
 {
-	return mIdentifierValues.value(identifier);
+	const auto it = mSlots.constFind(identifier);
+	return it != mSlots.constEnd() ? mValues[it.value()] : LuaValue();
 }
 
-void LuaInterpreter::setVariableValue(const QString &name, const QVariant &value)
+void LuaInterpreter::setVariableValue(const QString &name, const LuaValue &value)
 {
-	QString valueString = value.toString();
-	if (!valueString.isEmpty()
-			&& (valueString[0] == '\'' || valueString[0] == '\"')
-			&& (valueString[valueString.size() - 1] == '\'' || valueString[valueString.size() - 1] == '\"')
-			)
-	{
-		// It is a string variable, chop off quotes.
-		valueString.remove(0, 1);
-		valueString.chop(1);
-		mIdentifierValues.insert(name, valueString);
-	} else {
-		mIdentifierValues.insert(name, value);
+	const int variableSlot = slot(name);
+	mDefined[variableSlot] = true;
+
+	if (value.type() == LuaValue::Type::string) {
+		QString valueString = value.toString();
+		if (!valueString.isEmpty()
+				&& (valueString[0] == '\'' || valueString[0] == '\"')
+				&& (valueString[valueString.size() - 1] == '\'' || valueString[valueString.size() - 1] == '\"')
+				)
+		{
+			// It is a string variable, chop off quotes.
+			valueString.remove(0, 1);
+			valueString.chop(1);
+			mValues[variableSlot] = LuaValue(valueString);
+			return;
+		}
 	}
+
+	mValues[variableSlot] = value;
 }
 
 void LuaInterpreter::addReadOnlyVariable(const QString &name)
 {
-	mReadOnlyVariables.insert(name);
+	mReadOnly[slot(name)] = true;
 }
 
 void LuaInterpreter::clear()
 {
-	mIdentifierValues.clear();
-	mReadOnlyVariables.clear();
+	// Slots themselves are kept, compiled programs may refer to them.
+	mValues.fill(LuaValue());
+	mDefined.fill(false);
+	mReadOnly.fill(false);
+}
+
+int LuaInterpreter::slot(const QString &identifier)
+{
+	const auto it = mSlots.constFind(identifier);
+	if (it != mSlots.constEnd()) {
+		return it.value();
+	}
+
+	const int result = mValues.size();
+	mSlots.insert(identifier, result);
+	mValues << LuaValue();
+	mDefined << false;
+	mReadOnly << false;
+	return result;
+}
+
+int LuaInterpreter::functionIndex(const QString &name)
+{
+	const auto it = mFunctionIndices.constFind(name);
+	if (it != mFunctionIndices.constEnd()) {
+		return it.value();
+	}
+
+	const int result = mIntrinsicFunctions.size();
+	mFunctionIndices.insert(name, result);
+	mIntrinsicFunctions << IntrinsicFunction();
+	return result;
+}
+
+void LuaInterpreter::assign(int slot, const LuaValue &value, const QSharedPointer<core::ast::Node> &assignment)
+{
+	if (mReadOnly[slot]) {
+		mErrors.append(core::Error(assignment->start(), QObject::tr("Variable %1 is read-only")
+				, core::ErrorType::runtimeError, core::Severity::error));
+
+		return;
+	}
+
+	mValues[slot] = value;
+	mDefined[slot] = true;
+}
+
+LuaInterpreter::Program LuaInterpreter::compileUnaryOperator(const QSharedPointer<core::ast::Node> &root
+		, const core::SemanticAnalyzer &semanticAnalyzer)
+{
+	const auto operandNode = as<ast::UnaryOperator>(root)->operand();
+	const Program operand = compile(operandNode, semanticAnalyzer);
+	if (root->is<ast::UnaryMinus>()) {
+		return [operand]() { return negate(operand()); };
+	} else if (root->is<ast::Not>()) {
+		return [operand]() {
+			const LuaValue operandResult = operand();
+			return LuaValue(operandResult.isNull() || !operandResult.toBool());
+		};
+	} else if (root->is<ast::Length>()) {
+		return [operand, operandNode, &semanticAnalyzer]() {
+			return semanticAnalyzer.type(operandNode)->is<types::String>()
+					? LuaValue(operand().toString().length())
+					: LuaValue();
+		};
+	} else if (root->is<ast::BitwiseNegation>()) {
+		return [operand]() { return LuaValue(~(operand().toInt())); };
+	}
+
+	return []() { return LuaValue(); };
+}
+
+LuaInterpreter::Program LuaInterpreter::compileBinaryOperator(const QSharedPointer<core::ast::Node> &root
+		, const core::SemanticAnalyzer &semanticAnalyzer)
+{
+	const auto leftNode = as<ast::BinaryOperator>(root)->leftOperand();
+	const auto rightNode = as<ast::BinaryOperator>(root)->rightOperand();
+
+	if (root->is<ast::Addition>() || root->is<ast::Subtraction>() || root->is<ast::Multiplication>()
+			|| root->is<ast::Exponentiation>())
+	{
+		const NumberProgram number = compileNumber(root, semanticAnalyzer);
+		return [number]() { return LuaValue(number()); };
+	} else if (root->is<ast::LessThan>() || root->is<ast::LessOrEqual>()
+			|| root->is<ast::GreaterThan>() || root->is<ast::GreaterOrEqual>())
+	{
+		const NumberProgram left = compileNumber(leftNode, semanticAnalyzer);
+		const NumberProgram right = compileNumber(rightNode, semanticAnalyzer);
+		if (root->is<ast::LessThan>()) {
+			return [left, right]() { return LuaValue(left() < right()); };
+		} else if (root->is<ast::LessOrEqual>()) {
+			return [left, right]() { return LuaValue(left() <= right()); };
+		} else if (root->is<ast::GreaterThan>()) {
+			return [left, right]() { return LuaValue(left() > right()); };
+		}
+
+		return [left, right]() { return LuaValue(left() >= right()); };
+	} else if (root->is<ast::Division>()) {
+		// Unlike compileNumber(), returns integer zero on division by zero, as interpret() does.
+		const NumberProgram left = compileNumber(leftNode, semanticAnalyzer);
+		const NumberProgram right = compileNumber(rightNode, semanticAnalyzer);
+		return [this, left, right, root]() {
+			const double leftOperandValue = left();
+			const double rightOperandValue = right();
+			if (rightOperandValue != 0) {
+				return LuaValue(leftOperandValue / rightOperandValue);
+			}
+
+			reportDivisionByZero(root);
+			return LuaValue(0);
+		};
+	}
+
+	const Program left = compile(leftNode, semanticAnalyzer);
+	const Program right = compile(rightNode, semanticAnalyzer);
+
+	if (root->is<ast::IntegerDivision>() || root->is<ast::Modulo>()) {
+		const bool isDivision = root->is<ast::IntegerDivision>();
+		return [this, left, right, root, isDivision]() {
+			const int leftOperandValue = left().toInt();
+			const int rightOperandValue = right().toInt();
+			if (rightOperandValue != 0) {
+				return LuaValue(isDivision
+						? leftOperandValue / rightOperandValue
+						: leftOperandValue % rightOperandValue);
+			}
+
+			reportDivisionByZero(root);
+			return LuaValue(0);
+		};
+	} else if (root->is<ast::BitwiseAnd>()) {
+		return [left, right]() { return LuaValue(left().toInt() & right().toInt()); };
+	} else if (root->is<ast::BitwiseOr>()) {
+		return [left, right]() { return LuaValue(left().toInt() | right().toInt()); };
+	} else if (root->is<ast::BitwiseXor>()) {
+		return [left, right]() { return LuaValue(left().toInt() ^ right().toInt()); };
+	} else if (root->is<ast::BitwiseLeftShift>()) {
+		return [left, right]() { return LuaValue(left().toInt() << right().toInt()); };
+	} else if (root->is<ast::BitwiseRightShift>()) {
+		return [left, right]() { return LuaValue(left().toInt() >> right().toInt()); };
+	} else if (root->is<ast::Concatenation>()) {
+		return [left, right]() { return LuaValue(left().toString() + right().toString()); };
+	} else if (root->is<ast::Equality>()) {
+		return [left, right]() { return LuaValue(left() == right()); };
+	} else if (root->is<ast::Inequality>()) {
+		return [left, right]() { return LuaValue(left() != right()); };
+	} else if (root->is<ast::LogicalAnd>()) {
+		return [left, right]() { return LuaValue(left().toInt() && right().toInt()); };
+	} else if (root->is<ast::LogicalOr>()) {
+		return [left, right]() { return LuaValue(left().toInt() || right().toInt()); };
+	}
+
+	return []() { return LuaValue(); };
+}
+
+LuaInterpreter::NumberProgram LuaInterpreter::compileNumber(const QSharedPointer<core::ast::Node> &root
+		, const core::SemanticAnalyzer &semanticAnalyzer)
+{
+	if (root->is<ast::IntegerNumber>() || root->is<ast::FloatNumber>()) {
+		const double value = interpret(root, semanticAnalyzer).toDouble();
+		return [value]() { return value; };
+	} else if (root->is<ast::Identifier>()) {
+		const int variableSlot = slot(as<ast::Identifier>(root)->name());
+		return [this, variableSlot]() { return mValues[variableSlot].toDouble(); };
+	} else if (root->is<ast::Addition>() || root->is<ast::Subtraction>() || root->is<ast::Multiplication>()
+			|| root->is<ast::Division>() || root->is<ast::Exponentiation>())
+	{
+		const NumberProgram left = compileNumber(as<ast::BinaryOperator>(root)->leftOperand(), semanticAnalyzer);
+		const NumberProgram right = compileNumber(as<ast::BinaryOperator>(root)->rightOperand(), semanticAnalyzer);
+		if (root->is<ast::Addition>()) {
+			return [left, right]() { return left() + right(); };
+		} else if (root->is<ast::Subtraction>()) {
+			return [left, right]() { return left() - right(); };
+		} else if (root->is<ast::Multiplication>()) {
+			return [left, right]() {
+				const double leftOperandValue = left();
+				return leftOperandValue * right();
+			};
+		} else if (root->is<ast::Exponentiation>()) {
+			return [left, right]() { return qPow(left(), right()); };
+		}
+
+		return [this, left, right, root]() {
+			const double leftOperandValue = left();
+			const double rightOperandValue = right();
+			if (rightOperandValue != 0) {
+				return leftOperandValue / rightOperandValue;
+			}
+
+			reportDivisionByZero(root);
+			return 0.0;
+		};
+	}
+
+	const Program program = compile(root, semanticAnalyzer);
+	return [program]() { return program().toDouble(); };
+}
+
+void LuaInterpreter::reportDivisionByZero(const QSharedPointer<core::ast::Node> &root)
+{
+	mErrors.append(core::Error(root->start(), QObject::tr("Division by zero")
+			, core::ErrorType::runtimeError, core::Severity::error));
 }
 
-QVariant LuaInterpreter::interpretUnaryOperator(const QSharedPointer<core::ast::Node> &root
+LuaValue LuaInterpreter::interpretUnaryOperator(const QSharedPointer<core::ast::Node> &root
 		, const core::SemanticAnalyzer &semanticAnalyzer)
 {
 	auto operand = as<ast::UnaryOperator>(root)->operand();
 	if (root->is<ast::UnaryMinus>()) {
-		return -interpret(operand, semanticAnalyzer).toFloat();
+		return negate(interpret(operand, semanticAnalyzer));
 	} else if (root->is<ast::Not>()) {
-		const QVariant operandResult = interpret(operand, semanticAnalyzer);
+		const LuaValue operandResult = interpret(operand, semanticAnalyzer);
 		/// @todo Code 'nil' more adequately.
 		if (operandResult.isNull()) {
-			return true;
+			return LuaValue(true);
 		}
 
-		return !operandResult.toBool();
+		return LuaValue(!operandResult.toBool());
 	} else if (root->is<ast::Length>()) {
 		if (semanticAnalyzer.type(operand)->is<types::String>()) {
 			/// @todo Well, in Lua '#' returns bytes in a string, not symbols.
-			return interpret(operand, semanticAnalyzer).toString().length();
+			return LuaValue(interpret(operand, semanticAnalyzer).toString().length());
 		}
 		/// @todo Support everything else.
 	} else if (root->is<ast::BitwiseNegation>()) {
-		return ~(interpret(operand, semanticAnalyzer).toInt());
+		return LuaValue(~(interpret(operand, semanticAnalyzer).toInt()));
 	}
 
-	return QVariant();
+	return LuaValue();
 }
 
-QVariant LuaInterpreter::interpretBinaryOperator(const QSharedPointer<core::ast::Node> &root
+LuaValue LuaInterpreter::interpretBinaryOperator(const QSharedPointer<core::ast::Node> &root
 		, const core::SemanticAnalyzer &semanticAnalyzer)
 {
 	auto leftOperand = as<ast::BinaryOperator>(root)->leftOperand();
 	auto rightOperand = as<ast::BinaryOperator>(root)->rightOperand();
 
 	if (root->is<ast::Addition>()) {
-		return interpret(leftOperand, semanticAnalyzer).toDouble()
-				+ interpret(rightOperand, semanticAnalyzer).toDouble();
+		return LuaValue(interpret(leftOperand, semanticAnalyzer).toDouble()
+				+ interpret(rightOperand, semanticAnalyzer).toDouble());
 	} else if (root->is<ast::Subtraction>()) {
-		return interpret(leftOperand, semanticAnalyzer).toDouble()
-				- interpret(rightOperand, semanticAnalyzer).toDouble();
+		return LuaValue(interpret(leftOperand, semanticAnalyzer).toDouble()
+				- interpret(rightOperand, semanticAnalyzer).toDouble());
 	} else if (root->is<ast::Multiplication>()) {
-		QVariant leftOperandValue = interpret(leftOperand, semanticAnalyzer);
-		return leftOperandValue.toDouble()
-				* interpret(rightOperand, semanticAnalyzer).toDouble();
+		LuaValue leftOperandValue = interpret(leftOperand, semanticAnalyzer);
+		return LuaValue(leftOperandValue.toDouble()
+				* interpret(rightOperand, semanticAnalyzer).toDouble());
 	} else if (root->is<ast::Division>()) {
 		const auto leftOperandValue = interpret(leftOperand, semanticAnalyzer).toDouble();
 		const auto rightOperandValue = interpret(rightOperand, semanticAnalyzer).toDouble();
 		if (rightOperandValue != 0) {
-			return leftOperandValue / rightOperandValue;
+			return LuaValue(leftOperandValue / rightOperandValue);
 		} else {
 			mErrors.append(core::Error(root->start(), QObject::tr("Division by zero")
 					, core::ErrorType::runtimeError, core::Severity::error));
-			return 0;
+			return LuaValue(0);
 		}
 	} else if (root->is<ast::IntegerDivision>()) {
 		const auto leftOperandValue = interpret(leftOperand, semanticAnalyzer).toInt();
 		const auto rightOperandValue = interpret(rightOperand, semanticAnalyzer).toInt();
 		if (rightOperandValue != 0) {
-			return leftOperandValue / rightOperandValue;
+			return LuaValue(leftOperandValue / rightOperandValue);
 		} else {
 			mErrors.append(core::Error(root->start(), QObject::tr("Division by zero")
 					, core::ErrorType::runtimeError, core::Severity::error));
-			return 0;
+			return LuaValue(0);
 		}
 	} else if (root->is<ast::Exponentiation>()) {
-		return qPow(interpret(leftOperand, semanticAnalyzer).toDouble()
-				, interpret(rightOperand, semanticAnalyzer).toDouble());
+		return LuaValue(qPow(interpret(leftOperand, semanticAnalyzer).toDouble()
+				, interpret(rightOperand, semanticAnalyzer).toDouble()));
 	} else if (root->is<ast::Modulo>()) {
 		const auto leftOperandValue = interpret(leftOperand, semanticAnalyzer).toInt();
 		const auto rightOperandValue = interpret(rightOperand, semanticAnalyzer).toInt();
 		if (rightOperandValue != 0) {
-			return leftOperandValue % rightOperandValue;
+			return LuaValue(leftOperandValue % rightOperandValue);
 		} else {
 			mErrors.append(core::Error(root->start(), QObject::tr("Division by zero")
 					, core::ErrorType::runtimeError, core::Severity::error));
-			return 0;
+			return LuaValue(0);
 		}
 	} else if (root->is<ast::BitwiseAnd>()) {
-		return interpret(leftOperand, semanticAnalyzer).toInt()
-				& interpret(rightOperand, semanticAnalyzer).toInt();
+		return LuaValue(interpret(leftOperand, semanticAnalyzer).toInt()
+				& interpret(rightOperand, semanticAnalyzer).toInt());
 	} else if (root->is<ast::BitwiseOr>()) {
-		return interpret(leftOperand, semanticAnalyzer).toInt()
-				| interpret(rightOperand, semanticAnalyzer).toInt();
+		return LuaValue(interpret(leftOperand, semanticAnalyzer).toInt()
+				| interpret(rightOperand, semanticAnalyzer).toInt());
 	} else if (root->is<ast::BitwiseXor>()) {
-		return interpret(leftOperand, semanticAnalyzer).toInt()
-				^ interpret(rightOperand, semanticAnalyzer).toInt();
+		return LuaValue(interpret(leftOperand, semanticAnalyzer).toInt()
+				^ interpret(rightOperand, semanticAnalyzer).toInt());
 	} else if (root->is<ast::BitwiseLeftShift>()) {
-		return interpret(leftOperand, semanticAnalyzer).toInt()
-				<< interpret(rightOperand, semanticAnalyzer).toInt();
+		return LuaValue(interpret(leftOperand, semanticAnalyzer).toInt()
+				<< interpret(rightOperand, semanticAnalyzer).toInt());
 	} else if (root->is<ast::BitwiseRightShift>()) {
-		return interpret(leftOperand, semanticAnalyzer).toInt()
-				>> interpret(rightOperand, semanticAnalyzer).toInt();
+		return LuaValue(interpret(leftOperand, semanticAnalyzer).toInt()
+				>> interpret(rightOperand, semanticAnalyzer).toInt());
 
 	} else if (root->is<ast::Concatenation>()) {
-		return interpret(leftOperand, semanticAnalyzer).toString()
-				+ interpret(rightOperand, semanticAnalyzer).toString();
+		return LuaValue(interpret(leftOperand, semanticAnalyzer).toString()
+				+ interpret(rightOperand, semanticAnalyzer).toString());
 
 	/// @todo String comparison.
 	} else if (root->is<ast::LessThan>()) {
-		return interpret(leftOperand, semanticAnalyzer).toDouble()
-				< interpret(rightOperand, semanticAnalyzer).toDouble();
+		return LuaValue(interpret(leftOperand, semanticAnalyzer).toDouble()
+				< interpret(rightOperand, semanticAnalyzer).toDouble());
 	} else if (root->is<ast::LessOrEqual>()) {
-		return interpret(leftOperand, semanticAnalyzer).toDouble()
-				<= interpret(rightOperand, semanticAnalyzer).toDouble();
+		return LuaValue(interpret(leftOperand, semanticAnalyzer).toDouble()
+				<= interpret(rightOperand, semanticAnalyzer).toDouble());
 	} else if (root->is<ast::GreaterThan>()) {
-		return interpret(leftOperand, semanticAnalyzer).toDouble()
-				> interpret(rightOperand, semanticAnalyzer).toDouble();
+		return LuaValue(interpret(leftOperand, semanticAnalyzer).toDouble()
+				> interpret(rightOperand, semanticAnalyzer).toDouble());
 	} else if (root->is<ast::GreaterOrEqual>()) {
-		return interpret(leftOperand, semanticAnalyzer).toDouble()
-				>= interpret(rightOperand, semanticAnalyzer).toDouble();
+		return LuaValue(interpret(leftOperand, semanticAnalyzer).toDouble()
+				>= interpret(rightOperand, semanticAnalyzer).toDouble());
 	} else if (root->is<ast::Equality>()) {
-		return interpret(leftOperand, semanticAnalyzer) == interpret(rightOperand, semanticAnalyzer);
+		return LuaValue(interpret(leftOperand, semanticAnalyzer) == interpret(rightOperand, semanticAnalyzer));
 	} else if (root->is<ast::Inequality>()) {
-		return interpret(leftOperand, semanticAnalyzer) != interpret(rightOperand, semanticAnalyzer);
+		return LuaValue(interpret(leftOperand, semanticAnalyzer) != interpret(rightOperand, semanticAnalyzer));
 	} else if (root->is<ast::LogicalAnd>()) {
-		return interpret(leftOperand, semanticAnalyzer).toInt()
-				&& interpret(rightOperand, semanticAnalyzer).toInt();
+		return LuaValue(interpret(leftOperand, semanticAnalyzer).toInt()
+				&& interpret(rightOperand, semanticAnalyzer).toInt());
 	} else if (root->is<ast::LogicalOr>()) {
-		return interpret(leftOperand, semanticAnalyzer).toInt()
-				|| interpret(rightOperand, semanticAnalyzer).toInt();
+		return LuaValue(interpret(leftOperand, semanticAnalyzer).toInt()
+				|| interpret(rightOperand, semanticAnalyzer).toInt());
 	}
 
-	return QVariant();
+	return LuaValue();
 }
 
 
-QVariant LuaInterpreter::operateOnIndexingExpression(const QSharedPointer<core::ast::Node> &indexingExpression
+LuaValue LuaInterpreter::operateOnIndexingExpression(const QSharedPointer<core::ast::Node> &indexingExpression
 		, const core::SemanticAnalyzer &semanticAnalyzer
-		, const std::function<QVariant(const QString &
-				, const QVariantList &
+		, const std::function<LuaValue(const QString &
+				, const LuaValue::Table &
 				, const QVector<int> &
 				, const core::Connection &)> &action)
 {
 	return operateOnIndexingExpressionRecursive(indexingExpression, {}, semanticAnalyzer, action);
 }
 
-QVariant LuaInterpreter::operateOnIndexingExpressionRecursive(const QSharedPointer<core::ast::Node> &indexingExpression
+LuaValue LuaInterpreter::operateOnIndexingExpressionRecursive(const QSharedPointer<core::ast::Node> &indexingExpression
 		, const QVector<int> &currentIndex, const core::SemanticAnalyzer &semanticAnalyzer
-		, const std::function<QVariant(const QString &
-				, const QVariantList &
+		, const std::function<LuaValue(const QString &
+				, const LuaValue::Table &
 				, const QVector<int> &
 				, const core::Connection &)> &action)
 {
@@ -359,13 +655,13 @@ QVariant LuaInterpreter::operateOnIndexingExpressionRecursive(const QSharedPoint
 		const auto name = as<ast::Identifier>(node->table())->name();
 		if (semanticAnalyzer.type(node->indexer())->is<types::Number>()) {
 			const auto index = interpret(node->indexer(), semanticAnalyzer).toInt();
-			const auto table = mIdentifierValues.value(name).value<QVariantList>();
+			const auto table = value(name).toTable();
 
 			return action(name, table, QVector<int>{index} + currentIndex, node->start());
 		}
 
 		reportError();
-		return QVariant();
+		return LuaValue();
 	} else if (node->table()->is<ast::IndexingExpression>()) {
 		if (semanticAnalyzer.type(node->indexer())->is<types::Number>()) {
 			const auto index = interpret(node->indexer(), semanticAnalyzer).toInt();
@@ -374,7 +670,7 @@ QVariant LuaInterpreter::operateOnIndexingExpressionRecursive(const QSharedPoint
 		}
 
 		reportError();
-		return QVariant();
+		return LuaValue();
 	}
 
 	/// @todo Support more complex cases of table slice, like
@@ -384,13 +680,13 @@ QVariant LuaInterpreter::operateOnIndexingExpressionRecursive(const QSharedPoint
 			, QObject::tr("Tables denoted by something other than identifier (like f(x)[0]) are not allowed")
 			, core::ErrorType::runtimeError, core::Severity::error));
 
-	return QVariant();
+	return LuaValue();
 }
 
-QVariant LuaInterpreter::constructTable(const QSharedPointer<core::ast::Node> &tableConstructor
+LuaValue LuaInterpreter::constructTable(const QSharedPointer<core::ast::Node> &tableConstructor
 		, const core::SemanticAnalyzer &semanticAnalyzer)
 {
-	QVariantList temp;
+	LuaValue::Table temp;
 	for (const auto &node : as<ast::TableConstructor>(tableConstructor)->initializers()) {
 		if (node->implicitKey()) {
 			temp << interpret(node->value(), semanticAnalyzer);
@@ -400,11 +696,11 @@ QVariant LuaInterpreter::constructTable(const QSharedPointer<core::ast::Node> &t
 				if (temp.size() <= index) {
 					for (int i = 0; index >= temp.size(); ++i) {
 						/// @todo: add proper "nil" value.
-						temp.append("");
+						temp.append(LuaValue(QString("")));
 					}
 				}
 
-				temp[index] = interpret(node->value(), semanticAnalyzer).value<QString>();
+				temp[index] = LuaValue(interpret(node->value(), semanticAnalyzer).toString());
 			} else {
 				mErrors.append(core::Error(tableConstructor->start()
 						, QObject::tr("Explicit table indexes of non-integer type are not supported")
@@ -413,31 +709,33 @@ QVariant LuaInterpreter::constructTable(const QSharedPointer<core::ast::Node> &t
 		}
 	}
 
-	return QVariant(temp);
+	return LuaValue(temp);
 }
 
 void LuaInterpreter::assignToTableElement(const QSharedPointer<core::ast::Node> &variable
-		, const QVariant &interpretedValue, const core::SemanticAnalyzer &semanticAnalyzer)
+		, const LuaValue &interpretedValue, const core::SemanticAnalyzer &semanticAnalyzer)
 {
 	const auto action = [this, &interpretedValue] (
 			const QString &name
-			, const QVariantList &table
+			, const LuaValue::Table &table
 			, const QVector<int> &index
 			, const core::Connection &connection)
 	{
-		mIdentifierValues.insert(name, doAssignToTableElement(table, interpretedValue, index, connection));
-		return QVariant();
+		const int variableSlot = slot(name);
+		mValues[variableSlot] = LuaValue(doAssignToTableElement(table, interpretedValue, index, connection));
+		mDefined[variableSlot] = true;
+		return LuaValue();
 	};
 
 	operateOnIndexingExpression(variable, semanticAnalyzer, action);
 }
 
-QVariantList LuaInterpreter::doAssignToTableElement(const QVariantList &table
-		, const QVariant &value
+LuaValue::Table LuaInterpreter::doAssignToTableElement(const LuaValue::Table &table
+		, const LuaValue &value
 		, const QVector<int> &index
 		, const core::Connection &connection)
 {
-	QVariantList result;
+	LuaValue::Table result;
 	int i = 0;
 	const int currentIndex = index.first();
 	if (currentIndex < 0) {
@@ -452,7 +750,7 @@ QVariantList LuaInterpreter::doAssignToTableElement(const QVariantList &table
 	if (remainingIndex.isEmpty()) {
 		result = table;
 		for (int i = 0; currentIndex >= result.size(); ++i) {
-			result << QVariant();
+			result << LuaValue();
 		}
 
 		if (currentIndex >= 0) {
@@ -468,7 +766,7 @@ QVariantList LuaInterpreter::doAssignToTableElement(const QVariantList &table
 
 	for (const auto &element : table) {
 		if (i == currentIndex) {
-			result << QVariant(doAssignToTableElement(element.value<QVariantList>()
+			result << LuaValue(doAssignToTableElement(element.toTable()
 					, value
 					, remainingIndex
 					, connection));
@@ -481,26 +779,26 @@ QVariantList LuaInterpreter::doAssignToTableElement(const QVariantList &table
 
 	if (currentIndex >= result.size()) {
 		for (int i = 0; currentIndex >= result.size() + 1; ++i) {
-			result << QVariant();
+			result << LuaValue();
 		}
 
-		result << QVariant(doAssignToTableElement({}, value, remainingIndex, connection));
+		result << LuaValue(doAssignToTableElement(LuaValue::Table(), value, remainingIndex, connection));
 	}
 
 	return result;
 }
 
-QVariant LuaInterpreter::slice(const QSharedPointer<core::ast::Node> &indexingExpression
+LuaValue LuaInterpreter::slice(const QSharedPointer<core::ast::Node> &indexingExpression
 		, const core::SemanticAnalyzer &semanticAnalyzer)
 {
 	const auto action = [this] (const QString &name
-			, const QVariantList &table
+			, const LuaValue::Table &table
 			, const QVector<int> &index
 			, const core::Connection &connection)
 	{
 		Q_UNUSED(name);
 
-		QVariantList slice = table;
+		LuaValue::Table slice = table;
 
 		QVector<int> actualIndex = index;
 		const int lastIndex = index.last();
@@ -508,28 +806,28 @@ QVariant LuaInterpreter::slice(const QSharedPointer<core::ast::Node> &indexingEx
 
 		for (int i : actualIndex) {
 			if (slice.size() <= i) {
-				return QVariant();
+				return LuaValue();
 			}
 
 			if (i < 0) {
 				mErrors.append(core::Error(connection
 						, QObject::tr("Negative index for a table")
 						, core::ErrorType::runtimeError, core::Severity::error));
-				return QVariant();
+				return LuaValue();
 			}
 
-			slice = slice[i].value<QVariantList>();
+			slice = slice[i].toTable();
 		}
 
 		if (slice.size() <= lastIndex) {
-			return QVariant();
+			return LuaValue();
 		}
 
 		if (lastIndex < 0) {
 			mErrors.append(core::Error(connection
 					, QObject::tr("Negative index for a table")
 					, core::ErrorType::runtimeError, core::Severity::error));
-			return QVariant();
+			return LuaValue();
 		}
 
 		return slice[lastIndex];
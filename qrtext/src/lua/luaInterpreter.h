@@ -16,50 +16,66 @@
 
 #include <functional>
 #include <QtCore/QHash>
-#include <QtCore/QVariantList>
+#include <QtCore/QVector>
 
 #include "qrtext/core/error.h"
 #include "qrtext/core/ast/node.h"
 
 #include "qrtext/core/semantics/semanticAnalyzer.h"
 
+#include "qrtext/lua/luaValue.h"
 #include "qrtext/lua/types/function.h"
 
 namespace qrtext {
 namespace lua {
 namespace details {
 
-/// Interpreter of AST for Lua language.
+/// Interpreter of AST for Lua language. AST can be interpreted directly by tree walking or compiled once into a tree
+/// of pre-bound closures with resolved variable slots and constant literals, which is much faster for code that is
+/// executed many times. Both ways share the same execution state and give the same results.
+/// Values are represented by LuaValue, conversions to QVariant are done by callers (LuaToolbox) if needed.
 class LuaInterpreter
 {
 public:
+	/// Compiled form of AST, returns the result of calculation just like interpret() does.
+	typedef std::function<LuaValue()> Program;
+
+	/// Implementation of intrinsic function, takes a list of actual parameters and returns calculated value.
+	typedef std::function<LuaValue(const QVector<LuaValue> &)> IntrinsicFunction;
+
 	/// Constructor.
 	/// @param errors - error stream to report errors to.
 	explicit LuaInterpreter(QList<core::Error> &errors);
 
 	/// Registers external (intrinsic for a language) function in interpreter.
 	/// @param name - name of a function.
-	/// @param semantic - actual C++ function that implements it. Must take list of actual parameters and return
-	///        calculated value as QVariant.
-	void addIntrinsicFunction(const QString &name
-			, std::function<QVariant(const QList<QVariant> &)> const &semantic);
+	/// @param semantic - actual C++ function that implements it.
+	void addIntrinsicFunction(const QString &name, const IntrinsicFunction &semantic);
 
 	/// Interprets given AST using type information provided by given semantic analyzer, returns the result of
-	/// calculation or QVariant() if there is no result (error or AST is not supposed to return anything).
+	/// calculation or nil if there is no result (error or AST is not supposed to return anything).
 	/// @todo Remove direct reference to semanticAnalyzer.
-	QVariant interpret(const QSharedPointer<core::ast::Node> &root, const core::SemanticAnalyzer &semanticAnalyzer);
+	LuaValue interpret(const QSharedPointer<core::ast::Node> &root, const core::SemanticAnalyzer &semanticAnalyzer);
+
+	/// Compiles given AST into a program. Program keeps a reference to the given semantic analyzer (it is consulted
+	/// for types at run time, so program remains valid if types are reinferred) and to this interpreter,
+	/// so it must not outlive any of them. Constructs not supported by the compiler are interpreted by tree walking.
+	Program compile(const QSharedPointer<core::ast::Node> &root, const core::SemanticAnalyzer &semanticAnalyzer);
 
 	/// Returns a list of known identifiers
 	QStringList identifiers() const;
 
+	/// Returns true if identifier with given name is known, that is, has a value.
+	bool isDefined(const QString &identifier) const;
+
 	/// Remome identifier from known identifiers
 	void forgetIdentifier(const QString &identifier);
 
 	/// Returns a value of an identifier with given name.
-	QVariant value(const QString &identifier) const;
+	LuaValue value(const QString &identifier) const;
 
-	/// Sets a value of identifier with given name to given value.
-	void setVariableValue(const QString &name, const QVariant &value);
+	/// Sets a value of identifier with given name to given value. Quotes around string values are chopped off.
+	void setVariableValue(const QString &name, const LuaValue &value);
 
 	/// Registers variable with given name as read-only (can be modified only by setVariableValue() call).
 	void addReadOnlyVariable(const QString &name);
@@ -68,46 +84,78 @@ public:
 	void clear();
 
 private:
-	QVariant interpretUnaryOperator(const QSharedPointer<core::ast::Node> &root
+	/// Compiled arithmetic subexpression, returns the same as interpret(...).toDouble() but without packing
+	/// intermediate results into LuaValue.
+	typedef std::function<double()> NumberProgram;
+
+	/// Returns the index of variable slot for the identifier with given name, creating it if needed.
+	/// Slots are never deleted, so compiled programs may refer to them by index.
+	int slot(const QString &identifier);
+
+	/// Returns the index of intrinsic function with given name, registering empty one if needed.
+	int functionIndex(const QString &name);
+
+	/// Assigns value to the variable in given slot, reports an error if it is read-only.
+	void assign(int slot, const LuaValue &value, const QSharedPointer<core::ast::Node> &assignment);
+
+	Program compileUnaryOperator(const QSharedPointer<core::ast::Node> &root
 			, const core::SemanticAnalyzer &semanticAnalyzer);
 
-	QVariant interpretBinaryOperator(const QSharedPointer<core::ast::Node> &root
+	Program compileBinaryOperator(const QSharedPointer<core::ast::Node> &root
 			, const core::SemanticAnalyzer &semanticAnalyzer);
 
-	QVariant operateOnIndexingExpression(const QSharedPointer<core::ast::Node> &indexingExpression
+	NumberProgram compileNumber(const QSharedPointer<core::ast::Node> &root
+			, const core::SemanticAnalyzer &semanticAnalyzer);
+
+	void reportDivisionByZero(const QSharedPointer<core::ast::Node> &root);
+
+	LuaValue interpretUnaryOperator(const QSharedPointer<core::ast::Node> &root
+			, const core::SemanticAnalyzer &semanticAnalyzer);
+
+	LuaValue interpretBinaryOperator(const QSharedPointer<core::ast::Node> &root
+			, const core::SemanticAnalyzer &semanticAnalyzer);
+
+	LuaValue operateOnIndexingExpression(const QSharedPointer<core::ast::Node> &indexingExpression
 			, const core::SemanticAnalyzer &semanticAnalyzer
-			, const std::function<QVariant(const QString &
-					, const QVariantList &
+			, const std::function<LuaValue(const QString &
+					, const LuaValue::Table &
 					, const QVector<int> &
 					, const core::Connection &)> &action);
 
-	QVariant constructTable(const QSharedPointer<core::ast::Node> &tableConstructor
+	LuaValue constructTable(const QSharedPointer<core::ast::Node> &tableConstructor
 			, const core::SemanticAnalyzer &semanticAnalyzer);
 
-	void assignToTableElement(const QSharedPointer<core::ast::Node> &variable, const QVariant &interpretedValue
+	void assignToTableElement(const QSharedPointer<core::ast::Node> &variable, const LuaValue &interpretedValue
 			, const core::SemanticAnalyzer &semanticAnalyzer);
 
-	QVariantList doAssignToTableElement(const QVariantList &table
-			, const QVariant &value
+	LuaValue::Table doAssignToTableElement(const LuaValue::Table &table
+			, const LuaValue &value
 			, const QVector<int> &index
 			, const core::Connection &connection);
 
-	QVariant slice(const QSharedPointer<core::ast::Node> &indexingExpression
+	LuaValue slice(const QSharedPointer<core::ast::Node> &indexingExpression
 			, const core::SemanticAnalyzer &semanticAnalyzer);
 
-	QVariant operateOnIndexingExpressionRecursive(const QSharedPointer<core::ast::Node> &indexingExpression
+	LuaValue operateOnIndexingExpressionRecursive(const QSharedPointer<core::ast::Node> &indexingExpression
 			, const QVector<int> &currentIndex, const core::SemanticAnalyzer &semanticAnalyzer
-			, const std::function<QVariant(const QString &
-					, const QVariantList &
+			, const std::function<LuaValue(const QString &
+					, const LuaValue::Table &
 					, const QVector<int> &
 					, const core::Connection &)> &action);
 
-	QHash<QString, QVariant> mIdentifierValues;
-	QHash<QString, std::function<QVariant(const QList<QVariant> &)>> mIntrinsicFunctions;
+	/// Maps identifier names to indices of their slots in mValues, mDefined and mReadOnly.
+	QHash<QString, int> mSlots;
+	QVector<LuaValue> mValues;
 
-	/// A set of variables which can be modified only by setVariableValue() call (used to support sensor variables and
+	/// True for slots of identifiers that have values, identifiers with false here are unknown.
+	QVector<bool> mDefined;
+
+	/// True for variables which can be modified only by setVariableValue() call (used to support sensor variables and
 	/// ailases)
-	QSet<QString> mReadOnlyVariables;
+	QVector<bool> mReadOnly;
+
+	QHash<QString, int> mFunctionIndices;
+	QVector<IntrinsicFunction> mIntrinsicFunctions;
 
 	QList<core::Error> &mErrors;
 };
@@ -18,9 +18,328 @@ using namespace qrtext::lua;
 using namespace qrtext::lua::details;
 using namespace qrtext::core;
 
-LuaLexer::LuaLexer(QList<core::Error> &errors)
+/// Returns true if given character is a decimal digit as in [0-9].
+static bool isDigit(ushort character)
+{
+	return character >= '0' && character <= '9';
+}
+
+/// Returns true if given character is a hexadecimal digit as in [0-9a-fA-F].
+static bool isHexDigit(ushort character)
+{
+	return isDigit(character) || (character >= 'a' && character <= 'f') || (character >= 'A' && character <= 'F');
+}
+
+/// Returns true if given ASCII character may start an identifier.
+static bool isIdentifierStart(ushort character)
+{
+	return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') || character == '_';
+}
+
+/// Returns true if scanner can not be sure how "." in regexps treats given character: it depends on newline
+/// convention regexp engine was built with (and on validity of UTF-16 for surrogates).
+static bool isAmbiguousForDot(ushort character)
+{
+	return character == '\r' || character == 0x0b || character == 0x0c || character == 0x85
+			|| character == 0x2028 || character == 0x2029 || QChar::isSurrogate(character);
+}
+
+/// Returns a character at given position of input string or 0 if the position is past the end of input.
+static ushort at(const QString &input, int position)
+{
+	return position < input.length() ? input.at(position).unicode() : 0;
+}
+
+/// Returns the length of a run of characters satisfying given predicate starting at given position.
+static int run(const QString &input, int position, bool (*predicate)(ushort))
+{
+	int end = position;
+	while (end < input.length() && predicate(input.at(end).unicode())) {
+		++end;
+	}
+
+	return end - position;
+}
+
+/// Returns the length of an exponent value as in (([+-]digits+)|(digits*)) starting at given position.
+static int exponent(const QString &input, int position, bool (*isExponentDigit)(ushort))
+{
+	const ushort sign = at(input, position);
+	if ((sign == '+' || sign == '-') && isExponentDigit(at(input, position + 1))) {
+		return 1 + run(input, position + 1, isExponentDigit);
+	}
+
+	return run(input, position, isExponentDigit);
+}
+
+/// Returns the length of a float literal starting at given position or 0 if it does not match floatLiteral pattern.
+/// Alternatives are checked in the same order as regexp engine does.
+static int floatLiteral(const QString &input, int position)
+{
+	if (at(input, position) == '0' && (at(input, position + 1) == 'x' || at(input, position + 1) == 'X')
+			&& isHexDigit(at(input, position + 2)))
+	{
+		const int mantissaEnd = position + 2 + run(input, position + 2, isHexDigit);
+		const ushort next = at(input, mantissaEnd);
+		if (next == '.' && isHexDigit(at(input, mantissaEnd + 1))) {
+			const int fractionEnd = mantissaEnd + 1 + run(input, mantissaEnd + 1, isHexDigit);
+			const ushort exponentMark = at(input, fractionEnd);
+			return exponentMark == 'p' || exponentMark == 'P'
+					? fractionEnd + 1 + exponent(input, fractionEnd + 1, isHexDigit) - position
+					: fractionEnd - position;
+		}
+
+		if (next == 'p' || next == 'P') {
+			return mantissaEnd + 1 + exponent(input, mantissaEnd + 1, isHexDigit) - position;
+		}
+
+		// Decimal alternative can not match here too, there is 'x' after '0'.
+		return 0;
+	}
+
+	const int mantissaEnd = position + run(input, position, isDigit);
+	const ushort next = at(input, mantissaEnd);
+	if (next == '.' && isDigit(at(input, mantissaEnd + 1))) {
+		const int fractionEnd = mantissaEnd + 1 + run(input, mantissaEnd + 1, isDigit);
+		const ushort exponentMark = at(input, fractionEnd);
+		return exponentMark == 'e' || exponentMark == 'E'
+				? fractionEnd + 1 + exponent(input, fractionEnd + 1, isDigit) - position
+				: fractionEnd - position;
+	}
+
+	if (next == 'e' || next == 'E') {
+		return mantissaEnd + 1 + exponent(input, mantissaEnd + 1, isDigit) - position;
+	}
+
+	return 0;
+}
+
+/// Returns the length of an integer literal starting at given position (where a digit shall be).
+static int integerLiteral(const QString &input, int position)
+{
+	if (at(input, position) == '0' && (at(input, position + 1) == 'x' || at(input, position + 1) == 'X')
+			&& isHexDigit(at(input, position + 2)))
+	{
+		return 2 + run(input, position + 2, isHexDigit);
+	}
+
+	return run(input, position, isDigit);
+}
+
+LuaLexer::LuaLexer(QList<core::Error> &errors, Matcher matcher)
 	: Lexer<LuaTokenTypes>(initPatterns(), errors)
+	, mMatcher(matcher)
+{
+}
+
+int LuaLexer::findBestMatch(const QString &input, int absolutePosition, LuaTokenTypes &tokenType) const
+{
+	if (mMatcher == Matcher::scanner) {
+		const int length = scan(input, absolutePosition, tokenType);
+		if (length >= 0) {
+			return length;
+		}
+	}
+
+	return Lexer<LuaTokenTypes>::findBestMatch(input, absolutePosition, tokenType);
+}
+
+int LuaLexer::scan(const QString &input, int absolutePosition, LuaTokenTypes &tokenType) const
 {
+	const ushort current = at(input, absolutePosition);
+	const ushort next = at(input, absolutePosition + 1);
+
+	// Lexemes of single character or of a character followed by the same or by '='.
+	const auto oneOrTwo = [&tokenType, next](LuaTokenTypes single, ushort second, LuaTokenTypes pair) {
+		if (next == second) {
+			tokenType = pair;
+			return 2;
+		}
+
+		tokenType = single;
+		return 1;
+	};
+
+	if (current >= 0x80) {
+		// Non-ASCII identifiers are rare, leaving the question of what is a letter to regexps.
+		return -1;
+	}
+
+	if (isIdentifierStart(current)) {
+		int end = absolutePosition + 1;
+		while (end < input.length()) {
+			const ushort character = input.at(end).unicode();
+			if (isIdentifierStart(character) || isDigit(character)) {
+				++end;
+			} else if (character >= 0x80) {
+				return -1;
+			} else {
+				break;
+			}
+		}
+
+		tokenType = LuaTokenTypes::identifier;
+		return end - absolutePosition;
+	}
+
+	if (isDigit(current)) {
+		const int integerLength = integerLiteral(input, absolutePosition);
+		const int floatLength = floatLiteral(input, absolutePosition);
+		if (floatLength > integerLength) {
+			tokenType = LuaTokenTypes::floatLiteral;
+			return floatLength;
+		}
+
+		tokenType = LuaTokenTypes::integerLiteral;
+		return integerLength;
+	}
+
+	switch (current) {
+	case ' ':
+	case '\t':
+		tokenType = LuaTokenTypes::whitespace;
+		return run(input, absolutePosition, [](ushort character) { return character == ' ' || character == '\t'; });
+	case '\n':
+		tokenType = LuaTokenTypes::newline;
+		return 1;
+	case '"':
+	case '\'': {
+		int end = absolutePosition + 1;
+		while (end < input.length()) {
+			const ushort character = input.at(end).unicode();
+			if (character == current) {
+				tokenType = LuaTokenTypes::string;
+				return end + 1 - absolutePosition;
+			}
+
+			if (QChar::isSurrogate(character)) {
+				return -1;
+			}
+
+			if (character == '\\') {
+				if (end + 1 >= input.length()) {
+					return 0;
+				}
+
+				if (isAmbiguousForDot(input.at(end + 1).unicode())) {
+					return -1;
+				}
+
+				++end;
+			}
+
+			++end;
+		}
+
+		// Unterminated string does not match.
+		return 0;
+	}
+	case '-':
+		if (next == '-') {
+			int end = absolutePosition + 2;
+			while (end < input.length() && input.at(end) != '\n') {
+				if (isAmbiguousForDot(input.at(end).unicode())) {
+					return -1;
+				}
+
+				++end;
+			}
+
+			tokenType = LuaTokenTypes::comment;
+			return end - absolutePosition;
+		}
+
+		tokenType = LuaTokenTypes::minus;
+		return 1;
+	case '+':
+		tokenType = LuaTokenTypes::plus;
+		return 1;
+	case '*':
+		tokenType = LuaTokenTypes::asterick;
+		return 1;
+	case '/':
+		return oneOrTwo(LuaTokenTypes::slash, '/', LuaTokenTypes::doubleSlash);
+	case '%':
+		tokenType = LuaTokenTypes::percent;
+		return 1;
+	case '^':
+		tokenType = LuaTokenTypes::hat;
+		return 1;
+	case '#':
+		tokenType = LuaTokenTypes::sharp;
+		return 1;
+	case '&':
+		return oneOrTwo(LuaTokenTypes::ampersand, '&', LuaTokenTypes::doubleAmpersand);
+	case '|':
+		return oneOrTwo(LuaTokenTypes::verticalLine, '|', LuaTokenTypes::doubleVerticalLine);
+	case '~':
+		return oneOrTwo(LuaTokenTypes::tilda, '=', LuaTokenTypes::tildaEquals);
+	case '=':
+		return oneOrTwo(LuaTokenTypes::equals, '=', LuaTokenTypes::doubleEquals);
+	case '!':
+		if (next == '=') {
+			tokenType = LuaTokenTypes::exclamationMarkEquals;
+			return 2;
+		}
+
+		return 0;
+	case '<':
+		if (next == '<') {
+			tokenType = LuaTokenTypes::doubleLess;
+			return 2;
+		}
+
+		return oneOrTwo(LuaTokenTypes::less, '=', LuaTokenTypes::lessEquals);
+	case '>':
+		if (next == '>') {
+			tokenType = LuaTokenTypes::doubleGreater;
+			return 2;
+		}
+
+		return oneOrTwo(LuaTokenTypes::greater, '=', LuaTokenTypes::greaterEquals);
+	case '(':
+		tokenType = LuaTokenTypes::openingBracket;
+		return 1;
+	case ')':
+		tokenType = LuaTokenTypes::closingBracket;
+		return 1;
+	case '{':
+		tokenType = LuaTokenTypes::openingCurlyBracket;
+		return 1;
+	case '}':
+		tokenType = LuaTokenTypes::closingCurlyBracket;
+		return 1;
+	case '[':
+		tokenType = LuaTokenTypes::openingSquareBracket;
+		return 1;
+	case ']':
+		tokenType = LuaTokenTypes::closingSquareBracket;
+		return 1;
+	case ':':
+		return oneOrTwo(LuaTokenTypes::colon, ':', LuaTokenTypes::doubleColon);
+	case ';':
+		tokenType = LuaTokenTypes::semicolon;
+		return 1;
+	case ',':
+		tokenType = LuaTokenTypes::comma;
+		return 1;
+	case '.':
+		if (next == '.') {
+			if (at(input, absolutePosition + 2) == '.') {
+				tokenType = LuaTokenTypes::tripleDot;
+				return 3;
+			}
+
+			tokenType = LuaTokenTypes::doubleDot;
+			return 2;
+		}
+
+		tokenType = LuaTokenTypes::dot;
+		return 1;
+	default:
+		// No token starts with this character.
+		return 0;
+	}
 }
 
 TokenPatterns<LuaTokenTypes> LuaLexer::initPatterns()
@@ -24,19 +24,40 @@ namespace lua {
 namespace details {
 
 /// Lexer of something like Lua 5.3 based on regular expressions. Provides a list of tokens by given input string.
-/// Allows Unicode input.
+/// Allows Unicode input. By default lexemes are matched by hand-written scanner that gives the same results as
+/// token regexps (and falls back to them on input where equivalence is hard to guarantee, like non-ASCII
+/// identifiers), but is much faster.
 ///
 /// Now lexer (with default token patterns) follows Lua 5.3 specification with following exceptions:
 /// - long brackets are not supported, either for string literals or for comments.
 class LuaLexer: public core::Lexer<LuaTokenTypes>
 {
 public:
+	/// The way lexemes are matched.
+	enum class Matcher
+	{
+		/// Hand-written scanner specialized for Lua tokens.
+		scanner
+		/// Generic matching with all token regexps, slow but serves as a reference.
+		, regexps
+	};
+
 	/// Constructor.
 	/// @param errors - error stream to report errors to.
-	LuaLexer(QList<core::Error> &errors);
+	/// @param matcher - the way lexemes are matched.
+	LuaLexer(QList<core::Error> &errors, Matcher matcher = Matcher::scanner);
+
+protected:
+	int findBestMatch(const QString &input, int absolutePosition, LuaTokenTypes &tokenType) const override;
 
 private:
 	static core::TokenPatterns<LuaTokenTypes> initPatterns();
+
+	/// Scans a lexeme starting at given position. Returns its length, 0 if there is no lexeme at given position or
+	/// -1 if scanner is not sure that it will give the same result as regexps.
+	int scan(const QString &input, int absolutePosition, LuaTokenTypes &tokenType) const;
+
+	const Matcher mMatcher;
 };
 
 }
@@ -21,10 +21,26 @@
 #include "qrtext/src/lua/luaSemanticAnalyzer.h"
 #include "qrtext/src/lua/luaInterpreter.h"
 
+#include "qrtext/lua/ast/identifier.h"
+
 using namespace qrtext::lua;
 using namespace qrtext::core;
 using namespace qrtext::core::ast;
 
+/// Adds names of all identifiers used in the given AST to @a result.
+static void collectIdentifiers(const QSharedPointer<Node> &node, QSet<QString> &result)
+{
+	if (node->is<qrtext::lua::ast::Identifier>()) {
+		result << qrtext::as<qrtext::lua::ast::Identifier>(node)->name();
+	}
+
+	for (const auto &child : node->children()) {
+		if (!child.isNull()) {
+			collectIdentifiers(child, result);
+		}
+	}
+}
+
 LuaToolbox::LuaToolbox()
 	: mLexer(new details::LuaLexer(mErrors))
 	, mParser(new details::LuaParser(mErrors))
@@ -39,9 +55,14 @@ LuaToolbox::~LuaToolbox()
 
 QVariant LuaToolbox::interpret(QSharedPointer<Node> const &root)
 {
-	const auto result = mInterpreter->interpret(root, *mAnalyzer);
+	auto program = mPrograms.constFind(root.data());
+	if (program == mPrograms.constEnd()) {
+		program = mPrograms.insert(root.data(), mInterpreter->compile(root, *mAnalyzer));
+	}
+
+	const auto result = (*program)();
 	reportErrors();
-	return result;
+	return result.toVariant();
 }
 
 void LuaToolbox::interpret(const qReal::Id &id, const QString &propertyName, const QString &code)
@@ -68,6 +89,8 @@ QSharedPointer<Node> const &LuaToolbox::parse(const qReal::Id &id, const QString
 
 		if (mErrors.isEmpty()) {
 			mAnalyzer->forget(mAstRoots[id][propertyName]);
+			forgetAnalysis(mAstRoots[id][propertyName]);
+			mPrograms.remove(mAstRoots[id][propertyName].data());
 			mAstRoots[id][propertyName] = ast;
 		}
 
@@ -77,7 +100,7 @@ QSharedPointer<Node> const &LuaToolbox::parse(const qReal::Id &id, const QString
 	}
 
 	if (mErrors.isEmpty()) {
-		mAnalyzer->analyze(ast);
+		analyze(ast);
 	}
 
 	if (!mErrors.isEmpty()) {
@@ -107,6 +130,21 @@ void LuaToolbox::addIntrinsicFunction(const QString &name
 		, core::types::TypeExpression * const returnType
 		, const QList<core::types::TypeExpression *> &parameterTypes
 		, const std::function<QVariant(const QList<QVariant> &)> &semantic)
+{
+	addNativeFunction(name, returnType, parameterTypes, [semantic](const QVector<LuaValue> &params) {
+		QList<QVariant> variantParams;
+		for (const LuaValue &param : params) {
+			variantParams << param.toVariant();
+		}
+
+		return LuaValue::fromVariant(semantic(variantParams));
+	});
+}
+
+void LuaToolbox::addNativeFunction(const QString &name
+		, core::types::TypeExpression * const returnType
+		, const QList<core::types::TypeExpression *> &parameterTypes
+		, const std::function<LuaValue(const QVector<LuaValue> &)> &semantic)
 {
 	QList<QSharedPointer<core::types::TypeExpression>> wrappedParameterTypes;
 	for (core::types::TypeExpression * const type : parameterTypes) {
@@ -147,6 +185,7 @@ void LuaToolbox::forgetIdentifier(const QString &identifier)
 {
 	mInterpreter->forgetIdentifier(identifier);
 	mAnalyzer->removeReadOnlyVariable(identifier);
+	invalidateAnalysis(identifier);
 }
 
 void LuaToolbox::markAsSpecialConstant(const QString &identifier)
@@ -165,25 +204,29 @@ void LuaToolbox::markAsSpecial(const QString &identifier)
 
 	mInterpreter->addReadOnlyVariable(identifier);
 	mAnalyzer->addReadOnlyVariable(identifier);
+	invalidateAnalysis(identifier);
 }
 
 QVariant LuaToolbox::value(const QString &identifier) const
 {
-	return mInterpreter->value(identifier);
+	return mInterpreter->value(identifier).toVariant();
 }
 
-void LuaToolbox::setVariableValue(const QString &name, const QString &initCode, const QVariant &value)
+void LuaToolbox::setVariableValue(const QString &name, const std::function<QString()> &initCode
+		, const QVariant &value)
 {
-	if (!mInterpreter->identifiers().contains(name)) {
-		parse(qReal::Id(), "", initCode);
+	if (!mInterpreter->isDefined(name)) {
+		parse(qReal::Id(), "", initCode());
 	}
 
-	mInterpreter->setVariableValue(name, value);
+	mInterpreter->setVariableValue(name, LuaValue::fromVariant(value));
 }
 
 void LuaToolbox::clear()
 {
 	mAnalyzer->clear();
+	mAnalyzedRoots.clear();
+	mIdentifierUsers.clear();
 	mInterpreter->clear();
 	mSpecialConstants.clear();
 	mSpecialIdentifiers.clear();
@@ -195,6 +238,85 @@ bool LuaToolbox::isGeneralization(const QSharedPointer<qrtext::core::types::Type
 	return mAnalyzer->isGeneralization(specific, general);
 }
 
+void LuaToolbox::analyze(const QSharedPointer<Node> &root)
+{
+	if (!root || mAnalyzedRoots.contains(root.data())) {
+		return;
+	}
+
+	const QHash<QString, QString> typesBefore = variableTypeNames();
+	mAnalyzer->analyze(root);
+	const QHash<QString, QString> typesAfter = variableTypeNames();
+
+	// Other code may have been analyzed with old types of identifiers, it shall be checked again.
+	for (auto it = typesBefore.constBegin(); it != typesBefore.constEnd(); ++it) {
+		if (typesAfter.value(it.key()) != it.value()) {
+			invalidateAnalysis(it.key());
+		}
+	}
+
+	if (!mErrors.isEmpty()) {
+		// Code with errors is analyzed each time, so its errors are reported each time.
+		return;
+	}
+
+	QSet<QString> identifiers;
+	collectIdentifiers(root, identifiers);
+	for (const QString &identifier : identifiers) {
+		mIdentifierUsers[identifier].insert(root.data());
+	}
+
+	mAnalyzedRoots.insert(root.data(), identifiers);
+}
+
+void LuaToolbox::forgetAnalysis(const QSharedPointer<Node> &root)
+{
+	const auto analyzed = mAnalyzedRoots.find(root.data());
+	if (analyzed == mAnalyzedRoots.end()) {
+		return;
+	}
+
+	for (const QString &identifier : analyzed.value()) {
+		const auto users = mIdentifierUsers.find(identifier);
+		if (users != mIdentifierUsers.end()) {
+			users->remove(root.data());
+			if (users->isEmpty()) {
+				mIdentifierUsers.erase(users);
+			}
+		}
+	}
+
+	mAnalyzedRoots.erase(analyzed);
+}
+
+void LuaToolbox::invalidateAnalysis(const QString &identifier)
+{
+	const QSet<const Node *> users = mIdentifierUsers.take(identifier);
+	for (const Node * const user : users) {
+		const QSet<QString> identifiers = mAnalyzedRoots.take(user);
+		for (const QString &other : identifiers) {
+			const auto otherUsers = mIdentifierUsers.find(other);
+			if (otherUsers != mIdentifierUsers.end()) {
+				otherUsers->remove(user);
+				if (otherUsers->isEmpty()) {
+					mIdentifierUsers.erase(otherUsers);
+				}
+			}
+		}
+	}
+}
+
+QHash<QString, QString> LuaToolbox::variableTypeNames() const
+{
+	QHash<QString, QString> result;
+	const auto types = mAnalyzer->variableTypes();
+	for (auto it = types.constBegin(); it != types.constEnd(); ++it) {
+		result.insert(it.key(), it.value() ? it.value()->toString() : QString());
+	}
+
+	return result;
+}
+
 void LuaToolbox::reportErrors()
 {
 	for (const qrtext::core::Error &error : mErrors) {
@@ -0,0 +1,232 @@
+/* Copyright 2007-2016 QReal Research Group
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+#include "qrtext/lua/luaValue.h"
+
+#include <QtCore/QStringList>
+
+using namespace qrtext::lua;
+
+LuaValue::LuaValue()
+	: mType(Type::nil)
+	, mInteger(0)
+{
+}
+
+LuaValue::LuaValue(bool value)
+	: mType(Type::boolean)
+	, mBoolean(value)
+{
+}
+
+LuaValue::LuaValue(int value)
+	: mType(Type::integer)
+	, mInteger(value)
+{
+}
+
+LuaValue::LuaValue(double value)
+	: mType(Type::number)
+	, mNumber(value)
+{
+}
+
+LuaValue::LuaValue(const QString &value)
+	: mType(Type::string)
+	, mInteger(0)
+	, mString(value)
+{
+}
+
+LuaValue::LuaValue(const Table &value)
+	: mType(Type::table)
+	, mInteger(0)
+	, mTable(new Table(value))
+{
+}
+
+LuaValue LuaValue::fromVariant(const QVariant &value)
+{
+	switch (value.userType()) {
+	case QMetaType::UnknownType:
+		return LuaValue();
+	case QMetaType::Bool:
+		return LuaValue(value.toBool());
+	case QMetaType::Int:
+		return LuaValue(value.toInt());
+	case QMetaType::Double:
+		return LuaValue(value.toDouble());
+	case QMetaType::QString:
+		return LuaValue(value.toString());
+	case QMetaType::QVariantList: {
+		Table table;
+		for (const QVariant &element : value.toList()) {
+			table << fromVariant(element);
+		}
+
+		return LuaValue(table);
+	}
+	case QMetaType::QStringList: {
+		Table table;
+		for (const QString &element : value.toStringList()) {
+			table << LuaValue(element);
+		}
+
+		return LuaValue(table);
+	}
+	default: {
+		LuaValue result;
+		result.mType = Type::variant;
+		result.mVariant = value;
+		return result;
+	}
+	}
+}
+
+QVariant LuaValue::toVariant() const
+{
+	switch (mType) {
+	case Type::nil:
+		return QVariant();
+	case Type::boolean:
+		return QVariant(mBoolean);
+	case Type::integer:
+		return QVariant(mInteger);
+	case Type::number:
+		return QVariant(mNumber);
+	case Type::string:
+		return QVariant(mString);
+	case Type::table: {
+		QVariantList result;
+		for (const LuaValue &element : *mTable) {
+			result << element.toVariant();
+		}
+
+		return QVariant(result);
+	}
+	case Type::variant:
+		return mVariant;
+	}
+
+	return QVariant();
+}
+
+LuaValue::Type LuaValue::type() const
+{
+	return mType;
+}
+
+bool LuaValue::isNull() const
+{
+	switch (mType) {
+	case Type::nil:
+		return true;
+	case Type::string:
+		return mString.isNull();
+	case Type::variant:
+		return mVariant.isNull();
+	default:
+		return false;
+	}
+}
+
+bool LuaValue::toBool() const
+{
+	switch (mType) {
+	case Type::nil:
+		return false;
+	case Type::boolean:
+		return mBoolean;
+	case Type::integer:
+		return mInteger != 0;
+	default:
+		// Conversions of numbers and strings to bool have peculiar rules, leaving them to QVariant.
+		return toVariant().toBool();
+	}
+}
+
+int LuaValue::toInt() const
+{
+	switch (mType) {
+	case Type::nil:
+		return 0;
+	case Type::boolean:
+		return mBoolean ? 1 : 0;
+	case Type::integer:
+		return mInteger;
+	default:
+		return toVariant().toInt();
+	}
+}
+
+double LuaValue::toDouble() const
+{
+	switch (mType) {
+	case Type::nil:
+		return 0.0;
+	case Type::boolean:
+		return mBoolean ? 1.0 : 0.0;
+	case Type::integer:
+		return mInteger;
+	case Type::number:
+		return mNumber;
+	default:
+		return toVariant().toDouble();
+	}
+}
+
+QString LuaValue::toString() const
+{
+	return mType == Type::string ? mString : toVariant().toString();
+}
+
+LuaValue::Table LuaValue::toTable() const
+{
+	switch (mType) {
+	case Type::table:
+		return *mTable;
+	case Type::nil:
+	case Type::boolean:
+	case Type::integer:
+	case Type::number:
+		return Table();
+	default:
+		return fromVariant(QVariant(toVariant().value<QVariantList>())).toTable();
+	}
+}
+
+bool LuaValue::operator ==(const LuaValue &other) const
+{
+	if (mType == other.mType) {
+		switch (mType) {
+		case Type::nil:
+			return true;
+		case Type::boolean:
+			return mBoolean == other.mBoolean;
+		case Type::integer:
+			return mInteger == other.mInteger;
+		case Type::string:
+			return mString == other.mString;
+		default:
+			break;
+		}
+	}
+
+	return toVariant() == other.toVariant();
+}
+
+bool LuaValue::operator !=(const LuaValue &other) const
+{
+	return !(*this == other);
+}
@@ -52,3 +52,15 @@ tests {
 	trikStudioSimulatorTests.depends =  qrgui
 }
 
+benchmarks {
+
+	SUBDIRS += \
+		benchmarks \
+
+	benchmarks.subdir = $$PWD/qrtest/benchmarks
+
+	benchmarks.depends = \
+		qrkernel \
+		qrtext \
+		thirdparty \
+}